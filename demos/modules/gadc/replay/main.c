@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Measure how many high speed ADC conversions a slow consumer loses.
+ *
+ * This runs on a host (eg. the ChibiOS POSIX simulator or Win32) using the
+ * GADC replay driver (drivers/gadc/Replay) in stepped mode. It writes
+ * SAMPLE_FILE, a ramp that counts the timer ticks, and replays it into a
+ * stream. The consumer only looks at the stream every few ticks. As each
+ * conversion holds the number of its tick, the consumer can count the
+ * conversions it never saw. These are the stream's overruns (dropped as the
+ * ring was full) plus any that were still being converted when the stream
+ * was stopped.
+ *
+ * Nothing here depends on the clock so the counts are the same on every
+ * run. It returns the number of consumers whose counts don't add up.
+ */
+
+#include <stdio.h>
+#include "gfx.h"
+
+#define SAMPLE_FILE		GADC_REPLAY_FILENAME
+#define SAMPLE_ROWS		4096			// The ramp wraps at 12 bits
+#define FREQUENCY		8000			// Only sets the share of the ticks for each stream
+#define RING_SIZE		128				// Conversions
+#define WATERMARK		32
+#define RUN_TICKS		20000			// Ticks for each consumer
+
+static const unsigned	PollEvery[] = { 16, 64, 128, 256 };	// Ticks between each look at the stream
+
+static GADCStream		stream;
+static adcsample_t		ring[RING_SIZE];
+
+static bool_t writeRamp(void) {
+	FILE		*f;
+	unsigned	i;
+
+	if (!(f = fopen(SAMPLE_FILE, "w")))
+		return FALSE;
+	fprintf(f, "# A ramp for the gadc replay demo\n");
+	for(i = 0; i < SAMPLE_ROWS; i++)
+		fprintf(f, "%u\n", i);
+	fclose(f);
+	return TRUE;
+}
+
+int main(void) {
+	adcsample_t		*p;
+	uint32_t		ticks0, missed0, ticks, missed, overruns, seen, unseen;
+	unsigned		i, done, step, expect;
+	size_t			n, k;
+	int				failed;
+
+	if (!writeRamp()) {
+		printf("Can't write %s\n", SAMPLE_FILE);
+		return 1;
+	}
+	gfxInit();
+
+	printf("Poll every  Ticks  Missed   Seen  Unseen  Overruns  In flight\n");
+	failed = 0;
+	for(i = 0; i < sizeof(PollEvery)/sizeof(PollEvery[0]); i++) {
+		gadcStreamInit(&stream, GADC_PHYSDEV_MICROPHONE, FREQUENCY, ring, RING_SIZE, WATERMARK);
+		gadcStreamStart(&stream);
+		gadcReplayGetCounts(&ticks0, &missed0);
+
+		// Row n of the file is converted on tick n
+		seen = unseen = overruns = 0;
+		expect = ticks0 % SAMPLE_ROWS;
+		for(done = 0; done < RUN_TICKS; done += step) {
+			step = RUN_TICKS - done < PollEvery[i] ? RUN_TICKS - done : PollEvery[i];
+			gadcReplayStep(step);
+
+			// Take everything that is ready. It may come in two pieces if it wraps around the ring.
+			while((n = gadcStreamAcquire(&stream, &p, TIME_IMMEDIATE))) {
+				for(k = 0; k < n; k++) {
+					unseen += (p[k] + SAMPLE_ROWS - expect) % SAMPLE_ROWS;
+					expect = (p[k] + 1) % SAMPLE_ROWS;
+				}
+				seen += n;
+				gadcStreamRelease(&stream, n);
+			}
+			overruns += gadcStreamGetOverruns(&stream);
+		}
+
+		gadcStreamStop(&stream);
+		gadcReplayGetCounts(&ticks, &missed);
+		unseen += (ticks + SAMPLE_ROWS - expect) % SAMPLE_ROWS;		// Those after the last one seen
+		ticks -= ticks0;
+		missed -= missed0;
+		printf("%10u %6u %7u %6u %7u %9u %10d%s\n", PollEvery[i], (unsigned)ticks, (unsigned)missed,
+				(unsigned)seen, (unsigned)unseen, (unsigned)overruns, (int)(unseen - overruns),
+				ticks == seen + unseen + missed && unseen >= overruns ? "" : "  <- doesn't add up");
+		if (ticks != seen + unseen + missed || unseen < overruns)
+			failed++;
+	}
+	return failed;
+}
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * A rendering regression test.
+ *
+ * Each scene is drawn into the in-memory Framebuffer driver in each of the
+ * four orientations. The framebuffer is then compared, pixel by pixel, with
+ * the golden image golden/<scene>_<pixelformat>_<orientation>.bmp and the
+ * first pixel that differs is reported (in the unrotated coordinates of the
+ * framebuffer). A missing golden image is a failure. A failing result is
+ * written as golden/<scene>_<pixelformat>_<orientation>_fail.bmp for a
+ * closer look.
+ *
+ * The golden images for the pixel format in gfxconf.h are kept alongside
+ * this demo. To record them for another pixel format, or after a change
+ * that is meant to alter what is drawn, set RECORD_GOLDEN to TRUE and run
+ * it once on a known good build. Then check the new images by eye.
+ *
+ * Each scene is also drawn REPEATS times and the average time is shown. Run
+ * it before and after changing the drawing code.
+ *
+ * This runs on a host (eg. the ChibiOS POSIX simulator or Win32) and returns
+ * the number of failures.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "gfx.h"
+#include "framebuffer.h"
+
+#define REPEATS			50				// Times each scene is drawn for timing
+#define GOLDEN_DIR		"golden/"
+#define RECORD_GOLDEN	FALSE			// TRUE to write the golden images rather than check them
+
+#if GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB565
+	#define FORMAT_NAME		"rgb565"
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB888
+	#define FORMAT_NAME		"rgb888"
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB444
+	#define FORMAT_NAME		"rgb444"
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB332
+	#define FORMAT_NAME		"rgb332"
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB666
+	#define FORMAT_NAME		"rgb666"
+#else
+	#define FORMAT_NAME		"custom"
+#endif
+
+static const color_t	*fb;
+static coord_t			fbwidth, fbheight;
+static font_t			font1, font2;
+static char				failmsg[120];
+
+/*-------------------------------------------------------------------------
+ * The scenes. Each draws on a cleared display using its current size.
+ *-------------------------------------------------------------------------*/
+
+static void sceneLines(coord_t w, coord_t h) {
+	coord_t	i;
+
+	for(i = 0; i < w; i += 8)
+		gdispDrawLine(0, 0, i, h-1, Yellow);
+	for(i = 0; i < h; i += 8)
+		gdispDrawLine(w-1, 0, 0, i, Cyan);
+	gdispDrawLine(0, h/2, w-1, h/2, White);
+	gdispDrawLine(w/2, 0, w/2, h-1, White);
+	gdispDrawBox(4, 4, w-8, h-8, Red);
+	for(i = 0; i < 32; i++)
+		gdispDrawPixel(10+i*3, 10+i, Green);
+}
+
+static void sceneFills(coord_t w, coord_t h) {
+	static const color_t	colors[] = { Red, Green, Blue, Yellow, Cyan, Magenta, White, Gray };
+	coord_t					i;
+
+	for(i = 0; i < 8; i++)
+		gdispFillArea(i*w/8, 0, w/8, h/2, colors[i]);
+	for(i = 0; i < 8; i++)
+		gdispFillArea(w/4+i*3, h/2+i*3, w/2-i*6, h/2-i*6-4, colors[7-i]);
+	gdispFillArea(-10, h-10, 30, 30, White);		// Partly off the display
+}
+
+#if GDISP_NEED_CIRCLE && GDISP_NEED_ELLIPSE && GDISP_NEED_ARC
+	static void sceneCircles(coord_t w, coord_t h) {
+		gdispDrawCircle(w/4, h/4, h/5, White);
+		gdispFillCircle(3*w/4, h/4, h/5, Red);
+		gdispDrawEllipse(w/4, 3*h/4, w/6, h/8, Green);
+		gdispFillEllipse(3*w/4, 3*h/4, w/6, h/8, Blue);
+		gdispDrawArc(w/2, h/2, h/6, 30, 240, Yellow);
+		gdispFillArc(w/2, h/2, h/10, 300, 60, Magenta);
+		gdispDrawRoundedBox(8, 8, w/3, h/3, 6, Cyan);
+		gdispFillRoundedBox(w-8-w/3, h-8-h/3, w/3, h/3, 6, Gray);
+		gdispFillCircle(0, 0, 20, White);				// Partly off the display
+	}
+#endif
+
+static void sceneText(coord_t w, coord_t h) {
+	gdispDrawString(2, 2, "The quick brown fox", font1, White);
+	gdispDrawString(2, 20, "jumps over the lazy dog 0123456789", font2, Yellow);
+	gdispFillString(2, 36, "Filled text", font1, Black, Green);
+	gdispFillStringBox(0, h/2, w, 20, "Centered", font1, White, Blue, justifyCenter);
+	gdispFillStringBox(0, h/2+24, w, 20, "Right", font2, Black, Cyan, justifyRight);
+	gdispDrawStringBox(0, h-20, w, 20, "Left", font2, Red, justifyLeft);
+}
+
+static void sceneBlit(coord_t w, coord_t h) {
+	static pixel_t	buf[32*24];
+	coord_t			x, y;
+
+	for(y = 0; y < 24; y++)
+		for(x = 0; x < 32; x++)
+			buf[y*32+x] = RGB2COLOR(x*8, y*10, (x^y)*8);
+	gdispBlitArea(4, 4, 32, 24, buf);
+	gdispBlitAreaEx(w/2, h/2, 16, 12, 8, 6, 32, buf);		// Part of the buffer
+	gdispBlitArea(w-16, h-12, 32, 24, buf);					// Partly off the display
+	gdispBlitArea(-16, h/2, 32, 24, buf);
+}
+
+#if GDISP_NEED_CONVEX_POLYGON
+	static void scenePoly(coord_t w, coord_t h) {
+		static const point	star[] = { {0,-30}, {8,-10}, {30,-10}, {12,4}, {20,28}, {0,14}, {-20,28}, {-12,4}, {-30,-10}, {-8,-10} };
+		static const point	diamond[] = { {0,-30}, {30,0}, {0,30}, {-30,0} };
+		static const point	tri[] = { {0,0}, {50,10}, {10,40} };
+
+		gdispDrawPoly(w/4, h/2, star, sizeof(star)/sizeof(star[0]), White);
+		gdispFillConvexPoly(3*w/4, h/2, diamond, sizeof(diamond)/sizeof(diamond[0]), Red);
+		gdispFillConvexPoly(4, 4, tri, sizeof(tri)/sizeof(tri[0]), Green);
+		gdispFillConvexPoly(w-20, h-20, diamond, sizeof(diamond)/sizeof(diamond[0]), Blue);	// Partly off the display
+	}
+#endif
+
+#if GDISP_NEED_CLIP
+	static void sceneClip(coord_t w, coord_t h) {
+		coord_t	i;
+
+		gdispSetClip(w/4, h/4, w/2, h/2);
+		for(i = 0; i < w; i += 6)
+			gdispDrawLine(i, 0, w-1-i, h-1, Yellow);
+		gdispFillArea(0, h/2-4, w, 8, Red);
+		gdispDrawString(w/4-10, h/4+4, "Clipped text that is too long", font1, White);
+		#if GDISP_NEED_CIRCLE
+			gdispFillCircle(w/4, h/4, 20, Green);
+		#endif
+		gdispUnsetClip();
+	}
+#endif
+
+#if GFX_USE_GWIN && GWIN_NEED_CONSOLE
+	static void sceneConsole(coord_t w, coord_t h) {
+		static GConsoleObject	gc;
+		GHandle					gh;
+		unsigned				i;
+
+		gh = gwinCreateConsole(&gc, 8, 8, w-16, h-16, font2);
+		gwinSetColor(gh, Black);
+		gwinSetBgColor(gh, White);
+		gwinClear(gh);
+		for(i = 0; i < 40; i++)						// Enough to make it scroll
+			gwinPutString(gh, "The console wraps long lines and scrolls. ");
+		gwinDestroyWindow(gh);
+	}
+#endif
+
+static const struct scene {
+	const char	*name;
+	void		(*draw)(coord_t w, coord_t h);
+} scenes[] = {
+	{ "lines",		sceneLines },
+	{ "fills",		sceneFills },
+	#if GDISP_NEED_CIRCLE && GDISP_NEED_ELLIPSE && GDISP_NEED_ARC
+		{ "circles",	sceneCircles },
+	#endif
+	{ "text",		sceneText },
+	{ "blit",		sceneBlit },
+	#if GDISP_NEED_CONVEX_POLYGON
+		{ "poly",		scenePoly },
+	#endif
+	#if GDISP_NEED_CLIP
+		{ "clip",		sceneClip },
+	#endif
+	#if GFX_USE_GWIN && GWIN_NEED_CONSOLE
+		{ "console",	sceneConsole },
+	#endif
+};
+#define NUM_SCENES	(sizeof(scenes)/sizeof(scenes[0]))
+
+/*-------------------------------------------------------------------------
+ * Golden images. These are 24 bit BMP files of the unrotated framebuffer.
+ *-------------------------------------------------------------------------*/
+
+static void putLE(uint8_t *p, uint32_t v, unsigned bytes) {
+	while(bytes--) {
+		*p++ = (uint8_t)v;
+		v >>= 8;
+	}
+}
+
+static uint32_t getLE(const uint8_t *p, unsigned bytes) {
+	uint32_t	v;
+
+	for(v = 0, p += bytes; bytes--; )
+		v = (v << 8) | *--p;
+	return v;
+}
+
+#define BMP_HDRSIZE		54
+#define BMP_PADDING		((4 - (fbwidth*3) % 4) % 4)		// Each line is a multiple of 4 bytes
+
+static bool_t writeBMP(const char *fname) {
+	uint8_t			hdr[BMP_HDRSIZE];
+	const color_t	*p;
+	coord_t			x, y;
+	FILE			*f;
+
+	if (!(f = fopen(fname, "wb")))
+		return FALSE;
+	memset(hdr, 0, sizeof(hdr));
+	hdr[0] = 'B'; hdr[1] = 'M';
+	putLE(hdr+2, BMP_HDRSIZE + (fbwidth*3 + BMP_PADDING) * fbheight, 4);
+	putLE(hdr+10, BMP_HDRSIZE, 4);
+	putLE(hdr+14, 40, 4);
+	putLE(hdr+18, fbwidth, 4);
+	putLE(hdr+22, fbheight, 4);
+	putLE(hdr+26, 1, 2);
+	putLE(hdr+28, 24, 2);
+	fwrite(hdr, 1, sizeof(hdr), f);
+
+	for(y = fbheight-1; y >= 0; y--) {					// BMP lines are bottom up
+		for(p = fb + y*fbwidth, x = 0; x < fbwidth; x++, p++) {
+			putc(BLUE_OF(*p), f);
+			putc(GREEN_OF(*p), f);
+			putc(RED_OF(*p), f);
+		}
+		for(x = 0; x < BMP_PADDING; x++)
+			putc(0, f);
+	}
+	return fclose(f) == 0;
+}
+
+/*
+ * Compare the framebuffer with a golden image and report the first pixel that differs.
+ * Returns -1 if there is no golden image, 0 if it matches or 1 if it doesn't (the reason is in failmsg).
+ */
+static int compareBMP(const char *fname) {
+	uint8_t			hdr[BMP_HDRSIZE];
+	uint8_t			bgr[3];
+	const color_t	*p;
+	coord_t			x, y, badx, bady;
+	color_t			badcolor;
+	uint8_t			badbgr[3];
+	unsigned long	bad;
+	FILE			*f;
+
+	if (!(f = fopen(fname, "rb")))
+		return -1;
+	if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr) || hdr[0] != 'B' || hdr[1] != 'M'
+			|| getLE(hdr+18, 4) != (uint32_t)fbwidth || getLE(hdr+22, 4) != (uint32_t)fbheight || getLE(hdr+28, 2) != 24) {
+		fclose(f);
+		sprintf(failmsg, "%s is not a %dx%d 24 bit BMP", fname, fbwidth, fbheight);
+		return 1;
+	}
+	fseek(f, getLE(hdr+10, 4), SEEK_SET);
+
+	bad = 0;
+	badx = bady = 0;
+	badcolor = 0;
+	for(y = fbheight-1; y >= 0; y--) {
+		for(p = fb + y*fbwidth, x = 0; x < fbwidth; x++, p++) {
+			if (fread(bgr, 1, 3, f) != 3) {
+				fclose(f);
+				sprintf(failmsg, "%s is too short", fname);
+				return 1;
+			}
+			if (bgr[0] != BLUE_OF(*p) || bgr[1] != GREEN_OF(*p) || bgr[2] != RED_OF(*p)) {
+				// The lines are read bottom up so the last line with a difference is the first on the display
+				if (!bad++ || bady != y) {
+					badx = x;
+					bady = y;
+					badcolor = *p;
+					memcpy(badbgr, bgr, 3);
+				}
+			}
+		}
+		fseek(f, BMP_PADDING, SEEK_CUR);
+	}
+	fclose(f);
+	if (!bad)
+		return 0;
+	sprintf(failmsg, "%lu pixels differ, the first at (%d,%d): expected #%02x%02x%02x got #%02x%02x%02x", bad, badx, bady,
+		badbgr[2], badbgr[1], badbgr[0], RED_OF(badcolor), GREEN_OF(badcolor), BLUE_OF(badcolor));
+	return 1;
+}
+
+/* A hash of the framebuffer (FNV-1a) so that results can be compared by eye */
+static uint32_t hashFramebuffer(void) {
+	const color_t	*p, *e;
+	uint32_t		h;
+
+	h = 2166136261UL;
+	for(p = fb, e = fb + fbwidth*fbheight; p < e; p++) {
+		h = (h ^ RED_OF(*p)) * 16777619UL;
+		h = (h ^ GREEN_OF(*p)) * 16777619UL;
+		h = (h ^ BLUE_OF(*p)) * 16777619UL;
+	}
+	return h;
+}
+
+int main(void) {
+	static const struct orient {
+		gdisp_orientation_t	o;
+		unsigned			degrees;
+	} orients[] = {
+		{ GDISP_ROTATE_0, 0 }, { GDISP_ROTATE_90, 90 }, { GDISP_ROTATE_180, 180 }, { GDISP_ROTATE_270, 270 },
+	};
+	char					fname[80];
+	const struct scene		*s;
+	systemticks_t			start, elapsed;
+	unsigned				i, j, failed;
+	int						res;
+	#if GDISP_NEED_STATS
+		GDispStats			stats;
+	#endif
+
+	gfxInit();
+	fb = (const color_t *)gdispQuery(GDISP_QUERY_FRAMEBUFFER);
+	fbwidth = (coord_t)(size_t)gdispQuery(GDISP_QUERY_FRAMEBUFFER_WIDTH);
+	fbheight = (coord_t)(size_t)gdispQuery(GDISP_QUERY_FRAMEBUFFER_HEIGHT);
+	if (fb == (const color_t *)-1) {
+		printf("The display is not a framebuffer\n");
+		return 1;
+	}
+	font1 = gdispOpenFont("UI2");
+	font2 = gdispOpenFont("Small");
+
+	failed = 0;
+	for(s = scenes; s < scenes+NUM_SCENES; s++) {
+		for(i = 0; i < 4; i++) {
+			gdispSetOrientation(orients[i].o);
+
+			// Time it
+			#if GDISP_NEED_STATS
+				gdispResetStats();
+			#endif
+			start = gfxSystemTicks();
+			for(j = 0; j < REPEATS; j++) {
+				gdispClear(Black);
+				s->draw(gdispGetWidth(), gdispGetHeight());
+			}
+			elapsed = gfxSystemTicks() - start;
+
+			// Check it
+			sprintf(fname, GOLDEN_DIR "%s_" FORMAT_NAME "_%u.bmp", s->name, orients[i].degrees);
+			printf("%-8s %3u  %08lx  %6lu us", s->name, orients[i].degrees, (unsigned long)hashFramebuffer(),
+					(unsigned long)((uint64_t)elapsed * 1000000 / gfxMillisecondsToTicks(1000) / REPEATS));
+			#if GDISP_NEED_STATS
+				gdispGetStats(&stats);
+				printf("  %8lu pixels  %6lu us in the driver", (unsigned long)(stats.pixels / REPEATS),
+						(unsigned long)(gmiscPerfToMicroseconds(stats.lldtime) / REPEATS));
+			#endif
+			#if RECORD_GOLDEN
+				printf("  %s\n", writeBMP(fname) ? "recorded" : "can't record");
+				continue;
+			#endif
+			res = compareBMP(fname);
+			if (res < 0)
+				sprintf(failmsg, "%s is missing", fname);
+			if (res) {
+				printf("  FAILED\n    %s\n", failmsg);
+				sprintf(fname, GOLDEN_DIR "%s_" FORMAT_NAME "_%u_fail.bmp", s->name, orients[i].degrees);
+				writeBMP(fname);
+				failed++;
+			} else {
+				printf("  ok\n");
+			}
+		}
+	}
+
+	printf("%u of %u failed\n", failed, (unsigned)(NUM_SCENES*4));
+	return failed;
+}
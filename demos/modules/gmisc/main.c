@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2012, 2013, Joel Bodenmann aka Tectu <joel@unormal.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of the <organization> nor the
+ *      names of its contributors may be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * A micro-benchmark for the GMISC array operations.
+ *
+ * Every format conversion and every arithmetic operation is timed on a
+ * word aligned buffer and the result is shown in thousands of samples
+ * per second. Run it before and after changing src/gmisc/arrayops.c.
+ */
+
+#include "gfx.h"
+#include "chprintf.h"
+
+#define BENCH_SAMPLES		1024
+#define BENCH_TIME			200			// Milliseconds to run each test for
+
+static uint16_t		src1[BENCH_SAMPLES], src2[BENCH_SAMPLES], dst[BENCH_SAMPLES];
+
+static const struct fmtname {
+	ArrayDataFormat	fmt;
+	const char *	name;
+} fmts[] = {
+	{ ARRAY_DATA_4BITUNSIGNED,	"4U" },		{ ARRAY_DATA_4BITSIGNED,	"4S" },
+	{ ARRAY_DATA_8BITUNSIGNED,	"8U" },		{ ARRAY_DATA_8BITSIGNED,	"8S" },
+	{ ARRAY_DATA_10BITUNSIGNED,	"10U" },	{ ARRAY_DATA_10BITSIGNED,	"10S" },
+	{ ARRAY_DATA_12BITUNSIGNED,	"12U" },	{ ARRAY_DATA_12BITSIGNED,	"12S" },
+	{ ARRAY_DATA_14BITUNSIGNED,	"14U" },	{ ARRAY_DATA_14BITSIGNED,	"14S" },
+	{ ARRAY_DATA_16BITUNSIGNED,	"16U" },	{ ARRAY_DATA_16BITSIGNED,	"16S" },
+};
+#define NUM_FMTS	(sizeof(fmts)/sizeof(fmts[0]))
+
+static const char *opnames[] = { "Translate", "Multiply", "Divide", "MultDiv", "Add", "AddNoOverflow" };
+#define NUM_OPS		(sizeof(opnames)/sizeof(opnames[0]))
+
+static BaseSequentialStream	*con;
+
+/* Repeat an operation for BENCH_TIME and return thousands of samples per second */
+static unsigned bench(ArrayDataFormat srcfmt, ArrayDataFormat dstfmt, int op) {
+	systemticks_t	start, elapsed;
+	unsigned		loops;
+
+	loops = 0;
+	start = gfxSystemTicks();
+	do {
+		switch(op) {
+		case -1:	gmiscArrayConvert(srcfmt, src1, dstfmt, dst, BENCH_SAMPLES);		break;
+		case 0:		gmiscArrayTranslate(srcfmt, src1, dst, BENCH_SAMPLES, 5);			break;
+		case 1:		gmiscArrayMultiply(srcfmt, src1, dst, BENCH_SAMPLES, 3);			break;
+		case 2:		gmiscArrayDivide(srcfmt, src1, dst, BENCH_SAMPLES, 3);				break;
+		case 3:		gmiscArrayMultDiv(srcfmt, src1, dst, BENCH_SAMPLES, 3, 5);			break;
+		case 4:		gmiscArrayAdd(srcfmt, src1, src2, dst, BENCH_SAMPLES);				break;
+		case 5:		gmiscArrayAddNoOverflow(srcfmt, src1, src2, dst, BENCH_SAMPLES);	break;
+		}
+		loops++;
+		elapsed = gfxSystemTicks() - start;
+	} while(elapsed < gfxMillisecondsToTicks(BENCH_TIME));
+
+	// Ticks are converted to milliseconds assuming gfxMillisecondsToTicks() is linear
+	return (unsigned)((uint64_t)loops * BENCH_SAMPLES * gfxMillisecondsToTicks(1) / elapsed);
+}
+
+int main(void) {
+	GHandle		gh;
+	unsigned	i, j;
+
+	gfxInit();
+	gh = gwinCreateConsole(NULL, 0, 0, gdispGetWidth(), gdispGetHeight(), gdispOpenFont("Small"));
+	gwinSetColor(gh, White);
+	gwinSetBgColor(gh, Black);
+	gwinClear(gh);
+	con = gwinGetConsoleStream(gh);
+
+	for(i = 0; i < BENCH_SAMPLES; i++) {
+		src1[i] = (uint16_t)(i * 7919);
+		src2[i] = (uint16_t)(i * 104729);
+	}
+
+	chprintf(con, "gmiscArrayConvert (kSamples/s)\n");
+	for(i = 0; i < NUM_FMTS; i++) {
+		for(j = 0; j < NUM_FMTS; j++)
+			chprintf(con, "%s->%s %u\n", fmts[i].name, fmts[j].name, bench(fmts[i].fmt, fmts[j].fmt, -1));
+	}
+
+	for(j = 0; j < NUM_OPS; j++) {
+		chprintf(con, "gmiscArray%s (kSamples/s)\n", opnames[j]);
+		for(i = 0; i < NUM_FMTS; i++)
+			chprintf(con, "%s %u\n", fmts[i].name, bench(fmts[i].fmt, fmts[i].fmt, j));
+	}
+
+	while(TRUE) {
+		gfxSleepMilliseconds(500);
+	}
+}
@@ -0,0 +1,377 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/gadc/Replay/gadc_lld.c
+ * @brief   GADC - Driver file for replaying recorded samples on a host.
+ *
+ * @details	This stands in for a real ADC so that the GADC (and GAUDIN) high speed path
+ * 			can be run under an emulator. Conversions are read from GADC_REPLAY_FILENAME
+ * 			at the rate asked for (times GADC_REPLAY_SPEED) by a thread that plays the
+ * 			part of the ADC interrupt. As on real hardware, a timer tick that finds no
+ * 			conversion waiting is lost and sets GADC_Timer_Missed. The lost ticks are also
+ * 			counted (see gadcReplayGetCounts()).
+ *
+ * 			With GADC_REPLAY_STEPPED the timer doesn't follow the clock. It only ticks when
+ * 			gadcReplayStep() is called so a run gives the same results every time.
+ *
+ * @defgroup Driver Driver
+ * @ingroup GADC
+ * @{
+ */
+
+#include "gfx.h"
+
+#if GFX_USE_GADC
+
+#include "gadc/lld/gadc_lld.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if GADC_REPLAY_BITS != 8 && GADC_REPLAY_BITS != 10 && GADC_REPLAY_BITS != 12 && GADC_REPLAY_BITS != 14 && GADC_REPLAY_BITS != 16
+	#error "GADC Replay: GADC_REPLAY_BITS must be 8, 10, 12, 14 or 16"
+#endif
+#if GADC_REPLAY_SPEED < 1
+	#error "GADC Replay: GADC_REPLAY_SPEED must be at least 1"
+#endif
+
+#define REPLAY_COLUMNS		8			// The most columns in a file
+#define REPLAY_BATCH		32			// The most conversions we read before handing them over
+#define REPLAY_MAXVALUE		((1L << GADC_REPLAY_BITS) - 1)
+
+static FILE				*replayFile;
+static long				wavStart;		// The start of the WAV data (0 for a CSV file)
+static uint32_t			wavLength;		// The length of the WAV data in bytes
+static uint32_t			wavPos;			// How far through the WAV data we are
+static unsigned			wavChannels;
+static unsigned			wavBytes;		// Bytes per WAV sample (1 or 2)
+static adcsample_t		lastrow[REPLAY_COLUMNS];
+static adcsample_t		replayRows[REPLAY_BATCH][REPLAY_COLUMNS];	// The rows read for the next ticks
+static gfxMutex			replayMutex;	// Protects the file and replayRows
+
+static gfxSem			replaySem;
+static gfxThreadHandle	replayThread;
+static DECLARE_THREAD_STACK(waReplayThread, 1024);
+
+static volatile bool_t	timerRunning;
+static volatile uint16_t timerSession;	// Changes each time the timer is started
+static uint32_t			timerFreq;
+static GadcLldTimerData	timerConv;		// The high speed conversion waiting for timer ticks
+static size_t			timerDone;		// How many conversions of it have been done
+static size_t			timerSPC;		// The samples in each of its conversions
+static bool_t			timerArmed;
+static GadcLldNonTimerData nontimerConv;// The low speed conversion waiting to be done
+static bool_t			nontimerArmed;
+static volatile uint32_t ticksDone;		// The timer ticks since gfxInit()
+static volatile uint32_t ticksMissed;	// The ticks that found no conversion waiting
+
+static uint32_t getLE(const uint8_t *p, unsigned bytes) {
+	uint32_t	v;
+
+	for(v = 0, p += bytes; bytes--; )
+		v = (v << 8) | *--p;
+	return v;
+}
+
+// Find the format and the data in a WAV file. Returns FALSE if this is not a WAV file we understand.
+static bool_t openwav(void) {
+	uint8_t		hdr[16];
+	uint32_t	len;
+	unsigned	fmt, bits;
+
+	if (fread(hdr, 1, 12, replayFile) != 12 || memcmp(hdr, "RIFF", 4) || memcmp(hdr+8, "WAVE", 4))
+		return FALSE;
+
+	fmt = bits = 0;
+	while(fread(hdr, 1, 8, replayFile) == 8) {
+		len = getLE(hdr+4, 4);
+		if (!memcmp(hdr, "fmt ", 4) && len >= 16) {
+			if (fread(hdr, 1, 16, replayFile) != 16)
+				return FALSE;
+			fmt = getLE(hdr, 2);
+			wavChannels = getLE(hdr+2, 2);
+			bits = getLE(hdr+14, 2);
+			len -= 16;
+		} else if (!memcmp(hdr, "data", 4)) {
+			if (fmt != 1 || (bits != 8 && bits != 16) || !wavChannels)
+				return FALSE;
+			wavBytes = bits / 8;
+			wavStart = ftell(replayFile);
+			wavLength = len;
+			return TRUE;
+		}
+		fseek(replayFile, (len + 1) & ~1UL, SEEK_CUR);
+	}
+	return FALSE;
+}
+
+static void openfile(void) {
+	if (!(replayFile = fopen(GADC_REPLAY_FILENAME, "rb")))
+		return;
+	if (!openwav()) {
+		// Treat it as a CSV file
+		wavStart = 0;
+		rewind(replayFile);
+	}
+}
+
+// Read the next WAV frame. Returns FALSE at the end of the data.
+static bool_t readwav(adcsample_t *row) {
+	uint8_t		frame[2];
+	unsigned	i;
+
+	if (wavPos + wavChannels * wavBytes > wavLength)
+		return FALSE;
+	for(i = 0; i < wavChannels; i++) {
+		if (fread(frame, 1, wavBytes, replayFile) != wavBytes)
+			return FALSE;
+		if (i >= REPLAY_COLUMNS)
+			continue;
+		// 8 bit WAV is unsigned, 16 bit WAV is signed
+		if (wavBytes == 1)
+			row[i] = (adcsample_t)(frame[0] << (GADC_REPLAY_BITS - 8));
+		else
+			row[i] = (adcsample_t)((getLE(frame, 2) ^ 0x8000) >> (16 - GADC_REPLAY_BITS));
+	}
+	wavPos += wavChannels * wavBytes;
+	return TRUE;
+}
+
+// Read the next CSV line that has a number on it. Returns FALSE at the end of the file.
+static bool_t readcsv(adcsample_t *row) {
+	char		line[128];
+	char		*p, *e;
+	long		v;
+	unsigned	i;
+
+	while(fgets(line, sizeof(line), replayFile)) {
+		for(p = line; *p == ' ' || *p == '\t'; p++);
+		if (!(*p >= '0' && *p <= '9') && !(*p == '-' && p[1] >= '0' && p[1] <= '9'))
+			continue;				// A blank line, comment or heading
+		for(i = 0; i < REPLAY_COLUMNS; i++) {
+			v = strtol(p, &e, 10);
+			if (e == p)
+				break;
+			row[i] = (adcsample_t)(v < 0 ? 0 : (v > REPLAY_MAXVALUE ? REPLAY_MAXVALUE : v));
+			for(p = e; *p && *p != '-' && (*p < '0' || *p > '9'); p++);
+		}
+		return TRUE;
+	}
+	return FALSE;
+}
+
+// Read the next conversion for all the columns
+static void readrow(adcsample_t *row) {
+	unsigned	pass;
+
+	memset(row, 0, REPLAY_COLUMNS * sizeof(adcsample_t));
+	if (!replayFile)
+		return;
+	for(pass = 0; pass < 2; pass++) {
+		if (wavStart ? readwav(row) : readcsv(row))
+			return;
+		#if GADC_REPLAY_LOOP
+			fseek(replayFile, wavStart, SEEK_SET);
+			wavPos = 0;
+		#else
+			return;
+		#endif
+	}
+}
+
+// Copy the columns selected by physdev into an ADC buffer
+static void putrow(adcsample_t *buf, uint32_t physdev, const adcsample_t *row) {
+	unsigned	i;
+
+	for(i = 0; i < REPLAY_COLUMNS; i++) {
+		if ((physdev & (1UL << i)))
+			*buf++ = row[i];
+	}
+}
+
+// Do the low speed conversion if there is one. Must be called with the system locked.
+static void doNonTimerI(void) {
+	if (!nontimerArmed)
+		return;
+	nontimerArmed = FALSE;
+	putrow(nontimerConv.buffer, nontimerConv.physdev, lastrow);
+	GADC_ISR_CompleteI(0, nontimerConv.buffer, 1);
+}
+
+// Do n timer ticks with the conversions read into replayRows. Must be called with the system locked.
+static void doTicksI(unsigned n, uint16_t session) {
+	unsigned	i;
+
+	for(i = 0; i < n; i++) {
+		memcpy(lastrow, replayRows[i], sizeof(lastrow));
+		doNonTimerI();
+		if (session != timerSession)
+			continue;					// These ticks belong to a timer that has been stopped since
+		ticksDone++;
+		if (!timerArmed) {
+			GADC_Timer_Missed = TRUE;
+			ticksMissed++;
+			continue;
+		}
+		putrow(timerConv.buffer + timerDone * timerSPC, timerConv.physdev, replayRows[i]);
+		if (++timerDone >= timerConv.count) {
+			timerArmed = FALSE;
+			GADC_ISR_CompleteI(0, timerConv.buffer, timerConv.count);
+		}
+	}
+}
+
+static DECLARE_THREAD_FUNCTION(ReplayThread, param) {
+	#if !GADC_REPLAY_STEPPED
+		systemticks_t	start;
+		uint64_t		due, done;
+		unsigned		i, n;
+		uint16_t		session;
+	#endif
+	bool_t			fresh;
+	(void) param;
+
+	#if !GADC_REPLAY_STEPPED
+		session = timerSession - 1;
+		start = 0;
+		done = 0;
+	#endif
+	while(1) {
+		// Low speed conversions are done as soon as they are asked for.
+		// With no timer running nothing else moves the replay on so read a row for them now.
+		gfxMutexEnter(&replayMutex);
+		fresh = !timerRunning && nontimerArmed;
+		if (fresh)
+			readrow(replayRows[0]);
+		gfxSystemLock();
+		if (fresh && !timerRunning)
+			memcpy(lastrow, replayRows[0], sizeof(lastrow));
+		doNonTimerI();
+		gfxSystemUnlock();
+		gfxMutexExit(&replayMutex);
+
+		#if GADC_REPLAY_STEPPED
+			// The timer ticks are done by gadcReplayStep()
+			gfxSemWait(&replaySem, TIME_INFINITE);
+		#else
+			if (!timerRunning) {
+				gfxSemWait(&replaySem, TIME_INFINITE);
+				continue;
+			}
+
+			// Count the timer ticks from when the timer was started
+			if (session != timerSession) {
+				session = timerSession;
+				start = gfxSystemTicks();
+				done = 0;
+			}
+			due = (uint64_t)(systemticks_t)(gfxSystemTicks() - start) * timerFreq * GADC_REPLAY_SPEED / gfxMillisecondsToTicks(1000);
+
+			while(done < due && timerRunning) {
+				n = due - done > REPLAY_BATCH ? REPLAY_BATCH : (unsigned)(due - done);
+				gfxMutexEnter(&replayMutex);
+				for(i = 0; i < n; i++)
+					readrow(replayRows[i]);
+				done += n;
+
+				// Hand them over just like the ADC interrupt would
+				gfxSystemLock();
+				doTicksI(n, session);
+				gfxSystemUnlock();
+				gfxMutexExit(&replayMutex);
+			}
+
+			gfxSleepMilliseconds(1);
+		#endif
+	}
+	return 0;
+}
+
+void gadc_lld_init(void) {
+	if (replayThread)
+		return;
+	openfile();
+	gfxSemInit(&replaySem, 0, 1);
+	gfxMutexInit(&replayMutex);
+	replayThread = gfxThreadCreate(waReplayThread, sizeof(waReplayThread), HIGH_PRIORITY, ReplayThread, 0);
+}
+
+size_t gadc_lld_samples_per_conversion(uint32_t physdev) {
+	size_t	cnt;
+
+	/* physdev is a bitmap of the columns in the file */
+	for(cnt = 0; physdev; physdev >>= 1)
+		if (physdev & 0x01)
+			cnt++;
+	return cnt;
+}
+
+void gadc_lld_start_timer(uint32_t physdev, uint32_t frequency) {
+	(void) physdev;
+
+	gfxSystemLock();
+	timerFreq = frequency;
+	timerSession++;
+	timerRunning = TRUE;
+	gfxSemSignalI(&replaySem);
+	gfxSystemUnlock();
+}
+
+void gadc_lld_stop_timer(uint32_t physdev) {
+	(void) physdev;
+
+	gfxSystemLock();
+	timerRunning = FALSE;
+	timerArmed = FALSE;
+	gfxSystemUnlock();
+}
+
+void gadc_lld_adc_timerI(GadcLldTimerData *pgtd) {
+	/**
+	 * The conversions happen on the next timer ticks. We can't do the first one "now" as our
+	 * timer ticks are counted from when the timer was started.
+	 */
+	timerConv = *pgtd;
+	timerSPC = gadc_lld_samples_per_conversion(pgtd->physdev);
+	timerDone = 0;
+	timerArmed = TRUE;
+}
+
+void gadc_lld_adc_nontimerI(GadcLldNonTimerData *pgntd) {
+	nontimerConv = *pgntd;
+	nontimerArmed = TRUE;
+	gfxSemSignalI(&replaySem);
+}
+
+void gadcReplayGetCounts(uint32_t *pticks, uint32_t *pmissed) {
+	gfxSystemLock();
+	*pticks = ticksDone;
+	*pmissed = ticksMissed;
+	gfxSystemUnlock();
+}
+
+#if GADC_REPLAY_STEPPED
+	void gadcReplayStep(unsigned ticks) {
+		unsigned	i, n;
+
+		gfxMutexEnter(&replayMutex);
+		for(; ticks && timerRunning; ticks -= n) {
+			n = ticks > REPLAY_BATCH ? REPLAY_BATCH : ticks;
+			for(i = 0; i < n; i++)
+				readrow(replayRows[i]);
+			gfxSystemLock();
+			doTicksI(n, timerSession);
+			gfxSystemUnlock();
+		}
+		gfxMutexExit(&replayMutex);
+	}
+#endif
+
+#endif /* GFX_USE_GADC */
+/** @} */
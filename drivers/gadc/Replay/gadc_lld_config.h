@@ -0,0 +1,118 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/gadc/Replay/gadc_lld_config.h
+ * @brief   GADC Driver config file.
+ *
+ * @addtogroup GADC
+ * @{
+ */
+
+#ifndef GADC_LLD_CONFIG_H
+#define GADC_LLD_CONFIG_H
+
+#if GFX_USE_GADC
+
+/*===========================================================================*/
+/* Driver hardware support.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief	This is the replay driver. Other drivers can use this to pick up their settings.
+ */
+#define GADC_LLD_REPLAY						TRUE
+
+/**
+ * @brief	The file to replay.
+ * @details	Defaults to "gadc.wav" in the current directory
+ * @note	A file with a RIFF header is read as an 8 or 16 bit PCM WAV file. Anything else is
+ * 			read as a CSV file with one conversion per line and one column per channel.
+ */
+#ifndef GADC_REPLAY_FILENAME
+	#define GADC_REPLAY_FILENAME			"gadc.wav"
+#endif
+
+/**
+ * @brief	How much faster than real time to replay the samples.
+ * @details	Defaults to 1 (real time)
+ */
+#ifndef GADC_REPLAY_SPEED
+	#define GADC_REPLAY_SPEED				1
+#endif
+
+/**
+ * @brief	Tick the timer only when gadcReplayStep() is called.
+ * @details	Defaults to FALSE (the timer follows the clock)
+ * @note	A stepped replay doesn't depend on how the host schedules its threads
+ * 			so the counts it gives are the same on every run. GADC_REPLAY_SPEED is ignored.
+ */
+#ifndef GADC_REPLAY_STEPPED
+	#define GADC_REPLAY_STEPPED				FALSE
+#endif
+
+/**
+ * @brief	Start again at the beginning of the file when we get to the end.
+ * @details	Defaults to TRUE. If FALSE every conversion after the end of the file returns 0.
+ */
+#ifndef GADC_REPLAY_LOOP
+	#define GADC_REPLAY_LOOP				TRUE
+#endif
+
+/**
+ * @brief	The number of bits in each ADC sample (8, 10, 12, 14 or 16)
+ * @details	Defaults to 12. WAV samples are scaled to this. CSV values are used as they are.
+ */
+#ifndef GADC_REPLAY_BITS
+	#define GADC_REPLAY_BITS				12
+#endif
+
+#define ADC_ISR_FULL_CODE_BUG				FALSE
+
+#define GADC_MAX_SAMPLE_FREQUENCY			1000000
+
+#define GADC_BITS_PER_SAMPLE				GADC_REPLAY_BITS
+
+#define GADC_SAMPLE_FORMAT					((ArrayDataFormat)GADC_REPLAY_BITS)
+
+/**
+ * @brief	The physdev bitmap selects the columns (WAV channels) of the file.
+ * @details	There are up to 8 columns.
+ * @{
+ */
+#define GADC_PHYSDEV_COLUMN(n)				(1UL << (n))
+#define GADC_PHYSDEV_MICROPHONE				GADC_PHYSDEV_COLUMN(0)
+#define GADC_PHYSDEV_DIAL					GADC_PHYSDEV_COLUMN(1)
+#define GADC_PHYSDEV_TEMPERATURE			GADC_PHYSDEV_COLUMN(2)
+/** @} */
+
+/**
+ * @brief	Get the number of timer ticks since gfxInit() and how many of them were lost
+ * 			because no conversion was waiting.
+ */
+void gadcReplayGetCounts(uint32_t *pticks, uint32_t *pmissed);
+
+#if GADC_REPLAY_STEPPED
+	/**
+	 * @brief	Do the next ticks of the high speed timer.
+	 * @details	The conversions are handed over in the calling thread before this returns.
+	 * 			Nothing happens if the timer isn't running.
+	 */
+	void gadcReplayStep(unsigned ticks);
+#endif
+
+/* There is no ChibiOS ADC driver on a host - supply the types GADC needs */
+#if !GFX_USE_OS_CHIBIOS
+	typedef uint16_t	adcsample_t;
+	typedef void		ADCDriver;
+	typedef int			adcerror_t;
+#endif
+
+#endif	/* GFX_USE_GADC */
+
+#endif	/* GADC_LLD_CONFIG_H */
+/** @} */
@@ -0,0 +1,49 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/gaudin/gadc/gaudin_lld_board_replay.h
+ * @brief   GAUDIN Driver board config file for the GADC Replay driver.
+ *
+ * @addtogroup GAUDIN
+ * @{
+ */
+
+#ifndef _GAUDIN_LLD_BOARD_REPLAY_H
+#define _GAUDIN_LLD_BOARD_REPLAY_H
+
+/*===========================================================================*/
+/* Audio inputs for the replay driver                                        */
+/*===========================================================================*/
+
+/**
+ * @brief	The number of audio channels supported by this driver
+ */
+#define GAUDIN_NUM_CHANNELS					2
+
+/**
+ * @brief	The list of audio channels and their uses
+ * @{
+ */
+#define	GAUDIN_MICROPHONE					0			/* The first column (the left channel of a WAV) */
+#define	GAUDIN_STEREO						1			/* The first two columns interleaved */
+/** @} */
+
+/**
+ * @brief	The following defines are for the low level driver use only
+ * @{
+ */
+#ifdef GAUDIN_LLD_IMPLEMENTATION
+	static uint32_t gaudin_lld_physdevs[GAUDIN_NUM_CHANNELS] = {
+			GADC_PHYSDEV_COLUMN(0),
+			GADC_PHYSDEV_COLUMN(0)|GADC_PHYSDEV_COLUMN(1),
+			};
+#endif
+/** @} */
+
+#endif	/* _GAUDIN_LLD_BOARD_REPLAY_H */
+/** @} */
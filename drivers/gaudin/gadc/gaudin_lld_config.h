@@ -53,6 +53,8 @@ typedef adcsample_t		audin_sample_t;
 #if defined(GADC_USE_CUSTOM_BOARD) && GADC_USE_CUSTOM_BOARD
 	/* Include the user supplied board definitions */
 	#include "gaudin_lld_board.h"
+#elif defined(GADC_LLD_REPLAY) && GADC_LLD_REPLAY
+	#include "gaudin_lld_board_replay.h"
 #elif defined(BOARD_OLIMEX_SAM7_EX256)
 	#include "gaudin_lld_board_olimexsam7ex256.h"
 #else
@@ -0,0 +1,174 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/gaudout/WAV/gaudout_lld.c
+ * @brief   GAUDOUT - Driver file for writing audio to a WAV file on a host.
+ *
+ * @details	This stands in for a real DAC so that audio output can be developed and
+ * 			tested under an emulator. Blocks are taken from GAUDOUT at the rate a
+ * 			real device would play them and written to GAUDOUT_WAV_FILENAME.
+ * 			An underrun is written as a block of silence, which is what you would hear.
+ *
+ * @defgroup Driver Driver
+ * @ingroup GAUDOUT
+ * @{
+ */
+
+#include "gfx.h"
+
+#if GFX_USE_GAUDOUT
+
+/* Include the driver defines */
+#include "gaudout/lld/gaudout_lld.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const gaudout_params	*pwav;
+static FILE					*wavFile;
+static uint32_t				wavBytes;
+static volatile uint16_t	wavSession;		// Changes each time we start or stop
+static volatile bool_t		wavRunning;
+static gfxSem				wavStartSem;
+static gfxMutex				wavMutex;		// Protects the file
+static gfxThreadHandle		wavThread;
+static DECLARE_THREAD_STACK(waWavThread, 1024);
+
+static void putLE(uint8_t *p, uint32_t v, unsigned bytes) {
+	while(bytes--) {
+		*p++ = (uint8_t)v;
+		v >>= 8;
+	}
+}
+
+// Write (or re-write) the RIFF header to match what we have written so far.
+static void writeheader(void) {
+	uint8_t		hdr[44];
+	unsigned	nch;
+
+	nch = GAUDOUT_SAMPLES_PER_CONVERSION(pwav->channel);
+	memcpy(hdr, "RIFF\0\0\0\0WAVEfmt ", 16);
+	putLE(hdr+4, 36 + wavBytes, 4);
+	putLE(hdr+16, 16, 4);										// fmt chunk length
+	putLE(hdr+20, 1, 2);										// PCM
+	putLE(hdr+22, nch, 2);
+	putLE(hdr+24, pwav->frequency, 4);
+	putLE(hdr+28, pwav->frequency * nch * sizeof(audout_sample_t), 4);
+	putLE(hdr+32, nch * sizeof(audout_sample_t), 2);
+	putLE(hdr+34, GAUDOUT_BITS_PER_SAMPLE, 2);
+	memcpy(hdr+36, "data", 4);
+	putLE(hdr+40, wavBytes, 4);
+
+	fseek(wavFile, 0, SEEK_SET);
+	fwrite(hdr, 1, sizeof(hdr), wavFile);
+	fseek(wavFile, 0, SEEK_END);
+	fflush(wavFile);
+}
+
+static void closefile(void) {
+	gfxMutexEnter(&wavMutex);
+	if (wavFile) {
+		writeheader();
+		fclose(wavFile);
+		wavFile = 0;
+	}
+	gfxMutexExit(&wavMutex);
+}
+
+static DECLARE_THREAD_FUNCTION(WavThread, param) {
+	audout_sample_t	*buf;
+	size_t			n, sz;
+	uint32_t		frac;
+	uint16_t		session;
+	(void) param;
+
+	frac = 0;
+	while(1) {
+		// Wait until we are started
+		if (!wavRunning) {
+			gfxSemWait(&wavStartSem, TIME_INFINITE);
+			continue;
+		}
+
+		gfxSystemLock();
+		session = wavSession;
+		n = GAUDOUT_ISR_NextI(&buf);
+		gfxSystemUnlock();
+
+		// Write the block - or a block of silence if we have nothing to play
+		sz = sizeof(audout_sample_t) * GAUDOUT_SAMPLES_PER_CONVERSION(pwav->channel);
+		gfxMutexEnter(&wavMutex);
+		if (session == wavSession && wavFile) {
+			if (n)
+				fwrite(buf, sz, n, wavFile);
+			else {
+				for(n = pwav->samplesPerEvent * sz; n; n--)
+					fputc(0, wavFile);
+				buf = 0;
+				n = pwav->samplesPerEvent;
+			}
+			wavBytes += n * sz;
+		}
+		gfxMutexExit(&wavMutex);
+
+		// Take as long as a real device would to play it
+		frac += n * 1000;
+		gfxSleepMilliseconds(frac / pwav->frequency);
+		frac %= pwav->frequency;
+
+		// Release the block unless we have been stopped in the meantime
+		gfxSystemLock();
+		if (buf && session == wavSession)
+			GAUDOUT_ISR_CompleteI(buf, n);
+		gfxSystemUnlock();
+	}
+	return 0;
+}
+
+void gaudout_lld_init(const gaudout_params *paud) {
+	if (!wavThread) {
+		gfxSemInit(&wavStartSem, 0, 1);
+		gfxMutexInit(&wavMutex);
+		wavThread = gfxThreadCreate(waWavThread, sizeof(waWavThread), HIGH_PRIORITY, WavThread, 0);
+		atexit(closefile);
+	}
+
+	// Start a new file for the new settings
+	closefile();
+	pwav = paud;
+	gfxMutexEnter(&wavMutex);
+	wavBytes = 0;
+	if ((wavFile = fopen(GAUDOUT_WAV_FILENAME, "w+b")))
+		writeheader();
+	gfxMutexExit(&wavMutex);
+}
+
+void gaudout_lld_start(void) {
+	gfxSystemLock();
+	wavSession++;
+	wavRunning = TRUE;
+	gfxSemSignalI(&wavStartSem);
+	gfxSystemUnlock();
+}
+
+void gaudout_lld_stop(void) {
+	gfxSystemLock();
+	wavSession++;
+	wavRunning = FALSE;
+	gfxSystemUnlock();
+
+	// Leave a valid file behind in case that was the last of it
+	gfxMutexEnter(&wavMutex);
+	if (wavFile)
+		writeheader();
+	gfxMutexExit(&wavMutex);
+}
+
+#endif /* GFX_USE_GAUDOUT */
+/** @} */
@@ -0,0 +1,5 @@
+# List the required driver.
+GFXSRC += $(GFXLIB)/drivers/gaudout/WAV/gaudout_lld.c
+
+# Required include directories
+GFXINC += $(GFXLIB)/drivers/gaudout/WAV
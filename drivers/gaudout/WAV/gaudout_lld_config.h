@@ -0,0 +1,67 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/gaudout/WAV/gaudout_lld_config.h
+ * @brief   GAUDOUT Driver config file.
+ *
+ * @addtogroup GAUDOUT
+ * @{
+ */
+
+#ifndef GAUDOUT_LLD_CONFIG_H
+#define GAUDOUT_LLD_CONFIG_H
+
+#if GFX_USE_GAUDOUT
+
+/*===========================================================================*/
+/* Driver hardware support.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief	The audio output sample type
+ */
+typedef int16_t		audout_sample_t;
+
+/**
+ * @brief	The maximum sample frequency supported by this audio device
+ */
+#define GAUDOUT_MAX_SAMPLE_FREQUENCY		96000
+
+/**
+ * @brief	The number of bits in a sample
+ */
+#define GAUDOUT_BITS_PER_SAMPLE				16
+
+/**
+ * @brief	The format of an audio sample
+ */
+#define GAUDOUT_SAMPLE_FORMAT				ARRAY_DATA_16BITSIGNED
+
+/**
+ * @brief	The number of audio channels
+ * @details	Channel 0 is mono and channel 1 is stereo
+ */
+#define GAUDOUT_NUM_CHANNELS				2
+
+/**
+ * @brief	The number of samples in each conversion for a channel
+ */
+#define GAUDOUT_SAMPLES_PER_CONVERSION(ch)	((ch) + 1)
+
+/**
+ * @brief	The file the audio is written to.
+ * @details	Defaults to "gaudout.wav" in the current directory
+ */
+#ifndef GAUDOUT_WAV_FILENAME
+	#define GAUDOUT_WAV_FILENAME			"gaudout.wav"
+#endif
+
+#endif	/* GFX_USE_GAUDOUT */
+
+#endif	/* GAUDOUT_LLD_CONFIG_H */
+/** @} */
@@ -9,7 +9,26 @@
 
 #include "gfx.h"
 
-/* Control command for flushing all data to display. */
+/* Control command for flushing all data to display.
+ * The value selects the waveform, one of the EINK_FLUSH_xxx values below.
+ * Drawing is buffered until it is flushed (or the buffers run out), so
+ * draw a complete update and then flush it once, e.g.
+ *      gdispControl(GDISP_CONTROL_FLUSH, (void *)EINK_FLUSH_AUTO);
+ */
 #define GDISP_CONTROL_FLUSH (GDISP_CONTROL_LLD + 0)
 
+/* Choose the fast update for a few changed blocks, the normal update
+ * otherwise and a full update after EINK_FULLREFRESH fast updates. */
+#define EINK_FLUSH_AUTO 0
+
+/* EINK_FASTCOUNT passes. Quick but leaves some ghosting. */
+#define EINK_FLUSH_FAST 1
+
+/* EINK_WRITECOUNT passes. */
+#define EINK_FLUSH_NORMAL 2
+
+/* EINK_BLINKCOUNT passes to the opposite color followed by
+ * EINK_WRITECOUNT passes. Removes the ghosting from the changed area. */
+#define EINK_FLUSH_FULL 3
+
 #endif
@@ -71,6 +71,30 @@
 #       define EINK_WRITECOUNT 4
 #endif
 
+/* Number of passes to use for a fast update.
+ * Fewer passes are quicker and use less power but leave some ghosting. */
+#ifndef EINK_FASTCOUNT
+#       define EINK_FASTCOUNT 2
+#endif
+
+/* Largest number of changed blocks that an automatic flush writes
+ * with the fast update. */
+#ifndef EINK_FASTBLOCKS
+#       define EINK_FASTBLOCKS 6
+#endif
+
+/* Number of passes to the opposite color that start a full update.
+ * This removes the ghosting left behind by fast updates. */
+#ifndef EINK_BLINKCOUNT
+#       define EINK_BLINKCOUNT 2
+#endif
+
+/* Do a full update instead of an automatic flush after this many fast
+ * updates. 0 never does a full update automatically. */
+#ifndef EINK_FULLREFRESH
+#       define EINK_FULLREFRESH 10
+#endif
+
 /* ====================================
  *      Lower level driver functions
  * ==================================== */
@@ -328,6 +352,22 @@ static block_t g_blocks[EINK_NUMBUFFERS];
  */
 static uint8_t g_blockmap[BLOCKS_Y][BLOCKS_X]; 
 
+/* What we know of the current contents of each area of the display.
+ * Flushing a block that would not change it is skipped.
+ */
+#define STATE_UNKNOWN 0
+#define STATE_WHITE 1
+#define STATE_BLACK 2
+static uint8_t g_blockstate[BLOCKS_Y][BLOCKS_X];
+
+/* Number of fast updates since the last full update. */
+static uint8_t g_fastcount;
+
+/* The levels that the pixels of a block are driven to. */
+#define LEVEL_NONE (1 << 0)
+#define LEVEL_BLACK (1 << PIXEL_BLACK)
+#define LEVEL_WHITE (1 << PIXEL_WHITE)
+
 /** Check if the row contains any allocated blocks. */
 static bool_t blocks_on_row(unsigned by)
 {
@@ -342,10 +382,13 @@ static bool_t blocks_on_row(unsigned by)
     return FALSE;
 }
 
-/** Write out a block row. */
-static void write_block_row(unsigned by)
+/** Write out a block row.
+ * If invert is set the pixels are driven to the opposite colors. */
+static void write_block_row(unsigned by, bool_t invert)
 {
     unsigned bx, dy, dx;
+    uint8_t inverted[WIDTH_BYTES];
+    
     for (dy = 0; dy < EINK_BLOCKHEIGHT; dy++)
     {
         hscan_start();
@@ -362,7 +405,21 @@ static void write_block_row(unsigned by)
             else
             {
                 block_t *block = &g_blocks[g_blockmap[by][bx] - 1];
-                hscan_write(&block->data[dy][0], WIDTH_BYTES);
+                
+                if (invert)
+                {
+                    /* Swap the black and white bits of each pixel */
+                    for (dx = 0; dx < WIDTH_BYTES; dx++)
+                    {
+                        uint8_t byte = block->data[dy][dx];
+                        inverted[dx] = ((byte & 0x55) << 1) | ((byte & 0xAA) >> 1);
+                    }
+                    hscan_write(inverted, WIDTH_BYTES);
+                }
+                else
+                {
+                    hscan_write(&block->data[dy][0], WIDTH_BYTES);
+                }
             }
         }
         hscan_stop();
@@ -386,33 +443,167 @@ static void clear_block_map()
     g_next_block = 0;
 }
 
-/** Flush all the buffered rows to display. */
-static void flush_buffers()
+/** Find the levels that the pixels of a block are driven to. */
+static uint8_t block_levels(const block_t *block)
 {
-    unsigned by, dy, i;
+    unsigned dx, dy, i;
+    uint8_t byte, levels;
     
-    for (i = 0; i < EINK_WRITECOUNT; i++)
+    levels = 0;
+    for (dy = 0; dy < EINK_BLOCKHEIGHT; dy++)
     {
-        vscan_start();
-        
-        for (by = 0; by < BLOCKS_Y; by++)
+        for (dx = 0; dx < WIDTH_BYTES; dx++)
         {
-            if (!blocks_on_row(by))
+            byte = block->data[dy][dx];
+            if (byte == BYTE_WHITE)
+                levels |= LEVEL_WHITE;
+            else if (byte == BYTE_BLACK)
+                levels |= LEVEL_BLACK;
+            else if (byte == 0)
+                levels |= LEVEL_NONE;
+            else
             {
-                /* Skip the whole row of blocks. */
-                for (dy = 0; dy < EINK_BLOCKHEIGHT; dy++)
-                {
-                    vscan_skip();
-                }
+                for (i = 0; i < EINK_PPB; i++, byte >>= 2)
+                    levels |= 1 << (byte & PIXELMASK);
             }
+        }
+    }
+    
+    return levels;
+}
+
+/** Drop the blocks that would not change the display and update what
+ * we know of the display contents for the others.
+ * Returns the number of blocks left and the first and last block rows
+ * that contain any of them. */
+static unsigned prune_blocks(unsigned *first, unsigned *last)
+{
+    unsigned bx, by, count;
+    uint8_t levels, state;
+    
+    count = 0;
+    for (by = 0; by < BLOCKS_Y; by++)
+    {
+        for (bx = 0; bx < BLOCKS_X; bx++)
+        {
+            if (g_blockmap[by][bx] == 0)
+                continue;
+            
+            levels = block_levels(&g_blocks[g_blockmap[by][bx] - 1]);
+            state = g_blockstate[by][bx];
+            
+            if (!(levels & (LEVEL_WHITE | LEVEL_BLACK))
+                || (state == STATE_WHITE && !(levels & LEVEL_BLACK))
+                || (state == STATE_BLACK && !(levels & LEVEL_WHITE)))
+            {
+                /* Nothing would change */
+                g_blockmap[by][bx] = 0;
+                continue;
+            }
+            
+            if (levels == LEVEL_WHITE)
+                g_blockstate[by][bx] = STATE_WHITE;
+            else if (levels == LEVEL_BLACK)
+                g_blockstate[by][bx] = STATE_BLACK;
             else
+                g_blockstate[by][bx] = STATE_UNKNOWN;
+            
+            if (!count)
+                *first = by;
+            *last = by;
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+/** Do one pass over the rows from first to last (inclusive).
+ * Nothing is written outside of that window so those rows are
+ * clocked through as quickly as possible. */
+static void scan_window(unsigned first, unsigned last, bool_t invert)
+{
+    unsigned by, dy;
+    
+    vscan_start();
+    
+    for (dy = 0; dy < first * EINK_BLOCKHEIGHT; dy++)
+    {
+        vclock_quick();
+    }
+    
+    for (by = first; by <= last; by++)
+    {
+        if (!blocks_on_row(by))
+        {
+            /* Skip the whole row of blocks. */
+            for (dy = 0; dy < EINK_BLOCKHEIGHT; dy++)
             {
-                /* Write out the blocks. */
-                write_block_row(by);
+                vscan_skip();
             }
         }
-        
-        vscan_stop();
+        else
+        {
+            /* Write out the blocks. */
+            write_block_row(by, invert);
+        }
+    }
+    
+    for (dy = (last + 1) * EINK_BLOCKHEIGHT; dy < GDISP_SCREEN_HEIGHT; dy++)
+    {
+        vclock_quick();
+    }
+    
+    vscan_stop();
+}
+
+/** Flush all the buffered rows to display.
+ * The waveform is one of the EINK_FLUSH_xxx values. */
+static void flush_buffers(unsigned waveform)
+{
+    unsigned first, last, count, i;
+    
+    count = prune_blocks(&first, &last);
+    if (count == 0)
+    {
+        clear_block_map();
+        return;
+    }
+    
+    if (waveform == EINK_FLUSH_AUTO)
+    {
+        if (EINK_FULLREFRESH && g_fastcount >= EINK_FULLREFRESH)
+            waveform = EINK_FLUSH_FULL;
+        else if (count <= EINK_FASTBLOCKS)
+            waveform = EINK_FLUSH_FAST;
+        else
+            waveform = EINK_FLUSH_NORMAL;
+    }
+    
+    if (waveform == EINK_FLUSH_FULL)
+    {
+        for (i = 0; i < EINK_BLINKCOUNT; i++)
+        {
+            scan_window(first, last, TRUE);
+        }
+        g_fastcount = 0;
+    }
+    
+    if (waveform == EINK_FLUSH_FAST)
+    {
+        for (i = 0; i < EINK_FASTCOUNT; i++)
+        {
+            scan_window(first, last, FALSE);
+        }
+        if (g_fastcount < 255)
+            g_fastcount++;
+    }
+    else
+    {
+        for (i = 0; i < EINK_WRITECOUNT; i++)
+        {
+            scan_window(first, last, FALSE);
+        }
     }
     
     clear_block_map();
@@ -440,7 +631,7 @@ static block_t *alloc_buffer(unsigned bx, unsigned by)
     {
         if (g_next_block >= EINK_NUMBUFFERS)
         {
-            flush_buffers();
+            flush_buffers(EINK_FLUSH_AUTO);
         }
         
         result = &g_blocks[g_next_block];
@@ -489,7 +680,8 @@ bool_t gdisp_lld_init(void)
     return TRUE;
 }
 
-void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color)
+/* The emulation layer handles the orientation - these take native coordinates */
+void gdisp_lld_phys_draw_pixel(coord_t x, coord_t y, color_t color)
 {
     block_t *block;
     uint8_t byte;
@@ -524,7 +716,7 @@ void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color)
 #error You must enable GDISP_NEED_CONTROL for the E-Ink driver.
 #endif
 
-void gdisp_lld_control(unsigned what, void *value) {
+void gdisp_lld_phys_control(unsigned what, void *value) {
     gdisp_powermode_t newmode;
     
     switch(what)
@@ -541,14 +733,16 @@ void gdisp_lld_control(unsigned what, void *value) {
             }
             else
             {
-                flush_buffers();
+                flush_buffers(EINK_FLUSH_AUTO);
                 power_off();
             }
             GDISP.Powermode = newmode;
             break;
         
         case GDISP_CONTROL_FLUSH:
-            flush_buffers();
+            if ((unsigned)value > EINK_FLUSH_FULL)
+                value = (void *)EINK_FLUSH_AUTO;
+            flush_buffers((unsigned)value);
             break;
     }
 }
@@ -584,9 +778,19 @@ static void subclear(color_t color)
 
 void gdisp_lld_clear(color_t color)
 {
-    unsigned i;
+    unsigned i, bx, by;
     clear_block_map();
     
+    /* The whole display is now known to be this color */
+    for (by = 0; by < BLOCKS_Y; by++)
+    {
+        for (bx = 0; bx < BLOCKS_X; bx++)
+        {
+            g_blockstate[by][bx] = color ? STATE_WHITE : STATE_BLACK;
+        }
+    }
+    g_fastcount = 0;
+    
     if (EINK_BLINKCLEAR)
     {
         subclear(!color);
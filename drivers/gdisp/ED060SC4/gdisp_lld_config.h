@@ -17,6 +17,7 @@
 #define GDISP_HARDWARE_SCROLL           FALSE
 #define GDISP_HARDWARE_PIXELREAD        FALSE
 #define GDISP_HARDWARE_CONTROL          TRUE
+#define GDISP_SOFTWARE_ORIENTATION      TRUE
 
 #define GDISP_PIXELFORMAT               GDISP_PIXELFORMAT_MONO
 
@@ -0,0 +1,44 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/gdisp/Framebuffer/framebuffer.h
+ * @brief   GDISP Framebuffer driver query codes.
+ *
+ * @addtogroup GDISP
+ * @{
+ */
+
+#ifndef _FRAMEBUFFER_H
+#define _FRAMEBUFFER_H
+
+#include "gfx.h"
+
+/**
+ * @brief	Get the framebuffer.
+ * @details	Returns a pointer to the GDISP_SCREEN_WIDTH by GDISP_SCREEN_HEIGHT array of
+ *			color_t that holds the display in its native (unrotated) orientation, e.g.
+ * @code
+ *		const color_t *fb = (const color_t *)gdispQuery(GDISP_QUERY_FRAMEBUFFER);
+ * @endcode
+ */
+#define GDISP_QUERY_FRAMEBUFFER			(GDISP_QUERY_LLD + 0)
+
+/**
+ * @brief	Get the width of the framebuffer in pixels (cast the result to coord_t).
+ * @note	This is the native width. It does not change with the orientation.
+ */
+#define GDISP_QUERY_FRAMEBUFFER_WIDTH	(GDISP_QUERY_LLD + 1)
+
+/**
+ * @brief	Get the height of the framebuffer in pixels (cast the result to coord_t).
+ * @note	This is the native height. It does not change with the orientation.
+ */
+#define GDISP_QUERY_FRAMEBUFFER_HEIGHT	(GDISP_QUERY_LLD + 2)
+
+#endif /* _FRAMEBUFFER_H */
+/** @} */
@@ -0,0 +1,118 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/gdisp/Framebuffer/gdisp_lld.c
+ * @brief   GDISP Graphics Driver subsystem low level driver source for an in-memory framebuffer.
+ *
+ * @details	This driver draws into a plain array of pixels rather than a real display.
+ *			As it does exactly the same thing every time it is run it is useful for
+ *			comparing what is drawn against known good images and for measuring the
+ *			drawing code without the cost of a display bus. The orientation is
+ *			handled by the emulation layer so the framebuffer is always unrotated.
+ *
+ * @addtogroup GDISP
+ * @{
+ */
+
+#include "gfx.h"
+
+#if GFX_USE_GDISP /*|| defined(__DOXYGEN__)*/
+
+/* Include the emulation code for things we don't support */
+#include "gdisp/lld/emulation.c"
+
+#include "framebuffer.h"
+
+#ifndef GDISP_SCREEN_HEIGHT
+	#define GDISP_SCREEN_HEIGHT		240
+#endif
+#ifndef GDISP_SCREEN_WIDTH
+	#define GDISP_SCREEN_WIDTH		320
+#endif
+
+#if GDISP_PACKED_PIXELS
+	#error "GDISP Framebuffer: Packed pixel formats are not supported"
+#endif
+
+static color_t	framebuffer[GDISP_SCREEN_HEIGHT][GDISP_SCREEN_WIDTH];
+
+bool_t gdisp_lld_init(void) {
+	coord_t	x, y;
+
+	for(y = 0; y < GDISP_SCREEN_HEIGHT; y++)
+		for(x = 0; x < GDISP_SCREEN_WIDTH; x++)
+			framebuffer[y][x] = Black;
+
+	/* Initialise the GDISP structure to match */
+	GDISP.Orientation = GDISP_ROTATE_0;
+	GDISP.Powermode = powerOn;
+	GDISP.Backlight = 100;
+	GDISP.Contrast = 50;
+	GDISP.Width = GDISP_SCREEN_WIDTH;
+	GDISP.Height = GDISP_SCREEN_HEIGHT;
+	#if GDISP_NEED_VALIDATION || GDISP_NEED_CLIP
+		GDISP.clipx0 = 0;
+		GDISP.clipy0 = 0;
+		GDISP.clipx1 = GDISP.Width;
+		GDISP.clipy1 = GDISP.Height;
+	#endif
+	return TRUE;
+}
+
+/* The emulation layer clips and handles the orientation - these take native coordinates */
+void gdisp_lld_phys_draw_pixel(coord_t x, coord_t y, color_t color) {
+	framebuffer[y][x] = color;
+}
+
+void gdisp_lld_phys_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+	color_t	*p;
+	coord_t	i;
+
+	for(; cy--; y++)
+		for(p = &framebuffer[y][x], i = cx; i--; )
+			*p++ = color;
+}
+
+void gdisp_lld_phys_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
+	const pixel_t	*src;
+	color_t			*p;
+	coord_t			i;
+
+	for(buffer += srcy*srccx + srcx; cy--; y++, buffer += srccx)
+		for(p = &framebuffer[y][x], src = buffer, i = cx; i--; )
+			*p++ = *src++;
+}
+
+#if GDISP_NEED_PIXELREAD
+	color_t gdisp_lld_phys_get_pixel_color(coord_t x, coord_t y) {
+		return framebuffer[y][x];
+	}
+#endif
+
+#if GDISP_NEED_QUERY
+	/**
+	 * @brief   Query a driver value.
+	 * @details	As well as the standard queries this supports GDISP_QUERY_FRAMEBUFFER,
+	 *			GDISP_QUERY_FRAMEBUFFER_WIDTH and GDISP_QUERY_FRAMEBUFFER_HEIGHT.
+	 *
+	 * @param[in] what		What to query
+	 *
+	 * @notapi
+	 */
+	void *gdisp_lld_query(unsigned what) {
+		switch(what) {
+		case GDISP_QUERY_FRAMEBUFFER:			return (void *)framebuffer;
+		case GDISP_QUERY_FRAMEBUFFER_WIDTH:		return (void *)(size_t)GDISP_SCREEN_WIDTH;
+		case GDISP_QUERY_FRAMEBUFFER_HEIGHT:	return (void *)(size_t)GDISP_SCREEN_HEIGHT;
+		default:								return (void *)-1;
+		}
+	}
+#endif
+
+#endif /* GFX_USE_GDISP */
+/** @} */
@@ -0,0 +1,49 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/gdisp/Framebuffer/gdisp_lld_config.h
+ * @brief   GDISP Graphic Driver subsystem low level driver header for an in-memory framebuffer.
+ *
+ * @addtogroup GDISP
+ * @{
+ */
+
+#ifndef _GDISP_LLD_CONFIG_H
+#define _GDISP_LLD_CONFIG_H
+
+#if GFX_USE_GDISP
+
+/*===========================================================================*/
+/* Driver hardware support.                                                  */
+/*===========================================================================*/
+
+#define GDISP_DRIVER_NAME				"Framebuffer"
+
+#define GDISP_HARDWARE_CLEARS			FALSE
+#define GDISP_HARDWARE_FILLS			TRUE
+#define GDISP_HARDWARE_BITFILLS			TRUE
+#define GDISP_HARDWARE_SCROLL			FALSE
+#define GDISP_HARDWARE_PIXELREAD		TRUE
+#define GDISP_HARDWARE_CONTROL			FALSE
+#define GDISP_HARDWARE_QUERY			TRUE
+#define GDISP_HARDWARE_CIRCLES			FALSE
+#define GDISP_HARDWARE_CIRCLEFILLS		FALSE
+#define GDISP_HARDWARE_ARCS				FALSE
+#define GDISP_HARDWARE_ARCFILLS			FALSE
+#define GDISP_SOFTWARE_ORIENTATION		TRUE
+
+/* The framebuffer can hold any unpacked pixel format. Choose it in your gfxconf.h */
+#ifndef GDISP_FRAMEBUFFER_PIXELFORMAT
+	#define GDISP_FRAMEBUFFER_PIXELFORMAT	GDISP_PIXELFORMAT_RGB565
+#endif
+#define GDISP_PIXELFORMAT				GDISP_FRAMEBUFFER_PIXELFORMAT
+
+#endif	/* GFX_USE_GDISP */
+
+#endif	/* _GDISP_LLD_CONFIG_H */
+/** @} */
@@ -0,0 +1,5 @@
+# List the required driver.
+GFXSRC += $(GFXLIB)/drivers/ginput/keyboard/Stdin/ginput_lld_keyboard.c
+
+# Required include directories
+GFXINC += $(GFXLIB)/drivers/ginput/keyboard/Stdin
@@ -0,0 +1,143 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/ginput/keyboard/Stdin/ginput_lld_keyboard.c
+ * @brief   GINPUT Keyboard low level driver source for a POSIX terminal (stdin).
+ *
+ * @defgroup Keyboard Keyboard
+ * @ingroup GINPUT
+ * @{
+ */
+
+#include "gfx.h"
+
+#if (GFX_USE_GINPUT && GINPUT_NEED_KEYBOARD) /*|| defined(__DOXYGEN__)*/
+
+#include "ginput/lld/keyboard.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/select.h>
+
+static struct termios	oldtio;
+
+/* The terminal escape sequences we understand (the leading ESC is not included) */
+static const struct EscapeKey_t {
+	const char	*seq;
+	uint16_t	code;
+} EscapeKeys[] = {
+	{ "[A",		GKEY_UP },			{ "[B",		GKEY_DOWN },
+	{ "[C",		GKEY_RIGHT },		{ "[D",		GKEY_LEFT },
+	{ "[H",		GKEY_HOME },		{ "[F",		GKEY_END },
+	{ "[1~",	GKEY_HOME },		{ "[4~",	GKEY_END },
+	{ "[2~",	GKEY_INSERT },		{ "[3~",	GKEY_DELETE },
+	{ "[5~",	GKEY_PAGEUP },		{ "[6~",	GKEY_PAGEDOWN },
+	{ "OP",		GKEY_FN1 },			{ "OQ",		GKEY_FN2 },
+	{ "OR",		GKEY_FN3 },			{ "OS",		GKEY_FN4 },
+	{ "[15~",	GKEY_FN5 },			{ "[17~",	GKEY_FN6 },
+	{ "[18~",	GKEY_FN7 },			{ "[19~",	GKEY_FN8 },
+	{ "[20~",	GKEY_FN9 },			{ "[21~",	GKEY_FN10 },
+	{ "[23~",	GKEY_FN11 },		{ "[24~",	GKEY_FN12 },
+};
+
+static void restoreterminal(void) {
+	tcsetattr(STDIN_FILENO, TCSANOW, &oldtio);
+}
+
+static void putkey(uint16_t code) {
+	ginputKeyboardPut(0, code, TRUE);
+	ginputKeyboardPut(0, code, FALSE);
+}
+
+/**
+ * @brief   Initialise the keyboard.
+ *
+ * @notapi
+ */
+void ginput_lld_keyboard_init(void) {
+	struct termios	tio;
+
+	if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &oldtio))
+		return;
+
+	// Raw(ish) mode - no line buffering, no echo, no signals from ^C etc
+	tio = oldtio;
+	tio.c_lflag &= ~(ICANON|ECHO|ISIG|IEXTEN);
+	tio.c_iflag &= ~(IXON|ICRNL);
+	tio.c_cc[VMIN] = 1;
+	tio.c_cc[VTIME] = 0;
+	tcsetattr(STDIN_FILENO, TCSANOW, &tio);
+	atexit(restoreterminal);
+}
+
+/**
+ * @brief   Read any waiting key presses and pass them to GINPUT.
+ *
+ * @notapi
+ */
+void ginput_lld_keyboard_poll(void) {
+	struct timeval	tv;
+	fd_set			fds;
+	char			buf[32];
+	int				len, i, j, n;
+
+	n = 0;
+
+	// Read whatever is waiting without blocking
+	FD_ZERO(&fds);
+	FD_SET(STDIN_FILENO, &fds);
+	tv.tv_sec = tv.tv_usec = 0;
+	if (select(STDIN_FILENO+1, &fds, 0, 0, &tv) <= 0)
+		return;
+	if ((len = read(STDIN_FILENO, buf, sizeof(buf))) <= 0)
+		return;
+
+	for(i = 0; i < len; i++) {
+		switch(buf[i]) {
+		case 27:
+			// An escape sequence or just the ESC key on its own?
+			for(j = 0; j < (int)(sizeof(EscapeKeys)/sizeof(EscapeKeys[0])); j++) {
+				n = strlen(EscapeKeys[j].seq);
+				if (i+1+n <= len && !memcmp(buf+i+1, EscapeKeys[j].seq, n))
+					break;
+			}
+			if (j < (int)(sizeof(EscapeKeys)/sizeof(EscapeKeys[0]))) {
+				putkey(EscapeKeys[j].code);
+				i += n;
+			} else
+				putkey(GKEY_ESC);
+			break;
+		case '\r':
+		case '\n':
+			putkey(GKEY_CR);
+			break;
+		case 8:
+		case 127:
+			// Most terminals send DEL for the backspace key
+			putkey(GKEY_BACKSPACE);
+			break;
+		case '\t':
+			putkey(GKEY_TAB);
+			break;
+		default:
+			if (buf[i] > 0 && buf[i] < ' ') {
+				// A control key
+				ginputKeyboardPut(0, GKEY_CNTRL, TRUE);
+				putkey('a' + buf[i] - 1);
+				ginputKeyboardPut(0, GKEY_CNTRL, FALSE);
+			} else if (buf[i] > 0)
+				putkey(buf[i]);
+			break;
+		}
+	}
+}
+
+#endif /* GFX_USE_GINPUT && GINPUT_NEED_KEYBOARD */
+/** @} */
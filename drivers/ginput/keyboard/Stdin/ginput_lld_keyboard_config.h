@@ -0,0 +1,30 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    drivers/ginput/keyboard/Stdin/ginput_lld_keyboard_config.h
+ * @brief   GINPUT LLD header file for the stdin keyboard driver.
+ *
+ * @defgroup Keyboard Keyboard
+ * @ingroup GINPUT
+ *
+ * @{
+ */
+
+#ifndef _LLD_GINPUT_KEYBOARD_CONFIG_H
+#define _LLD_GINPUT_KEYBOARD_CONFIG_H
+
+// A terminal only gives us key presses (no key releases) so each key is reported as a down immediately
+//	followed by an up. The terminal does its own auto-repeat so we don't need ours.
+#define GINPUT_KEYBOARD_POLL_PERIOD				20
+#define GINPUT_KEYBOARD_REPEAT_DELAY			0
+
+// A pasted block of text (or a burst of escape sequences) can arrive in a single read
+#define GINPUT_KEYBOARD_QUEUE_SIZE				64
+
+#endif	/* _LLD_GINPUT_KEYBOARD_CONFIG_H */
+/** @} */
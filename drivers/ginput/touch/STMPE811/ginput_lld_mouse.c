@@ -163,6 +163,23 @@ void ginput_lld_mouse_get_reading(MouseReading *pt)
 
 }
 
+#if GINPUT_MOUSE_PEN_IRQ
+/**
+ * @brief   Enable or disable the pen down interrupt.
+ *
+ * @param[in] enable	TRUE to enable the interrupt
+ *
+ * @notapi
+ */
+void ginput_lld_mouse_pen_irq(bool_t enable) {
+	pen_irq_enable(enable);
+
+	// Don't miss a touch that happened before the interrupt was enabled
+	if (enable && getpin_irq())
+		ginputMouseWakeup();
+}
+#endif
+
 #endif /* GFX_USE_GINPUT && GINPUT_NEED_MOUSE */
 /** @} */
 
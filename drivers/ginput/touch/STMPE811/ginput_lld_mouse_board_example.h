@@ -71,5 +71,22 @@ static uint16_t read_reg(uint8_t reg, uint8_t n)
 	#error "ginputSTMPE811: You must supply a definition for read_reg for your board"
 }
 
+#if GINPUT_MOUSE_PEN_IRQ
+	/**
+	 * @brief   Enable or disable the pen down interrupt
+	 *
+	 * @param[in] enable	TRUE to enable the interrupt
+	 *
+	 * @note	Only needed if GINPUT_MOUSE_PEN_IRQ is TRUE.
+	 * @note	The interrupt handler must call ginputMouseWakeupI()
+	 *
+	 * @notapi
+	 */
+	static inline void pen_irq_enable(bool_t enable) {
+		/* Code here */
+		#error "ginputSTMPE811: You must supply a definition for pen_irq_enable for your board"
+	}
+#endif
+
 #endif /* _GINPUT_LLD_MOUSE_BOARD_H */
 /** @} */
@@ -617,54 +617,6 @@ void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color) {
 	}
 #endif
 
-#if (GDISP_HARDWARE_BITFILLS && GDISP_NEED_CONTROL) || defined(__DOXYGEN__)
-	static pixel_t *rotateimg(coord_t cx, coord_t cy, coord_t srcx, coord_t srccx, const pixel_t *buffer) {
-		pixel_t	*dstbuf;
-		pixel_t	*dst;
-		const pixel_t	*src;
-		size_t	sz;
-		coord_t	i, j;
-
-		// Shortcut.
-		if (GDISP.Orientation == GDISP_ROTATE_0 && srcx == 0 && cx == srccx)
-			return (pixel_t *)buffer;
-		
-		// Allocate the destination buffer
-		sz = (size_t)cx * (size_t)cy;
-		if (!(dstbuf = (pixel_t *)malloc(sz * sizeof(pixel_t))))
-			return 0;
-		
-		// Copy the bits we need
-		switch(GDISP.Orientation) {
-		case GDISP_ROTATE_0:
-			for(dst = dstbuf, src = buffer+srcx, j = 0; j < cy; j++)
-				for(i = 0; i < cx; i++, src += srccx - cx)
-					*dst++ = *src++;
-			break;
-		case GDISP_ROTATE_90:
-			for(src = buffer+srcx, j = 0; j < cy; j++) {
-				dst = dstbuf+cy-j-1;
-				for(i = 0; i < cx; i++, src += srccx - cx, dst += cy)
-					*dst = *src++;
-			}
-			break;
-		case GDISP_ROTATE_180:
-			for(dst = dstbuf+sz, src = buffer+srcx, j = 0; j < cy; j++)
-				for(i = 0; i < cx; i++, src += srccx - cx)
-					*--dst = *src++;
-			break;
-		case GDISP_ROTATE_270:
-			for(src = buffer+srcx, j = 0; j < cy; j++) {
-				dst = dstbuf+sz-cy+j;
-				for(i = 0; i < cx; i++, src += srccx - cx, dst -= cy)
-					*dst = *src++;
-			}
-			break;
-		}
-		return dstbuf;
-	}
-#endif
-	
 #if GDISP_HARDWARE_BITFILLS || defined(__DOXYGEN__)
 	/**
 	 * @brief   Fill an area with a bitmap.
@@ -682,7 +634,8 @@ void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color) {
 		BITMAPV4HEADER bmpInfo;
 		RECT	rect;
 		#if GDISP_NEED_CONTROL
-			pixel_t	*srcimg;
+			static pixel_t	tile[GDISP_ROTATE_TILE_SIZE*GDISP_ROTATE_TILE_SIZE];
+			coord_t			tx, ty, tcx, tcy, px, py, pcx, pcy;
 		#endif
 
 		#if GDISP_NEED_VALIDATION || GDISP_NEED_CLIP
@@ -715,59 +668,45 @@ void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color) {
 		bmpInfo.bV4CSType = 0; //LCS_sRGB;
 
 		#if GDISP_NEED_CONTROL
-			bmpInfo.bV4SizeImage = (cy*cx) * sizeof(pixel_t);
-			srcimg = rotateimg(cx, cy, srcx, srccx, buffer);
-			if (!srcimg) return;
-			
-			switch(GDISP.Orientation) {
-			case GDISP_ROTATE_0:
-				bmpInfo.bV4Width = cx;
-				bmpInfo.bV4Height = -cy; /* top-down image */
+			if (GDISP.Orientation != GDISP_ROTATE_0) {
+				// Rotate and draw a tile at a time so we never need a copy of the whole image
+				buffer += srcx;
+				for(ty = 0; ty < cy; ty += GDISP_ROTATE_TILE_SIZE) {
+					tcy = cy - ty < GDISP_ROTATE_TILE_SIZE ? cy - ty : GDISP_ROTATE_TILE_SIZE;
+					for(tx = 0; tx < cx; tx += GDISP_ROTATE_TILE_SIZE) {
+						tcx = cx - tx < GDISP_ROTATE_TILE_SIZE ? cx - tx : GDISP_ROTATE_TILE_SIZE;
+						_rotate_block(tile, tcx, tcy, srccx, buffer + ty*srccx + tx);
+						px = x + tx;
+						py = y + ty;
+						pcx = tcx;
+						pcy = tcy;
+						_phys_area(&px, &py, &pcx, &pcy);
+						bmpInfo.bV4Width = pcx;
+						bmpInfo.bV4Height = -pcy; /* top-down image */
+						bmpInfo.bV4SizeImage = (pcy*pcx) * sizeof(pixel_t);
+						SetDIBitsToDevice(dcBuffer, px, py, pcx, pcy, 0, 0, 0, pcy, tile, (BITMAPINFO*)&bmpInfo, DIB_RGB_COLORS);
+					}
+				}
+				_phys_area(&x, &y, &cx, &cy);
 				rect.top = y;
 				rect.bottom = rect.top+cy;
 				rect.left = x;
 				rect.right = rect.left+cx;
-				break;
-			case GDISP_ROTATE_90:
-				bmpInfo.bV4Width = cy;
-				bmpInfo.bV4Height = -cx; /* top-down image */
-				rect.top = x;
-				rect.bottom = rect.top+cx;
-				rect.right = GDISP.Height - y;
-				rect.left = rect.right-cy;
-				break;
-			case GDISP_ROTATE_180:
-				bmpInfo.bV4Width = cx;
-				bmpInfo.bV4Height = -cy; /* top-down image */
-				rect.bottom = GDISP.Height - y;
-				rect.top = rect.bottom-cy;
-				rect.right = GDISP.Width - x;
-				rect.left = rect.right-cx;
-				break;
-			case GDISP_ROTATE_270:
-				bmpInfo.bV4Width = cy;
-				bmpInfo.bV4Height = -cx; /* top-down image */
-				rect.bottom = GDISP.Width - x;
-				rect.top = rect.bottom-cx;
-				rect.left = y;
-				rect.right = rect.left+cy;
-				break;
+				InvalidateRect(winRootWindow, &rect, FALSE);
+				UpdateWindow(winRootWindow);
+				return;
 			}
-			SetDIBitsToDevice(dcBuffer, rect.left, rect.top, rect.right-rect.left, rect.bottom-rect.top, 0, 0, 0, rect.bottom-rect.top, srcimg, (BITMAPINFO*)&bmpInfo, DIB_RGB_COLORS);
-			if (srcimg != (pixel_t *)buffer)
-				free(srcimg);
-			
-		#else
-			bmpInfo.bV4Width = srccx;
-			bmpInfo.bV4Height = -cy; /* top-down image */
-			bmpInfo.bV4SizeImage = (cy*srccx) * sizeof(pixel_t);
-			rect.top = y;
-			rect.bottom = rect.top+cy;
-			rect.left = x;
-			rect.right = rect.left+cx;
-			SetDIBitsToDevice(dcBuffer, x, y, cx, cy, srcx, 0, 0, cy, buffer, (BITMAPINFO*)&bmpInfo, DIB_RGB_COLORS);
 		#endif
 
+		bmpInfo.bV4Width = srccx;
+		bmpInfo.bV4Height = -cy; /* top-down image */
+		bmpInfo.bV4SizeImage = (cy*srccx) * sizeof(pixel_t);
+		rect.top = y;
+		rect.bottom = rect.top+cy;
+		rect.left = x;
+		rect.right = rect.left+cx;
+		SetDIBitsToDevice(dcBuffer, x, y, cx, cy, srcx, 0, 0, cy, buffer, (BITMAPINFO*)&bmpInfo, DIB_RGB_COLORS);
+
 		// Invalidate the region to get it on the screen.
 		InvalidateRect(winRootWindow, &rect, FALSE);
 		UpdateWindow(winRootWindow);
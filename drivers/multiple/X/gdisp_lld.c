@@ -260,15 +260,11 @@ bool_t gdisp_lld_init(void)
     return TRUE;
 }
 
-void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color)
+/* The emulation layer clips and handles the orientation - these take native coordinates */
+void gdisp_lld_phys_draw_pixel(coord_t x, coord_t y, color_t color)
 {
 	XColor	col;
 
-   #if GDISP_NEED_VALIDATION || GDISP_NEED_CLIP
-        // Clip pre orientation change
-        if (x < GDISP.clipx0 || y < GDISP.clipy0 || x >= GDISP.clipx1 || y >= GDISP.clipy1) return;
-    #endif
-
 	col.red = RED_OF(color) << 8;
 	col.green = GREEN_OF(color) << 8;
 	col.blue = BLUE_OF(color) << 8;
@@ -279,17 +275,8 @@ void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color)
 	XFlush(dis);
 }
 
-void gdisp_lld_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+void gdisp_lld_phys_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 	XColor	col;
-	
-    #if GDISP_NEED_VALIDATION || GDISP_NEED_CLIP
-        // Clip pre orientation change
-        if (x < GDISP.clipx0) { cx -= GDISP.clipx0 - x; x = GDISP.clipx0; }
-        if (y < GDISP.clipy0) { cy -= GDISP.clipy0 - y; y = GDISP.clipy0; }
-        if (cx <= 0 || cy <= 0 || x >= GDISP.clipx1 || y >= GDISP.clipy1) return;
-        if (x+cx > GDISP.clipx1)	cx = GDISP.clipx1 - x;
-        if (y+cy > GDISP.clipy1)	cy = GDISP.clipy1 - y;
-    #endif
 
 	col.red = RED_OF(color) << 8;
 	col.green = GREEN_OF(color) << 8;
@@ -34,6 +34,7 @@
 #define GDISP_HARDWARE_CIRCLEFILLS		FALSE
 #define GDISP_HARDWARE_ARCS			FALSE
 #define GDISP_HARDWARE_ARCFILLS			FALSE
+#define GDISP_SOFTWARE_ORIENTATION		TRUE
 
 #define GDISP_PIXELFORMAT			GDISP_PIXELFORMAT_RGB888
 
@@ -19,6 +19,9 @@
 #define GFX_USE_OS_WIN32		FALSE
 #define GFX_USE_OS_POSIX		FALSE
 
+/* GOS features */
+#define GOS_NEED_POOLS			FALSE
+
 /* GFX subsystems to turn on */
 #define GFX_USE_GDISP			FALSE
 #define GFX_USE_TDISP			FALSE
@@ -35,11 +38,18 @@
 /* Features for the GDISP subsystem */
 #define GDISP_NEED_VALIDATION		TRUE
 #define GDISP_NEED_CLIP				TRUE
+#define GDISP_NEED_CLIPREGION		FALSE
 #define GDISP_NEED_TEXT				TRUE
+#define GDISP_NEED_ANTIALIAS		FALSE
+#define GDISP_NEED_UTF8				FALSE
+#define GDISP_NEED_FONTLOAD			FALSE
+#define GDISP_NEED_TEXTLAYOUT		FALSE
 #define GDISP_NEED_CIRCLE			TRUE
 #define GDISP_NEED_ELLIPSE			TRUE
 #define GDISP_NEED_ARC				FALSE
 #define GDISP_NEED_CONVEX_POLYGON	FALSE
+#define GDISP_NEED_STYLEDLINE		FALSE
+#define GDISP_NEED_ALPHA			FALSE
 #define GDISP_NEED_SCROLL			FALSE
 #define GDISP_NEED_PIXELREAD		FALSE
 #define GDISP_NEED_CONTROL			FALSE
@@ -48,6 +58,8 @@
 #define GDISP_NEED_MULTITHREAD		FALSE
 #define GDISP_NEED_ASYNC			FALSE
 #define GDISP_NEED_MSGAPI			FALSE
+#define GDISP_NEED_MULTIPLE_DISPLAYS	FALSE
+#define GDISP_NEED_STATS		FALSE
 
 /* GDISP - builtin fonts */
 #define GDISP_INCLUDE_FONT_SMALL		FALSE
@@ -63,6 +75,7 @@
 #define GDISP_NEED_IMAGE_JPG		FALSE
 #define GDISP_NEED_IMAGE_PNG		FALSE
 #define GDISP_NEED_IMAGE_ACCOUNTING	FALSE
+#define GDISP_NEED_IMAGE_COMPRESSED	FALSE
 
 /* Optional image support that can be turned off */
 /*
@@ -78,6 +91,7 @@
 
 /* Features for the TDISP subsystem. */
 #define TDISP_NEED_MULTITHREAD	FALSE
+#define TDISP_NEED_BUFFER		FALSE
 
 /* Features for the GWIN subsystem. */
 #define GWIN_NEED_BUTTON		FALSE
@@ -85,12 +99,14 @@
 #define GWIN_NEED_GRAPH			FALSE
 #define GWIN_NEED_SLIDER		FALSE
 #define GWIN_NEED_CHECKBOX		FALSE
+#define GWIN_NEED_SPECTRUM		FALSE
 
 /* Features for the GEVENT subsystem. */
 #define GEVENT_ASSERT_NO_RESOURCE	FALSE
+#define GEVENT_NEED_STATS		FALSE
 
 /* Features for the GTIMER subsystem. */
-/* NONE */
+#define GTIMER_NEED_STATS		FALSE
 
 /* Features for the GQUEUE subsystem. */
 #define GQUEUE_NEED_ASYNC		FALSE
@@ -110,12 +126,16 @@
 /* NONE */
 
 /* Features for the GAUDOUT subsystem. */
-/* NONE */
+#define GAUDOUT_NEED_MIXER		FALSE
 
 /* Features for the GMISC subsystem. */
 #define GMISC_NEED_ARRAYOPS		FALSE
 #define GMISC_NEED_FASTTRIG		FALSE
 #define GMISC_NEED_FIXEDTRIG	FALSE
+#define GMISC_NEED_FIXEDMATH	FALSE
+#define GMISC_NEED_DSP			FALSE
+#define GMISC_NEED_PERF			FALSE
+#define GMISC_NEED_TRACE		FALSE
 
 /* Optional Parameters for various subsystems */
 /*
@@ -127,6 +147,10 @@
 	#define GWIN_BUTTON_LAZY_RELEASE		FALSE
 	#define GWIN_CONSOLE_USE_BASESTREAM		FALSE
 	#define GWIN_CONSOLE_USE_FLOAT			FALSE
+	#define GWIN_USE_POOLS					FALSE
+	#define GDISP_IMAGE_USE_POOLS			FALSE
+	#define GOS_POOL_SIZES					16, 32, 64, 128, 256
+	#define GOS_POOL_COUNTS					16, 16, 8, 4, 2
 */
 
 /* Optional Low Level Driver Definitions */
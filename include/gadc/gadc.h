@@ -19,15 +19,16 @@
  *			device (but different channels). This layer attempts to solve these
  *			problems to provide a architecture neutral API. It also provides extra
  *			features such as multi-buffer chaining for high speed ADC sources.
- *			It provides one high speed virtual ADC device (eg a microphone) and
- *			numerous low speed (less than 100Hz) virtual ADC devices (eg dials,
- *			temperature sensors etc). The high speed device has timer based polling
- *			to ensure exact conversion periods and a buffer management system.
+ *			It provides high speed virtual ADC streams (eg a microphone, or the
+ *			voltage and current of a power monitor) and numerous low speed (less
+ *			than 100Hz) virtual ADC devices (eg dials, temperature sensors etc).
+ *			The high speed streams have timer based polling to ensure exact conversion
+ *			periods and a ring buffer each. Streams can run at the same time at
+ *			different rates. Streams at the same rate are converted together.
  *			The low speed devices are assumed to be non-critical timing devices
  *			and do not have any buffer management.
- *			Note that while only one high speed device has been provided it can
- *			be used to read multiple physical ADC channels on the one physical
- *			ADC device.
+ *			The original single high speed device API is still provided and is
+ *			built on a stream.
  *			All callback routines are thread based unlike the Chibi-OS interrupt based
  *			routines.
  *
@@ -94,6 +95,27 @@ typedef void (*GADCCallbackFunction)(adcsample_t *buffer, void *param);
  */
 typedef void (*GADCISRCallbackFunction)(adcsample_t *buffer, size_t size);
 
+/**
+ * @brief A high speed ADC stream
+ * @note  All the members are private. Use @p gadcStreamInit() to set one up.
+ */
+typedef struct GADCStream_t {
+	struct GADCStream_t	*next;				// The next running stream
+	uint32_t			physdev;
+	uint32_t			frequency;
+	uint32_t			phase;				// Decides which timer ticks belong to this stream
+	adcsample_t			*buffer;
+	size_t				bufcount;			// The ring size in conversions
+	size_t				watermark;			// Wake the consumer when this many conversions are ready
+	size_t				samplesPerConversion;
+	size_t				wr;					// Where the next conversion goes
+	size_t				rd;					// The oldest conversion the consumer has not released
+	volatile size_t		filled;				// Conversions between rd and wr
+	volatile uint32_t	overruns;			// Conversions dropped because the ring was full
+	uint16_t			flags;
+	gfxSem				sem;
+	} GADCStream;
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -206,6 +228,89 @@ void gadcHighSpeedStart(void);
  */
 void gadcHighSpeedStop(void);
 
+/**
+ * @brief				Initialise a high speed ADC stream.
+ * @details				Initialises but does not start the conversions.
+ *
+ * @param[in] ps			The stream structure to initialise
+ * @param[in] physdev		A value passed to describe which physical ADC devices/channels to use.
+ * @param[in] frequency		The frequency to create ADC conversions (no more than GADC_MAX_HIGH_SPEED_SAMPLERATE)
+ * @param[in] buffer		The ring buffer to put the ADC samples into.
+ * @param[in] bufcount		The total number of conversions that will fit in the buffer.
+ * @param[in] watermark		Wake the consumer when this many conversions are ready.
+ *
+ * @note				The stream must not be running.
+ * @note				Conversions are never overwritten before they are released. When the ring
+ * 						is full new conversions are dropped and counted as overruns.
+ * @note				When several streams are running the ADC timer runs at the fastest rate and each
+ * 						stream takes its share of the timer ticks. Streams at the same rate sample
+ * 						together so eg. voltage and current conversions line up. Streams at a
+ * 						slower rate that does not divide the fastest rate see some jitter.
+ *
+ * @api
+ */
+void gadcStreamInit(GADCStream *ps, uint32_t physdev, uint32_t frequency, adcsample_t *buffer, size_t bufcount, size_t watermark);
+
+/**
+ * @brief				Start a high speed ADC stream.
+ * @return				FALSE if the stream can't be run
+ *
+ * @param[in] ps			The stream
+ *
+ * @note				Starting or stopping a stream briefly stops the ADC timer for all streams.
+ *
+ * @api
+ */
+bool_t gadcStreamStart(GADCStream *ps);
+
+/**
+ * @brief				Stop a high speed ADC stream.
+ * @details				Conversions already in the ring can still be acquired.
+ *
+ * @param[in] ps			The stream
+ *
+ * @api
+ */
+void gadcStreamStop(GADCStream *ps);
+
+/**
+ * @brief				Get the oldest conversions in the ring without copying them.
+ * @return				The number of conversions at *pbuffer.
+ *
+ * @param[in] ps			The stream
+ * @param[out] pbuffer		Set to point to the conversions
+ * @param[in] ms			How long to wait for the watermark to be reached
+ *
+ * @note				If the watermark isn't reached in time whatever is ready is returned (which may be nothing).
+ * @note				This returns fewer conversions than are ready when they wrap around the end of the ring.
+ * 						Release these and call it again to get the rest.
+ * @note				The conversions stay in the ring until they are released with @p gadcStreamRelease().
+ * @note				Only one thread should consume the stream.
+ *
+ * @api
+ */
+size_t gadcStreamAcquire(GADCStream *ps, adcsample_t **pbuffer, delaytime_t ms);
+
+/**
+ * @brief				Give conversions back to the ring
+ *
+ * @param[in] ps			The stream
+ * @param[in] count			The number of conversions to release. The oldest are released first.
+ *
+ * @api
+ */
+void gadcStreamRelease(GADCStream *ps, size_t count);
+
+/**
+ * @brief				Get the number of conversions dropped because the ring was full.
+ * @return				The count since the last call.
+ *
+ * @param[in] ps			The stream
+ *
+ * @api
+ */
+uint32_t gadcStreamGetOverruns(GADCStream *ps);
+
 /**
  * @brief	Perform a single low speed ADC conversion
  * @details	Blocks until the conversion is complete
@@ -104,6 +104,8 @@ void gadc_lld_init(void);
  *
  * @note				A physdev describing a mono device would return 1, a stereo device would return 2.
  * 						For most ADC's physdev is a bitmap so it is only a matter of counting the bits.
+ * @note				When several high speed streams are running their physdevs are or'ed together.
+ * 						The samples in each conversion must then be in bit order (lowest bit first).
  *
  * @param[in] physdev	A value passed to describe which physical ADC devices/channels to use.
  *
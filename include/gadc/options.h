@@ -36,6 +36,15 @@
 	#ifndef GADC_MAX_HIGH_SPEED_SAMPLERATE
 		#define GADC_MAX_HIGH_SPEED_SAMPLERATE	44000
 	#endif
+	/**
+	 * @brief   The size of the buffer (in samples) the ADC converts into when several streams are running
+	 * @details	Defaults to 64
+	 * @note	Each ADC interrupt handles this many samples for all the running streams.
+	 * 			It must hold at least one conversion of all the streams' channels.
+	 */
+	#ifndef GADC_STREAM_STAGING_SIZE
+		#define GADC_STREAM_STAGING_SIZE		64
+	#endif
 /** @} */
 
 #endif /* _GADC_OPTIONS_H */
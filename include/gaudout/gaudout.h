@@ -21,10 +21,55 @@
 
 #if GFX_USE_GAUDOUT || defined(__DOXYGEN__)
 
+/* Include the driver defines */
+#include "gaudout_lld_config.h"
+
 /*===========================================================================*/
 /* Type definitions                                                          */
 /*===========================================================================*/
 
+// Event types for GAUDOUT
+#define GEVENT_AUDIO_OUT		(GEVENT_GAUDOUT_FIRST+0)
+
+/**
+ * @brief   The Audio Output event structure.
+ * @{
+ */
+typedef struct GEventAudioOut_t {
+	#if GFX_USE_GEVENT || defined(__DOXYGEN__)
+	/**
+	 * @brief The type of this event (GEVENT_AUDIO_OUT)
+	 */
+		GEventType				type;
+	#endif
+	/**
+	 * @brief The current channel
+	 */
+	uint16_t				channel;
+	/**
+	 * @brief The event flags
+	 */
+	uint16_t				flags;
+		/**
+		 * @brief   The event flag values.
+		 * @{
+		 */
+		#define	GAUDOUT_AUDIO_OUT_LOSTEVENT		0x0001		/**< @brief The last GEVENT_AUDIO_OUT event was lost */
+		#define	GAUDOUT_AUDIO_OUT_UNDERRUN		0x0002		/**< @brief The driver ran out of samples since the last event */
+		/** @} */
+	/**
+	 * @brief The number of conversions that can now be written without blocking
+	 */
+	size_t					count;
+} GEventAudioOut;
+/** @} */
+
+/**
+ * @brief   The mixer volume that plays a sample at its recorded level.
+ * @details	Volumes are 8.8 fixed point so a volume of 128 halves the amplitude.
+ */
+#define GAUDOUT_VOLUME_UNITY		256
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -33,6 +78,171 @@
 extern "C" {
 #endif
 
+/**
+ * @brief		Initialise (but not start) the Audio Output Subsystem.
+ * @details		Returns FALSE for an invalid channel or other invalid parameter.
+ *
+ * @param[in] channel			The channel to output to. Can be set from 0 to GAUDOUT_NUM_CHANNELS - 1.
+ * @param[in] frequency			The sample frequency
+ * @param[in] buffer			The static buffer to queue the samples in.
+ * @param[in] bufcount			The total number of conversions that will fit in the buffer.
+ * @param[in] samplesPerEvent	The largest number of conversions handed to the driver in one block.
+ *
+ * @note				Only one channel is active at a time. If an audio output is running it will be stopped
+ * 						and any queued samples are discarded. The Event subsystem is disconnected from the
+ * 						audio subsystem and any binary semaphore event is forgotten.
+ * @note				Some channels may be stereo channels which take twice as much sample data with
+ * 						the left and right channel data interleaved. As with GAUDIN, 'bufcount' and
+ * 						'samplesPerEvent' count conversions, not samples.
+ * @note				The buffer is a ring. The driver plays blocks of up to samplesPerEvent conversions
+ * 						straight out of it while the application refills the space behind them. A buffer
+ * 						holding two or more blocks gives classic double buffering. More blocks give the
+ * 						application more time to respond before the driver runs out of samples.
+ *
+ * @return				FALSE if invalid channel or parameter
+ *
+ * @api
+ */
+bool_t gaudoutInit(uint16_t channel, uint32_t frequency, audout_sample_t *buffer, size_t bufcount, size_t samplesPerEvent);
+
+#if GFX_USE_GEVENT || defined(__DOXYGEN__)
+	/**
+	 * @brief   			Turn on sending buffer space notifications to the GEVENT sub-system.
+	 * @details				Returns a GSourceHandle to listen for GEVENT_AUDIO_OUT events.
+	 *
+	 * @note				An event is sent each time the driver finishes playing a block.
+	 * 						Once turned on it can only be turned off by calling @p gaudoutInit() again.
+	 * @note				The audio output is capable of signalling via this method and a binary semaphore
+	 * 						at the same time.
+	 *
+	 * @return				The GSourceHandle
+	 *
+	 * @api
+	 */
+	GSourceHandle gaudoutGetSource(void);
+#endif
+
+/**
+ * @brief				Allow waiting for buffer space using a Binary Semaphore and a static event buffer.
+ *
+ * @param[in] pbsem			The semaphore is signaled when the driver has finished playing a block.
+ * @param[in] pEvent		The static event buffer to place the result information.
+ *
+ * @note				Passing a NULL for pbsem or pEvent will turn off signalling via this method.
+ *
+ * @api
+ */
+void gaudoutSetBSem(gfxSem *pbsem, GEventAudioOut *pEvent);
+
+/**
+ * @brief   Start the audio output.
+ * @pre		It must have been initialised first with @p gaudoutInit()
+ *
+ * @note	Queue some samples with @p gaudoutWrite() before starting to avoid an immediate underrun.
+ *
+ * @api
+ */
+void gaudoutStart(void);
+
+/**
+ * @brief   Stop the audio output.
+ * @note	Samples still queued are kept and play when the output is started again.
+ *
+ * @api
+ */
+void gaudoutStop(void);
+
+/**
+ * @brief   Queue samples for playing.
+ * @return	The number of conversions queued. This is less than count if the timeout expired.
+ *
+ * @param[in] data		The samples to queue
+ * @param[in] fmt		The format of the samples. They are converted to GAUDOUT_SAMPLE_FORMAT as they are queued.
+ * @param[in] count		The number of conversions to queue
+ * @param[in] ms		The maximum time to wait for space in the buffer. TIME_IMMEDIATE queues what fits now.
+ *
+ * @note	Formats up to ARRAY_DATA_8BITSIGNED are stored one sample per byte, the others one per uint16_t.
+ *
+ * @api
+ */
+size_t gaudoutWrite(void *data, ArrayDataFormat fmt, size_t count, delaytime_t ms);
+
+/**
+ * @brief   Get the number of conversions that can be queued without blocking.
+ *
+ * @api
+ */
+size_t gaudoutSpace(void);
+
+/**
+ * @brief   Get the number of times the driver has run out of samples since @p gaudoutInit().
+ *
+ * @api
+ */
+uint32_t gaudoutGetUnderruns(void);
+
+#if GAUDOUT_NEED_MIXER || defined(__DOXYGEN__)
+	/**
+	 * @brief   Start playing a sound on a mixer channel.
+	 * @return	FALSE if the mixer channel is invalid
+	 *
+	 * @param[in] mixch		The mixer channel. Can be set from 0 to GAUDOUT_MIXER_CHANNELS - 1.
+	 * @param[in] samples	The sound. It is laid out like the output channel (interleaved if stereo).
+	 * @param[in] count		The number of conversions in the sound
+	 * @param[in] volume	The volume (GAUDOUT_VOLUME_UNITY plays it unchanged)
+	 * @param[in] loop		TRUE to repeat the sound until it is stopped
+	 *
+	 * @note	Any sound already playing on this mixer channel is replaced.
+	 * @note	The samples are not copied and must remain valid while the sound plays.
+	 *
+	 * @api
+	 */
+	bool_t gaudoutMixerPlay(unsigned mixch, const int16_t *samples, size_t count, uint16_t volume, bool_t loop);
+
+	/**
+	 * @brief   Stop the sound on a mixer channel.
+	 *
+	 * @param[in] mixch		The mixer channel
+	 *
+	 * @api
+	 */
+	void gaudoutMixerStop(unsigned mixch);
+
+	/**
+	 * @brief   Change the volume of a mixer channel.
+	 *
+	 * @param[in] mixch		The mixer channel
+	 * @param[in] volume	The volume (GAUDOUT_VOLUME_UNITY plays it unchanged)
+	 *
+	 * @api
+	 */
+	void gaudoutMixerSetVolume(unsigned mixch, uint16_t volume);
+
+	/**
+	 * @brief   Is a mixer channel still playing?
+	 *
+	 * @param[in] mixch		The mixer channel
+	 *
+	 * @api
+	 */
+	bool_t gaudoutMixerIsPlaying(unsigned mixch);
+
+	/**
+	 * @brief   Mix the active mixer channels and queue the result.
+	 * @return	The number of conversions queued
+	 *
+	 * @param[in] count		The number of conversions to mix
+	 * @param[in] ms		The maximum time to wait for space in the buffer
+	 *
+	 * @note	Channels are summed at 32 bits and the result is saturated, so loud sounds clip rather than wrap.
+	 * @note	Only as much as fits is mixed so nothing is lost when the timeout expires.
+	 * 			Call this regularly (for instance in response to GEVENT_AUDIO_OUT) to keep the output fed.
+	 *
+	 * @api
+	 */
+	size_t gaudoutMix(size_t count, delaytime_t ms);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,4 +251,3 @@ extern "C" {
 
 #endif /* _GAUDOUT_H */
 /** @} */
-
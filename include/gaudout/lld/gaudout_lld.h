@@ -0,0 +1,117 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    include/gaudout/lld/gaudout_lld.h
+ * @brief   GAUDOUT - Audio Output driver header file.
+ *
+ * @defgroup Driver Driver
+ * @ingroup GAUDOUT
+ * @{
+ */
+
+#ifndef _GAUDOUT_LLD_H
+#define _GAUDOUT_LLD_H
+
+#include "gfx.h"
+
+#if GFX_USE_GAUDOUT || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Type definitions                                                          */
+/*===========================================================================*/
+
+/**
+ * @brief				The structure passed to start an audio output
+ * @note				We use the structure instead of parameters purely to save
+ * 						interrupt stack space which is very limited in some platforms.
+ * @{
+ */
+typedef struct gaudout_params_t {
+	uint16_t		channel;
+	uint32_t		frequency;
+	audout_sample_t	*buffer;
+	size_t			bufcount;
+	size_t			samplesPerEvent;
+	} gaudout_params;
+/** @} */
+
+/**
+ * @brief				These routines are the callbacks that the driver uses.
+ * @details				Defined in the high level GAUDOUT code.
+ * @note				A DMA style driver calls GAUDOUT_ISR_NextI() twice when it starts so that it
+ * 						always has the following block ready. Each time a block finishes it calls
+ * 						GAUDOUT_ISR_CompleteI() and then asks for another block.
+ *
+ * @iclass
+ * @notapi
+ *
+ * @{
+ */
+
+/**
+ * @brief				Get the next block of samples to play
+ * @return				The number of conversions in the block. 0 means there is nothing to play
+ * 						(an underrun) and the driver should output silence and try again later.
+ *
+ * @param[out] pbuffer	Returns the start of the block
+ */
+extern size_t GAUDOUT_ISR_NextI(audout_sample_t **pbuffer);
+
+/**
+ * @param[in] buffer	The block that has finished playing
+ * @param[in] n			The number of conversions in the block
+ * @note				Blocks must be completed in the order they were fetched.
+ * */
+extern void GAUDOUT_ISR_CompleteI(audout_sample_t *buffer, size_t n);
+
+extern void GAUDOUT_ISR_ErrorI(void);
+/**
+ * @}
+ */
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief				Initialise the driver
+ *
+ * @param[in] paud		Initialisation parameters
+ *
+ * @api
+ */
+void gaudout_lld_init(const gaudout_params *paud);
+
+/**
+ * @brief				Start the audio output
+ *
+ * @api
+ */
+void gaudout_lld_start(void);
+
+/**
+ * @brief				Stop the audio output
+ * @note				The driver must not complete any more blocks once this returns.
+ * 						Blocks that were fetched but not completed are treated as played.
+ *
+ * @api
+ */
+void gaudout_lld_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GFX_USE_GAUDOUT */
+
+#endif /* _GAUDOUT_LLD_H */
+/** @} */
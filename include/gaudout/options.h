@@ -20,12 +20,34 @@
  * @name    GAUDOUT Functionality to be included
  * @{
  */
+	/**
+	 * @brief   Include the fixed point sound mixer.
+	 * @details	Defaults to FALSE
+	 */
+	#ifndef GAUDOUT_NEED_MIXER
+		#define GAUDOUT_NEED_MIXER			FALSE
+	#endif
 /**
  * @}
  *
  * @name    GAUDOUT Optional Sizing Parameters
  * @{
  */
+	/**
+	 * @brief   The number of sounds the mixer can play at once.
+	 * @details	Defaults to 4
+	 */
+	#ifndef GAUDOUT_MIXER_CHANNELS
+		#define GAUDOUT_MIXER_CHANNELS		4
+	#endif
+	/**
+	 * @brief   The number of samples the mixer works on at a time.
+	 * @details	Defaults to 64
+	 * @note	The mixer keeps a 32 bit accumulator and a 16 bit result of this size.
+	 */
+	#ifndef GAUDOUT_MIXER_BLOCK_SIZE
+		#define GAUDOUT_MIXER_BLOCK_SIZE	64
+	#endif
 /** @} */
 
 #endif /* _GAUDOUT_OPTIONS_H */
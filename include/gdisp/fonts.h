@@ -32,6 +32,43 @@
 	#error "GDISP: GDISP_MAX_FONT_HEIGHT must be either 16 or 32"
 #endif
 
+/**
+ * @brief   A range of characters in a sparse font.
+ * @note	The table is sorted by character so it can be binary searched.
+ */
+struct fontrange {
+	uint16_t			first;			/* The first character in the range */
+	uint16_t			last;			/* The last character in the range */
+	uint16_t			index;			/* The glyph index of the first character */
+};
+
+/**
+ * @brief   A kerning pair.
+ * @note	The table is sorted by left and then right character so it can be binary searched.
+ */
+struct fontkern {
+	uint16_t			left;
+	uint16_t			right;
+	int8_t				adjust;			/* Added to the gap between the two characters */
+};
+
+/**
+ * @brief   The anti-aliased glyph data for a font.
+ * @note	Each glyph is a full cell (its width by the font height) of coverage values
+ *			stored row-major as a stream of run bytes. Each run byte holds the coverage
+ *			in its low bitsPerPixel bits and one less than the run length in its
+ *			remaining bits. Runs continue from the end of one row onto the next.
+ *			A coverage of 0 is the background and (1 << bitsPerPixel) - 1 is solid.
+ * @note	These are generated from TrueType fonts by tools/mkfont.
+ */
+struct fontaa {
+	uint8_t					bitsPerPixel;	/* 2 or 4 */
+	uint16_t				kernCount;
+	const uint32_t			*glyphOffsets;	/* The offset of each glyphs runs */
+	const uint8_t			*glyphRuns;
+	const struct fontkern	*kernTable;
+};
+
 /**
  * @brief   Internal font structure.
  * @note	This structure is followed by:
@@ -40,6 +77,11 @@
  *				3. Each characters array of column data (fontcolumn_t)
  *			Each sub-structure must be padded to a multiple of 8 bytes
  *			to allow the tables to work across many different compilers.
+ * @note	An anti-aliased font sets aa and leaves offsetTable and dataTable empty.
+ *			Its xscale and yscale must be 1.
+ * @note	A font normally has a glyph for every character from minChar to maxChar.
+ *			A sparse font instead sets rangeTable to the ranges of characters it has
+ *			and the tables are then indexed by glyph rather than by character.
  */
 struct font {
 	const char *		name;
@@ -49,18 +91,52 @@ struct font {
 	uint8_t				descenderHeight;
 	uint8_t				minWidth;
 	uint8_t				maxWidth;
-	char				minChar;
-	char				maxChar;
+	uint8_t				minChar;
+	uint8_t				maxChar;
 	uint8_t				xscale;
 	uint8_t				yscale;
 	const uint8_t		*widthTable;
 	const uint16_t      *offsetTable;
 	const fontcolumn_t  *dataTable;
+	const struct fontaa	*aa;
+	uint16_t			rangeCount;
+	const struct fontrange	*rangeTable;
 };
 
-#define _getCharWidth(f,c)		(((c) < (f)->minChar || (c) > (f)->maxChar) ? 0 : (f)->widthTable[(c) - (f)->minChar])
-#define _getCharOffset(f,c)		((f)->offsetTable[(c) - (f)->minChar])
-#define _getCharData(f,c)		(&(f)->dataTable[_getCharOffset(f, c)])
+/* The character code as an unsigned value */
+#if GDISP_NEED_UTF8
+	#define _getCharCode(c)		((uint32_t)(c))
+#else
+	#define _getCharCode(c)		((uint32_t)(uint8_t)(c))
+#endif
+
+/* The glyph index of a character or -1 if the font doesn't have it */
+#define _getCharIndex(f,c)		((f)->rangeCount ? _gdispFindGlyph((f), (c)) :																\
+									(_getCharCode(c) < (f)->minChar || _getCharCode(c) > (f)->maxChar) ? -1 :	\
+									(int)(_getCharCode(c) - (f)->minChar))
+#define _getGlyphWidth(f,i)		((f)->widthTable[i])
+#define _getGlyphData(f,i)		(&(f)->dataTable[(f)->offsetTable[i]])
+#if GDISP_NEED_FONTLOAD
+	/* A font loaded from a file or stream has no glyphRuns and pages each glyph in when it is drawn */
+	#define _getGlyphRuns(f,i)	((f)->aa->glyphRuns ? &(f)->aa->glyphRuns[(f)->aa->glyphOffsets[i]] : _gdispPageGlyph((f), (i)))
+#else
+	#define _getGlyphRuns(f,i)	(&(f)->aa->glyphRuns[(f)->aa->glyphOffsets[i]])
+#endif
+
+int _gdispFindGlyph(font_t font, unicode_t c);
+const uint8_t *_gdispPageGlyph(font_t font, int glyph);
+
+static inline coord_t _getCharWidth(font_t font, unicode_t c) {
+	int		i;
+
+	i = _getCharIndex(font, c);
+	return i < 0 ? 0 : _getGlyphWidth(font, i);
+}
+#if GDISP_NEED_ANTIALIAS
+	#define _getCharKerning(f,l,r)	((f)->aa && (f)->aa->kernCount ? gdispGetCharKerning((l), (r), (f)) : 0)
+#else
+	#define _getCharKerning(f,l,r)	((void)(l), (void)(r), 0)
+#endif
 
 #endif /* _GDISP_FONTS_H */
 /** @} */
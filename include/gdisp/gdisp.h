@@ -62,6 +62,15 @@ typedef enum fontmetric {fontHeight, fontDescendersHeight, fontLineSpacing, font
  * @brief   The type of a font.
  */
 typedef const struct font *font_t;
+/**
+ * @brief   The type of a character code.
+ * @note	This is a Unicode code point if GDISP_NEED_UTF8 is TRUE, otherwise it is a char.
+ */
+#if GDISP_NEED_UTF8 || defined(__DOXYGEN__)
+	typedef uint32_t	unicode_t;
+#else
+	typedef char		unicode_t;
+#endif
 /**
  * @brief   Type for the screen orientation.
  */
@@ -71,6 +80,87 @@ typedef enum orientation {GDISP_ROTATE_0, GDISP_ROTATE_90, GDISP_ROTATE_180, GDI
  */
 typedef enum powermode {powerOff, powerSleep, powerDeepSleep, powerOn} gdisp_powermode_t;
 
+#if GDISP_NEED_TEXTLAYOUT || defined(__DOXYGEN__)
+	/**
+	 * @brief   A character in a text layout.
+	 */
+	typedef struct gdispTextGlyph_t {
+		coord_t		x;				/* Relative to the layout box */
+		coord_t		width;
+		unicode_t	c;
+		} gdispTextGlyph;
+
+	/**
+	 * @brief   A line in a text layout.
+	 */
+	typedef struct gdispTextLine_t {
+		coord_t		y;				/* Relative to the layout box */
+		unsigned	first;			/* The first glyph on the line */
+		unsigned	count;			/* The number of glyphs on the line */
+		} gdispTextLine;
+
+	/**
+	 * @brief   A text layout.
+	 * @details	Filled in by gdispLayoutText().
+	 */
+	typedef struct gdispTextLayout_t {
+		font_t			font;
+		coord_t			cx, cy;			/* The size of the box */
+		coord_t			width;			/* The width of the widest line */
+		coord_t			height;			/* The height of the lines */
+		unsigned		lineCount;
+		gdispTextLine	*lines;
+		gdispTextGlyph	*glyphs;
+		} gdispTextLayout;
+#endif
+
+#if GDISP_NEED_CLIPREGION || defined(__DOXYGEN__)
+	/**
+	 * @brief   A rectangle in a clip region.
+	 * @note	x1 and y1 are not inclusive.
+	 */
+	typedef struct GClipRect_t {
+		coord_t		x0, y0;
+		coord_t		x1, y1;
+		} GClipRect;
+
+	/**
+	 * @brief   A clip region.
+	 * @details	A short list of rectangles that do not overlap. Drawing is
+	 * 			limited to the area they cover.
+	 */
+	typedef struct GClipRegion_t {
+		unsigned	count;
+		GClipRect	rects[GDISP_CLIPREGION_RECTS];
+		} GClipRegion;
+#endif
+
+#if GDISP_NEED_STATS || defined(__DOXYGEN__)
+	/**
+	 * @brief   The operations counted by the driver statistics
+	 */
+	typedef enum gdispStatOp {
+		GDISP_STAT_CLEAR, GDISP_STAT_PIXEL, GDISP_STAT_LINE, GDISP_STAT_FILL, GDISP_STAT_BLIT,
+		GDISP_STAT_CIRCLE, GDISP_STAT_FILLCIRCLE, GDISP_STAT_ELLIPSE, GDISP_STAT_FILLELLIPSE,
+		GDISP_STAT_ARC, GDISP_STAT_FILLARC, GDISP_STAT_CHAR, GDISP_STAT_FILLCHAR,
+		GDISP_STAT_PIXELREAD, GDISP_STAT_SCROLL, GDISP_STAT_CONTROL, GDISP_STAT_QUERY, GDISP_STAT_CLIP,
+		GDISP_STAT_COUNT
+		} gdispStatOp;
+
+	/**
+	 * @brief   The driver statistics
+	 * @note	Times are in performance clock units (see gmiscPerfToMicroseconds()).
+	 */
+	typedef struct GDispStats_t {
+		uint32_t	calls[GDISP_STAT_COUNT];	/* Calls to the driver for each operation */
+		uint32_t	pixels;						/* The area of the clears, pixels, lines, fills, blits and scrolls */
+		perftime_t	lldtime;					/* Time spent in the driver */
+		perftime_t	locktime;					/* Time the display lock was held (multi-thread and async only) */
+		perftime_t	lockwait;					/* Time spent waiting for the display lock */
+		uint16_t	queuemax;					/* The deepest the async queue has been */
+		} GDispStats;
+#endif
+
 /*
  * This is not documented in Doxygen as it is meant to be a black-box.
  * Applications should always use the routines and macros defined
@@ -87,6 +177,9 @@ typedef struct GDISPDriver_t {
 			coord_t				clipx0, clipy0;
 			coord_t				clipx1, clipy1;		/* not inclusive */
 		#endif
+		#if GDISP_NEED_CLIPREGION
+			const GClipRegion	*region;			/* NULL for no clip region */
+		#endif
 		} GDISPDriver;
 
 extern GDISPDriver	GDISP;
@@ -287,11 +380,136 @@ extern GDISPDriver	GDISP;
 	#error "GDISP: Pixel read-back is wanted but not supported."
 #endif
 
+#if GDISP_NEED_ALPHA && GDISP_PACKED_PIXELS
+	#error "GDISP: Alpha blending is not supported for packed pixel formats."
+#endif
+
+#if GDISP_NEED_ALPHA && GDISP_NEED_ASYNC
+	#error "GDISP: GDISP_NEED_ALPHA is not supported with GDISP_NEED_ASYNC."
+#endif
+
 /**
  * @brief   The type of a pixel.
  */
 typedef color_t		pixel_t;
 
+#if GDISP_NEED_MULTIPLE_DISPLAYS || defined(__DOXYGEN__)
+	#if GDISP_NEED_ASYNC
+		#error "GDISP: GDISP_NEED_MULTIPLE_DISPLAYS is not supported with GDISP_NEED_ASYNC."
+	#endif
+
+	/*
+	 * The low level driver entry points for a display.
+	 * Like the GDISPDriver structure this is meant to be a black-box.
+	 * It is filled in by GDISP_VMT_INIT using whatever gdisp_lld_xxx()
+	 * routines and GDISP structure are visible where it is used.
+	 */
+	typedef struct GDISPVMT_t {
+		GDISPDriver	*state;
+		bool_t		(*init)(void);
+		void		(*clear)(color_t color);
+		void		(*draw_pixel)(coord_t x, coord_t y, color_t color);
+		void		(*fill_area)(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
+		void		(*blit_area_ex)(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer);
+		void		(*draw_line)(coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color);
+		#if GDISP_NEED_CIRCLE
+			void	(*draw_circle)(coord_t x, coord_t y, coord_t radius, color_t color);
+			void	(*fill_circle)(coord_t x, coord_t y, coord_t radius, color_t color);
+		#endif
+		#if GDISP_NEED_ELLIPSE
+			void	(*draw_ellipse)(coord_t x, coord_t y, coord_t a, coord_t b, color_t color);
+			void	(*fill_ellipse)(coord_t x, coord_t y, coord_t a, coord_t b, color_t color);
+		#endif
+		#if GDISP_NEED_ARC
+			void	(*draw_arc)(coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle, color_t color);
+			void	(*fill_arc)(coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle, color_t color);
+		#endif
+		#if GDISP_NEED_TEXT
+			void	(*draw_char)(coord_t x, coord_t y, unicode_t c, font_t font, color_t color);
+			void	(*fill_char)(coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor);
+		#endif
+		#if GDISP_NEED_PIXELREAD
+			color_t	(*get_pixel_color)(coord_t x, coord_t y);
+		#endif
+		#if GDISP_NEED_SCROLL
+			void	(*vertical_scroll)(coord_t x, coord_t y, coord_t cx, coord_t cy, int lines, color_t bgcolor);
+		#endif
+		#if GDISP_NEED_CONTROL
+			void	(*control)(unsigned what, void *value);
+		#endif
+		#if GDISP_NEED_QUERY
+			void *	(*query)(unsigned what);
+		#endif
+		#if GDISP_NEED_CLIP
+			void	(*set_clip)(coord_t x, coord_t y, coord_t cx, coord_t cy);
+		#endif
+		} GDISPVMT;
+
+	#if GDISP_NEED_CIRCLE
+		#define _GDISP_VMT_CIRCLE		, gdisp_lld_draw_circle, gdisp_lld_fill_circle
+	#else
+		#define _GDISP_VMT_CIRCLE
+	#endif
+	#if GDISP_NEED_ELLIPSE
+		#define _GDISP_VMT_ELLIPSE		, gdisp_lld_draw_ellipse, gdisp_lld_fill_ellipse
+	#else
+		#define _GDISP_VMT_ELLIPSE
+	#endif
+	#if GDISP_NEED_ARC
+		#define _GDISP_VMT_ARC			, gdisp_lld_draw_arc, gdisp_lld_fill_arc
+	#else
+		#define _GDISP_VMT_ARC
+	#endif
+	#if GDISP_NEED_TEXT
+		#define _GDISP_VMT_TEXT			, gdisp_lld_draw_char, gdisp_lld_fill_char
+	#else
+		#define _GDISP_VMT_TEXT
+	#endif
+	#if GDISP_NEED_PIXELREAD
+		#define _GDISP_VMT_PIXELREAD	, gdisp_lld_get_pixel_color
+	#else
+		#define _GDISP_VMT_PIXELREAD
+	#endif
+	#if GDISP_NEED_SCROLL
+		#define _GDISP_VMT_SCROLL		, gdisp_lld_vertical_scroll
+	#else
+		#define _GDISP_VMT_SCROLL
+	#endif
+	#if GDISP_NEED_CONTROL
+		#define _GDISP_VMT_CONTROL		, gdisp_lld_control
+	#else
+		#define _GDISP_VMT_CONTROL
+	#endif
+	#if GDISP_NEED_QUERY
+		#define _GDISP_VMT_QUERY		, gdisp_lld_query
+	#else
+		#define _GDISP_VMT_QUERY
+	#endif
+	#if GDISP_NEED_CLIP
+		#define _GDISP_VMT_CLIP			, gdisp_lld_set_clip
+	#else
+		#define _GDISP_VMT_CLIP
+	#endif
+
+	/* The initialiser for a GDISPVMT - see include/gdisp/lld/display.c */
+	#define GDISP_VMT_INIT		{ &GDISP, gdisp_lld_init, gdisp_lld_clear, gdisp_lld_region_draw_pixel,		\
+									gdisp_lld_region_fill_area, gdisp_lld_region_blit_area_ex, gdisp_lld_draw_line	\
+									_GDISP_VMT_CIRCLE _GDISP_VMT_ELLIPSE _GDISP_VMT_ARC _GDISP_VMT_TEXT			\
+									_GDISP_VMT_PIXELREAD _GDISP_VMT_SCROLL _GDISP_VMT_CONTROL _GDISP_VMT_QUERY	\
+									_GDISP_VMT_CLIP }
+
+	/**
+	 * @brief   A handle for a display.
+	 * @note	Display 0 is the display driven by the normal gdispXXX() calls.
+	 */
+	typedef struct GDisplay_t {
+		const GDISPVMT		*vmt;
+		#if GDISP_NEED_MULTITHREAD
+			gfxMutex		mutex;		/* Each display has its own lock */
+		#endif
+		} GDisplay;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -487,7 +705,7 @@ extern "C" {
 		 *
 		 * @api
 		 */
-		void gdispDrawChar(coord_t x, coord_t y, char c, font_t font, color_t color);
+		void gdispDrawChar(coord_t x, coord_t y, unicode_t c, font_t font, color_t color);
 
 		/**
 		 * @brief   Draw a text character with a filled background.
@@ -500,7 +718,7 @@ extern "C" {
 		 *
 		 * @api
 		 */
-		void gdispFillChar(coord_t x, coord_t y, char c, font_t font, color_t color, color_t bgcolor);
+		void gdispFillChar(coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor);
 	#endif
 	
 	/* Read a pixel Function */
@@ -572,13 +790,15 @@ extern "C" {
 	#include "gdisp/lld/gdisp_lld.h"
 
 	/* The same as above but use the low level driver directly if no multi-thread support is needed */
-	#define _gdispInit(gdisp)									gdisp_lld_init()
+	#if !GDISP_NEED_MULTIPLE_DISPLAYS
+		#define _gdispInit(gdisp)								gdisp_lld_init()
+	#endif
 	#define gdispIsBusy()										FALSE
 	#define gdispClear(color)									gdisp_lld_clear(color)
-	#define gdispDrawPixel(x, y, color)							gdisp_lld_draw_pixel(x, y, color)
+	#define gdispDrawPixel(x, y, color)							gdisp_lld_region_draw_pixel(x, y, color)
 	#define gdispDrawLine(x0, y0, x1, y1, color)				gdisp_lld_draw_line(x0, y0, x1, y1, color)
-	#define gdispFillArea(x, y, cx, cy, color)					gdisp_lld_fill_area(x, y, cx, cy, color)
-	#define gdispBlitAreaEx(x, y, cx, cy, sx, sy, scx, buf)		gdisp_lld_blit_area_ex(x, y, cx, cy, sx, sy, scx, buf)
+	#define gdispFillArea(x, y, cx, cy, color)					gdisp_lld_region_fill_area(x, y, cx, cy, color)
+	#define gdispBlitAreaEx(x, y, cx, cy, sx, sy, scx, buf)		gdisp_lld_region_blit_area_ex(x, y, cx, cy, sx, sy, scx, buf)
 	#define gdispSetClip(x, y, cx, cy)							gdisp_lld_set_clip(x, y, cx, cy)
 	#define gdispDrawCircle(x, y, radius, color)				gdisp_lld_draw_circle(x, y, radius, color)
 	#define gdispFillCircle(x, y, radius, color)				gdisp_lld_fill_circle(x, y, radius, color)
@@ -612,6 +832,104 @@ extern "C" {
  */
 void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
 
+#if GDISP_NEED_STYLEDLINE || defined(__DOXYGEN__)
+	/**
+	 * @brief   Draw a dashed, dotted and/or thick line.
+	 * @details	The line is broken into runs of pixels which are sent to the
+	 * 			driver as area fills rather than as individual pixels. With
+	 * 			GDISP_NEED_MULTITHREAD the whole line is drawn under a single lock.
+	 *
+	 * @param[in] x0,y0		The start position
+	 * @param[in] x1,y1 	The end position
+	 * @param[in] thickness	The width of the line in pixels (1 or more)
+	 * @param[in] dashon	The number of pixels drawn in each dash
+	 * @param[in] dashoff	The number of pixels skipped between each dash
+	 * @param[in] color		The color to use
+	 *
+	 * @note	If either dashon or dashoff is 0 a solid line is drawn.
+	 * @note	A dotted line is simply a dashon of 1.
+	 * @note	Thick lines are widened perpendicular to their major axis and
+	 * 			centered on the line.
+	 *
+	 * @api
+	 */
+	void gdispDrawStyledLine(coord_t x0, coord_t y0, coord_t x1, coord_t y1, coord_t thickness, coord_t dashon, coord_t dashoff, color_t color);
+#endif
+
+#if GDISP_NEED_ALPHA || GDISP_NEED_ANTIALIAS || defined(__DOXYGEN__)
+	/**
+	 * @brief   Blend two colors.
+	 * @return	The blended color
+	 *
+	 * @param[in] fg		The foreground color
+	 * @param[in] bg		The background color
+	 * @param[in] alpha		The opacity of the foreground (0 = transparent, 255 = opaque)
+	 *
+	 * @api
+	 */
+	color_t gdispBlendColor(color_t fg, color_t bg, uint8_t alpha);
+#endif
+
+#if GDISP_NEED_ALPHA || defined(__DOXYGEN__)
+	/**
+	 * @brief   Fill an area with a translucent color.
+	 *
+	 * @param[in] x,y		The start filled area
+	 * @param[in] cx,cy		The width and height to be filled
+	 * @param[in] color		The color to use
+	 * @param[in] alpha		The opacity of the color (0 = transparent, 255 = opaque)
+	 *
+	 * @note	The display is read back using the pixel read driver call
+	 * 			so this is much slower than gdispFillArea().
+	 *
+	 * @api
+	 */
+	void gdispFillAreaAlpha(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color, uint8_t alpha);
+
+	/**
+	 * @brief   Fill an area using a bitmap that is blended with the display.
+	 *
+	 * @param[in] x,y		The start filled area
+	 * @param[in] cx,cy		The width and height to be filled
+	 * @param[in] srcx,srcy	The bitmap position to start the fill from
+	 * @param[in] srccx		The width of a line in the bitmap
+	 * @param[in] buffer	The bitmap in the driver's pixel format
+	 * @param[in] alpha		The opacity of the bitmap (0 = transparent, 255 = opaque)
+	 *
+	 * @api
+	 */
+	void gdispBlitAreaAlphaEx(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer, uint8_t alpha);
+
+	/**
+	 * @brief   Fill an area using a bitmap with an alpha channel.
+	 *
+	 * @param[in] x,y		The start filled area
+	 * @param[in] cx,cy		The width and height to be filled
+	 * @param[in] srcx,srcy	The bitmap position to start the fill from
+	 * @param[in] srccx		The width of a line in the bitmap
+	 * @param[in] buffer	The bitmap as 32 bit 0xAARRGGBB pixels
+	 *
+	 * @note	Runs of fully opaque pixels are drawn without reading back the display.
+	 *
+	 * @api
+	 */
+	void gdispBlitAreaARGBEx(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const uint32_t *buffer);
+
+	/**
+	 * @brief   Blend a whole bitmap with the display.
+	 *
+	 * @api
+	 */
+	#define gdispBlitAreaAlpha(x, y, cx, cy, buffer, alpha)		gdispBlitAreaAlphaEx(x, y, cx, cy, 0, 0, cx, buffer, alpha)
+
+	/**
+	 * @brief   Draw a whole bitmap with an alpha channel.
+	 *
+	 * @api
+	 */
+	#define gdispBlitAreaARGB(x, y, cx, cy, buffer)				gdispBlitAreaARGBEx(x, y, cx, cy, 0, 0, cx, buffer)
+#endif
+
 #if GDISP_NEED_CONVEX_POLYGON || defined(__DOXYGEN__)
 	/**
 	 * @brief   Draw an enclosed polygon (convex, non-convex or complex).
@@ -725,7 +1043,20 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
 	 *
 	 * @api
 	 */
-	coord_t gdispGetCharWidth(char c, font_t font);
+	coord_t gdispGetCharWidth(unicode_t c, font_t font);
+
+	/**
+	 * @brief   Get the kerning adjustment between two characters.
+	 * @return  The number of pixels to add to the gap between the characters.
+	 * 			This is usually negative and is always 0 for a font without kerning.
+	 *
+	 * @param[in] left    The first character
+	 * @param[in] right   The character that follows it
+	 * @param[in] font    The font to use
+	 *
+	 * @api
+	 */
+	coord_t gdispGetCharKerning(unicode_t left, unicode_t right, font_t font);
 
 	/**
 	 * @brief   Get the pixel width of a string.
@@ -746,6 +1077,8 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
 	 * @param[in] name		The font name to find.
 	 *
 	 * @note				Wildcard matching will match the shortest possible match.
+	 * @note				A name without a '*' is looked up by its hash rather than by
+	 *						searching every registered font.
 	 *
 	 * @api
 	 */
@@ -753,6 +1086,8 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
 
 	/**
 	 * @brief	Release a font after use.
+	 * @details	A loaded font is freed when it has been closed as many times as it was
+	 *			loaded and opened. Other fonts are unaffected.
 	 *
 	 * @param[in] font		The font to release.
 	 *
@@ -760,6 +1095,71 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
 	 */
 	void gdispCloseFont(font_t font);
 
+	/**
+	 * @brief	Add a font to the registry so that gdispOpenFont() can find it.
+	 * @return	TRUE if the font is now registered or FALSE if the registry is full.
+	 *
+	 * @param[in] font		The font to add. It must remain valid for as long as the program runs.
+	 *
+	 * @note				The built-in fonts are added automatically. This is for fonts
+	 *						generated by mkfont and compiled into the program.
+	 * @note				If two registered fonts have the same name the one added last is found.
+	 * @note				The registry size is set by GDISP_FONT_REGISTRY_SIZE.
+	 *
+	 * @api
+	 */
+	bool_t gdispAddFont(font_t font);
+
+	#if GDISP_NEED_FONTLOAD || defined(__DOXYGEN__)
+		/**
+		 * @brief	Load a font from a font file image in memory.
+		 * @return	The font or NULL if it could not be loaded.
+		 *
+		 * @param[in] memfont	A pointer to the font file image (as written by mkfont -x).
+		 *
+		 * @note				The memory must remain valid until the font is closed.
+		 *						The glyphs are drawn directly from it so it can be in flash.
+		 * @note				The font is added to the registry and must be released
+		 *						with gdispCloseFont().
+		 *
+		 * @api
+		 */
+		font_t gdispLoadFontMemory(const void *memfont);
+
+		#if GFX_USE_OS_CHIBIOS || defined(__DOXYGEN__)
+			/**
+			 * @brief	Load a font from a ChibiOS BaseFileStream.
+			 * @return	The font or NULL if it could not be loaded.
+			 *
+			 * @param[in] BaseFileStreamPtr	A pointer to an open BaseFileStream.
+			 *
+			 * @note				Only the font tables are read into RAM. Each glyph is read from the
+			 *						stream when it is first drawn and GDISP_FONT_CACHE_GLYPHS of them
+			 *						are kept in RAM.
+			 * @note				The stream is closed when the font is closed or if it could not be loaded.
+			 * @note				A font loaded this way must not be drawn on two displays at the same time.
+			 *
+			 * @api
+			 */
+			font_t gdispLoadFontBaseFileStream(void *BaseFileStreamPtr);
+		#endif
+
+		#if defined(WIN32) || GFX_USE_OS_WIN32 || GFX_USE_OS_POSIX || defined(__DOXYGEN__)
+			/**
+			 * @brief	Load a font from a file on the host operating system's file system.
+			 * @return	The font or NULL if it could not be loaded.
+			 *
+			 * @param[in] filename	The filename to open.
+			 *
+			 * @note				Glyphs are read from the file as they are needed in the same
+			 *						way as gdispLoadFontBaseFileStream().
+			 *
+			 * @api
+			 */
+			font_t gdispLoadFontFile(const char *filename);
+		#endif
+	#endif
+
 	/**
 	 * @brief	Get the name of the specified font.
 	 * @returns	The name of the font.
@@ -771,6 +1171,64 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
 	const char *gdispGetFontName(font_t font);
 #endif
 
+/* Text Layout Functions */
+
+#if GDISP_NEED_TEXTLAYOUT || defined(__DOXYGEN__)
+	/**
+	 * @brief   Lay out a string in a box so that it can be drawn many times.
+	 * @details	The string is measured, split into lines and justified once.
+	 *			Drawing the layout then just draws each character at its position.
+	 * @return	FALSE if there is not enough memory for the layout.
+	 *
+	 * @param[out] pl		The layout to fill in
+	 * @param[in] str		The string to lay out. It is not needed after this call.
+	 * @param[in] font		The font to use
+	 * @param[in] cx,cy		The size of the box
+	 * @param[in] justify	Justify each line left, center or right within the box
+	 * @param[in] wordwrap	Break lines between words to fit the box. Lines are
+	 *						otherwise only broken at a '\n'.
+	 *
+	 * @note	The lines are centered vertically in the box. Characters and lines that
+	 *			do not fit in the box are left out the same way as gdispDrawStringBox().
+	 * @note	A layout must be freed with gdispFreeTextLayout() before it is reused.
+	 *
+	 * @api
+	 */
+	bool_t gdispLayoutText(gdispTextLayout *pl, const char *str, font_t font, coord_t cx, coord_t cy, justify_t justify, bool_t wordwrap);
+
+	/**
+	 * @brief   Free the memory used by a text layout.
+	 *
+	 * @param[in] pl		The layout
+	 *
+	 * @api
+	 */
+	void gdispFreeTextLayout(gdispTextLayout *pl);
+
+	/**
+	 * @brief   Draw a text layout.
+	 *
+	 * @param[in] x,y		The top left corner of the box
+	 * @param[in] pl		The layout
+	 * @param[in] color		The color to use
+	 *
+	 * @api
+	 */
+	void gdispDrawTextLayout(coord_t x, coord_t y, const gdispTextLayout *pl, color_t color);
+
+	/**
+	 * @brief   Draw a text layout and fill the rest of its box with the background color.
+	 *
+	 * @param[in] x,y		The top left corner of the box
+	 * @param[in] pl		The layout
+	 * @param[in] color		The color to use
+	 * @param[in] bgcolor	The background color to use
+	 *
+	 * @api
+	 */
+	void gdispFillTextLayout(coord_t x, coord_t y, const gdispTextLayout *pl, color_t color, color_t bgcolor);
+#endif
+
 /* Extra Arc Functions */
 
 #if GDISP_NEED_ARC || defined(__DOXYGEN__)
@@ -919,6 +1377,185 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
  */
 #define gdispUnsetClip()						gdispSetClip(0,0,gdispGetWidth(),gdispGetHeight())
 
+#if GDISP_NEED_CLIPREGION || defined(__DOXYGEN__)
+	/**
+	 * @brief   Initialise a clip region to a single rectangle.
+	 *
+	 * @param[in] pr		The region to initialise
+	 * @param[in] x,y		The start position
+	 * @param[in] cx,cy		The size. If either is zero the region is empty.
+	 *
+	 * @api
+	 */
+	void gdispClipRegionInit(GClipRegion *pr, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
+	/**
+	 * @brief   Add a rectangle to a clip region.
+	 * @return	FALSE if the result needs more than GDISP_CLIPREGION_RECTS rectangles.
+	 * 			The region is then left unchanged.
+	 *
+	 * @param[in] pr		The region
+	 * @param[in] x,y		The start position
+	 * @param[in] cx,cy		The size
+	 *
+	 * @note	Any part of the region already covered by the rectangle is removed
+	 * 			first so the rectangles never overlap.
+	 *
+	 * @api
+	 */
+	bool_t gdispClipRegionAdd(GClipRegion *pr, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
+	/**
+	 * @brief   Remove a rectangle from a clip region.
+	 * @return	FALSE if the result needs more than GDISP_CLIPREGION_RECTS rectangles.
+	 * 			The region is then left unchanged.
+	 *
+	 * @param[in] pr		The region
+	 * @param[in] x,y		The start position
+	 * @param[in] cx,cy		The size
+	 *
+	 * @note	This is how to get the visible part of a window - start with the
+	 * 			window's rectangle and subtract each window that overlaps it.
+	 *
+	 * @api
+	 */
+	bool_t gdispClipRegionSubtract(GClipRegion *pr, coord_t x, coord_t y, coord_t cx, coord_t cy);
+
+	/**
+	 * @brief   Limit all drawing to a clip region.
+	 * @details	Each operation is drawn in a single pass with the pixels, spans and
+	 * 			blits it produces split across the rectangles of the region.
+	 * 			The region applies as well as the clip rectangle set by gdispSetClip().
+	 *
+	 * @param[in] pr		The region or NULL to stop using a region.
+	 *
+	 * @note	The region is not copied. It must not be changed or go out of scope
+	 * 			while it is being used.
+	 * @note	gdispClear() and gdispVerticalScroll() ignore the region. A driver that
+	 * 			accelerates lines, circles, ellipses, arcs or text in hardware must
+	 * 			use the region itself.
+	 *
+	 * @api
+	 */
+	void gdispSetClipRegion(const GClipRegion *pr);
+#endif
+
+#if GDISP_NEED_STATS || defined(__DOXYGEN__)
+	/**
+	 * @brief   Get a copy of the driver statistics
+	 *
+	 * @param[out] pstats	Where to put them
+	 *
+	 * @note	The counters are updated without any locking so a copy taken
+	 * 			while another thread is drawing may be slightly inconsistent.
+	 * @note	Each call to the driver is also recorded in the trace buffer if
+	 * 			GMISC_NEED_TRACE is TRUE.
+	 *
+	 * @api
+	 */
+	void gdispGetStats(GDispStats *pstats);
+
+	/**
+	 * @brief   Set all the driver statistics back to zero
+	 *
+	 * @api
+	 */
+	void gdispResetStats(void);
+#endif
+
+#if GDISP_NEED_MULTIPLE_DISPLAYS || defined(__DOXYGEN__)
+	/**
+	 * @brief   Attach an extra display.
+	 * @return	The handle for the display or NULL if it could not be initialised
+	 * 			or there are already GDISP_TOTAL_DISPLAYS displays.
+	 *
+	 * @param[in] vmt		The driver table for the display. This is declared
+	 * 						by compiling the driver using include/gdisp/lld/display.c
+	 *
+	 * @note	The main display (display 0) is attached automatically by gfxInit().
+	 * @note	Displays should be attached before any other thread starts using them.
+	 *
+	 * @api
+	 */
+	GDisplay *gdispAttachDisplay(const GDISPVMT *vmt);
+
+	/**
+	 * @brief   Get the handle for a display.
+	 * @return	The display handle or NULL if there is no such display.
+	 *
+	 * @param[in] display	The display number. 0 is the main display.
+	 *
+	 * @api
+	 */
+	GDisplay *gdispGetDisplay(unsigned display);
+
+	/*
+	 * The same as the gdispXXX() routines above but drawing on the
+	 * specified display. Each display has its own lock so drawing on
+	 * one display never has to wait for drawing on another.
+	 */
+	bool_t gdispGIsBusy(GDisplay *g);
+	void gdispGClear(GDisplay *g, color_t color);
+	void gdispGDrawPixel(GDisplay *g, coord_t x, coord_t y, color_t color);
+	void gdispGDrawLine(GDisplay *g, coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color);
+	void gdispGFillArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
+	void gdispGBlitAreaEx(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer);
+	void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
+	#if GDISP_NEED_CLIP
+		void gdispGSetClip(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy);
+	#endif
+	#if GDISP_NEED_CLIPREGION
+		void gdispGSetClipRegion(GDisplay *g, const GClipRegion *pr);
+	#endif
+	#if GDISP_NEED_CIRCLE
+		void gdispGDrawCircle(GDisplay *g, coord_t x, coord_t y, coord_t radius, color_t color);
+		void gdispGFillCircle(GDisplay *g, coord_t x, coord_t y, coord_t radius, color_t color);
+	#endif
+	#if GDISP_NEED_ELLIPSE
+		void gdispGDrawEllipse(GDisplay *g, coord_t x, coord_t y, coord_t a, coord_t b, color_t color);
+		void gdispGFillEllipse(GDisplay *g, coord_t x, coord_t y, coord_t a, coord_t b, color_t color);
+	#endif
+	#if GDISP_NEED_ARC
+		void gdispGDrawArc(GDisplay *g, coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle, color_t color);
+		void gdispGFillArc(GDisplay *g, coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle, color_t color);
+	#endif
+	#if GDISP_NEED_TEXT
+		void gdispGDrawChar(GDisplay *g, coord_t x, coord_t y, unicode_t c, font_t font, color_t color);
+		void gdispGFillChar(GDisplay *g, coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor);
+		void gdispGDrawString(GDisplay *g, coord_t x, coord_t y, const char *str, font_t font, color_t color);
+		void gdispGFillString(GDisplay *g, coord_t x, coord_t y, const char *str, font_t font, color_t color, color_t bgcolor);
+	#endif
+	#if GDISP_NEED_TEXTLAYOUT
+		void gdispGDrawTextLayout(GDisplay *g, coord_t x, coord_t y, const gdispTextLayout *pl, color_t color);
+		void gdispGFillTextLayout(GDisplay *g, coord_t x, coord_t y, const gdispTextLayout *pl, color_t color, color_t bgcolor);
+	#endif
+	#if GDISP_NEED_PIXELREAD
+		color_t gdispGGetPixelColor(GDisplay *g, coord_t x, coord_t y);
+	#endif
+	#if GDISP_NEED_SCROLL
+		void gdispGVerticalScroll(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, int lines, color_t bgcolor);
+	#endif
+	#if GDISP_NEED_CONTROL
+		void gdispGControl(GDisplay *g, unsigned what, void *value);
+	#endif
+	#if GDISP_NEED_QUERY
+		void *gdispGQuery(GDisplay *g, unsigned what);
+	#endif
+
+	#define gdispGBlitArea(g, x, y, cx, cy, buffer)		gdispGBlitAreaEx(g, x, y, cx, cy, 0, 0, cx, buffer)
+	#define gdispGSetPowerMode(g, powerMode)			gdispGControl(g, GDISP_CONTROL_POWER, (void *)(unsigned)(powerMode))
+	#define gdispGSetOrientation(g, newOrientation)		gdispGControl(g, GDISP_CONTROL_ORIENTATION, (void *)(unsigned)(newOrientation))
+	#define gdispGSetBacklight(g, percent)				gdispGControl(g, GDISP_CONTROL_BACKLIGHT, (void *)(unsigned)(percent))
+	#define gdispGSetContrast(g, percent)				gdispGControl(g, GDISP_CONTROL_CONTRAST, (void *)(unsigned)(percent))
+	#define gdispGGetWidth(g)							((g)->vmt->state->Width)
+	#define gdispGGetHeight(g)							((g)->vmt->state->Height)
+	#define gdispGGetPowerMode(g)						((g)->vmt->state->Powermode)
+	#define gdispGGetOrientation(g)						((g)->vmt->state->Orientation)
+	#define gdispGGetBacklight(g)						((g)->vmt->state->Backlight)
+	#define gdispGGetContrast(g)						((g)->vmt->state->Contrast)
+	#define gdispGUnsetClip(g)							gdispGSetClip(g, 0, 0, gdispGGetWidth(g), gdispGGetHeight(g))
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -129,6 +129,26 @@ extern "C" {
 	 */
 	bool_t gdispImageSetMemoryReader(gdispImage *img, const void *memimage);
 
+	#if GDISP_NEED_IMAGE_COMPRESSED || defined(__DOXYGEN__)
+		/**
+		 * @brief	Sets the io fields in the image structure to routines
+		 * 			that support reading from an image compressed by file2c -z
+		 * 			stored in RAM or Flash.
+		 *
+		 * @return	TRUE if the IO open function succeeds
+		 *
+		 * @param[in] img   	The image structure
+		 * @param[in] memimage	A pointer to the compressed image in RAM or Flash
+		 *
+		 * @note	Decompression needs a buffer the size of the window the image was
+		 * 			compressed with (file2c -w). It is freed when the image is closed.
+		 * @note	Reading forward and seeking back within the window are cheap. Seeking
+		 * 			back any further decompresses the image again from the start.
+		 * @note	Returns FALSE if this is not a compressed image or there is no memory.
+		 */
+		bool_t gdispImageSetCompressedMemoryReader(gdispImage *img, const void *memimage);
+	#endif
+
 	#if GFX_USE_OS_CHIBIOS || defined(__DOXYGEN__)
 		/**
 		 * @brief	Sets the io fields in the image structure to routines
@@ -0,0 +1,158 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file	include/gdisp/lld/display.c
+ * @brief	GDISP support for compiling a low level driver as an extra display.
+ *
+ * @addtogroup GDISP
+ *
+ * @details	Create a source file for each extra display that looks something like...
+ * @code
+ *		#include "gfx.h"
+ *
+ *		#define GDISP_DISPLAY_NAME		oled
+ *		#define GDISP_DISPLAY_CONFIG	"drivers/gdisp/Nokia6610GE8/gdisp_lld_config.h"
+ *		#define GDISP_DISPLAY_DRIVER	"drivers/gdisp/Nokia6610GE8/gdisp_lld.c"
+ *		#include "gdisp/lld/display.c"
+ * @endcode
+ *			This compiles the driver with its gdisp_lld_xxx() routines renamed to
+ *			oled_lld_xxx() and its GDISP structure renamed to oled_GDISP. It then
+ *			declares the driver table GDISPVMT_oled which the application passes
+ *			to gdispAttachDisplay().
+ *
+ * @note	GDISP_DISPLAY_WIDTH and GDISP_DISPLAY_HEIGHT can be defined to
+ *			set GDISP_SCREEN_WIDTH and GDISP_SCREEN_HEIGHT for this driver.
+ * @note	The driver must use the same pixel format as the main display.
+ * @note	Only one display can be declared in each source file.
+ *
+ * @{
+ */
+#ifndef GDISP_DISPLAY_C
+#define GDISP_DISPLAY_C
+
+#if GFX_USE_GDISP && GDISP_NEED_MULTIPLE_DISPLAYS
+
+#if !defined(GDISP_DISPLAY_NAME) || !defined(GDISP_DISPLAY_CONFIG) || !defined(GDISP_DISPLAY_DRIVER)
+	#error "GDISP: GDISP_DISPLAY_NAME, GDISP_DISPLAY_CONFIG and GDISP_DISPLAY_DRIVER must be defined to declare a display"
+#endif
+
+/* Remember the pixel format of the main display */
+#if GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_MONO
+	#define GDISP_MAIN_PIXELFORMAT		GDISP_PIXELFORMAT_MONO
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB565
+	#define GDISP_MAIN_PIXELFORMAT		GDISP_PIXELFORMAT_RGB565
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB888
+	#define GDISP_MAIN_PIXELFORMAT		GDISP_PIXELFORMAT_RGB888
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB444
+	#define GDISP_MAIN_PIXELFORMAT		GDISP_PIXELFORMAT_RGB444
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB332
+	#define GDISP_MAIN_PIXELFORMAT		GDISP_PIXELFORMAT_RGB332
+#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB666
+	#define GDISP_MAIN_PIXELFORMAT		GDISP_PIXELFORMAT_RGB666
+#else
+	#define GDISP_MAIN_PIXELFORMAT		GDISP_PIXELFORMAT_CUSTOM
+#endif
+
+/* Forget everything the main display's driver configuration told us */
+#undef _GDISP_LLD_CONFIG_H
+#undef GDISP_LLD_CONFIG_H
+#undef _GDISP_LLD_H
+#undef GDISP_DRIVER_NAME
+#undef GDISP_HARDWARE_LINES
+#undef GDISP_HARDWARE_CLEARS
+#undef GDISP_HARDWARE_FILLS
+#undef GDISP_HARDWARE_BITFILLS
+#undef GDISP_HARDWARE_CIRCLES
+#undef GDISP_HARDWARE_CIRCLEFILLS
+#undef GDISP_HARDWARE_ELLIPSES
+#undef GDISP_HARDWARE_ELLIPSEFILLS
+#undef GDISP_HARDWARE_ARCS
+#undef GDISP_HARDWARE_ARCFILLS
+#undef GDISP_HARDWARE_TEXT
+#undef GDISP_HARDWARE_TEXTFILLS
+#undef GDISP_HARDWARE_SCROLL
+#undef GDISP_HARDWARE_PIXELREAD
+#undef GDISP_HARDWARE_CONTROL
+#undef GDISP_HARDWARE_QUERY
+#undef GDISP_HARDWARE_CLIP
+#undef GDISP_SOFTWARE_TEXTFILLDRAW
+#undef GDISP_SOFTWARE_TEXTBLITCOLUMN
+#undef GDISP_SOFTWARE_ORIENTATION
+#undef GDISP_PIXELFORMAT
+#undef GDISP_PACKED_PIXELS
+#undef GDISP_PACKED_LINES
+#undef GDISP_SCREEN_WIDTH
+#undef GDISP_SCREEN_HEIGHT
+#ifdef GDISP_DISPLAY_WIDTH
+	#define GDISP_SCREEN_WIDTH		GDISP_DISPLAY_WIDTH
+#endif
+#ifdef GDISP_DISPLAY_HEIGHT
+	#define GDISP_SCREEN_HEIGHT		GDISP_DISPLAY_HEIGHT
+#endif
+
+/* Rename everything the driver exports */
+#define _GDISP_DISPLAY_CAT2(a, b)	a##_##b
+#define _GDISP_DISPLAY_CAT(a, b)	_GDISP_DISPLAY_CAT2(a, b)
+
+#define GDISP						_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, GDISP)
+#define gdisp_lld_init				_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_init)
+#define gdisp_lld_clear				_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_clear)
+#define gdisp_lld_draw_pixel		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_draw_pixel)
+#define gdisp_lld_fill_area			_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_fill_area)
+#define gdisp_lld_blit_area_ex		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_blit_area_ex)
+#define gdisp_lld_draw_line			_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_draw_line)
+#define gdisp_lld_draw_circle		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_draw_circle)
+#define gdisp_lld_fill_circle		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_fill_circle)
+#define gdisp_lld_draw_ellipse		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_draw_ellipse)
+#define gdisp_lld_fill_ellipse		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_fill_ellipse)
+#define gdisp_lld_draw_arc			_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_draw_arc)
+#define gdisp_lld_fill_arc			_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_fill_arc)
+#define gdisp_lld_draw_char			_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_draw_char)
+#define gdisp_lld_fill_char			_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_fill_char)
+#define gdisp_lld_get_pixel_color	_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_get_pixel_color)
+#define gdisp_lld_vertical_scroll	_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_vertical_scroll)
+#define gdisp_lld_control			_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_control)
+#define gdisp_lld_query				_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_query)
+#define gdisp_lld_set_clip			_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_set_clip)
+#define gdisp_lld_msg_dispatch		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_msg_dispatch)
+#define gdisp_lld_phys_draw_pixel	_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_phys_draw_pixel)
+#define gdisp_lld_phys_fill_area	_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_phys_fill_area)
+#define gdisp_lld_phys_blit_area_ex	_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_phys_blit_area_ex)
+#define gdisp_lld_phys_get_pixel_color	_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_phys_get_pixel_color)
+#define gdisp_lld_phys_control		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_phys_control)
+#if GDISP_NEED_CLIPREGION
+	#define gdisp_lld_region_draw_pixel		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_region_draw_pixel)
+	#define gdisp_lld_region_fill_area		_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_region_fill_area)
+	#define gdisp_lld_region_blit_area_ex	_GDISP_DISPLAY_CAT(GDISP_DISPLAY_NAME, lld_region_blit_area_ex)
+#endif
+
+/* Now read this driver's configuration */
+#include GDISP_DISPLAY_CONFIG
+#include "gdisp/lld/gdisp_lld.h"
+
+#if GDISP_PIXELFORMAT != GDISP_MAIN_PIXELFORMAT
+	#error "GDISP: An extra display must use the same pixel format as the main display."
+#endif
+
+#if GDISP_NEED_SCROLL && !GDISP_HARDWARE_SCROLL
+	#error "GDISP: Hardware scrolling is wanted but not supported by an extra display."
+#endif
+
+#if GDISP_NEED_PIXELREAD && !GDISP_HARDWARE_PIXELREAD
+	#error "GDISP: Pixel read-back is wanted but not supported by an extra display."
+#endif
+
+/* Compile the driver and declare its driver table */
+#include GDISP_DISPLAY_DRIVER
+
+const GDISPVMT _GDISP_DISPLAY_CAT(GDISPVMT, GDISP_DISPLAY_NAME) = GDISP_VMT_INIT;
+
+#endif /* GFX_USE_GDISP && GDISP_NEED_MULTIPLE_DISPLAYS */
+
+#endif /* GDISP_DISPLAY_C */
+/** @} */
@@ -26,9 +26,283 @@
 /* Include the low level driver information */
 #include "gdisp/lld/gdisp_lld.h"
 
+/* Compile the driver routines as gdisp_lld_xxx_hw() if they are being measured */
+#include "gdisp/lld/gdisp_lld_stats.h"
+
 /* Declare the GDISP structure */
 GDISPDriver	GDISP;
 
+#if GDISP_NEED_CLIPREGION
+	/*
+	 * The primitive emitters. Each piece of an operation is split across the
+	 * rectangles of the clip region (if any) before it is sent to the driver.
+	 * As the rectangles don't overlap nothing is drawn twice.
+	 */
+	void gdisp_lld_region_draw_pixel(coord_t x, coord_t y, color_t color) {
+		const GClipRect	*r, *e;
+
+		if (!GDISP.region) {
+			gdisp_lld_draw_pixel(x, y, color);
+			return;
+		}
+		for(r = GDISP.region->rects, e = r + GDISP.region->count; r < e; r++) {
+			if (x >= r->x0 && x < r->x1 && y >= r->y0 && y < r->y1) {
+				gdisp_lld_draw_pixel(x, y, color);
+				return;
+			}
+		}
+	}
+
+	void gdisp_lld_region_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+		const GClipRect	*r, *e;
+		coord_t			x0, y0, x1, y1;
+
+		if (!GDISP.region) {
+			gdisp_lld_fill_area(x, y, cx, cy, color);
+			return;
+		}
+		for(r = GDISP.region->rects, e = r + GDISP.region->count; r < e; r++) {
+			x0 = x < r->x0 ? r->x0 : x;
+			y0 = y < r->y0 ? r->y0 : y;
+			x1 = x+cx > r->x1 ? r->x1 : x+cx;
+			y1 = y+cy > r->y1 ? r->y1 : y+cy;
+			if (x0 < x1 && y0 < y1)
+				gdisp_lld_fill_area(x0, y0, x1-x0, y1-y0, color);
+		}
+	}
+
+	void gdisp_lld_region_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
+		const GClipRect	*r, *e;
+		coord_t			x0, y0, x1, y1;
+
+		if (!GDISP.region) {
+			gdisp_lld_blit_area_ex(x, y, cx, cy, srcx, srcy, srccx, buffer);
+			return;
+		}
+		for(r = GDISP.region->rects, e = r + GDISP.region->count; r < e; r++) {
+			x0 = x < r->x0 ? r->x0 : x;
+			y0 = y < r->y0 ? r->y0 : y;
+			x1 = x+cx > r->x1 ? r->x1 : x+cx;
+			y1 = y+cy > r->y1 ? r->y1 : y+cy;
+			if (x0 < x1 && y0 < y1)
+				gdisp_lld_blit_area_ex(x0, y0, x1-x0, y1-y0, srcx+x0-x, srcy+y0-y, srccx, buffer);
+		}
+	}
+#endif
+
+#if GDISP_NEED_CONTROL || GDISP_SOFTWARE_ORIENTATION
+	/*
+	 * Transform an area in the current orientation into the display's native coordinates.
+	 */
+	static inline void _phys_area(coord_t *x, coord_t *y, coord_t *cx, coord_t *cy) {
+		coord_t	t;
+
+		switch(GDISP.Orientation) {
+		case GDISP_ROTATE_90:
+			t = *x; *x = GDISP.Height - *y - *cy; *y = t;
+			t = *cx; *cx = *cy; *cy = t;
+			break;
+		case GDISP_ROTATE_180:
+			*x = GDISP.Width - *x - *cx;
+			*y = GDISP.Height - *y - *cy;
+			break;
+		case GDISP_ROTATE_270:
+			t = *y; *y = GDISP.Width - *x - *cx; *x = t;
+			t = *cx; *cx = *cy; *cy = t;
+			break;
+		default:
+			break;
+		}
+	}
+
+	/*
+	 * Copy a cx by cy block of pixels (with lines srccx pixels apart) into dst rotated
+	 * for the current orientation. The lines of dst are cy pixels long when rotated by
+	 * 90 or 270 degrees and cx pixels long otherwise. Callers keep the block to a small
+	 * tile so that both the source and the destination stay in the cache.
+	 */
+	static inline void _rotate_block(pixel_t *dst, coord_t cx, coord_t cy, coord_t srccx, const pixel_t *buffer) {
+		const pixel_t	*src;
+		pixel_t			*d;
+		coord_t			i, j;
+
+		switch(GDISP.Orientation) {
+		case GDISP_ROTATE_0:
+			for(j = 0; j < cy; j++, buffer += srccx)
+				for(src = buffer, i = 0; i < cx; i++)
+					*dst++ = *src++;
+			break;
+		case GDISP_ROTATE_90:
+			for(j = 0; j < cy; j++, buffer += srccx)
+				for(src = buffer, d = dst+cy-1-j, i = 0; i < cx; i++, d += cy)
+					*d = *src++;
+			break;
+		case GDISP_ROTATE_180:
+			for(dst += cx*cy, j = 0; j < cy; j++, buffer += srccx)
+				for(src = buffer, i = 0; i < cx; i++)
+					*--dst = *src++;
+			break;
+		case GDISP_ROTATE_270:
+			for(j = 0; j < cy; j++, buffer += srccx)
+				for(src = buffer, d = dst+(cx-1)*cy+j, i = 0; i < cx; i++, d -= cy)
+					*d = *src++;
+			break;
+		}
+	}
+#endif
+
+#if GDISP_SOFTWARE_ORIENTATION
+	/*
+	 * The orientation layer. Everything is clipped in the current orientation and
+	 * then transformed once into the driver's native coordinates.
+	 */
+	void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color) {
+		#if GDISP_NEED_VALIDATION || GDISP_NEED_CLIP
+			if (x < GDISP.clipx0 || y < GDISP.clipy0 || x >= GDISP.clipx1 || y >= GDISP.clipy1) return;
+		#endif
+		switch(GDISP.Orientation) {
+		case GDISP_ROTATE_0:	gdisp_lld_phys_draw_pixel(x, y, color);									break;
+		case GDISP_ROTATE_90:	gdisp_lld_phys_draw_pixel(GDISP.Height-1-y, x, color);					break;
+		case GDISP_ROTATE_180:	gdisp_lld_phys_draw_pixel(GDISP.Width-1-x, GDISP.Height-1-y, color);	break;
+		case GDISP_ROTATE_270:	gdisp_lld_phys_draw_pixel(y, GDISP.Width-1-x, color);					break;
+		}
+	}
+
+	void gdisp_lld_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+		#if !GDISP_HARDWARE_FILLS
+			coord_t x0, x1, y1;
+		#endif
+
+		#if GDISP_NEED_VALIDATION || GDISP_NEED_CLIP
+			if (x < GDISP.clipx0) { cx -= GDISP.clipx0 - x; x = GDISP.clipx0; }
+			if (y < GDISP.clipy0) { cy -= GDISP.clipy0 - y; y = GDISP.clipy0; }
+			if (cx <= 0 || cy <= 0 || x >= GDISP.clipx1 || y >= GDISP.clipy1) return;
+			if (x+cx > GDISP.clipx1)	cx = GDISP.clipx1 - x;
+			if (y+cy > GDISP.clipy1)	cy = GDISP.clipy1 - y;
+		#endif
+
+		_phys_area(&x, &y, &cx, &cy);
+
+		#if GDISP_HARDWARE_FILLS
+			gdisp_lld_phys_fill_area(x, y, cx, cy, color);
+		#else
+			x0 = x;
+			x1 = x + cx;
+			y1 = y + cy;
+			for(; y < y1; y++)
+				for(x = x0; x < x1; x++)
+					gdisp_lld_phys_draw_pixel(x, y, color);
+		#endif
+	}
+
+	void gdisp_lld_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
+		#if GDISP_HARDWARE_BITFILLS && GDISP_NEED_CONTROL
+			static pixel_t	tile[GDISP_ROTATE_TILE_SIZE*GDISP_ROTATE_TILE_SIZE];
+			coord_t			tx, ty, tcx, tcy, px, py, pcx, pcy;
+		#elif !GDISP_HARDWARE_BITFILLS
+			const pixel_t	*src;
+			coord_t			px, py, dx, dy, qx, qy, i, j;
+		#endif
+
+		#if GDISP_NEED_VALIDATION || GDISP_NEED_CLIP
+			if (x < GDISP.clipx0) { cx -= GDISP.clipx0 - x; srcx += GDISP.clipx0 - x; x = GDISP.clipx0; }
+			if (y < GDISP.clipy0) { cy -= GDISP.clipy0 - y; srcy += GDISP.clipy0 - y; y = GDISP.clipy0; }
+			if (srcx+cx > srccx)		cx = srccx - srcx;
+			if (cx <= 0 || cy <= 0 || x >= GDISP.clipx1 || y >= GDISP.clipy1) return;
+			if (x+cx > GDISP.clipx1)	cx = GDISP.clipx1 - x;
+			if (y+cy > GDISP.clipy1)	cy = GDISP.clipy1 - y;
+		#endif
+
+		#if GDISP_HARDWARE_BITFILLS
+			#if GDISP_NEED_CONTROL
+				if (GDISP.Orientation != GDISP_ROTATE_0) {
+					// Rotate and send a tile at a time
+					buffer += srcy*srccx + srcx;
+					for(ty = 0; ty < cy; ty += GDISP_ROTATE_TILE_SIZE) {
+						tcy = cy - ty < GDISP_ROTATE_TILE_SIZE ? cy - ty : GDISP_ROTATE_TILE_SIZE;
+						for(tx = 0; tx < cx; tx += GDISP_ROTATE_TILE_SIZE) {
+							tcx = cx - tx < GDISP_ROTATE_TILE_SIZE ? cx - tx : GDISP_ROTATE_TILE_SIZE;
+							_rotate_block(tile, tcx, tcy, srccx, buffer + ty*srccx + tx);
+							px = x + tx;
+							py = y + ty;
+							pcx = tcx;
+							pcy = tcy;
+							_phys_area(&px, &py, &pcx, &pcy);
+							gdisp_lld_phys_blit_area_ex(px, py, pcx, pcy, 0, 0, pcx, tile);
+						}
+					}
+					return;
+				}
+			#endif
+			gdisp_lld_phys_blit_area_ex(x, y, cx, cy, srcx, srcy, srccx, buffer);
+		#else
+			// Find the native position of the first pixel and the native step along a source line
+			switch(GDISP.Orientation) {
+			default:
+			case GDISP_ROTATE_0:	px = x;					py = y;					dx = 1;		dy = 0;		break;
+			case GDISP_ROTATE_90:	px = GDISP.Height-1-y;	py = x;					dx = 0;		dy = 1;		break;
+			case GDISP_ROTATE_180:	px = GDISP.Width-1-x;	py = GDISP.Height-1-y;	dx = -1;	dy = 0;		break;
+			case GDISP_ROTATE_270:	px = y;					py = GDISP.Width-1-x;	dx = 0;		dy = -1;	break;
+			}
+
+			// The next source line is a quarter turn clockwise from the line step
+			buffer += srcy*srccx + srcx;
+			for(j = 0; j < cy; j++, buffer += srccx, px -= dy, py += dx)
+				for(src = buffer, qx = px, qy = py, i = 0; i < cx; i++, qx += dx, qy += dy)
+					gdisp_lld_phys_draw_pixel(qx, qy, *src++);
+		#endif
+	}
+
+	#if GDISP_NEED_PIXELREAD && GDISP_HARDWARE_PIXELREAD
+		color_t gdisp_lld_get_pixel_color(coord_t x, coord_t y) {
+			switch(GDISP.Orientation) {
+			case GDISP_ROTATE_90:	return gdisp_lld_phys_get_pixel_color(GDISP.Height-1-y, x);
+			case GDISP_ROTATE_180:	return gdisp_lld_phys_get_pixel_color(GDISP.Width-1-x, GDISP.Height-1-y);
+			case GDISP_ROTATE_270:	return gdisp_lld_phys_get_pixel_color(y, GDISP.Width-1-x);
+			default:				return gdisp_lld_phys_get_pixel_color(x, y);
+			}
+		}
+	#endif
+
+	#if GDISP_NEED_CONTROL
+		void gdisp_lld_control(unsigned what, void *value) {
+			coord_t		t;
+
+			if (what != GDISP_CONTROL_ORIENTATION) {
+				#if GDISP_HARDWARE_CONTROL
+					gdisp_lld_phys_control(what, value);
+				#endif
+				return;
+			}
+
+			switch((gdisp_orientation_t)value) {
+			case GDISP_ROTATE_0:
+			case GDISP_ROTATE_90:
+			case GDISP_ROTATE_180:
+			case GDISP_ROTATE_270:
+				break;
+			default:
+				return;
+			}
+
+			// Swap the width and height when changing between portrait and landscape
+			if (((gdisp_orientation_t)value ^ GDISP.Orientation) & 1) {
+				t = GDISP.Width;
+				GDISP.Width = GDISP.Height;
+				GDISP.Height = t;
+			}
+			GDISP.Orientation = (gdisp_orientation_t)value;
+
+			#if GDISP_NEED_CLIP || GDISP_NEED_VALIDATION
+				GDISP.clipx0 = 0;
+				GDISP.clipy0 = 0;
+				GDISP.clipx1 = GDISP.Width;
+				GDISP.clipy1 = GDISP.Height;
+			#endif
+		}
+	#endif
+#endif
+
 #if !GDISP_HARDWARE_CLEARS 
 	void gdisp_lld_clear(color_t color) {
 		gdisp_lld_fill_area(0, 0, GDISP.Width, GDISP.Height, color);
@@ -45,16 +319,16 @@ GDISPDriver	GDISP;
 		// speed improvement if vertical or horizontal
 		if (x0 == x1) {
 			if (y1 > y0)
-				gdisp_lld_fill_area(x0, y0, 1, y1-y0+1, color);
+				gdisp_lld_region_fill_area(x0, y0, 1, y1-y0+1, color);
 			else
-				gdisp_lld_fill_area(x0, y1, 1, y0-y1+1, color);
+				gdisp_lld_region_fill_area(x0, y1, 1, y0-y1+1, color);
 			return;
 		}
 		if (y0 == y1) {
 			if (x1 > x0)
-				gdisp_lld_fill_area(x0, y0, x1-x0+1, 1, color);
+				gdisp_lld_region_fill_area(x0, y0, x1-x0+1, 1, color);
 			else
-				gdisp_lld_fill_area(x0, y1, x0-x1+1, 1, color);
+				gdisp_lld_region_fill_area(x0, y1, x0-x1+1, 1, color);
 			return;
 		}
 		#endif
@@ -80,7 +354,7 @@ GDISPDriver	GDISP;
 			diff = P - dx;
 
 			for(i=0; i<=dx; ++i) {
-				gdisp_lld_draw_pixel(x0, y0, color);
+				gdisp_lld_region_draw_pixel(x0, y0, color);
 				if (P < 0) {
 					P  += dy;
 					x0 += addx;
@@ -96,7 +370,7 @@ GDISPDriver	GDISP;
 			diff = P - dy;
 
 			for(i=0; i<=dy; ++i) {
-				gdisp_lld_draw_pixel(x0, y0, color);
+				gdisp_lld_region_draw_pixel(x0, y0, color);
 				if (P < 0) {
 					P  += dx;
 					y0 += addy;
@@ -110,7 +384,7 @@ GDISPDriver	GDISP;
 	}
 #endif
 
-#if !GDISP_HARDWARE_FILLS
+#if !GDISP_HARDWARE_FILLS && !GDISP_SOFTWARE_ORIENTATION
 	void gdisp_lld_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 		#if GDISP_HARDWARE_SCROLL
 			gdisp_lld_vertical_scroll(x, y, cx, cy, cy, color);
@@ -134,7 +408,7 @@ GDISPDriver	GDISP;
 	}
 #endif
 
-#if !GDISP_HARDWARE_BITFILLS
+#if !GDISP_HARDWARE_BITFILLS && !GDISP_SOFTWARE_ORIENTATION
 	void gdisp_lld_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
 			coord_t x0, x1, y1;
 			
@@ -175,14 +449,14 @@ GDISPDriver	GDISP;
 		P = 1 - radius;
 
 		do {
-			gdisp_lld_draw_pixel(x+a, y+b, color);
-			gdisp_lld_draw_pixel(x+b, y+a, color);
-			gdisp_lld_draw_pixel(x-a, y+b, color);
-			gdisp_lld_draw_pixel(x-b, y+a, color);
-			gdisp_lld_draw_pixel(x+b, y-a, color);
-			gdisp_lld_draw_pixel(x+a, y-b, color);
-			gdisp_lld_draw_pixel(x-a, y-b, color);
-			gdisp_lld_draw_pixel(x-b, y-a, color);
+			gdisp_lld_region_draw_pixel(x+a, y+b, color);
+			gdisp_lld_region_draw_pixel(x+b, y+a, color);
+			gdisp_lld_region_draw_pixel(x-a, y+b, color);
+			gdisp_lld_region_draw_pixel(x-b, y+a, color);
+			gdisp_lld_region_draw_pixel(x+b, y-a, color);
+			gdisp_lld_region_draw_pixel(x+a, y-b, color);
+			gdisp_lld_region_draw_pixel(x-a, y-b, color);
+			gdisp_lld_region_draw_pixel(x-b, y-a, color);
 			if (P < 0)
 				P += 3 + 2*a++;
 			else
@@ -219,10 +493,10 @@ GDISPDriver	GDISP;
 		long err = b2-(2*b-1)*a2, e2; /* Fehler im 1. Schritt */
 
 		do {
-			gdisp_lld_draw_pixel(x+dx, y+dy, color); /* I. Quadrant */
-			gdisp_lld_draw_pixel(x-dx, y+dy, color); /* II. Quadrant */
-			gdisp_lld_draw_pixel(x-dx, y-dy, color); /* III. Quadrant */
-			gdisp_lld_draw_pixel(x+dx, y-dy, color); /* IV. Quadrant */
+			gdisp_lld_region_draw_pixel(x+dx, y+dy, color); /* I. Quadrant */
+			gdisp_lld_region_draw_pixel(x-dx, y+dy, color); /* II. Quadrant */
+			gdisp_lld_region_draw_pixel(x-dx, y-dy, color); /* III. Quadrant */
+			gdisp_lld_region_draw_pixel(x+dx, y-dy, color); /* IV. Quadrant */
 
 			e2 = 2*err;
 			if(e2 <  (2*dx+1)*b2) {
@@ -236,8 +510,8 @@ GDISPDriver	GDISP;
 		} while(dy >= 0); 
 
 		while(dx++ < a) { /* fehlerhafter Abbruch bei flachen Ellipsen (b=1) */
-			gdisp_lld_draw_pixel(x+dx, y, color); /* -> Spitze der Ellipse vollenden */
-			gdisp_lld_draw_pixel(x-dx, y, color);
+			gdisp_lld_region_draw_pixel(x+dx, y, color); /* -> Spitze der Ellipse vollenden */
+			gdisp_lld_region_draw_pixel(x-dx, y, color);
 	   }   
 	}
 #endif
@@ -264,16 +538,45 @@ GDISPDriver	GDISP;
 		} while(dy >= 0); 
 
 		while(dx++ < a) { /* fehlerhafter Abbruch bei flachen Ellipsen (b=1) */
-			gdisp_lld_draw_pixel(x+dx, y, color); /* -> Spitze der Ellipse vollenden */
-			gdisp_lld_draw_pixel(x-dx, y, color);
+			gdisp_lld_region_draw_pixel(x+dx, y, color); /* -> Spitze der Ellipse vollenden */
+			gdisp_lld_region_draw_pixel(x-dx, y, color);
 	   }   
 	}
 #endif
 
-#if GDISP_NEED_ARC && !GDISP_HARDWARE_ARCS
+#if GDISP_NEED_ARC && (!GDISP_HARDWARE_ARCS || !GDISP_HARDWARE_ARCFILLS)
+	/*
+	 * cos() of 0 .. 90 degrees in 2.30 fixed point. Using whole degrees keeps
+	 * cos(60) exactly 0.5 so arcs end on the same pixels as the libm version.
+	 */
+	static const uint32_t _arc_cos[91] = {
+		1073741824, 1073578288, 1073087729, 1072270298, 1071126243, 1069655912, 1067859754, 1065738315,
+		1063292242, 1060522280, 1057429273, 1054014162, 1050277989, 1046221891, 1041847103, 1037154959,
+		1032146887, 1026824413, 1021189159, 1015242840, 1008987269, 1002424350, 995556083, 988384560,
+		980911966, 973140576, 965072759, 956710970, 948057759, 939115760, 929887697, 920376381,
+		910584710, 900515665, 890172315, 879557810, 868675383, 857528349, 846120104, 834454122,
+		822533958, 810363241, 797945680, 785285058, 772385229, 759250125, 745883746, 732290163,
+		718473518, 704438018, 690187940, 675727625, 661061475, 646193961, 631129609, 615873009,
+		600428808, 584801711, 568996477, 553017922, 536870912, 520560366, 504091252, 487468587,
+		470697435, 453782903, 436730145, 419544355, 402230767, 384794656, 367241333, 349576144,
+		331804471, 313931728, 295963357, 277904834, 259761657, 241539355, 223243478, 204879599,
+		186453311, 167970228, 149435979, 130856211, 112236583, 93582766, 74900443, 56195305,
+		37473049, 18739379, 0
+		};
 
-	#include <math.h>
+	/*
+	 * The x co-ordinate of a point on the arc as a fixed point offset from the middle.
+	 */
+	static fixed _arc_x(uint16_t radius, uint16_t degrees) {
+		if (degrees > 180)
+			degrees = 360 - degrees;
+		if (degrees > 90)
+			return -(fixed)(((uint64_t)radius * _arc_cos[180 - degrees]) >> 14);
+		return (fixed)(((uint64_t)radius * _arc_cos[degrees]) >> 14);
+	}
+#endif
 
+#if GDISP_NEED_ARC && !GDISP_HARDWARE_ARCS
 	/*
 	 * @brief				Internal helper function for gdispDrawArc()
 	 *
@@ -289,13 +592,13 @@ GDISPDriver	GDISP;
 	 */
 	static void _draw_arc(coord_t x, coord_t y, uint16_t start, uint16_t end, uint16_t radius, color_t color) {
 	    if (/*start >= 0 && */start <= 180) {
-	        float x_maxI = x + radius*cos(start*M_PI/180);
-	        float x_minI;
+	        coord_t x_maxI = x + NONFIXED(_arc_x(radius, start));
+	        coord_t x_minI;
 
 	        if (end > 180)
 	            x_minI = x - radius;
 	        else
-	            x_minI = x + radius*cos(end*M_PI/180);
+	            x_minI = x + NONFIXED(_arc_x(radius, end) + FIXED(1) - 1);
 
 	        int a = 0;
 	        int b = radius;
@@ -303,13 +606,13 @@ GDISPDriver	GDISP;
 
 	        do {
 	            if(x-a <= x_maxI && x-a >= x_minI)
-	            	gdisp_lld_draw_pixel(x-a, y-b, color);
+	            	gdisp_lld_region_draw_pixel(x-a, y-b, color);
 	            if(x+a <= x_maxI && x+a >= x_minI)
-	            	gdisp_lld_draw_pixel(x+a, y-b, color);
+	            	gdisp_lld_region_draw_pixel(x+a, y-b, color);
 	            if(x-b <= x_maxI && x-b >= x_minI)
-	            	gdisp_lld_draw_pixel(x-b, y-a, color);
+	            	gdisp_lld_region_draw_pixel(x-b, y-a, color);
 	            if(x+b <= x_maxI && x+b >= x_minI)
-	            	gdisp_lld_draw_pixel(x+b, y-a, color);
+	            	gdisp_lld_region_draw_pixel(x+b, y-a, color);
 
 	            if (P < 0) {
 	                P = P + 3 + 2*a;
@@ -323,13 +626,13 @@ GDISPDriver	GDISP;
 	    }
 
 	    if (end > 180 && end <= 360) {
-	        float x_maxII = x+radius*cos(end*M_PI/180);
-	        float x_minII;
+	        coord_t x_maxII = x + NONFIXED(_arc_x(radius, end));
+	        coord_t x_minII;
 
 	        if(start <= 180)
 	            x_minII = x - radius;
 	        else
-	            x_minII = x+radius*cos(start*M_PI/180);
+	            x_minII = x + NONFIXED(_arc_x(radius, start) + FIXED(1) - 1);
 
 	        int a = 0;
 	        int b = radius;
@@ -337,13 +640,13 @@ GDISPDriver	GDISP;
 
 	        do {
 	            if(x-a <= x_maxII && x-a >= x_minII)
-	            	gdisp_lld_draw_pixel(x-a, y+b, color);
+	            	gdisp_lld_region_draw_pixel(x-a, y+b, color);
 	            if(x+a <= x_maxII && x+a >= x_minII)
-	            	gdisp_lld_draw_pixel(x+a, y+b, color);
+	            	gdisp_lld_region_draw_pixel(x+a, y+b, color);
 	            if(x-b <= x_maxII && x-b >= x_minII)
-	            	gdisp_lld_draw_pixel(x-b, y+a, color);
+	            	gdisp_lld_region_draw_pixel(x-b, y+a, color);
 	            if(x+b <= x_maxII && x+b >= x_minII)
-	            	gdisp_lld_draw_pixel(x+b, y+a, color);
+	            	gdisp_lld_region_draw_pixel(x+b, y+a, color);
 
 	            if (P < 0) {
 	                P = P + 3 + 2*a;
@@ -383,13 +686,13 @@ GDISPDriver	GDISP;
 	 */
 	static void _fill_arc(coord_t x, coord_t y, uint16_t start, uint16_t end, uint16_t radius, color_t color) {
 	    if (/*start >= 0 && */start <= 180) {
-	        float x_maxI = x + radius*cos(start*M_PI/180);
-	        float x_minI;
+	        coord_t x_maxI = x + NONFIXED(_arc_x(radius, start));
+	        coord_t x_minI;
 
 	        if (end > 180)
 	            x_minI = x - radius;
 	        else
-	            x_minI = x + radius*cos(end*M_PI/180);
+	            x_minI = x + NONFIXED(_arc_x(radius, end) + FIXED(1) - 1);
 
 	        int a = 0;
 	        int b = radius;
@@ -417,13 +720,13 @@ GDISPDriver	GDISP;
 	    }
 
 	    if (end > 180 && end <= 360) {
-	        float x_maxII = x+radius*cos(end*M_PI/180);
-	        float x_minII;
+	        coord_t x_maxII = x + NONFIXED(_arc_x(radius, end));
+	        coord_t x_minII;
 
 	        if(start <= 180)
 	            x_minII = x - radius;
 	        else
-	            x_minII = x+radius*cos(start*M_PI/180);
+	            x_minII = x + NONFIXED(_arc_x(radius, start) + FIXED(1) - 1);
 
 	        int a = 0;
 	        int b = radius;
@@ -465,23 +768,114 @@ GDISPDriver	GDISP;
 	#include "gdisp/fonts.h"
 #endif
 
+#if GDISP_NEED_TEXT && GDISP_NEED_ANTIALIAS && !GDISP_HARDWARE_TEXT
+	/* Without a known background there is nothing to blend against so just draw the mostly covered pixels */
+	static void _draw_char_aa(coord_t x, coord_t y, coord_t width, const uint8_t *runs, font_t font, color_t color) {
+		coord_t			height, i, j, n, k;
+		unsigned		shift, mask;
+		bool_t			solid;
+
+		height = font->height;
+		shift = font->aa->bitsPerPixel;
+		mask = (1 << shift) - 1;
+
+		/* Each run may wrap across several rows */
+		for(i = j = 0; j < height; runs++) {
+			n = (*runs >> shift) + 1;
+			solid = (*runs & mask) > (mask >> 1);
+			while(n && j < height) {
+				k = width - i;
+				if (k > n) k = n;
+				if (solid)
+					gdisp_lld_region_fill_area(x+i, y+j, k, 1, color);
+				n -= k;
+				if ((i += k) >= width) {
+					i = 0;
+					j++;
+				}
+			}
+		}
+	}
+#endif
+
+#if GDISP_NEED_TEXT && GDISP_NEED_ANTIALIAS && !GDISP_HARDWARE_TEXTFILLS
+	/* Blend the character against the background into a buffer and blit it */
+	static void _fill_char_aa(coord_t x, coord_t y, coord_t width, const uint8_t *runs, font_t font, color_t color, color_t bgcolor) {
+		static pixel_t	buf[GDISP_ANTIALIAS_BUFFER_SIZE];
+		color_t			shade[16];
+		coord_t			height, rows, cx, i, j, x0, y0, n;
+		unsigned		shift, mask, v;
+
+		height = font->height;
+		shift = font->aa->bitsPerPixel;
+		mask = (1 << shift) - 1;
+
+		/* Blit as many whole rows at a time as will fit in our buffer. A wider glyph is blitted a piece of a row at a time. */
+		if (width <= GDISP_ANTIALIAS_BUFFER_SIZE) {
+			cx = width;
+			rows = GDISP_ANTIALIAS_BUFFER_SIZE / width;
+		} else {
+			cx = GDISP_ANTIALIAS_BUFFER_SIZE;
+			rows = 1;
+		}
+
+		/* There are only a few coverage levels so blend each of them just once */
+		shade[0] = bgcolor;
+		for(v = 1; v < mask; v++)
+			shade[v] = gdispBlendColor(color, bgcolor, (v * 255) / mask);
+		shade[mask] = color;
+
+		for(i = j = x0 = y0 = 0; j < height; runs++) {
+			n = (*runs >> shift) + 1;
+			v = *runs & mask;
+			for(; n && j < height; n--) {
+				gdispPackPixels(buf, cx, i-x0, j-y0, shade[v]);
+				if (++i < width && i - x0 < cx)
+					continue;
+				if (cx < width) {
+					gdisp_lld_region_blit_area_ex(x+x0, y+j, i-x0, 1, 0, 0, cx, buf);
+					x0 = i;
+					if (i < width)
+						continue;
+				}
+				i = x0 = 0;
+				if (++j - y0 >= rows || j >= height) {
+					if (cx == width)
+						gdisp_lld_region_blit_area_ex(x, y+y0, width, j-y0, 0, 0, width, buf);
+					y0 = j;
+				}
+			}
+		}
+	}
+#endif
+
 #if GDISP_NEED_TEXT && !GDISP_HARDWARE_TEXT
-	void gdisp_lld_draw_char(coord_t x, coord_t y, char c, font_t font, color_t color) {
+	void gdisp_lld_draw_char(coord_t x, coord_t y, unicode_t c, font_t font, color_t color) {
 		const fontcolumn_t	*ptr;
 		fontcolumn_t		column;
 		coord_t				width, height, xscale, yscale;
 		coord_t				i, j, xs, ys;
+		int					glyph;
 
 		/* Check we actually have something to print */
-		width = _getCharWidth(font, c);
+		glyph = _getCharIndex(font, c);
+		if (glyph < 0) return;
+		width = _getGlyphWidth(font, glyph);
 		if (!width) return;
 		
+		#if GDISP_NEED_ANTIALIAS
+			if (font->aa) {
+				_draw_char_aa(x, y, width, _getGlyphRuns(font, glyph), font, color);
+				return;
+			}
+		#endif
+
 		xscale = font->xscale;
 		yscale = font->yscale;
 		height = font->height * yscale;
 		width *= xscale;
 
-		ptr = _getCharData(font, c);
+		ptr = _getGlyphData(font, glyph);
 
 		/* Loop through the data and display. The font data is LSBit first, down the column */
 		for(i=0; i < width; i+=xscale) {
@@ -493,7 +887,7 @@ GDISPDriver	GDISP;
 				if (column & 0x01) {
 					for(xs=0; xs < xscale; xs++)
 						for(ys=0; ys < yscale; ys++)
-							gdisp_lld_draw_pixel(x+i+xs, y+j+ys, color);
+							gdisp_lld_region_draw_pixel(x+i+xs, y+j+ys, color);
 				}
 			}
 		}
@@ -501,14 +895,24 @@ GDISPDriver	GDISP;
 #endif
 
 #if GDISP_NEED_TEXT && !GDISP_HARDWARE_TEXTFILLS
-	void gdisp_lld_fill_char(coord_t x, coord_t y, char c, font_t font, color_t color, color_t bgcolor) {
+	void gdisp_lld_fill_char(coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor) {
 		coord_t			width, height;
 		coord_t			xscale, yscale;
+		int				glyph;
 		
 		/* Check we actually have something to print */
-		width = _getCharWidth(font, c);
+		glyph = _getCharIndex(font, c);
+		if (glyph < 0) return;
+		width = _getGlyphWidth(font, glyph);
 		if (!width) return;
 
+		#if GDISP_NEED_ANTIALIAS
+			if (font->aa) {
+				_fill_char_aa(x, y, width, _getGlyphRuns(font, glyph), font, color, bgcolor);
+				return;
+			}
+		#endif
+
 		xscale = font->xscale;
 		yscale = font->yscale;
 		height = font->height * yscale;
@@ -518,7 +922,7 @@ GDISPDriver	GDISP;
 		#if GDISP_HARDWARE_TEXT || GDISP_SOFTWARE_TEXTFILLDRAW
 			
 			/* Fill the area */
-			gdisp_lld_fill_area(x, y, width, height, bgcolor);
+			gdisp_lld_region_fill_area(x, y, width, height, bgcolor);
 			
 			/* Draw the text */
 			gdisp_lld_draw_char(x, y, c, font, color);
@@ -541,7 +945,7 @@ GDISPDriver	GDISP;
 				if ((unsigned)height > sizeof(buf)/sizeof(buf[0]))	return;
 			#endif
 
-			ptr = _getCharData(font, c);
+			ptr = _getGlyphData(font, glyph);
 
 			/* Loop through the data and display. The font data is LSBit first, down the column */
 			for(i = 0; i < width; i+=xscale) {
@@ -560,7 +964,7 @@ GDISPDriver	GDISP;
 				}
 
 				for(xs=0; xs < xscale; xs++)
-					gdisp_lld_blit_area_ex(x+i+xs, y, 1, height, 0, 0, 1, buf);
+					gdisp_lld_region_blit_area_ex(x+i+xs, y, 1, height, 0, 0, 1, buf);
 			}
 		}
 
@@ -582,7 +986,7 @@ GDISPDriver	GDISP;
 				if ((unsigned)(width * height) > sizeof(buf)/sizeof(buf[0]))	return;
 			#endif
 
-			ptr = _getCharData(font, c);
+			ptr = _getGlyphData(font, glyph);
 
 			/* Loop through the data and display. The font data is LSBit first, down the column */
 			for(i = 0; i < width; i+=xscale) {
@@ -604,7 +1008,7 @@ GDISPDriver	GDISP;
 			}
 
 			/* [Patch by Badger] Write all in one stroke */
-			gdisp_lld_blit_area_ex(x, y, width, height, 0, 0, width, buf);
+			gdisp_lld_region_blit_area_ex(x, y, width, height, 0, 0, width, buf);
 		}
 
 		/* Method 4: Draw pixel by pixel */
@@ -614,7 +1018,7 @@ GDISPDriver	GDISP;
 			fontcolumn_t		column;
 			coord_t				i, j, xs, ys;
 
-			ptr = _getCharData(font, c);
+			ptr = _getGlyphData(font, glyph);
 
 			/* Loop through the data and display. The font data is LSBit first, down the column */
 			for(i = 0; i < width; i+=xscale) {
@@ -626,11 +1030,11 @@ GDISPDriver	GDISP;
 					if (column & 0x01) {
 						for(xs=0; xs < xscale; xs++)
 							for(ys=0; ys < yscale; ys++)
-								gdisp_lld_draw_pixel(x+i+xs, y+j+ys, color);
+								gdisp_lld_region_draw_pixel(x+i+xs, y+j+ys, color);
 					} else {
 						for(xs=0; xs < xscale; xs++)
 							for(ys=0; ys < yscale; ys++)
-								gdisp_lld_draw_pixel(x+i+xs, y+j+ys, bgcolor);
+								gdisp_lld_region_draw_pixel(x+i+xs, y+j+ys, bgcolor);
 					}
 				}
 			}
@@ -640,7 +1044,7 @@ GDISPDriver	GDISP;
 #endif
 
 
-#if GDISP_NEED_CONTROL && !GDISP_HARDWARE_CONTROL
+#if GDISP_NEED_CONTROL && !GDISP_HARDWARE_CONTROL && !GDISP_SOFTWARE_ORIENTATION
 	void gdisp_lld_control(unsigned what, void *value) {
 		(void)what;
 		(void)value;
@@ -656,6 +1060,9 @@ void *gdisp_lld_query(unsigned what) {
 #endif
 
 #if GDISP_NEED_MSGAPI
+	/* Messages are measured like any other call */
+	#include "gdisp/lld/gdisp_lld_stats.h"
+
 	void gdisp_lld_msg_dispatch(gdisp_lld_msg_t *msg) {
 		switch(msg->action) {
 		case GDISP_LLD_MSG_NOP:
@@ -667,13 +1074,13 @@ void *gdisp_lld_query(unsigned what) {
 			gdisp_lld_clear(msg->clear.color);
 			break;
 		case GDISP_LLD_MSG_DRAWPIXEL:
-			gdisp_lld_draw_pixel(msg->drawpixel.x, msg->drawpixel.y, msg->drawpixel.color);
+			gdisp_lld_region_draw_pixel(msg->drawpixel.x, msg->drawpixel.y, msg->drawpixel.color);
 			break;
 		case GDISP_LLD_MSG_FILLAREA:
-			gdisp_lld_fill_area(msg->fillarea.x, msg->fillarea.y, msg->fillarea.cx, msg->fillarea.cy, msg->fillarea.color);
+			gdisp_lld_region_fill_area(msg->fillarea.x, msg->fillarea.y, msg->fillarea.cx, msg->fillarea.cy, msg->fillarea.color);
 			break;
 		case GDISP_LLD_MSG_BLITAREA:
-			gdisp_lld_blit_area_ex(msg->blitarea.x, msg->blitarea.y, msg->blitarea.cx, msg->blitarea.cy, msg->blitarea.srcx, msg->blitarea.srcy, msg->blitarea.srccx, msg->blitarea.buffer);
+			gdisp_lld_region_blit_area_ex(msg->blitarea.x, msg->blitarea.y, msg->blitarea.cx, msg->blitarea.cy, msg->blitarea.srcx, msg->blitarea.srcy, msg->blitarea.srccx, msg->blitarea.buffer);
 			break;
 		case GDISP_LLD_MSG_DRAWLINE:
 			gdisp_lld_draw_line(msg->drawline.x0, msg->drawline.y0, msg->drawline.x1, msg->drawline.y1, msg->drawline.color);
@@ -683,6 +1090,11 @@ void *gdisp_lld_query(unsigned what) {
 				gdisp_lld_set_clip(msg->setclip.x, msg->setclip.y, msg->setclip.cx, msg->setclip.cy);
 				break;
 		#endif
+		#if GDISP_NEED_CLIPREGION
+			case GDISP_LLD_MSG_SETCLIPREGION:
+				GDISP.region = msg->setclipregion.region;
+				break;
+		#endif
 		#if GDISP_NEED_CIRCLE
 			case GDISP_LLD_MSG_DRAWCIRCLE:
 				gdisp_lld_draw_circle(msg->drawcircle.x, msg->drawcircle.y, msg->drawcircle.radius, msg->drawcircle.color);
@@ -737,6 +1149,9 @@ void *gdisp_lld_query(unsigned what) {
 		#endif
 		}
 	}
+
+	/* Back to the driver's own routines */
+	#include "gdisp/lld/gdisp_lld_stats.h"
 #endif
 
 #endif  /* GFX_USE_GDISP */
@@ -187,6 +187,19 @@
 	#ifndef GDISP_SOFTWARE_TEXTBLITCOLUMN
 		#define GDISP_SOFTWARE_TEXTBLITCOLUMN	FALSE
 	#endif
+
+	/**
+	 * @brief   Let the emulation layer handle the display orientation.
+	 * @details If set to @p TRUE the driver only ever draws in its native
+	 *			orientation. It provides gdisp_lld_phys_xxx() routines that take
+	 *			already clipped physical coordinates and the emulation layer
+	 *			provides the gdisp_lld_xxx() routines and GDISP_CONTROL_ORIENTATION.
+	 * @note	Only clears, fills, bit fills, pixel reads and other controls
+	 *			can be accelerated by such a driver.
+	 */
+	#ifndef GDISP_SOFTWARE_ORIENTATION
+		#define GDISP_SOFTWARE_ORIENTATION		FALSE
+	#endif
 /** @} */
 
 /**
@@ -240,6 +253,18 @@
 	#endif
 /** @} */
 
+/* A hardware line knows nothing of the clip region so draw lines in software through the region emitters */
+#if GDISP_NEED_CLIPREGION && GDISP_HARDWARE_LINES
+	#undef GDISP_HARDWARE_LINES
+	#define GDISP_HARDWARE_LINES			FALSE
+#endif
+
+#if GDISP_SOFTWARE_ORIENTATION && (GDISP_HARDWARE_LINES || GDISP_HARDWARE_CIRCLES || GDISP_HARDWARE_CIRCLEFILLS \
+		|| GDISP_HARDWARE_ELLIPSES || GDISP_HARDWARE_ELLIPSEFILLS || GDISP_HARDWARE_ARCS || GDISP_HARDWARE_ARCFILLS \
+		|| GDISP_HARDWARE_TEXT || GDISP_HARDWARE_TEXTFILLS || GDISP_HARDWARE_SCROLL || GDISP_HARDWARE_CLIP)
+	#error "GDISP: A driver using GDISP_SOFTWARE_ORIENTATION can only accelerate clears, fills, bit fills, pixel reads and controls"
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -262,6 +287,17 @@ extern "C" {
 	extern void gdisp_lld_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer);
 	extern void gdisp_lld_draw_line(coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color);
 
+	/* Drawing functions that honour the clip region - provided by the emulation layer */
+	#if GDISP_NEED_CLIPREGION
+	extern void gdisp_lld_region_draw_pixel(coord_t x, coord_t y, color_t color);
+	extern void gdisp_lld_region_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
+	extern void gdisp_lld_region_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer);
+	#else
+	#define gdisp_lld_region_draw_pixel		gdisp_lld_draw_pixel
+	#define gdisp_lld_region_fill_area		gdisp_lld_fill_area
+	#define gdisp_lld_region_blit_area_ex	gdisp_lld_blit_area_ex
+	#endif
+
 	/* Circular Drawing Functions */
 	#if GDISP_NEED_CIRCLE
 	extern void gdisp_lld_draw_circle(coord_t x, coord_t y, coord_t radius, color_t color);
@@ -281,8 +317,8 @@ extern "C" {
 
 	/* Text Rendering Functions */
 	#if GDISP_NEED_TEXT
-	extern void gdisp_lld_draw_char(coord_t x, coord_t y, char c, font_t font, color_t color);
-	extern void gdisp_lld_fill_char(coord_t x, coord_t y, char c, font_t font, color_t color, color_t bgcolor);
+	extern void gdisp_lld_draw_char(coord_t x, coord_t y, unicode_t c, font_t font, color_t color);
+	extern void gdisp_lld_fill_char(coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor);
 	#endif
 
 	/* Pixel readback */
@@ -316,6 +352,68 @@ extern "C" {
 	extern void gdisp_lld_msg_dispatch(gdisp_lld_msg_t *msg);
 	#endif
 
+	/* Native orientation routines - provided by the driver when the emulation layer handles the orientation */
+	#if GDISP_SOFTWARE_ORIENTATION
+	extern void gdisp_lld_phys_draw_pixel(coord_t x, coord_t y, color_t color);
+	#if GDISP_HARDWARE_FILLS
+	extern void gdisp_lld_phys_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
+	#endif
+	#if GDISP_HARDWARE_BITFILLS
+	extern void gdisp_lld_phys_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer);
+	#endif
+	#if GDISP_NEED_PIXELREAD && GDISP_HARDWARE_PIXELREAD
+	extern color_t gdisp_lld_phys_get_pixel_color(coord_t x, coord_t y);
+	#endif
+	#if GDISP_NEED_CONTROL && GDISP_HARDWARE_CONTROL
+	extern void gdisp_lld_phys_control(unsigned what, void *value);
+	#endif
+	#endif
+
+	/* The driver's own routines when they are being measured - see gdisp_lld_stats.h */
+	#if GDISP_NEED_STATS
+	extern void gdisp_lld_clear_hw(color_t color);
+	extern void gdisp_lld_draw_pixel_hw(coord_t x, coord_t y, color_t color);
+	extern void gdisp_lld_fill_area_hw(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
+	extern void gdisp_lld_blit_area_ex_hw(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer);
+	extern void gdisp_lld_draw_line_hw(coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color);
+	#if GDISP_NEED_CLIPREGION
+	extern void gdisp_lld_region_draw_pixel_hw(coord_t x, coord_t y, color_t color);
+	extern void gdisp_lld_region_fill_area_hw(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color);
+	extern void gdisp_lld_region_blit_area_ex_hw(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer);
+	#endif
+	#if GDISP_NEED_CIRCLE
+	extern void gdisp_lld_draw_circle_hw(coord_t x, coord_t y, coord_t radius, color_t color);
+	extern void gdisp_lld_fill_circle_hw(coord_t x, coord_t y, coord_t radius, color_t color);
+	#endif
+	#if GDISP_NEED_ELLIPSE
+	extern void gdisp_lld_draw_ellipse_hw(coord_t x, coord_t y, coord_t a, coord_t b, color_t color);
+	extern void gdisp_lld_fill_ellipse_hw(coord_t x, coord_t y, coord_t a, coord_t b, color_t color);
+	#endif
+	#if GDISP_NEED_ARC
+	extern void gdisp_lld_draw_arc_hw(coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle, color_t color);
+	extern void gdisp_lld_fill_arc_hw(coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle, color_t color);
+	#endif
+	#if GDISP_NEED_TEXT
+	extern void gdisp_lld_draw_char_hw(coord_t x, coord_t y, unicode_t c, font_t font, color_t color);
+	extern void gdisp_lld_fill_char_hw(coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor);
+	#endif
+	#if GDISP_NEED_PIXELREAD
+	extern color_t gdisp_lld_get_pixel_color_hw(coord_t x, coord_t y);
+	#endif
+	#if GDISP_NEED_SCROLL
+	extern void gdisp_lld_vertical_scroll_hw(coord_t x, coord_t y, coord_t cx, coord_t cy, int lines, color_t bgcolor);
+	#endif
+	#if GDISP_NEED_CONTROL
+	extern void gdisp_lld_control_hw(unsigned what, void *value);
+	#endif
+	#if GDISP_NEED_QUERY
+	extern void *gdisp_lld_query_hw(unsigned what);
+	#endif
+	#if GDISP_NEED_CLIP
+	extern void gdisp_lld_set_clip_hw(coord_t x, coord_t y, coord_t cx, coord_t cy);
+	#endif
+	#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,9 @@ typedef enum gdisp_msgaction {
 	#if GDISP_NEED_CLIP
 		GDISP_LLD_MSG_SETCLIP,
 	#endif
+	#if GDISP_NEED_CLIPREGION
+		GDISP_LLD_MSG_SETCLIPREGION,
+	#endif
 	#if GDISP_NEED_CIRCLE
 		GDISP_LLD_MSG_DRAWCIRCLE,
 		GDISP_LLD_MSG_FILLCIRCLE,
@@ -100,6 +103,11 @@ typedef union gdisp_lld_msg {
 		coord_t				x, y;
 		coord_t				cx, cy;
 	} setclip;
+	struct gdisp_lld_msg_setclipregion {
+		gfxQueueItem		qi;
+		gdisp_msgaction_t	action;			// GDISP_LLD_MSG_SETCLIPREGION
+		const GClipRegion	*region;
+	} setclipregion;
 	struct gdisp_lld_msg_drawline {
 		gfxQueueItem		qi;
 		gdisp_msgaction_t	action;			// GDISP_LLD_MSG_DRAWLINE
@@ -155,7 +163,7 @@ typedef union gdisp_lld_msg {
 		gfxQueueItem		qi;
 		gdisp_msgaction_t	action;			// GDISP_LLD_MSG_DRAWCHAR
 		coord_t				x, y;
-		char				c;
+		unicode_t			c;
 		font_t				font;
 		color_t				color;
 	} drawchar;
@@ -163,7 +171,7 @@ typedef union gdisp_lld_msg {
 		gfxQueueItem		qi;
 		gdisp_msgaction_t	action;			// GDISP_LLD_MSG_FILLCHAR
 		coord_t				x, y;
-		char				c;
+		unicode_t			c;
 		font_t				font;
 		color_t				color;
 		color_t				bgcolor;
@@ -0,0 +1,84 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file	include/gdisp/lld/gdisp_lld_stats.h
+ * @brief	GDISP renaming of the low level driver routines for the driver statistics.
+ *
+ * @addtogroup GDISP
+ *
+ * @details	When GDISP_NEED_STATS is TRUE the driver's gdisp_lld_xxx() routines are
+ *			compiled as gdisp_lld_xxx_hw(). The gdisp_lld_xxx() routines in gdisp.c
+ *			then measure each call before passing it on. Calls the driver makes to
+ *			itself (eg an emulated circle drawing pixels) are not counted.
+ *
+ * @note	There is deliberately no include guard. Each inclusion toggles the
+ *			renaming so that emulation.c can turn it off around code that must
+ *			call the measured routines.
+ * @note	Extra displays (include/gdisp/lld/display.c) are not renamed.
+ *
+ * @{
+ */
+
+#if GDISP_NEED_STATS && !defined(GDISP_DISPLAY_NAME)
+
+#ifndef GDISP_LLD_STATS_RENAMED
+	#define GDISP_LLD_STATS_RENAMED
+
+	#define gdisp_lld_clear					gdisp_lld_clear_hw
+	#define gdisp_lld_draw_pixel			gdisp_lld_draw_pixel_hw
+	#define gdisp_lld_fill_area				gdisp_lld_fill_area_hw
+	#define gdisp_lld_blit_area_ex			gdisp_lld_blit_area_ex_hw
+	#define gdisp_lld_draw_line				gdisp_lld_draw_line_hw
+	#if GDISP_NEED_CLIPREGION
+		#define gdisp_lld_region_draw_pixel		gdisp_lld_region_draw_pixel_hw
+		#define gdisp_lld_region_fill_area		gdisp_lld_region_fill_area_hw
+		#define gdisp_lld_region_blit_area_ex	gdisp_lld_region_blit_area_ex_hw
+	#endif
+	#define gdisp_lld_draw_circle			gdisp_lld_draw_circle_hw
+	#define gdisp_lld_fill_circle			gdisp_lld_fill_circle_hw
+	#define gdisp_lld_draw_ellipse			gdisp_lld_draw_ellipse_hw
+	#define gdisp_lld_fill_ellipse			gdisp_lld_fill_ellipse_hw
+	#define gdisp_lld_draw_arc				gdisp_lld_draw_arc_hw
+	#define gdisp_lld_fill_arc				gdisp_lld_fill_arc_hw
+	#define gdisp_lld_draw_char				gdisp_lld_draw_char_hw
+	#define gdisp_lld_fill_char				gdisp_lld_fill_char_hw
+	#define gdisp_lld_get_pixel_color		gdisp_lld_get_pixel_color_hw
+	#define gdisp_lld_vertical_scroll		gdisp_lld_vertical_scroll_hw
+	#define gdisp_lld_control				gdisp_lld_control_hw
+	#define gdisp_lld_query					gdisp_lld_query_hw
+	#define gdisp_lld_set_clip				gdisp_lld_set_clip_hw
+#else
+	#undef GDISP_LLD_STATS_RENAMED
+
+	#undef gdisp_lld_clear
+	#undef gdisp_lld_draw_pixel
+	#undef gdisp_lld_fill_area
+	#undef gdisp_lld_blit_area_ex
+	#undef gdisp_lld_draw_line
+	#if GDISP_NEED_CLIPREGION
+		#undef gdisp_lld_region_draw_pixel
+		#undef gdisp_lld_region_fill_area
+		#undef gdisp_lld_region_blit_area_ex
+	#endif
+	#undef gdisp_lld_draw_circle
+	#undef gdisp_lld_fill_circle
+	#undef gdisp_lld_draw_ellipse
+	#undef gdisp_lld_fill_ellipse
+	#undef gdisp_lld_draw_arc
+	#undef gdisp_lld_fill_arc
+	#undef gdisp_lld_draw_char
+	#undef gdisp_lld_fill_char
+	#undef gdisp_lld_get_pixel_color
+	#undef gdisp_lld_vertical_scroll
+	#undef gdisp_lld_control
+	#undef gdisp_lld_query
+	#undef gdisp_lld_set_clip
+#endif
+
+#endif /* GDISP_NEED_STATS && !defined(GDISP_DISPLAY_NAME) */
+/** @} */
@@ -41,6 +41,15 @@
 	#ifndef GDISP_NEED_CLIP
 		#define GDISP_NEED_CLIP			TRUE
 	#endif
+	/**
+	 * @brief   Are clip regions (lists of clip rectangles) needed.
+	 * @details	Defaults to FALSE
+	 * @note	Hardware accelerated lines can't follow a region so
+	 * 			software lines are used instead.
+	 */
+	#ifndef GDISP_NEED_CLIPREGION
+		#define GDISP_NEED_CLIPREGION	FALSE
+	#endif
 	/**
 	 * @brief   Are text functions needed.
 	 * @details	Defaults to TRUE
@@ -48,6 +57,41 @@
 	#ifndef GDISP_NEED_TEXT
 		#define GDISP_NEED_TEXT			TRUE
 	#endif
+	/**
+	 * @brief   Are anti-aliased fonts (with kerning) supported.
+	 * @details	Defaults to FALSE
+	 * @note	Anti-aliased characters are blended against the background
+	 * 			color so they look best drawn with the fill text functions.
+	 */
+	#ifndef GDISP_NEED_ANTIALIAS
+		#define GDISP_NEED_ANTIALIAS	FALSE
+	#endif
+	/**
+	 * @brief   Are strings UTF-8 encoded.
+	 * @details	Defaults to FALSE
+	 * @note	Characters are then Unicode code points. Fonts generated with
+	 * 			characters above 255 need this.
+	 */
+	#ifndef GDISP_NEED_UTF8
+		#define GDISP_NEED_UTF8			FALSE
+	#endif
+	/**
+	 * @brief   Are text layouts supported.
+	 * @details	Defaults to FALSE
+	 * @note	A text layout holds a string that has been measured, word-wrapped
+	 * 			and justified so that it can be redrawn quickly.
+	 */
+	#ifndef GDISP_NEED_TEXTLAYOUT
+		#define GDISP_NEED_TEXTLAYOUT	FALSE
+	#endif
+	/**
+	 * @brief   Can fonts be loaded at run-time from memory or a file.
+	 * @details	Defaults to FALSE
+	 * @note	Only anti-aliased fonts written by mkfont -x can be loaded.
+	 */
+	#ifndef GDISP_NEED_FONTLOAD
+		#define GDISP_NEED_FONTLOAD		FALSE
+	#endif
 	/**
 	 * @brief   Are circle functions needed.
 	 * @details	Defaults to TRUE
@@ -80,6 +124,23 @@
 	#ifndef GDISP_NEED_CONVEX_POLYGON
 		#define GDISP_NEED_CONVEX_POLYGON		FALSE
 	#endif
+	/**
+	 * @brief   Are dashed, dotted and thick line functions needed.
+	 * @details	Defaults to FALSE
+	 */
+	#ifndef GDISP_NEED_STYLEDLINE
+		#define GDISP_NEED_STYLEDLINE	FALSE
+	#endif
+	/**
+	 * @brief   Are alpha blended fill and blit functions needed.
+	 * @details	Defaults to FALSE
+	 * @note	Requires GDISP_NEED_PIXELREAD and so a low level driver
+	 * 			that can read pixels back.
+	 * @note	Not supported with GDISP_NEED_ASYNC.
+	 */
+	#ifndef GDISP_NEED_ALPHA
+		#define GDISP_NEED_ALPHA		FALSE
+	#endif
 	/**
 	 * @brief   Are scrolling functions needed.
 	 * @details	Defaults to FALSE
@@ -131,6 +192,26 @@
 	#ifndef GDISP_NEED_MSGAPI
 		#define GDISP_NEED_MSGAPI		FALSE
 	#endif
+	/**
+	 * @brief   Are extra displays and the gdispGXXX() functions needed.
+	 * @details	Defaults to FALSE
+	 * @note	Each extra display is a low level driver compiled using
+	 * 			include/gdisp/lld/display.c and then attached with
+	 * 			gdispAttachDisplay(). All displays must use the same pixel format.
+	 * @note	Not supported with GDISP_NEED_ASYNC.
+	 */
+	#ifndef GDISP_NEED_MULTIPLE_DISPLAYS
+		#define GDISP_NEED_MULTIPLE_DISPLAYS	FALSE
+	#endif
+	/**
+	 * @brief   Are the driver statistics (gdispGetStats()) required.
+	 * @details	Defaults to FALSE
+	 * @note	This turns on GFX_USE_GMISC and GMISC_NEED_PERF.
+	 * @note	Only the main display is measured.
+	 */
+	#ifndef GDISP_NEED_STATS
+		#define GDISP_NEED_STATS		FALSE
+	#endif
 /**
  * @}
  *
@@ -180,6 +261,21 @@
 	#ifndef GDISP_NEED_IMAGE_ACCOUNTING
 		#define GDISP_NEED_IMAGE_ACCOUNTING	FALSE
 	#endif
+	/**
+	 * @brief   Is reading images compressed by file2c -z required.
+	 * @details	Defaults to FALSE
+	 */
+	#ifndef GDISP_NEED_IMAGE_COMPRESSED
+		#define GDISP_NEED_IMAGE_COMPRESSED	FALSE
+	#endif
+	/**
+	 * @brief   Should image decoders get their private memory from the GOS memory pools.
+	 * @details	Defaults to FALSE
+	 * @note	This turns on GOS_NEED_POOLS. Big buffers (eg a GIF dictionary) still use the heap.
+	 */
+	#ifndef GDISP_IMAGE_USE_POOLS
+		#define GDISP_IMAGE_USE_POOLS		FALSE
+	#endif
 /**
  * @}
  *
@@ -252,6 +348,68 @@
 	#ifndef GDISP_MAX_FONT_HEIGHT
 		#define GDISP_MAX_FONT_HEIGHT	16
 	#endif
+	/**
+	 * @brief   The maximum number of displays including the main display.
+	 * @details	Defaults to 2
+	 * @note	Only used if GDISP_NEED_MULTIPLE_DISPLAYS is TRUE
+	 */
+	#ifndef GDISP_TOTAL_DISPLAYS
+		#define GDISP_TOTAL_DISPLAYS	2
+	#endif
+	/**
+	 * @brief   The maximum number of rectangles in a clip region.
+	 * @details	Defaults to 8
+	 * @note	Only used if GDISP_NEED_CLIPREGION is TRUE
+	 */
+	#ifndef GDISP_CLIPREGION_RECTS
+		#define GDISP_CLIPREGION_RECTS	8
+	#endif
+	/**
+	 * @brief   The number of pixels blended at a time by the alpha functions.
+	 * @details	Defaults to 32
+	 * @note	This many pixels are held on the stack of the drawing thread.
+	 */
+	#ifndef GDISP_ALPHA_BUFFER_SIZE
+		#define GDISP_ALPHA_BUFFER_SIZE	32
+	#endif
+	/**
+	 * @brief   The number of pixels in the anti-aliased character buffer.
+	 * @details	Defaults to 1024
+	 * @note	A character is blitted in one go if it fits in the buffer,
+	 *			otherwise it is blitted a band of rows at a time, or a piece of a
+	 *			row at a time if a single row won't fit.
+	 * @note	Only used if GDISP_NEED_ANTIALIAS is TRUE
+	 */
+	#ifndef GDISP_ANTIALIAS_BUFFER_SIZE
+		#define GDISP_ANTIALIAS_BUFFER_SIZE	1024
+	#endif
+	/**
+	 * @brief   The maximum number of fonts that can be registered at once.
+	 * @details	Defaults to 24
+	 * @note	The built-in fonts are registered automatically and count towards this.
+	 * @note	Must be no more than 255.
+	 */
+	#ifndef GDISP_FONT_REGISTRY_SIZE
+		#define GDISP_FONT_REGISTRY_SIZE	24
+	#endif
+	/**
+	 * @brief   The number of glyphs each file or stream loaded font caches in RAM.
+	 * @details	Defaults to 16
+	 * @note	Each cached glyph uses as many bytes as the largest glyph in the font.
+	 * @note	Only used if GDISP_NEED_FONTLOAD is TRUE
+	 */
+	#ifndef GDISP_FONT_CACHE_GLYPHS
+		#define GDISP_FONT_CACHE_GLYPHS		16
+	#endif
+	/**
+	 * @brief   The width and height of the tiles a rotated bit fill is copied in.
+	 * @details	Defaults to 16
+	 * @note	The tile buffer uses the square of this many pixels of RAM.
+	 * @note	Only used by drivers that rotate bit fills in software.
+	 */
+	#ifndef GDISP_ROTATE_TILE_SIZE
+		#define GDISP_ROTATE_TILE_SIZE		16
+	#endif
 /**
  * @}
  *
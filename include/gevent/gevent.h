@@ -60,6 +60,9 @@ typedef struct GListener {
 	GEventCallbackFn	callback;			// Private: Call back Function
 	void				*param;				// Private: Parameter for the callback function.
 	GEvent				event;				// Public:  The event object into which the event information is stored.
+	#if GEVENT_NEED_STATS
+		perftime_t		sent;				// Private: When the last event was sent
+	#endif
 	} GListener;
 
 // The Source Object
@@ -73,6 +76,23 @@ typedef struct GSourceListener_t {
 	unsigned		srcflags;			// For the source's exclusive use. Initialised as 0 for a new listener source assignment.
 	} GSourceListener;
 
+#if GEVENT_NEED_STATS || defined(__DOXYGEN__)
+	/**
+	 * @brief	The event statistics
+	 * @note	Times are in performance clock units (see gmiscPerfToMicroseconds()).
+	 */
+	typedef struct GEventStats_t {
+		uint32_t		sent;				// Events sent to a waiting listener
+		uint32_t		dropped;			// Events a source could not send as the listener was busy
+		uint32_t		delivered;			// Events a waiting listener has received
+		perftime_t		latencymax;			// The longest from an event being sent to the listener receiving it
+		perftime_t		latencytotal;		// The total of those (divide by delivered for the average)
+		uint32_t		callbacks;			// Events sent to a callback
+		perftime_t		callbackmax;		// The longest time spent in a callback
+		perftime_t		callbacktotal;		// The total time spent in callbacks
+		} GEventStats;
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -222,6 +242,23 @@ void geventSendEvent(GSourceListener *psl);
  */
 void geventDetachSourceListeners(GSourceHandle gsh);
 
+#if GEVENT_NEED_STATS || defined(__DOXYGEN__)
+	/**
+	 * @brief	Get a copy of the event statistics
+	 *
+	 * @param[out] pstats	Where to put them
+	 *
+	 * @note	The counters are updated without any locking so a copy taken
+	 * 			while events are being sent may be slightly inconsistent.
+	 */
+	void geventGetStats(GEventStats *pstats);
+
+	/**
+	 * @brief	Set all the event statistics back to zero
+	 */
+	void geventResetStats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
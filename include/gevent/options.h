@@ -29,6 +29,14 @@
 	#ifndef GEVENT_ASSERT_NO_RESOURCE
 		#define GEVENT_ASSERT_NO_RESOURCE		FALSE
 	#endif
+	/**
+	 * @brief   Are the event statistics (geventGetStats()) required.
+	 * @details	Defaults to FALSE
+	 * @note	This turns on GFX_USE_GMISC and GMISC_NEED_PERF.
+	 */
+	#ifndef GEVENT_NEED_STATS
+		#define GEVENT_NEED_STATS				FALSE
+	#endif
 /**
  * @}
  *
@@ -46,6 +46,13 @@
 			#warning "GWIN: Drawing can occur outside the defined windows as GDISP_NEED_CLIP is FALSE"
 		#endif
 	#endif
+	#if GWIN_USE_POOLS && !GOS_NEED_POOLS
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GWIN: GOS_NEED_POOLS is required if GWIN_USE_POOLS is TRUE. It has been turned on for you."
+		#endif
+		#undef GOS_NEED_POOLS
+		#define	GOS_NEED_POOLS		TRUE
+	#endif
 	#if GWIN_NEED_BUTTON
 		#if !GDISP_NEED_TEXT
 			#error "GWIN: GDISP_NEED_TEXT is required if GWIN_NEED_BUTTON is TRUE."
@@ -77,6 +84,13 @@
 		#endif
 	#endif
 	#if GWIN_NEED_GRAPH
+		#if !GDISP_NEED_STYLEDLINE
+			#if GFX_DISPLAY_RULE_WARNINGS
+				#warning "GWIN: GDISP_NEED_STYLEDLINE is required if GWIN_NEED_GRAPH is TRUE. It has been turned on for you."
+			#endif
+			#undef GDISP_NEED_STYLEDLINE
+			#define GDISP_NEED_STYLEDLINE	TRUE
+		#endif
 	#endif
 #endif
 
@@ -110,9 +124,62 @@
 		#undef GQUEUE_NEED_GSYNC
 		#define	GQUEUE_NEED_GSYNC	TRUE
 	#endif
+	#if GDISP_NEED_ALPHA && !GDISP_NEED_PIXELREAD
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GDISP: GDISP_NEED_PIXELREAD is required if GDISP_NEED_ALPHA is TRUE. It has been turned on for you."
+		#endif
+		#undef GDISP_NEED_PIXELREAD
+		#define	GDISP_NEED_PIXELREAD	TRUE
+	#endif
+	#if GDISP_NEED_FONTLOAD && !GDISP_NEED_ANTIALIAS
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GDISP: GDISP_NEED_ANTIALIAS is required if GDISP_NEED_FONTLOAD is TRUE. It has been turned on for you."
+		#endif
+		#undef GDISP_NEED_ANTIALIAS
+		#define	GDISP_NEED_ANTIALIAS	TRUE
+	#endif
+	#if (GDISP_NEED_ANTIALIAS || GDISP_NEED_UTF8 || GDISP_NEED_TEXTLAYOUT) && !GDISP_NEED_TEXT
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GDISP: GDISP_NEED_TEXT is required if GDISP_NEED_ANTIALIAS, GDISP_NEED_UTF8 or GDISP_NEED_TEXTLAYOUT is TRUE. It has been turned on for you."
+		#endif
+		#undef GDISP_NEED_TEXT
+		#define	GDISP_NEED_TEXT		TRUE
+	#endif
+	#if GDISP_NEED_STATS && !(GFX_USE_GMISC && GMISC_NEED_PERF)
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GDISP: GFX_USE_GMISC and GMISC_NEED_PERF are required if GDISP_NEED_STATS is TRUE. They have been turned on for you."
+		#endif
+		#undef GFX_USE_GMISC
+		#define	GFX_USE_GMISC			TRUE
+		#undef GMISC_NEED_PERF
+		#define	GMISC_NEED_PERF			TRUE
+	#endif
+	#if GDISP_NEED_IMAGE && GDISP_IMAGE_USE_POOLS && !GOS_NEED_POOLS
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GDISP: GOS_NEED_POOLS is required if GDISP_IMAGE_USE_POOLS is TRUE. It has been turned on for you."
+		#endif
+		#undef GOS_NEED_POOLS
+		#define	GOS_NEED_POOLS		TRUE
+	#endif
 #endif
 
 #if GFX_USE_TDISP
+	#if TDISP_NEED_BUFFER && TDISP_BUFFER_FLUSH_PERIOD
+		#if !GFX_USE_GTIMER
+			#if GFX_DISPLAY_RULE_WARNINGS
+				#warning "TDISP: GFX_USE_GTIMER is required if TDISP_BUFFER_FLUSH_PERIOD is set. It has been turned on for you."
+			#endif
+			#undef GFX_USE_GTIMER
+			#define	GFX_USE_GTIMER			TRUE
+		#endif
+		#if !TDISP_NEED_MULTITHREAD
+			#if GFX_DISPLAY_RULE_WARNINGS
+				#warning "TDISP: TDISP_NEED_MULTITHREAD is required if TDISP_BUFFER_FLUSH_PERIOD is set. It has been turned on for you."
+			#endif
+			#undef TDISP_NEED_MULTITHREAD
+			#define	TDISP_NEED_MULTITHREAD	TRUE
+		#endif
+	#endif
 #endif
 
 #if GFX_USE_GAUDIN
@@ -125,6 +192,25 @@
 	#endif
 #endif
 
+#if GFX_USE_GAUDOUT
+	#if !GFX_USE_GMISC || !GMISC_NEED_ARRAYOPS
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GAUDOUT: GFX_USE_GMISC and GMISC_NEED_ARRAYOPS are required if GFX_USE_GAUDOUT is TRUE. They have been turned on for you."
+		#endif
+		#undef GFX_USE_GMISC
+		#define	GFX_USE_GMISC		TRUE
+		#undef GMISC_NEED_ARRAYOPS
+		#define	GMISC_NEED_ARRAYOPS	TRUE
+	#endif
+	#if GFX_USE_GEVENT && !GFX_USE_GTIMER
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GAUDOUT: GFX_USE_GTIMER is required if GFX_USE_GAUDOUT and GFX_USE_GEVENT are TRUE. It has been turned on for you."
+		#endif
+		#undef GFX_USE_GTIMER
+		#define	GFX_USE_GTIMER		TRUE
+	#endif
+#endif
+
 #if GFX_USE_GADC
 	#if !GFX_USE_GTIMER
 		#if GFX_DISPLAY_RULE_WARNINGS
@@ -136,9 +222,27 @@
 #endif
 
 #if GFX_USE_GEVENT
+	#if GEVENT_NEED_STATS && !(GFX_USE_GMISC && GMISC_NEED_PERF)
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GEVENT: GFX_USE_GMISC and GMISC_NEED_PERF are required if GEVENT_NEED_STATS is TRUE. They have been turned on for you."
+		#endif
+		#undef GFX_USE_GMISC
+		#define	GFX_USE_GMISC			TRUE
+		#undef GMISC_NEED_PERF
+		#define	GMISC_NEED_PERF			TRUE
+	#endif
 #endif
 
 #if GFX_USE_GTIMER
+	#if GTIMER_NEED_STATS && !(GFX_USE_GMISC && GMISC_NEED_PERF)
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GTIMER: GFX_USE_GMISC and GMISC_NEED_PERF are required if GTIMER_NEED_STATS is TRUE. They have been turned on for you."
+		#endif
+		#undef GFX_USE_GMISC
+		#define	GFX_USE_GMISC			TRUE
+		#undef GMISC_NEED_PERF
+		#define	GMISC_NEED_PERF			TRUE
+	#endif
 	#if GFX_USE_GDISP && !GDISP_NEED_MULTITHREAD && !GDISP_NEED_ASYNC
 		#if GFX_DISPLAY_RULE_WARNINGS
 			#warning "GTIMER: Neither GDISP_NEED_MULTITHREAD nor GDISP_NEED_ASYNC has been specified."
@@ -147,13 +251,27 @@
 	#endif
 #endif
 
-#if GFX_USE_GAUDOUT
-#endif
-
 #if GFX_USE_GQUEUE
 #endif
 
 #if GFX_USE_GMISC
+	#if GMISC_NEED_DSP && !GMISC_NEED_ARRAYOPS
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GMISC: GMISC_NEED_ARRAYOPS is required if GMISC_NEED_DSP is TRUE. It has been turned on for you."
+		#endif
+		#undef GMISC_NEED_ARRAYOPS
+		#define	GMISC_NEED_ARRAYOPS	TRUE
+	#endif
+	#if GMISC_NEED_TRACE && !GMISC_NEED_PERF
+		#if GFX_DISPLAY_RULE_WARNINGS
+			#warning "GMISC: GMISC_NEED_PERF is required if GMISC_NEED_TRACE is TRUE. It has been turned on for you."
+		#endif
+		#undef GMISC_NEED_PERF
+		#define	GMISC_NEED_PERF		TRUE
+	#endif
+	#if GMISC_DSP_FFT_MAX_LOG2 > 10
+		#error "GMISC: GMISC_DSP_FFT_MAX_LOG2 can be no more than 10"
+	#endif
 #endif
 
 #endif /* _GFX_H */
@@ -78,6 +78,7 @@ typedef struct GEventKeyboard_t {
 		#define GMETA_KEY_WINKEY		0x0010
 		#define GMETA_KEY_RCLKKEY		0x0020
 		#define GMETA_KEY_FN			0x0040
+		#define GMETA_KEY_REPEAT		0x0080		// This key down is a repeat of the key being held down
 		#define GMETA_KEY_MISSED_EVENT	0x8000
 	uint16_t		last_buttons;			// The value of current_buttons on the last event
 } GEventKeyboard;
@@ -0,0 +1,77 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    include/ginput/lld/keyboard.h
+ * @brief   GINPUT LLD header file for keyboard drivers.
+ *
+ * @defgroup Keyboard Keyboard
+ * @ingroup GINPUT
+ * @{
+ */
+
+#ifndef _LLD_GINPUT_KEYBOARD_H
+#define _LLD_GINPUT_KEYBOARD_H
+
+#if GINPUT_NEED_KEYBOARD || defined(__DOXYGEN__)
+
+#include "ginput_lld_keyboard_config.h"
+
+// n			- Millisecs between poll's. TIME_INFINITE means the driver pushes key events itself.
+#ifndef GINPUT_KEYBOARD_POLL_PERIOD
+	#define GINPUT_KEYBOARD_POLL_PERIOD				TIME_INFINITE
+#endif
+
+// n			- The number of key events that can be buffered before keys are lost
+#ifndef GINPUT_KEYBOARD_QUEUE_SIZE
+	#define GINPUT_KEYBOARD_QUEUE_SIZE				16
+#endif
+
+// ms			- Millisecs a key must be held down before it starts to repeat. 0 turns off software key repeat.
+#ifndef GINPUT_KEYBOARD_REPEAT_DELAY
+	#define GINPUT_KEYBOARD_REPEAT_DELAY			500
+#endif
+
+// ms			- Millisecs between key repeats once repeating has started
+#ifndef GINPUT_KEYBOARD_REPEAT_PERIOD
+	#define GINPUT_KEYBOARD_REPEAT_PERIOD			100
+#endif
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	void ginput_lld_keyboard_init(void);
+
+	#if GINPUT_KEYBOARD_POLL_PERIOD != TIME_INFINITE
+		/* Called every GINPUT_KEYBOARD_POLL_PERIOD. The driver should report any key changes using ginputKeyboardPut() */
+		void ginput_lld_keyboard_poll(void);
+	#endif
+
+	/* This routine is provided to low level drivers to report a key going down or up from a thread context.
+	 *	A key down for a key that is already down is treated as a (hardware) key repeat.
+	 *	The event is queued and processed later by the GINPUT timer thread.
+	 */
+	void ginputKeyboardPut(uint16_t instance, uint16_t code, bool_t down);
+
+	/* This routine is provided to low level drivers to report a key going down or up from an ISR.
+	 *	It must be called with the system locked (as for any other I-class function).
+	 */
+	void ginputKeyboardPutI(uint16_t instance, uint16_t code, bool_t down);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GINPUT_NEED_KEYBOARD */
+
+#endif /* _LLD_GINPUT_KEYBOARD_H */
+/** @} */
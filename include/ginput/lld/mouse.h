@@ -41,11 +41,16 @@
 	#define GINPUT_MOUSE_MAX_CALIBRATION_ERROR		-1
 #endif
 
-// n			- How many times to read (and average) per poll
+// n			- How many times to read per poll (the median reading is used)
 #ifndef GINPUT_MOUSE_READ_CYCLES
 	#define GINPUT_MOUSE_READ_CYCLES				1
 #endif
 
+// n			- Raw reading movement ignored while the pen stays down (0 = none)
+#ifndef GINPUT_MOUSE_READ_HYSTERESIS
+	#define GINPUT_MOUSE_READ_HYSTERESIS			0
+#endif
+
 // n			 - Millisecs between poll's
 #ifndef GINPUT_MOUSE_POLL_PERIOD
 	#define GINPUT_MOUSE_POLL_PERIOD				25
@@ -66,6 +71,31 @@
 	#define GINPUT_MOUSE_CLICK_TIME					700
 #endif
 
+// TRUE/FALSE	- Is the driver woken by a pen down interrupt? If so there is no polling while the panel is untouched.
+#ifndef GINPUT_MOUSE_PEN_IRQ
+	#define GINPUT_MOUSE_PEN_IRQ					FALSE
+#endif
+
+// n			- Millisecs between reads while the pen is moving (pen interrupt mode only).
+//					While the pen is held still this slows down to GINPUT_MOUSE_POLL_PERIOD.
+#ifndef GINPUT_MOUSE_PEN_POLL_PERIOD
+	#define GINPUT_MOUSE_PEN_POLL_PERIOD			10
+#endif
+
+// TRUE/FALSE	- Take the median of the last 3 readings while the pen is down (removes single sample spikes)
+#ifndef GINPUT_MOUSE_FILTER_MEDIAN
+	#define GINPUT_MOUSE_FILTER_MEDIAN				FALSE
+#endif
+
+// n			- Smooth readings while the pen is down. Each reading moves the position 1/2^n of the way. 0 = no smoothing
+#ifndef GINPUT_MOUSE_FILTER_IIR
+	#define GINPUT_MOUSE_FILTER_IIR					0
+#endif
+
+#if GINPUT_MOUSE_PEN_IRQ && GINPUT_MOUSE_POLL_PERIOD == TIME_INFINITE
+	#error "GINPUT: GINPUT_MOUSE_POLL_PERIOD can not be TIME_INFINITE when GINPUT_MOUSE_PEN_IRQ is TRUE"
+#endif
+
 
 typedef struct MouseReading_t {
 	coord_t		x, y, z;
@@ -103,6 +133,22 @@ extern "C" {
 	 */
 	void ginput_lld_mouse_get_reading(MouseReading *pt);
 
+	#if GINPUT_MOUSE_PEN_IRQ
+		/**
+		 * @brief   Enable or disable the pen down interrupt.
+		 *
+		 * @param[in] enable	TRUE when the pen has been released and GINPUT has stopped polling.
+		 * 						FALSE when the pen is down and GINPUT is polling.
+		 *
+		 * @note	The pen down interrupt handler should call ginputMouseWakeupI().
+		 * @note	If the pen is already down when the interrupt is enabled the driver
+		 * 			should call ginputMouseWakeup() so that the touch is not missed.
+		 *
+		 * @notapi
+		 */
+		void ginput_lld_mouse_pen_irq(bool_t enable);
+	#endif
+
 	#if GINPUT_MOUSE_LLD_CALIBRATION_LOADSAVE
 		/**
 		 * @brief   Load calibration data from a storage area on the touch controller.
@@ -35,7 +35,7 @@
 	 * @details	Defaults to FALSE
 	 * @note	Also add the a keyboard hardware driver to your makefile.
 	 * 			Eg.
-	 * 				include $(GFXLIB)/drivers/ginput/keyboard/XXXX/ginput_lld.mk
+	 * 				include $(GFXLIB)/drivers/ginput/keyboard/Stdin/ginput_lld.mk
 	 */
 	#ifndef GINPUT_NEED_KEYBOARD
 		#define GINPUT_NEED_KEYBOARD	FALSE
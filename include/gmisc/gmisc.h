@@ -51,8 +51,41 @@ typedef int32_t	fixed;
 #define NONFIXED(x)		((x)>>16)					/* @< fixed to integer */
 #define FP2FIXED(x)		((fixed)((x)*65536.0))		/* @< floating point to fixed */
 #define FIXED2FP(x)		((double)(x)/65536.0)		/* @< fixed to floating point */
+#define FIXED0_5		32768						/* @< 0.5 as a fixed (used for rounding) */
+#define FIXEDMUL(a,b)	((fixed)(((int64_t)(a)*(b)+FIXED0_5)>>16))	/* @< multiply two fixed with rounding */
 /* @} */
 
+/**
+ * @brief   An angle in binary angle units.
+ * @details	A full turn is 65536 units so angles wrap around for free and
+ * 			one unit is about 0.0055 degrees.
+ */
+typedef uint16_t	binangle;
+
+/**
+ * @brief   Macros to convert to and from binary angle units.
+ * @{
+ */
+#define BINANGLE(degrees)		((binangle)(((int64_t)(degrees)*11930465L+32768)>>16))	/* @< integer degrees to binangle (rounded) */
+#define FIXED2BINANGLE(fdeg)	((binangle)((fixed)(fdeg)/360))				/* @< fixed degrees to binangle */
+#define BINANGLE2FIXED(a)		((fixed)(a)*360)							/* @< binangle to fixed degrees 0 .. 360 */
+/* @} */
+
+/**
+ * @brief   A Q15 fixed point number.
+ * @details	1 sign bit and 15 fraction bits giving -1.0 .. 0.99997.
+ * @note	This is the same as ARRAY_DATA_16BITSIGNED sample data.
+ */
+typedef int16_t	q15;
+
+/**
+ * @brief   A complex number made from two Q15 fixed point numbers.
+ */
+typedef struct q15complex_t {
+	q15		re;
+	q15		im;
+	} q15complex;
+
 /**
  * @brief   The famous number pi
  */
@@ -63,6 +96,24 @@ typedef int32_t	fixed;
  */
 #define FIXED_PI	FP2FIXED(PI)
 
+#if (GFX_USE_GMISC && GMISC_NEED_PERF) || defined(__DOXYGEN__)
+	/**
+	 * @brief   A reading of (or an interval measured by) the performance clock
+	 */
+	typedef GMISC_PERF_TYPE		perftime_t;
+
+	/**
+	 * @brief   Read the performance clock
+	 * @note	Intervals are found by subtracting two readings. This works across the counter wrapping.
+	 */
+	#define gmiscPerfClock()		((perftime_t)GMISC_PERF_CLOCK())
+
+	/**
+	 * @brief   Convert a performance clock interval to microseconds
+	 */
+	#define gmiscPerfToMicroseconds(t)	((uint32_t)((uint64_t)(t) * 1000000 / (GMISC_PERF_CLOCK_HZ)))
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -96,19 +147,100 @@ extern "C" {
 	 */
 	void gmiscArrayConvert(ArrayDataFormat srcfmt, void *src, ArrayDataFormat dstfmt, void *dst, size_t cnt);
 
-	#if 0
-		void gmiscArrayTranslate(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int trans);
+	/**
+	 * @brief				Add a constant to each element of an array.
+	 *
+	 * @param[in] fmt			The format of the arrays
+	 * @param[in] src			The source array
+	 * @param[in] dst			The destination array (which can be the same as the source array)
+	 * @param[in] cnt			The number of array elements
+	 * @param[in] trans			The amount to add
+	 *
+	 * @note				Elements of a signed format are treated as signed values.
+	 * @note				The result wraps to the bit width of the format.
+	 * @note				This and the arithmetic routines below are optimised to work a word at a time where they can.
+	 * 						The arrays should be word aligned to get the benefit.
+	 *
+	 * @api
+	 */
+	void gmiscArrayTranslate(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int trans);
 
-		void gmiscArrayMultiply(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mult);
+	/**
+	 * @brief				Multiply each element of an array by a constant.
+	 *
+	 * @param[in] fmt			The format of the arrays
+	 * @param[in] src			The source array
+	 * @param[in] dst			The destination array (which can be the same as the source array)
+	 * @param[in] cnt			The number of array elements
+	 * @param[in] mult			The multiplier
+	 *
+	 * @note				The result wraps to the bit width of the format.
+	 *
+	 * @api
+	 */
+	void gmiscArrayMultiply(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mult);
 
-		void gmiscArrayDivide(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mdiv);
+	/**
+	 * @brief				Divide each element of an array by a constant.
+	 *
+	 * @param[in] fmt			The format of the arrays
+	 * @param[in] src			The source array
+	 * @param[in] dst			The destination array (which can be the same as the source array)
+	 * @param[in] cnt			The number of array elements
+	 * @param[in] mdiv			The divisor. Nothing is done if this is 0.
+	 *
+	 * @note				The result is truncated towards zero.
+	 *
+	 * @api
+	 */
+	void gmiscArrayDivide(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mdiv);
 
-		void gmiscArrayMultDiv(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mult, int div);
+	/**
+	 * @brief				Multiply each element of an array by a constant and then divide by another constant.
+	 *
+	 * @param[in] fmt			The format of the arrays
+	 * @param[in] src			The source array
+	 * @param[in] dst			The destination array (which can be the same as the source array)
+	 * @param[in] cnt			The number of array elements
+	 * @param[in] mult			The multiplier
+	 * @param[in] div			The divisor. Nothing is done if this is 0.
+	 *
+	 * @note				The intermediate result is 32 bits so mult must be less than 65536 for 16 bit formats.
+	 * @note				The result wraps to the bit width of the format.
+	 *
+	 * @api
+	 */
+	void gmiscArrayMultDiv(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mult, int div);
 
-		void gmiscArrayAdd(ArrayDataFormat fmt, void *src1, void *src2, void *dst, size_t cnt);
+	/**
+	 * @brief				Add two arrays element by element.
+	 *
+	 * @param[in] fmt			The format of the arrays
+	 * @param[in] src1			The first source array
+	 * @param[in] src2			The second source array
+	 * @param[in] dst			The destination array (which can be the same as either source array)
+	 * @param[in] cnt			The number of array elements
+	 *
+	 * @note				The result wraps to the bit width of the format.
+	 *
+	 * @api
+	 */
+	void gmiscArrayAdd(ArrayDataFormat fmt, void *src1, void *src2, void *dst, size_t cnt);
 
-		void gmiscArrayAddNoOverflow(ArrayDataFormat fmt, void *src1, void *src2, void *dst, size_t cnt);
-	#endif
+	/**
+	 * @brief				Add two arrays element by element, limiting the result to the range of the format.
+	 *
+	 * @param[in] fmt			The format of the arrays
+	 * @param[in] src1			The first source array
+	 * @param[in] src2			The second source array
+	 * @param[in] dst			The destination array (which can be the same as either source array)
+	 * @param[in] cnt			The number of array elements
+	 *
+	 * @note				On a Cortex-M4 the 8 and 16 bit formats use the DSP saturating add instructions.
+	 *
+	 * @api
+	 */
+	void gmiscArrayAddNoOverflow(ArrayDataFormat fmt, void *src1, void *src2, void *dst, size_t cnt);
 #endif
 
 #if GMISC_NEED_FASTTRIG || defined(__DOXYGEN__)
@@ -181,6 +313,281 @@ extern "C" {
 		/** @} */
 #endif
 
+#if GMISC_NEED_FIXEDMATH || defined(__DOXYGEN__)
+	/**
+	 * @brief	Interpolated fixed point sin() and cos()
+	 * @return	A fixed point in the range -1.0 .. 0.0 .. 1.0
+	 *
+	 * @param[in] angle		The angle in binary angle units
+	 *
+	 * @note	The error is less than 2/65536 at any angle.
+	 *
+	 * @api
+	 * @{
+	 */
+	fixed gmiscFixedSin(binangle angle);
+	fixed gmiscFixedCos(binangle angle);
+	/** @} */
+
+	/**
+	 * @brief	The angle of the vector (x,y) from the positive x axis
+	 * @return	The angle in binary angle units (0 if x and y are both 0)
+	 *
+	 * @param[in] y, x		The vector. Any scale can be used as only the ratio matters.
+	 *
+	 * @note	Uses a 16 step CORDIC. The error is about 1 binary angle unit.
+	 *
+	 * @api
+	 */
+	binangle gmiscFixedAtan2(fixed y, fixed x);
+
+	/**
+	 * @brief	Integer square root
+	 * @return	The square root rounded down
+	 *
+	 * @param[in] n		The number
+	 *
+	 * @api
+	 */
+	uint16_t gmiscISqrt(uint32_t n);
+
+	/**
+	 * @brief	Fixed point square root
+	 * @return	The square root rounded to the nearest fixed point value (0 for a negative number)
+	 *
+	 * @param[in] x		The number
+	 *
+	 * @api
+	 */
+	fixed gmiscFixedSqrt(fixed x);
+
+	/**
+	 * @brief	Fixed point divide
+	 * @return	a / b rounded to the nearest fixed point value
+	 *
+	 * @param[in] a, b	The numerator and denominator
+	 *
+	 * @note	The result saturates on an overflow or a divide by zero.
+	 * @note	Use FIXEDMUL() to multiply.
+	 *
+	 * @api
+	 */
+	fixed gmiscFixedDiv(fixed a, fixed b);
+#endif
+
+#if GMISC_NEED_DSP || defined(__DOXYGEN__)
+	/**
+	 * @brief	The window applied to samples before an FFT
+	 */
+	typedef enum FFTWindow_e {
+		FFT_WINDOW_NONE, FFT_WINDOW_HANN, FFT_WINDOW_HAMMING, FFT_WINDOW_BLACKMAN
+		} FFTWindow;
+
+	/**
+	 * @brief	The state of a CIC decimator
+	 * @note	Initialise it with @p gmiscCICInit()
+	 */
+	typedef struct CICDecimator_t {
+		uint32_t	integ[GMISC_DSP_CIC_MAX_STAGES];
+		uint32_t	comb[GMISC_DSP_CIC_MAX_STAGES];
+		uint32_t	gain;
+		uint16_t	factor;
+		uint16_t	phase;
+		uint8_t		stages;
+		uint8_t		shift;
+		} CICDecimator;
+
+	/**
+	 * @brief	The state of a FIR decimator
+	 * @note	Initialise it with @p gmiscFIRInit()
+	 */
+	typedef struct FIRDecimator_t {
+		const q15	*coeffs;
+		q15			*history;
+		uint16_t	ntaps;
+		uint16_t	factor;
+		uint16_t	pos;
+		uint16_t	phase;
+		} FIRDecimator;
+
+	/**
+	 * @brief				Load raw samples into an FFT buffer applying a window.
+	 *
+	 * @param[in] fmt			The format of the samples (eg. GAUDIN_SAMPLE_FORMAT)
+	 * @param[in] src			The samples. There must be 2^log2n of them.
+	 * @param[out] data			The FFT buffer. It must hold 2^log2n complex values.
+	 * @param[in] log2n			The size of the FFT as a power of 2
+	 * @param[in] window		The window to apply
+	 *
+	 * @note				Unsigned formats (like most ADCs) are centred on zero as they are loaded.
+	 *
+	 * @api
+	 */
+	void gmiscFFTLoad(ArrayDataFormat fmt, void *src, q15complex *data, unsigned log2n, FFTWindow window);
+
+	/**
+	 * @brief				An in-place radix-2 fixed point FFT.
+	 * @return				FALSE if the size is not supported
+	 *
+	 * @param[in,out] data		The complex values to transform
+	 * @param[in] log2n			The size of the FFT as a power of 2 (1 .. GMISC_DSP_FFT_MAX_LOG2)
+	 * @param[in] inverse		TRUE for an inverse FFT
+	 *
+	 * @note				Each pass is scaled by 1/2 so the result is divided by 2^log2n and cannot overflow.
+	 * 						A full scale sine wave gives a bin of about 0.5 (0.25 with a Hann window).
+	 * @note				For real input only the first half of the bins are useful. The second half are
+	 * 						their mirror image.
+	 *
+	 * @api
+	 */
+	bool_t gmiscFFT(q15complex *data, unsigned log2n, bool_t inverse);
+
+	/**
+	 * @brief				Get the magnitude of FFT bins.
+	 *
+	 * @param[in] data			The FFT result
+	 * @param[out] mag			The magnitudes
+	 * @param[in] cnt			The number of bins
+	 *
+	 * @note				mag may be the same buffer as data.
+	 *
+	 * @api
+	 */
+	void gmiscFFTMagnitude(q15complex *data, q15 *mag, size_t cnt);
+
+	/**
+	 * @brief				Initialise a CIC decimator.
+	 * @return				FALSE if the parameters are not supported
+	 *
+	 * @param[in] pcic			The decimator state
+	 * @param[in] stages		The number of integrator/comb stages (1 .. GMISC_DSP_CIC_MAX_STAGES)
+	 * @param[in] factor		The decimation factor
+	 *
+	 * @note				factor^stages must be no more than 65536. A power of 2 avoids a divide for each output.
+	 *
+	 * @api
+	 */
+	bool_t gmiscCICInit(CICDecimator *pcic, unsigned stages, unsigned factor);
+
+	/**
+	 * @brief				Decimate raw samples with a CIC filter.
+	 * @return				The number of Q15 samples written to dst
+	 *
+	 * @param[in] pcic			The decimator state
+	 * @param[in] fmt			The format of the samples (eg. GAUDIN_SAMPLE_FORMAT)
+	 * @param[in] src			The samples
+	 * @param[in] cnt			The number of samples
+	 * @param[out] dst			The decimated samples. It must have room for (cnt + factor - 1) / factor samples.
+	 *
+	 * @note				The state is kept between calls so a stream can be processed a buffer at a time.
+	 *
+	 * @api
+	 */
+	size_t gmiscCICDecimate(CICDecimator *pcic, ArrayDataFormat fmt, void *src, size_t cnt, q15 *dst);
+
+	/**
+	 * @brief				Initialise a FIR decimator.
+	 *
+	 * @param[in] pfir			The decimator state
+	 * @param[in] coeffs		The filter coefficients as Q15. They are not copied.
+	 * @param[in] history		A buffer of ntaps samples to hold the filter history
+	 * @param[in] ntaps			The number of coefficients
+	 * @param[in] factor		The decimation factor (1 for a plain FIR filter)
+	 *
+	 * @api
+	 */
+	void gmiscFIRInit(FIRDecimator *pfir, const q15 *coeffs, q15 *history, unsigned ntaps, unsigned factor);
+
+	/**
+	 * @brief				Filter and decimate Q15 samples.
+	 * @return				The number of samples written to dst
+	 *
+	 * @param[in] pfir			The decimator state
+	 * @param[in] src			The samples
+	 * @param[in] cnt			The number of samples
+	 * @param[out] dst			The filtered samples. This may be the same buffer as src.
+	 *
+	 * @note				Only the outputs that are kept are calculated. A CIC decimator followed by a short
+	 * 						FIR to flatten its response is a cheap way to drop the sample rate a long way.
+	 *
+	 * @api
+	 */
+	size_t gmiscFIRDecimate(FIRDecimator *pfir, const q15 *src, size_t cnt, q15 *dst);
+
+	/**
+	 * @brief				Measure the RMS and peak level of raw samples.
+	 *
+	 * @param[in] fmt			The format of the samples (eg. GAUDIN_SAMPLE_FORMAT)
+	 * @param[in] src			The samples
+	 * @param[in] cnt			The number of samples
+	 * @param[out] prms			Returns the RMS level as Q15. Can be NULL.
+	 * @param[out] ppeak		Returns the peak level as Q15. Can be NULL.
+	 *
+	 * @api
+	 */
+	void gmiscLevels(ArrayDataFormat fmt, void *src, size_t cnt, q15 *prms, q15 *ppeak);
+#endif
+
+#if GMISC_NEED_TRACE || defined(__DOXYGEN__)
+	/**
+	 * @brief				The function that receives the trace text from gmiscTraceDump()
+	 *
+	 * @param[in] param			The parameter passed to gmiscTraceDump()
+	 * @param[in] str			The next piece of the trace (a nul terminated string)
+	 */
+	typedef void (*TraceWriteFn)(void *param, const char *str);
+
+	/**
+	 * @brief				Record an operation that has just finished
+	 *
+	 * @param[in] cat			The category (usually the module name eg "gdisp")
+	 * @param[in] name			The operation
+	 * @param[in] start			When it started (from gmiscPerfClock())
+	 *
+	 * @note				The cat and name strings are not copied so they must be constant.
+	 * @note				This may be called from any thread (but not an interrupt).
+	 *
+	 * @api
+	 */
+	void gmiscTraceComplete(const char *cat, const char *name, perftime_t start);
+
+	/**
+	 * @brief				Record a moment in time
+	 *
+	 * @param[in] cat			The category
+	 * @param[in] name			What happened
+	 *
+	 * @api
+	 */
+	void gmiscTraceInstant(const char *cat, const char *name);
+
+	/**
+	 * @brief				Record the value of a counter (eg a queue depth)
+	 *
+	 * @param[in] cat			The category
+	 * @param[in] name			The counter
+	 * @param[in] value			Its value now
+	 *
+	 * @api
+	 */
+	void gmiscTraceCounter(const char *cat, const char *name, uint32_t value);
+
+	/**
+	 * @brief				Empty the trace buffer as a Chrome trace
+	 *
+	 * @param[in] fn			The function to write the text
+	 * @param[in] param			A parameter to pass to fn
+	 *
+	 * @details				The output is the JSON loaded by chrome://tracing (and Perfetto).
+	 * 						Times are in microseconds from the performance clock.
+	 * @note				The records are removed as they are written. Records made during
+	 * 						the dump are included.
+	 *
+	 * @api
+	 */
+	void gmiscTraceDump(TraceWriteFn fn, void *param);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
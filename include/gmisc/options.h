@@ -41,12 +41,93 @@
 	#ifndef GMISC_NEED_FIXEDTRIG
 		#define GMISC_NEED_FIXEDTRIG		FALSE
 	#endif
+	/**
+	 * @brief   Include fixed point math (interpolated sin and cos, atan2, sqrt, divide)
+	 * @details	Defaults to FALSE
+	 */
+	#ifndef GMISC_NEED_FIXEDMATH
+		#define GMISC_NEED_FIXEDMATH		FALSE
+	#endif
+	/**
+	 * @brief   Include fixed point signal processing (FFT, decimation, levels)
+	 * @details	Defaults to FALSE
+	 */
+	#ifndef GMISC_NEED_DSP
+		#define GMISC_NEED_DSP				FALSE
+	#endif
+	/**
+	 * @brief   Include the performance clock used by the module statistics
+	 * @details	Defaults to FALSE
+	 * @note	GDISP_NEED_STATS, GEVENT_NEED_STATS and GTIMER_NEED_STATS turn this on.
+	 */
+	#ifndef GMISC_NEED_PERF
+		#define GMISC_NEED_PERF				FALSE
+	#endif
+	/**
+	 * @brief   Include the trace buffer (read out in Chrome trace format)
+	 * @details	Defaults to FALSE
+	 * @note	Modules with statistics turned on also record each operation in the trace buffer.
+	 */
+	#ifndef GMISC_NEED_TRACE
+		#define GMISC_NEED_TRACE			FALSE
+	#endif
 /**
  * @}
  *
  * @name    GMISC Optional Sizing Parameters
  * @{
  */
+	/**
+	 * @brief   The largest FFT supported as a power of 2.
+	 * @details	Defaults to 10 (1024 points) which is also the maximum.
+	 */
+	#ifndef GMISC_DSP_FFT_MAX_LOG2
+		#define GMISC_DSP_FFT_MAX_LOG2		10
+	#endif
+	/**
+	 * @brief   The most stages a CIC decimator can have.
+	 * @details	Defaults to 4
+	 */
+	#ifndef GMISC_DSP_CIC_MAX_STAGES
+		#define GMISC_DSP_CIC_MAX_STAGES	4
+	#endif
+	/**
+	 * @brief   The number of records in the trace buffer.
+	 * @details	Defaults to 256. Each record is 20 bytes on a 32 bit cpu.
+	 * @note	When it is full the oldest records are overwritten.
+	 */
+	#ifndef GMISC_TRACE_SIZE
+		#define GMISC_TRACE_SIZE			256
+	#endif
+/**
+ * @}
+ *
+ * @name    GMISC Performance Clock
+ * @brief	The system tick is usually too coarse to time a single drawing operation.
+ * 			Set these to use a faster free running counter (eg the Cortex-M DWT cycle counter).
+ * @{
+ */
+	/**
+	 * @brief   Read the performance clock
+	 * @details	Defaults to gfxSystemTicks()
+	 */
+	#ifndef GMISC_PERF_CLOCK
+		#define GMISC_PERF_CLOCK()			gfxSystemTicks()
+	#endif
+	/**
+	 * @brief   The frequency of the performance clock in Hz
+	 * @details	Defaults to gfxMillisecondsToTicks(1000)
+	 */
+	#ifndef GMISC_PERF_CLOCK_HZ
+		#define GMISC_PERF_CLOCK_HZ			gfxMillisecondsToTicks(1000)
+	#endif
+	/**
+	 * @brief   The unsigned type returned by the performance clock
+	 * @details	Defaults to systemticks_t
+	 */
+	#ifndef GMISC_PERF_TYPE
+		#define GMISC_PERF_TYPE				systemticks_t
+	#endif
 /** @} */
 
 #endif /* _GMISC_OPTIONS_H */
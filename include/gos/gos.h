@@ -427,5 +427,95 @@
 	#error "Your operating system is not supported yet"
 #endif
 
+#if GOS_NEED_POOLS || defined(__DOXYGEN__)
+	/**
+	 * @brief	A pool of fixed size memory blocks
+	 * @note	The statistics may be read directly. Everything else is private.
+	 */
+	typedef struct gfxPool {
+		void *		freelist;
+		uint8_t *	mem;
+		uint8_t *	memend;
+		size_t		blocksize;		/**< The size of each block */
+		uint16_t	count;			/**< The number of blocks */
+		uint16_t	used;			/**< The number of blocks in use now */
+		uint16_t	maxused;		/**< The most blocks that have been in use at once */
+		uint32_t	failed;			/**< How many allocations found the pool empty */
+	} gfxPool;
+
+	#ifdef __cplusplus
+	extern "C" {
+	#endif
+
+	/**
+	 * @brief	Initialise a pool of fixed size memory blocks
+	 *
+	 * @param[in] pool		The pool
+	 * @param[in] mem		The memory for the blocks (at least blocksize * count bytes)
+	 * @param[in] blocksize	The size of each block. It is rounded up to keep the blocks aligned.
+	 * @param[in] count		The number of blocks
+	 *
+	 * @api
+	 */
+	void gfxPoolInit(gfxPool *pool, void *mem, size_t blocksize, size_t count);
+
+	/**
+	 * @brief	Allocate a block from a pool
+	 * @return	The block or NULL if the pool is empty
+	 *
+	 * @param[in] pool		The pool
+	 *
+	 * @api
+	 */
+	void *gfxPoolAlloc(gfxPool *pool);
+
+	/**
+	 * @brief	Return a block to its pool
+	 *
+	 * @param[in] pool		The pool
+	 * @param[in] ptr		The block
+	 *
+	 * @api
+	 */
+	void gfxPoolFree(gfxPool *pool, void *ptr);
+
+	/**
+	 * @brief	Allocate memory from the smallest of the GOS_POOL_SIZES pools that fits
+	 * @return	A pointer to the memory allocated or NULL if there is no more memory available
+	 *
+	 * @param[in] sz	The size in bytes of the area to allocate
+	 *
+	 * @note	If that pool is empty the next larger pool is tried. If they are all empty
+	 * 			(or sz is bigger than all of them) the memory comes from gfxAlloc().
+	 * @note	The memory must be freed with gfxFreePooled().
+	 *
+	 * @api
+	 */
+	void *gfxAllocPooled(size_t sz);
+
+	/**
+	 * @brief	Free memory from gfxAllocPooled()
+	 *
+	 * @param[in] ptr	The memory to free (NULL is ignored)
+	 *
+	 * @api
+	 */
+	void gfxFreePooled(void *ptr);
+
+	/**
+	 * @brief	Get one of the GOS_POOL_SIZES pools so its statistics can be read
+	 * @return	The pool or NULL if there are not that many pools
+	 *
+	 * @param[in] n		The pool number (0 is the smallest)
+	 *
+	 * @api
+	 */
+	const gfxPool *gfxPoolGetClass(unsigned n);
+
+	#ifdef __cplusplus
+	}
+	#endif
+#endif
+
 #endif /* _GOS_H */
 /** @} */
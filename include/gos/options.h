@@ -54,12 +54,43 @@
 	#ifndef GFX_USE_OS_POSIX
 		#define GFX_USE_OS_POSIX		FALSE
 	#endif
+/**
+ * @}
+ *
+ * @name    GOS Functionality to be included
+ * @{
+ */
+	/**
+	 * @brief   Should the fixed size memory pools be included.
+	 * @details	Defaults to FALSE
+	 * @note	Small allocations that come and go (eg windows and image decoders)
+	 * 			fragment the heap. The pools keep them apart from it.
+	 */
+	#ifndef GOS_NEED_POOLS
+		#define GOS_NEED_POOLS			FALSE
+	#endif
 /**
  * @}
  *
  * @name    GOS Optional Sizing Parameters
  * @{
  */
+	/**
+	 * @brief   The block sizes of the pools used by gfxAllocPooled()
+	 * @details	Defaults to 16, 32, 64, 128, 256
+	 * @note	These must be in increasing order.
+	 */
+	#ifndef GOS_POOL_SIZES
+		#define GOS_POOL_SIZES			16, 32, 64, 128, 256
+	#endif
+	/**
+	 * @brief   The number of blocks in each of the pools used by gfxAllocPooled()
+	 * @details	Defaults to 16, 16, 8, 4, 2
+	 * @note	There must be one for each of GOS_POOL_SIZES.
+	 */
+	#ifndef GOS_POOL_COUNTS
+		#define GOS_POOL_COUNTS			16, 16, 8, 4, 2
+	#endif
 /** @} */
 
 #endif /* _GOS_OPTIONS_H */
@@ -58,6 +58,20 @@ typedef struct GTimer_t {
 	struct GTimer_t		*prev;
 } GTimer;
 
+#if GTIMER_NEED_STATS || defined(__DOXYGEN__)
+	/**
+	 * @brief	The timer statistics
+	 */
+	typedef struct GTimerStats_t {
+		uint32_t		fired;				/**< Timer callbacks made */
+		uint32_t		jabbed;				/**< How many of those were due to a jab */
+		systemticks_t	latemax;			/**< The latest a timer has been called (in system ticks) */
+		systemticks_t	latetotal;			/**< The total lateness of the timers not jabbed */
+		perftime_t		callbackmax;		/**< The longest time spent in a callback (in performance clock units) */
+		perftime_t		callbacktotal;		/**< The total time spent in callbacks */
+	} GTimerStats;
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -159,6 +173,27 @@ void gtimerJab(GTimer *pt);
  */
 void gtimerJabI(GTimer *pt);
 
+#if GTIMER_NEED_STATS || defined(__DOXYGEN__)
+	/**
+	 * @brief				Get a copy of the timer statistics
+	 *
+	 * @param[out] pstats	Where to put them
+	 *
+	 * @note				A callback is late if it is made after the time it was due.
+	 * 						This is usually because another callback took too long.
+	 *
+	 * @api
+	 */
+	void gtimerGetStats(GTimerStats *pstats);
+
+	/**
+	 * @brief				Set all the timer statistics back to zero
+	 *
+	 * @api
+	 */
+	void gtimerResetStats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
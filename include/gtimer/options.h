@@ -20,6 +20,14 @@
  * @name    GTIMER Functionality to be included
  * @{
  */
+	/**
+	 * @brief   Are the timer statistics (gtimerGetStats()) required.
+	 * @details	Defaults to FALSE
+	 * @note	This turns on GFX_USE_GMISC and GMISC_NEED_PERF.
+	 */
+	#ifndef GTIMER_NEED_STATS
+		#define GTIMER_NEED_STATS				FALSE
+	#endif
 /**
  * @}
  *
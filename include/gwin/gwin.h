@@ -544,6 +544,7 @@ void gwinBlitArea(GHandle gh, coord_t x, coord_t y, coord_t cx, coord_t cy, coor
 #include "gwin/graph.h"			/* 0x0003 */
 #include "gwin/slider.h"		/* 0x0004 */
 #include "gwin/checkbox.h"		/* 0x0005 */
+#include "gwin/spectrum.h"		/* 0x0006 */
 
 #endif /* GFX_USE_GWIN */
 
@@ -25,11 +25,20 @@
 #define GBTN_FLG_ALLOCTXT				0x0002
 #define GWIN_FIRST_CONTROL_FLAG			0x0004
 
+/* The memory allocator for dynamic window objects and button text */
+#if GWIN_USE_POOLS
+	#define _gwinAlloc(sz)				gfxAllocPooled(sz)
+	#define _gwinFree(ptr)				gfxFreePooled(ptr)
+#else
+	#define _gwinAlloc(sz)				gfxAlloc(sz)
+	#define _gwinFree(ptr)				gfxFree(ptr)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-GHandle _gwinInit(GWindowObject *gw, coord_t x, coord_t y, coord_t width, coord_t height, size_t size);
+GHandle _gwindowInit(GWindowObject *gw, coord_t x, coord_t y, coord_t width, coord_t height, size_t size);
 
 #ifdef __cplusplus
 }
@@ -53,6 +53,14 @@
 	#ifndef GWIN_NEED_SLIDER
 		#define GWIN_NEED_SLIDER	FALSE
 	#endif
+	/**
+	 * @brief   Should spectrum functions be included.
+	 * @details	Defaults to FALSE
+	 * @note	Use with GMISC_NEED_DSP to calculate the spectrum.
+	 */
+	#ifndef GWIN_NEED_SPECTRUM
+		#define GWIN_NEED_SPECTRUM	FALSE
+	#endif
 /**
  * @}
  *
@@ -80,6 +88,22 @@
 	#ifndef GWIN_CONSOLE_USE_BASESTREAM
 		#define GWIN_CONSOLE_USE_BASESTREAM		FALSE
 	#endif
+	/**
+	 * @brief   The maximum number of bars in a spectrum window
+	 * @details	Defaults to 64
+	 * @note	Each bar costs a coord_t in every spectrum window object for its peak marker.
+	 */
+	#ifndef GWIN_SPECTRUM_MAX_BARS
+		#define GWIN_SPECTRUM_MAX_BARS			64
+	#endif
+	/**
+	 * @brief   Dynamically created windows (and button text) come from the GOS memory pools
+	 * @details	Defaults to FALSE
+	 * @note	This turns on GOS_NEED_POOLS. Windows bigger than the largest pool still use the heap.
+	 */
+	#ifndef GWIN_USE_POOLS
+		#define GWIN_USE_POOLS					FALSE
+	#endif
 /** @} */
 
 #endif /* _GWIN_OPTIONS_H */
@@ -0,0 +1,105 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file	include/gwin/spectrum.h
+ * @brief	GWIN SPECTRUM module header file.
+ *
+ * @defgroup Spectrum Spectrum
+ * @ingroup GWIN
+ *
+ * @details	A spectrum window draws a bar for each frequency bin of an FFT, for instance
+ * 			the magnitudes returned by @p gmiscFFTMagnitude().
+ * @pre		GFX_USE_GWIN must be set to TRUE in your gfxconf.h
+ * @pre		GWIN_NEED_SPECTRUM must be set to TRUE in your gfxconf.h
+ *
+ * @{
+ */
+
+#ifndef _GWIN_SPECTRUM_H
+#define _GWIN_SPECTRUM_H
+
+#if GWIN_NEED_SPECTRUM || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.														 */
+/*===========================================================================*/
+
+#define GW_SPECTRUM				0x0006
+
+/*===========================================================================*/
+/* Type definitions                                                          */
+/*===========================================================================*/
+
+// A spectrum window
+typedef struct GSpectrumObject_t {
+	GWindowObject		gwin;
+	color_t				peakcolor;
+	uint8_t				range;			// The dB range shown for a log scale (0 for a linear scale)
+	uint8_t				decay;			// How fast the peak markers fall (pixels per draw)
+	coord_t				peaks[GWIN_SPECTRUM_MAX_BARS];
+	} GSpectrumObject;
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief				Create a spectrum window.
+ * @return				NULL if there is no resultant drawing area, otherwise a window handle.
+ *
+ * @param[in] gs		The GSpectrumObject structure to initialise. If this is NULL the structure is dynamically allocated.
+ * @param[in] x,y		The screen co-ordinates for the top left corner of the window
+ * @param[in] width		The width of the window
+ * @param[in] height	The height of the window
+ *
+ * @note				The bars are drawn in the window color on the window background color.
+ * @note				The default is a 60dB log scale with peak markers in White.
+ *
+ * @api
+ */
+GHandle gwinCreateSpectrum(GSpectrumObject *gs, coord_t x, coord_t y, coord_t width, coord_t height);
+
+/**
+ * @brief				Set how the spectrum is drawn.
+ *
+ * @param[in] gh		The window handle (must be a spectrum window)
+ * @param[in] range		The dB range of a log scale (eg. 60) or 0 for a linear scale
+ * @param[in] peakcolor	The color of the peak markers
+ * @param[in] decay		How many pixels the peak markers fall each time the spectrum is drawn. 0 turns them off.
+ *
+ * @api
+ */
+void gwinSpectrumSetStyle(GHandle gh, uint8_t range, color_t peakcolor, uint8_t decay);
+
+/**
+ * @brief				Draw a spectrum.
+ *
+ * @param[in] gh		The window handle (must be a spectrum window)
+ * @param[in] mag		The magnitude of each bin as Q15
+ * @param[in] bins		The number of bins
+ *
+ * @note				Bins are shared out across the width of the window. Where several bins fall
+ * 						into one bar the largest is shown. At most GWIN_SPECTRUM_MAX_BARS bars are drawn.
+ * @note				Each bar is redrawn over the top of the last so there is no flicker.
+ *
+ * @api
+ */
+void gwinSpectrumDraw(GHandle gh, const q15 *mag, size_t bins);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* GWIN_NEED_SPECTRUM */
+
+#endif	/* _GWIN_SPECTRUM_H */
+/** @} */
@@ -30,6 +30,32 @@
 	#ifndef TDISP_NEED_READ
 		#define TDISP_NEED_READ				FALSE
 	#endif
+	/**
+	 * @brief   Draw into a RAM copy of the display and only send the changes to the display.
+	 * @details	Defaults to FALSE
+	 * @details	If TRUE, drawing only updates RAM. The display is updated by calling tdispFlush()
+	 * 			or periodically if TDISP_BUFFER_FLUSH_PERIOD is set.
+	 * @note	The buffer is TDISP_COLUMNS x TDISP_ROWS characters.
+	 * @note	Display shifting (tdispSetShiftMode(shiftOn)) is not supported in this mode.
+	 */
+	#ifndef TDISP_NEED_BUFFER
+		#define TDISP_NEED_BUFFER			FALSE
+	#endif
+/**
+ * @}
+ *
+ * @name    TDISP Buffer Options
+ * @pre		TDISP_NEED_BUFFER must be TRUE
+ * @{
+ */
+	/**
+	 * @brief   How often (in milliseconds) the buffer is automatically flushed to the display.
+	 * @details	Defaults to 0 (no automatic flushing - call tdispFlush())
+	 * @note	Automatic flushing requires GTIMER and TDISP_NEED_MULTITHREAD.
+	 */
+	#ifndef TDISP_BUFFER_FLUSH_PERIOD
+		#define TDISP_BUFFER_FLUSH_PERIOD	0
+	#endif
 /**
  * @}
  *
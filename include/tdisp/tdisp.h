@@ -183,6 +183,17 @@ void tdispDrawChar(char c);
  */
 void tdispDrawString(char *s);
 
+#if TDISP_NEED_BUFFER || defined(__DOXYGEN__)
+	/**
+	 * @brief	Send any changes drawn since the last flush to the display
+	 *
+	 * @note	Only the characters that have changed are sent. Runs of changed characters
+	 * 			on a row are sent without moving the cursor in between.
+	 * @note	This is called automatically if TDISP_BUFFER_FLUSH_PERIOD is set.
+	 */
+	void tdispFlush(void);
+#endif
+
 /**
  * @brief		Scrolls the display to the left or right by an amout of positions with a certain delay between each position
  * 
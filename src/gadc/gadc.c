@@ -40,31 +40,36 @@ static GTimer	LowSpeedGTimer;
 
 static volatile uint16_t	gflags = 0;
 	#define GADC_GFLG_ISACTIVE	0x0001
+	#define GADC_GFLG_HSACTIVE	0x0002
 
 #define GADC_FLG_ISACTIVE	0x0001
 #define GADC_FLG_ISDONE		0x0002
 #define GADC_FLG_ERROR		0x0004
 #define GADC_FLG_GTIMER		0x0008
+#define GADC_FLG_LEGACY		0x0010
 
 static struct hsdev {
 	// Our status flags
 	uint16_t				flags;
 
-	// What we started with
-	uint32_t				frequency;
-	adcsample_t				*buffer;
-	size_t					bufcount;
-	size_t					samplesPerEvent;
+	// The running streams and what the timer is doing for them
+	GADCStream				*streams;
+	uint32_t				physdev;				// All the streams' channels
+	uint32_t				frequency;				// The fastest stream
+	size_t					samplesPerConversion;
+	GADCStream				*direct;				// Set if a single stream can convert straight into its ring
+	GadcLldTimerData		lld;
+	adcsample_t				staging[GADC_STREAM_STAGING_SIZE];
+
+	// The stream behind the gadcHighSpeedXXX() calls
+	GADCStream				legacy;
 
 	// The last set of results
 	size_t					lastcount;
 	adcsample_t				*lastbuffer;
 	uint16_t				lastflags;
 
-	// Other stuff we need to track progress and for signaling
-	GadcLldTimerData		lld;
-	size_t					samplesPerConversion;
-	size_t					remaining;
+	// Signaling for the gadcHighSpeedXXX() calls
 	gfxSem					*bsem;
 	GEventADC				*pEvent;
 	GADCISRCallbackFunction	isrfn;
@@ -82,6 +87,127 @@ static struct lsdev {
 
 static struct lsdev *curlsdev;
 
+/* Tell the user of the gadcHighSpeedXXX() calls about the conversions in the legacy stream */
+static void LegacyEventI(GADCStream *ps) {
+	/* Save the details */
+	hs.lastcount = ps->filled;
+	hs.lastbuffer = ps->buffer + ps->rd * ps->samplesPerConversion;
+	hs.lastflags = GADC_Timer_Missed ? GADC_HSADC_LOSTEVENT : 0;
+
+	/* Nobody gives these back - they just get overwritten next time around */
+	ps->rd = ps->wr;
+	ps->filled = 0;
+
+	/* Signal the user with the data */
+	if (hs.pEvent) {
+		#if GFX_USE_GEVENT
+			hs.pEvent->type = GEVENT_ADC;
+		#endif
+		hs.pEvent->count = hs.lastcount;
+		hs.pEvent->buffer = hs.lastbuffer;
+		hs.pEvent->flags = hs.lastflags;
+	}
+
+	/* Our three signalling mechanisms */
+	if (hs.isrfn)
+		hs.isrfn(hs.lastbuffer, hs.lastcount);
+
+	if (hs.bsem)
+		gfxSemSignalI(hs.bsem);
+
+	#if GFX_USE_GEVENT
+		if (hs.flags & GADC_FLG_GTIMER)
+			gtimerJabI(&HighSpeedGTimer);
+	#endif
+}
+
+/* Account for n conversions just put into a stream's ring. They never cross the end of the ring. */
+static void StreamAddedI(GADCStream *ps, size_t n) {
+	ps->wr += n;
+	if (ps->wr >= ps->bufcount)
+		ps->wr = 0;
+	ps->filled += n;
+
+	if ((ps->flags & GADC_FLG_LEGACY)) {
+		if (ps->filled >= ps->watermark || !ps->wr)
+			LegacyEventI(ps);
+		return;
+	}
+
+	/* Wake the consumer only as the watermark is crossed */
+	if (ps->filled >= ps->watermark && ps->filled - n < ps->watermark)
+		gfxSemSignalI(&ps->sem);
+}
+
+/**
+ * Hand out the conversions in the staging buffer to the streams. Each stream takes
+ * its share of the timer ticks and only the channels it asked for.
+ * The low level driver puts the samples for each channel in physdev bit order.
+ */
+static void DemultiplexI(adcsample_t *buffer, size_t n) {
+	GADCStream	*ps;
+	adcsample_t	*d;
+	uint32_t	bit;
+	size_t		k;
+
+	for(; n; n--, buffer += hs.samplesPerConversion) {
+		for(ps = hs.streams; ps; ps = ps->next) {
+			ps->phase += ps->frequency;
+			if (ps->phase < hs.frequency)
+				continue;
+			ps->phase -= hs.frequency;
+
+			/* Never overwrite what the consumer hasn't released */
+			if (ps->filled >= ps->bufcount) {
+				ps->overruns++;
+				continue;
+			}
+
+			d = ps->buffer + ps->wr * ps->samplesPerConversion;
+			if (ps->physdev == hs.physdev) {
+				for(k = 0; k < hs.samplesPerConversion; k++)
+					d[k] = buffer[k];
+			} else {
+				for(bit = 1, k = 0; k < hs.samplesPerConversion; bit <<= 1) {
+					if (!(hs.physdev & bit))
+						continue;
+					if ((ps->physdev & bit))
+						*d++ = buffer[k];
+					k++;
+				}
+			}
+			StreamAddedI(ps, 1);
+		}
+	}
+}
+
+/* Set up the next high speed conversion */
+static void PrepareHighSpeedI(void) {
+	GADCStream	*ps;
+	size_t		n;
+
+	hs.lld.physdev = hs.physdev;
+
+	/**
+	 * A stream running on its own converts straight into its ring. We stop at the
+	 * watermark so the consumer hears about it as soon as possible.
+	 */
+	if ((ps = hs.direct) && ps->filled < ps->bufcount) {
+		n = ps->filled < ps->watermark ? ps->watermark - ps->filled : ps->watermark;
+		if (n > ps->bufcount - ps->filled)
+			n = ps->bufcount - ps->filled;
+		if (n > ps->bufcount - ps->wr)
+			n = ps->bufcount - ps->wr;
+		hs.lld.buffer = ps->buffer + ps->wr * ps->samplesPerConversion;
+		hs.lld.count = n;
+		return;
+	}
+
+	/* Otherwise (or if the ring is full) convert into the staging buffer */
+	hs.lld.buffer = hs.staging;
+	hs.lld.count = GADC_STREAM_STAGING_SIZE / hs.samplesPerConversion;
+}
+
 /* Find the next conversion to activate */
 static inline void FindNextConversionI(void) {
 	if (curlsdev) {
@@ -111,7 +237,8 @@ static inline void FindNextConversionI(void) {
 	curlsdev = 0;
 
 	/* No more low speed devices - do a high speed conversion */
-	if (hs.flags & GADC_FLG_ISACTIVE) {
+	if (gflags & GADC_GFLG_HSACTIVE) {
+		PrepareHighSpeedI();
 		hs.lld.now = GADC_Timer_Missed ? TRUE : FALSE;
 		GADC_Timer_Missed = 0;
 		gadc_lld_adc_timerI(&hs.lld);
@@ -149,52 +276,27 @@ void GADC_ISR_CompleteI(ADCDriver *adcp, adcsample_t *buffer, size_t n) {
 		#endif
 
 	} else {
-		/* This interrupt must be in relation to the high speed device */
-
-		if (hs.flags & GADC_FLG_ISACTIVE) {
-			/* Save the details */
-			hs.lastcount = n;
-			hs.lastbuffer = buffer;
-			hs.lastflags = GADC_Timer_Missed ? GADC_HSADC_LOSTEVENT : 0;
-
-			/* Signal the user with the data */
-			if (hs.pEvent) {
-				#if GFX_USE_GEVENT
-					hs.pEvent->type = GEVENT_ADC;
-				#endif
-				hs.pEvent->count = hs.lastcount;
-				hs.pEvent->buffer = hs.lastbuffer;
-				hs.pEvent->flags = hs.lastflags;
-			}
+		/* This interrupt must be in relation to the high speed streams */
 
-			/* Our three signalling mechanisms */
-			if (hs.isrfn)
-				hs.isrfn(buffer, n);
+		if (gflags & GADC_GFLG_HSACTIVE) {
+			GADCStream	*ps;
 
-			if (hs.bsem)
-				gfxSemSignalI(hs.bsem);
-
-			#if GFX_USE_GEVENT
-				if (hs.flags & GADC_FLG_GTIMER)
-					gtimerJabI(&HighSpeedGTimer);
-			#endif
+			/**
+			 * Either staged conversions for all the streams or direct conversions into a ring.
+			 * Direct conversions must land exactly where the stream expects - anything else is
+			 * left over from before the streams were changed.
+			 */
+			if (buffer >= hs.staging && buffer < hs.staging + GADC_STREAM_STAGING_SIZE)
+				DemultiplexI(buffer, n);
+			else if ((ps = hs.direct) && buffer == ps->buffer + ps->wr * ps->samplesPerConversion)
+				StreamAddedI(ps, n);
 
 			/* Adjust what we have left to do */
 			hs.lld.count -= n;
-			hs.remaining -= n;
 
 			/* Half completion - We have done all we can for now - wait for the next interrupt */
 			if (hs.lld.count)
 				return;
-
-			/* Our buffer is cyclic - set up the new buffer pointers */
-			if (hs.remaining) {
-				hs.lld.buffer = buffer + (n * hs.samplesPerConversion);
-			} else {
-				hs.remaining = hs.bufcount;
-				hs.lld.buffer = hs.buffer;
-			}
-			hs.lld.count = hs.remaining < hs.samplesPerEvent ? hs.remaining : hs.samplesPerEvent;
 		}
 	}
 
@@ -226,7 +328,7 @@ void GADC_ISR_ErrorI(ADCDriver *adcp, adcerror_t err) {
 		#endif
 
 	} else {
-		if (hs.flags & GADC_FLG_ISACTIVE)
+		if (gflags & GADC_GFLG_HSACTIVE)
 			/* Mark the error and then try to repeat it */
 			hs.flags |= GADC_FLG_ERROR;
 	}
@@ -318,24 +420,161 @@ static void LowSpeedGTimerCallback(void *param) {
 
 }
 
+/**
+ * Rebuild the timer for the running streams. The timer runs at the rate of the fastest
+ * stream and converts all their channels. Must be called with the gadcmutex held.
+ */
+static void RestartHighSpeed(void) {
+	GADCStream	*ps;
+	uint32_t	physdev, frequency;
+
+	if (hs.frequency)
+		gadc_lld_stop_timer(hs.physdev);
+
+	physdev = frequency = 0;
+	for(ps = hs.streams; ps; ps = ps->next) {
+		physdev |= ps->physdev;
+		if (ps->frequency > frequency)
+			frequency = ps->frequency;
+	}
+
+	gfxSystemLock();
+	hs.physdev = physdev;
+	hs.frequency = frequency;
+	hs.samplesPerConversion = gadc_lld_samples_per_conversion(physdev);
+	hs.direct = hs.streams && !hs.streams->next ? hs.streams : 0;
+	for(ps = hs.streams; ps; ps = ps->next)
+		ps->phase = frequency - ps->frequency;		// The first tick is for everyone
+	if (frequency)
+		gflags |= GADC_GFLG_HSACTIVE;
+	else
+		gflags &= ~GADC_GFLG_HSACTIVE;
+	gfxSystemUnlock();
+
+	if (frequency)
+		gadc_lld_start_timer(physdev, frequency);
+
+	/*
+	 * We have to pass TRUE to StartADC() as we might have the ADC marked as active when it isn't
+	 * due to stopping the timer while it was converting.
+	 */
+	StartADC(TRUE);
+}
+
+void gadcStreamInit(GADCStream *ps, uint32_t physdev, uint32_t frequency, adcsample_t *buffer, size_t bufcount, size_t watermark) {
+	ps->next = 0;
+	ps->physdev = physdev;
+	ps->frequency = frequency;
+	ps->phase = 0;
+	ps->buffer = buffer;
+	ps->bufcount = bufcount;
+	ps->watermark = !watermark ? 1 : (watermark > bufcount ? bufcount : watermark);
+	ps->samplesPerConversion = gadc_lld_samples_per_conversion(physdev);
+	ps->wr = ps->rd = ps->filled = 0;
+	ps->overruns = 0;
+	ps->flags = 0;
+	gfxSemInit(&ps->sem, 0, 1);
+}
+
+bool_t gadcStreamStart(GADCStream *ps) {
+	/* If its already going we don't need to do anything */
+	if (ps->flags & GADC_FLG_ISACTIVE)
+		return TRUE;
+
+	if (!ps->frequency || ps->frequency > GADC_MAX_HIGH_SPEED_SAMPLERATE || !ps->bufcount)
+		return FALSE;
+
+	gfxMutexEnter(&gadcmutex);
+
+	/* A conversion of all the streams' channels must fit in the staging buffer */
+	if (gadc_lld_samples_per_conversion(hs.physdev | ps->physdev) > GADC_STREAM_STAGING_SIZE) {
+		gfxMutexExit(&gadcmutex);
+		return FALSE;
+	}
+
+	gfxSystemLock();
+	ps->next = hs.streams;
+	hs.streams = ps;
+	ps->flags |= GADC_FLG_ISACTIVE;
+	gfxSystemUnlock();
+
+	RestartHighSpeed();
+	gfxMutexExit(&gadcmutex);
+	return TRUE;
+}
+
+void gadcStreamStop(GADCStream *ps) {
+	GADCStream	**pp;
+
+	gfxMutexEnter(&gadcmutex);
+	if (ps->flags & GADC_FLG_ISACTIVE) {
+		/* No more from us */
+		gfxSystemLock();
+		for(pp = &hs.streams; *pp; pp = &(*pp)->next) {
+			if (*pp == ps) {
+				*pp = ps->next;
+				break;
+			}
+		}
+		ps->flags &= ~GADC_FLG_ISACTIVE;
+		gfxSystemUnlock();
+
+		RestartHighSpeed();
+	}
+	gfxMutexExit(&gadcmutex);
+}
+
+size_t gadcStreamAcquire(GADCStream *ps, adcsample_t **pbuffer, delaytime_t ms) {
+	size_t	n;
+
+	/**
+	 * The semaphore may still be signaled from a watermark crossing the consumer
+	 * has already dealt with so check again after each wait.
+	 */
+	while(ps->filled < ps->watermark) {
+		if (!gfxSemWait(&ps->sem, ms))
+			break;
+	}
+
+	/* Only the consumer moves rd so only filled can change under us */
+	n = ps->filled;
+	if (n > ps->bufcount - ps->rd)
+		n = ps->bufcount - ps->rd;
+	*pbuffer = ps->buffer + ps->rd * ps->samplesPerConversion;
+	return n;
+}
+
+void gadcStreamRelease(GADCStream *ps, size_t count) {
+	gfxSystemLock();
+	if (count > ps->filled)
+		count = ps->filled;
+	ps->rd += count;
+	if (ps->rd >= ps->bufcount)
+		ps->rd -= ps->bufcount;
+	ps->filled -= count;
+	gfxSystemUnlock();
+}
+
+uint32_t gadcStreamGetOverruns(GADCStream *ps) {
+	uint32_t	cnt;
+
+	gfxSystemLock();
+	cnt = ps->overruns;
+	ps->overruns = 0;
+	gfxSystemUnlock();
+	return cnt;
+}
+
 void gadcHighSpeedInit(uint32_t physdev, uint32_t frequency, adcsample_t *buffer, size_t bufcount, size_t samplesPerEvent)
 {
-	gadcHighSpeedStop();		/* This does the init for us */
+	gadcHighSpeedStop();
 
 	/* Just save the details and reset everything for now */
-	hs.frequency = frequency;
-	hs.buffer = buffer;
-	hs.bufcount = bufcount;
-	hs.samplesPerEvent = samplesPerEvent;
+	gadcStreamInit(&hs.legacy, physdev, frequency, buffer, bufcount, samplesPerEvent);
+	hs.legacy.flags = GADC_FLG_LEGACY;
 	hs.lastcount = 0;
 	hs.lastbuffer = 0;
 	hs.lastflags = 0;
-	hs.lld.physdev = physdev;
-	hs.lld.buffer = buffer;
-	hs.lld.count = samplesPerEvent;
-	hs.lld.now = FALSE;
-	hs.samplesPerConversion = gadc_lld_samples_per_conversion(physdev);
-	hs.remaining = bufcount;
 	hs.bsem = 0;
 	hs.pEvent = 0;
 	hs.isrfn = 0;
@@ -363,26 +602,11 @@ void gadcHighSpeedSetBSem(gfxSem *pbsem, GEventADC *pEvent) {
 }
 
 void gadcHighSpeedStart(void) {
-	/* If its already going we don't need to do anything */
-	if (hs.flags & GADC_FLG_ISACTIVE)
-		return;
-
-	gadc_lld_start_timer(hs.lld.physdev, hs.frequency);
-	hs.flags = GADC_FLG_ISACTIVE;
-	StartADC(FALSE);
+	gadcStreamStart(&hs.legacy);
 }
 
 void gadcHighSpeedStop(void) {
-	if (hs.flags & GADC_FLG_ISACTIVE) {
-		/* No more from us */
-		hs.flags = 0;
-		gadc_lld_stop_timer(hs.lld.physdev);
-		/*
-		 * We have to pass TRUE to StartADC() as we might have the ADC marked as active when it isn't
-		 * due to stopping the timer while it was converting.
-		 */
-		StartADC(TRUE);
-	}
+	gadcStreamStop(&hs.legacy);
 }
 
 void gadcLowSpeedGet(uint32_t physdev, adcsample_t *buffer) {
@@ -390,7 +614,7 @@ void gadcLowSpeedGet(uint32_t physdev, adcsample_t *buffer) {
 	gfxSem			mysem;
 
 	/* Start the Low Speed Timer */
-	gfxSemInit(&mysem, 1, 1);
+	gfxSemInit(&mysem, 0, 1);
 	gfxMutexEnter(&gadcmutex);
 	if (!gtimerIsActive(&LowSpeedGTimer))
 		gtimerStart(&LowSpeedGTimer, LowSpeedGTimerCallback, NULL, TRUE, TIME_INFINITE);
@@ -34,7 +34,7 @@ static uint16_t			audFlags;
 	static void AudGTimerCallback(void *param) {
 		(void) param;
 		GSourceListener	*psl;
-		GEventADC		*pe;
+		GEventAudioIn	*pe;
 
 		psl = 0;
 		while ((psl = geventGetSourceListener((GSourceHandle)(&aud), psl))) {
@@ -14,10 +14,360 @@
  */
 #include "gfx.h"
 
-#if GFX_USE_GAUDOUT || defined(__DOXYGEN__)
+#if GFX_USE_GAUDOUT
 
-	#error "GAUDOUT: Not implemented yet"
+/* Include the driver defines */
+#include "gaudout/lld/gaudout_lld.h"
+
+static gaudout_params	aud;
+static gfxSem			*paudSem;
+static GEventAudioOut	*paudEvent;
+static gfxSem			audSpaceSem;
+static uint16_t			audFlags;
+	#define AUDFLG_RUNNING		0x0001
+	#define AUDFLG_USE_EVENTS	0x0002
+	#define AUDFLG_UNDERRUN		0x0004
+
+/*
+ * The ring buffer. Conversions are written at wrpos and handed to the driver from rdpos.
+ * 'filled' conversions are waiting to be handed out and 'inflight' conversions (the ones
+ * just before rdpos) belong to the driver until it completes them.
+ * These are only changed with the system locked.
+ */
+static size_t			wrpos, rdpos;
+static size_t			filled, inflight;
+static uint32_t			underruns;
+
+#define SPACE()			(aud.bufcount - filled - inflight)
+
+#if GFX_USE_GEVENT
+	static GTimer AudGTimer;
+
+	static void AudGTimerCallback(void *param) {
+		(void) param;
+		GSourceListener	*psl;
+		GEventAudioOut	*pe;
+		uint16_t		flags;
+
+		gfxSystemLock();
+		flags = (audFlags & AUDFLG_UNDERRUN) ? GAUDOUT_AUDIO_OUT_UNDERRUN : 0;
+		audFlags &= ~AUDFLG_UNDERRUN;
+		gfxSystemUnlock();
+
+		psl = 0;
+		while ((psl = geventGetSourceListener((GSourceHandle)(&aud), psl))) {
+			if (!(pe = (GEventAudioOut *)geventGetEventBuffer(psl))) {
+				// This listener is missing - save this.
+				psl->srcflags |= GAUDOUT_AUDIO_OUT_LOSTEVENT|flags;
+				continue;
+			}
+
+			pe->type = GEVENT_AUDIO_OUT;
+			pe->channel = aud.channel;
+			pe->count = gaudoutSpace();
+			pe->flags = psl->srcflags|flags;
+			psl->srcflags = 0;
+			geventSendEvent(psl);
+		}
+	}
+#endif
+
+size_t GAUDOUT_ISR_NextI(audout_sample_t **pbuffer) {
+	size_t	n;
+
+	if (!filled) {
+		underruns++;
+		audFlags |= AUDFLG_UNDERRUN;
+		return 0;
+	}
+
+	/* Hand out as much as we can up to the end of the buffer */
+	n = aud.bufcount - rdpos;
+	if (n > filled)
+		n = filled;
+	if (n > aud.samplesPerEvent)
+		n = aud.samplesPerEvent;
+
+	*pbuffer = aud.buffer + rdpos * GAUDOUT_SAMPLES_PER_CONVERSION(aud.channel);
+	rdpos += n;
+	if (rdpos >= aud.bufcount)
+		rdpos = 0;
+	filled -= n;
+	inflight += n;
+	return n;
+}
+
+void GAUDOUT_ISR_CompleteI(audout_sample_t *buffer, size_t n) {
+	(void) buffer;
+
+	/* That space is free again */
+	inflight -= n;
+	gfxSemSignalI(&audSpaceSem);
+
+	/* Signal the user */
+	if (paudEvent) {
+		#if GFX_USE_GEVENT
+			paudEvent->type = GEVENT_AUDIO_OUT;
+		#endif
+		paudEvent->channel = aud.channel;
+		paudEvent->count = SPACE();
+		paudEvent->flags = (audFlags & AUDFLG_UNDERRUN) ? GAUDOUT_AUDIO_OUT_UNDERRUN : 0;
+
+		/* It has been reported - unless the GEVENT listeners still need to see it */
+		#if GFX_USE_GEVENT
+			if (!(audFlags & AUDFLG_USE_EVENTS))
+		#endif
+				audFlags &= ~AUDFLG_UNDERRUN;
+	}
+
+	/* Our two signalling mechanisms */
+	if (paudSem)
+		gfxSemSignalI(paudSem);
+
+	#if GFX_USE_GEVENT
+		if (audFlags & AUDFLG_USE_EVENTS)
+			gtimerJabI(&AudGTimer);
+	#endif
+}
+
+void GAUDOUT_ISR_ErrorI(void) {
+	/* Ignore any errors for now */
+}
+
+#if GAUDOUT_NEED_MIXER
+	static struct MixerChannel_t {
+		const int16_t	*samples;		// NULL when the channel is idle
+		size_t			count;			// In samples (not conversions)
+		size_t			pos;
+		uint16_t		volume;
+		bool_t			loop;
+	} MixerChannels[GAUDOUT_MIXER_CHANNELS];
+	static gfxMutex			MixerMutex;
+#endif
+
+/* The module initialiser */
+void _gaudoutInit(void) {
+	gfxSemInit(&audSpaceSem, 0, 1);
+	#if GFX_USE_GEVENT
+		gtimerInit(&AudGTimer);
+	#endif
+	#if GAUDOUT_NEED_MIXER
+		gfxMutexInit(&MixerMutex);
+	#endif
+}
+
+bool_t gaudoutInit(uint16_t channel, uint32_t frequency, audout_sample_t *buffer, size_t bufcount, size_t samplesPerEvent) {
+	/* Check the channel is valid */
+	if (channel >= GAUDOUT_NUM_CHANNELS || !frequency || frequency > GAUDOUT_MAX_SAMPLE_FREQUENCY || !bufcount || !samplesPerEvent)
+		return FALSE;
+
+	/* Stop any existing output */
+	if ((audFlags & AUDFLG_RUNNING))
+		gaudout_lld_stop();
+	audFlags = 0;
+
+	/* Initialise everything */
+	gfxSystemLock();
+	aud.channel = channel;
+	aud.frequency = frequency;
+	aud.buffer = buffer;
+	aud.bufcount = bufcount;
+	aud.samplesPerEvent = samplesPerEvent;
+	paudSem = 0;
+	paudEvent = 0;
+	wrpos = rdpos = 0;
+	filled = inflight = 0;
+	underruns = 0;
+	gfxSystemUnlock();
+
+	/* Set up the low level driver */
+	gaudout_lld_init(&aud);
+	return TRUE;
+}
+
+#if GFX_USE_GEVENT
+	GSourceHandle gaudoutGetSource(void) {
+		if (!gtimerIsActive(&AudGTimer))
+			gtimerStart(&AudGTimer, AudGTimerCallback, NULL, TRUE, TIME_INFINITE);
+		audFlags |= AUDFLG_USE_EVENTS;
+		return (GSourceHandle)&aud;
+	}
+#endif
+
+void gaudoutSetBSem(gfxSem *pbsem, GEventAudioOut *pEvent) {
+	gfxSystemLock();
+	paudSem = pbsem;
+	paudEvent = pEvent;
+	gfxSystemUnlock();
+}
+
+void gaudoutStart(void) {
+	if (!(audFlags & AUDFLG_RUNNING)) {
+		audFlags |= AUDFLG_RUNNING;
+		gaudout_lld_start();
+	}
+}
+
+void gaudoutStop(void) {
+	if ((audFlags & AUDFLG_RUNNING)) {
+		gaudout_lld_stop();
+		audFlags &= ~AUDFLG_RUNNING;
+
+		/* The driver has abandoned any blocks it was playing */
+		gfxSystemLock();
+		inflight = 0;
+		gfxSemSignalI(&audSpaceSem);
+		gfxSystemUnlock();
+	}
+}
+
+size_t gaudoutWrite(void *data, ArrayDataFormat fmt, size_t count, delaytime_t ms) {
+	uint8_t		*src;
+	size_t		done, n, wp, spc, srcsize;
+
+	spc = GAUDOUT_SAMPLES_PER_CONVERSION(aud.channel);
+	srcsize = (fmt <= ARRAY_DATA_8BITSIGNED ? sizeof(uint8_t) : sizeof(uint16_t)) * spc;
+	src = (uint8_t *)data;
+
+	for(done = 0; done < count; done += n) {
+		gfxSystemLock();
+		n = SPACE();
+		wp = wrpos;
+		gfxSystemUnlock();
+
+		if (!n) {
+			// Wait for the driver to finish a block
+			if (!gfxSemWait(&audSpaceSem, ms))
+				break;
+			continue;
+		}
+
+		/* We are the only writer so this space can't disappear while we fill it */
+		if (n > count - done)
+			n = count - done;
+		if (n > aud.bufcount - wp)
+			n = aud.bufcount - wp;
+		gmiscArrayConvert(fmt, src, GAUDOUT_SAMPLE_FORMAT, aud.buffer + wp * spc, n * spc);
+		src += n * srcsize;
+
+		gfxSystemLock();
+		wrpos = wp + n >= aud.bufcount ? 0 : wp + n;
+		filled += n;
+		gfxSystemUnlock();
+	}
+	return done;
+}
+
+size_t gaudoutSpace(void) {
+	size_t	n;
+
+	gfxSystemLock();
+	n = SPACE();
+	gfxSystemUnlock();
+	return n;
+}
+
+uint32_t gaudoutGetUnderruns(void) {
+	return underruns;
+}
+
+#if GAUDOUT_NEED_MIXER
+	bool_t gaudoutMixerPlay(unsigned mixch, const int16_t *samples, size_t count, uint16_t volume, bool_t loop) {
+		struct MixerChannel_t	*pmc;
+
+		if (mixch >= GAUDOUT_MIXER_CHANNELS)
+			return FALSE;
+
+		pmc = MixerChannels+mixch;
+		gfxMutexEnter(&MixerMutex);
+		pmc->samples = count ? samples : 0;
+		pmc->count = count * GAUDOUT_SAMPLES_PER_CONVERSION(aud.channel);
+		pmc->pos = 0;
+		pmc->volume = volume;
+		pmc->loop = loop;
+		gfxMutexExit(&MixerMutex);
+		return TRUE;
+	}
+
+	void gaudoutMixerStop(unsigned mixch) {
+		if (mixch >= GAUDOUT_MIXER_CHANNELS)
+			return;
+		gfxMutexEnter(&MixerMutex);
+		MixerChannels[mixch].samples = 0;
+		gfxMutexExit(&MixerMutex);
+	}
+
+	void gaudoutMixerSetVolume(unsigned mixch, uint16_t volume) {
+		if (mixch >= GAUDOUT_MIXER_CHANNELS)
+			return;
+		gfxMutexEnter(&MixerMutex);
+		MixerChannels[mixch].volume = volume;
+		gfxMutexExit(&MixerMutex);
+	}
+
+	bool_t gaudoutMixerIsPlaying(unsigned mixch) {
+		if (mixch >= GAUDOUT_MIXER_CHANNELS)
+			return FALSE;
+		return MixerChannels[mixch].samples != 0;
+	}
+
+	size_t gaudoutMix(size_t count, delaytime_t ms) {
+		static int32_t			acc[GAUDOUT_MIXER_BLOCK_SIZE];
+		static int16_t			mix[GAUDOUT_MIXER_BLOCK_SIZE];
+		struct MixerChannel_t	*pmc;
+		size_t					done, n, spc, i, j, k, len;
+		int32_t					v;
+
+		spc = GAUDOUT_SAMPLES_PER_CONVERSION(aud.channel);
+
+		for(done = 0; done < count; done += n) {
+			// Wait for some space and then mix only as much as will fit
+			if (!(n = gaudoutSpace())) {
+				if (!gfxSemWait(&audSpaceSem, ms))
+					break;
+				continue;
+			}
+			if (n > count - done)
+				n = count - done;
+			if (n > GAUDOUT_MIXER_BLOCK_SIZE / spc)
+				n = GAUDOUT_MIXER_BLOCK_SIZE / spc;
+			len = n * spc;
+
+			for(i = 0; i < len; i++)
+				acc[i] = 0;
+
+			gfxMutexEnter(&MixerMutex);
+			for(pmc = MixerChannels; pmc < MixerChannels+GAUDOUT_MIXER_CHANNELS; pmc++) {
+				for(i = 0; pmc->samples && i < len; i += j) {
+					// Mix up to the end of the sound
+					j = pmc->count - pmc->pos;
+					if (j > len - i)
+						j = len - i;
+					for(k = 0; k < j; k++)
+						acc[i+k] += ((int32_t)pmc->samples[pmc->pos+k] * pmc->volume) >> 8;
+					pmc->pos += j;
+
+					if (pmc->pos >= pmc->count) {
+						pmc->pos = 0;
+						if (!pmc->loop)
+							pmc->samples = 0;
+					}
+				}
+			}
+			gfxMutexExit(&MixerMutex);
+
+			// Saturate
+			for(i = 0; i < len; i++) {
+				v = acc[i];
+				mix[i] = v > 32767 ? 32767 : (v < -32768 ? -32768 : (int16_t)v);
+			}
+
+			// There is room for this so it won't block
+			gaudoutWrite(mix, ARRAY_DATA_16BITSIGNED, n, ms);
+		}
+		return done;
+	}
+#endif
 
 #endif /* GFX_USE_GAUDOUT */
 /** @} */
-
@@ -19,6 +19,8 @@
 
 #include "gdisp/fonts.h"
 
+#include <string.h>
+
 /* fontSmall - for side buttons */
 #if GDISP_INCLUDE_FONT_SMALL
     /* Forward Declarations of internal arrays */
@@ -31,19 +33,22 @@
 									11, 0, 14, 2, 2, 12, ' ', '~', 1, 1,
 									fontSmall_Widths,
 									fontSmall_Offsets,
-									fontSmall_Data};
+									fontSmall_Data,
+									0, 0, 0};
     static const struct font fontSmallDouble = {
 									"Small Double",
 									11, 0, 14, 2, 2, 12, ' ', '~', 2, 2,
 									fontSmall_Widths,
 									fontSmall_Offsets,
-									fontSmall_Data};
+									fontSmall_Data,
+									0, 0, 0};
     static const struct font fontSmallNarrow = {
 									"Small Narrow",
 									11, 0, 14, 2, 2, 12, ' ', '~', 1, 2,
 									fontSmall_Widths,
 									fontSmall_Offsets,
-									fontSmall_Data};
+									fontSmall_Data,
+									0, 0, 0};
 
 	static const uint8_t fontSmall_Widths[] = {
 		2, 3, 6, 8, 7, 9, 7, 3, 4, 4, 5, 7, 4, 4, 3, 6,
@@ -178,19 +183,22 @@
 									12, 1, 13, 2, 2, 13, ' ', '~', 1, 1,
 									fontLarger_Widths,
 									fontLarger_Offsets,
-									fontLarger_Data};
+									fontLarger_Data,
+									0, 0, 0};
     static const struct font fontLargerDouble = {
 									"Larger Double",
 									12, 1, 13, 2, 2, 13, ' ', '~', 2, 2,
 									fontLarger_Widths,
 									fontLarger_Offsets,
-									fontLarger_Data};
+									fontLarger_Data,
+									0, 0, 0};
     static const struct font fontLargerNarrow = {
 									"Larger Narrow",
 									12, 1, 13, 2, 2, 13, ' ', '~', 1, 2,
 									fontLarger_Widths,
 									fontLarger_Offsets,
-									fontLarger_Data};
+									fontLarger_Data,
+									0, 0, 0};
 	static const uint8_t fontLarger_Widths[] = {
 		2, 3, 5, 8, 7, 13, 8, 2, 4, 4, 7, 8, 3, 4, 3, 5,
 		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 3, 3, 9, 8, 9, 6,
@@ -325,19 +333,22 @@
 									13, 0, 15, 2, 3, 13, ' ', '~', 1, 1,
 									fontUI1_Widths,
 									fontUI1_Offsets,
-									fontUI1_Data};
+									fontUI1_Data,
+									0, 0, 0};
     static const struct font fontUI1Double = {
 									"UI1 Double",
 									13, 0, 15, 2, 3, 13, ' ', '~', 2, 2,
 									fontUI1_Widths,
 									fontUI1_Offsets,
-									fontUI1_Data};
+									fontUI1_Data,
+									0, 0, 0};
     static const struct font fontUI1Narrow = {
 									"UI1 Narrow",
 									13, 0, 15, 2, 3, 13, ' ', '~', 1, 2,
 									fontUI1_Widths,
 									fontUI1_Offsets,
-									fontUI1_Data};
+									fontUI1_Data,
+									0, 0, 0};
 
 	static const uint8_t fontUI1_Widths[] = {
 		3, 3, 6, 8, 7, 13, 9, 3, 5, 5, 6, 8, 3, 5, 3, 7,
@@ -473,19 +484,22 @@
 									11, 1, 13, 2, 2, 12, ' ', '~', 1, 1,
 									fontUI2_Widths,
 									fontUI2_Offsets,
-									fontUI2_Data};
+									fontUI2_Data,
+									0, 0, 0};
 	static const struct font fontUI2Double = {
 									"UI2 Double",
 									11, 1, 13, 2, 2, 12, ' ', '~', 2, 2,
 									fontUI2_Widths,
 									fontUI2_Offsets,
-									fontUI2_Data};
+									fontUI2_Data,
+									0, 0, 0};
 	static const struct font fontUI2Narrow = {
 									"UI2 Narrow",
 									11, 1, 13, 2, 2, 12, ' ', '~', 1, 2,
 									fontUI2_Widths,
 									fontUI2_Offsets,
-									fontUI2_Data};
+									fontUI2_Data,
+									0, 0, 0};
 
 	static const uint8_t fontUI2_Widths[] = {
 		2, 2, 5, 8, 6, 12, 8, 2, 4, 4, 6, 8, 2, 4, 2, 5,
@@ -624,18 +638,21 @@
 									16, 2, 21, 1, 3, 15, '%', ':', 1, 1,
 									fontLargeNumbers_Widths,
 									fontLargeNumbers_Offsets,
-									fontLargeNumbers_Data};
+									fontLargeNumbers_Data,
+									0, 0, 0};
     static const struct font fontLargeNumbersDouble = {
 									"LargeNumbers Double",
 									16, 2, 21, 1, 3, 15, '%', ':', 2, 2,
 									fontLargeNumbers_Widths,
 									fontLargeNumbers_Offsets,
-									fontLargeNumbers_Data};
+									fontLargeNumbers_Data,
+									0, 0, 0};
     static const struct font fontLargeNumbersNarrow = {
 									"LargeNumbers Narrow", 16, 2, 21, 1, 3, 15, '%', ':', 1, 2,
 									fontLargeNumbers_Widths,
 									fontLargeNumbers_Offsets,
-									fontLargeNumbers_Data};
+									fontLargeNumbers_Data,
+									0, 0, 0};
 
 	static const uint8_t fontLargeNumbers_Widths[] = {
 		15, 0, 0, 0, 0, 0, 11, 3, 6, 3, 0, 10, 10, 10, 10, 10,
@@ -685,6 +702,31 @@ static const struct font *BuiltinFontTable[] = {
 	#endif
 	};
 
+/**
+ * Find the glyph index of a character in a sparse font.
+ */
+int _gdispFindGlyph(font_t font, unicode_t c) {
+	const struct fontrange	*pr;
+	uint32_t				code;
+	unsigned				lo, hi, mid;
+
+	/* The ranges are sorted so binary search for the one holding this character */
+	code = _getCharCode(c);
+	lo = 0;
+	hi = font->rangeCount;
+	while(lo < hi) {
+		mid = (lo + hi) / 2;
+		pr = font->rangeTable + mid;
+		if (code < pr->first)
+			hi = mid;
+		else if (code > pr->last)
+			lo = mid + 1;
+		else
+			return pr->index + (code - pr->first);
+	}
+	return -1;
+}
+
 /**
  * Match a pattern against the font name.
  */
@@ -711,18 +753,477 @@ static bool_t matchfont(const char *pattern, const char *name) {
 	}
 }
 
-font_t gdispOpenFont(const char *name) {
-	const struct font **p;
+#if GDISP_FONT_REGISTRY_SIZE > 255
+	#error "GDISP: GDISP_FONT_REGISTRY_SIZE must be no more than 255"
+#endif
+
+#define FONT_HASH_SIZE		16				// The number of hash chains - must be a power of 2
+#define FONTREG_LOADED		0x01			// The font was loaded and is freed when it is closed
+
+/* The font registry. Entries are chained by the hash of the font name. */
+static struct FontRegEntry_t {
+	font_t		font;				// 0 if this entry is free
+	uint32_t	hash;
+	uint16_t	refs;				// The number of opens of a loaded font
+	uint8_t		flags;
+	uint8_t		next;				// The next entry in this hash chain + 1 (0 for the end)
+} FontReg[GDISP_FONT_REGISTRY_SIZE];
+static uint8_t	FontHash[FONT_HASH_SIZE];	// The first entry in each hash chain + 1 (0 for empty)
+static gfxMutex	FontRegMutex;
+
+/**
+ * The FNV-1a hash of a font name.
+ */
+static uint32_t hashfont(const char *name) {
+	uint32_t	h;
+
+	for(h = 2166136261UL; *name; name++)
+		h = (h ^ (uint8_t)*name) * 16777619UL;
+	return h;
+}
+
+/**
+ * Add a font to the registry. Must be called with the registry mutex held.
+ */
+static struct FontRegEntry_t *AddFont(font_t font, uint8_t flags) {
+	struct FontRegEntry_t	*pe;
+	unsigned				i;
+
+	for(i = 0, pe = FontReg; i < GDISP_FONT_REGISTRY_SIZE; i++, pe++) {
+		if (!pe->font) {
+			pe->font = font;
+			pe->hash = hashfont(font->name);
+			pe->refs = 1;
+			pe->flags = flags;
+			pe->next = FontHash[pe->hash & (FONT_HASH_SIZE-1)];
+			FontHash[pe->hash & (FONT_HASH_SIZE-1)] = i+1;
+			return pe;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Find the registry entry for a font. Must be called with the registry mutex held.
+ */
+static struct FontRegEntry_t *FindFont(font_t font) {
+	unsigned	i;
 
-	for(p = BuiltinFontTable; p < BuiltinFontTable+sizeof(BuiltinFontTable)/sizeof(BuiltinFontTable[0]); p++) {
-		if (matchfont(name, p[0]->name))
-			return p[0];
+	for(i = FontHash[hashfont(font->name) & (FONT_HASH_SIZE-1)]; i; i = FontReg[i-1].next) {
+		if (FontReg[i-1].font == font)
+			return FontReg+i-1;
 	}
 	return 0;
 }
 
+/**
+ * Remove an entry from the registry. Must be called with the registry mutex held.
+ */
+static void RemoveFont(struct FontRegEntry_t *pe) {
+	uint8_t		*pi;
+
+	for(pi = FontHash + (pe->hash & (FONT_HASH_SIZE-1)); *pi; pi = &FontReg[*pi-1].next) {
+		if (FontReg + *pi - 1 == pe) {
+			*pi = pe->next;
+			break;
+		}
+	}
+	pe->font = 0;
+}
+
+#if GDISP_NEED_FONTLOAD
+	/**
+	 * A font file (as written by mkfont -x) is little endian and holds...
+	 *		A header of FONTFILE_HEADER_SIZE bytes...
+	 *			"GFNT", uint8_t version, bitsPerPixel, height, charPadding, lineSpacing,
+	 *			descenderHeight, minWidth, maxWidth, uint16_t glyphs, ranges, kerns,
+	 *			uint8_t name length (including the nul), reserved
+	 *		The font name including its terminating nul
+	 *		The character ranges - 3 x uint16_t first, last and glyph index each
+	 *		The kerning pairs - 2 x uint16_t left and right character, int8_t adjust each
+	 *		The glyph widths - uint8_t each
+	 *		The glyph offsets - uint32_t each plus one more for the end of the last glyph
+	 *		The glyph runs
+	 */
+	#define FONTFILE_HEADER_SIZE	20
+	#define FONTFILE_VERSION		1
+	#define FONTFILE_RANGE_SIZE		6				// The same as a struct fontrange
+	#define FONTFILE_KERN_SIZE		5
+
+	#define LE16(p)		((uint16_t)((p)[0] | ((p)[1] << 8)))
+	#define LE32(p)		((uint32_t)LE16(p) | ((uint32_t)LE16((p)+2) << 16))
+
+	struct FontIOFunctions;
+
+	typedef struct FontIO {
+		const void *					fd;
+		size_t							pos;
+		const struct FontIOFunctions *	fns;
+	} FontIO;
+
+	typedef struct FontIOFunctions {
+		size_t	(*read)(FontIO *pio, void *buf, size_t len);
+		void	(*seek)(FontIO *pio, size_t pos);
+		void	(*close)(FontIO *pio);
+	} FontIOFunctions;
+
+	/* A loaded font. It is followed in memory by its tables. */
+	typedef struct LoadedFont {
+		struct font		f;
+		struct fontaa	aa;
+		FontIO			io;
+		size_t			runsPos;							// Where the glyph runs start in the file
+		size_t			maxRuns;							// The size of the largest glyph
+		uint8_t *		cache;								// GDISP_FONT_CACHE_GLYPHS glyphs of maxRuns bytes each
+		int				cacheGlyph[GDISP_FONT_CACHE_GLYPHS];	// The glyph in each cache slot or -1
+		unsigned		cacheNext;							// The cache slot to replace next
+	} LoadedFont;
+
+	static size_t FontMemoryRead(FontIO *pio, void *buf, size_t len) {
+		memcpy(buf, ((const char *)pio->fd)+pio->pos, len);
+		pio->pos += len;
+		return len;
+	}
+
+	static void FontMemorySeek(FontIO *pio, size_t pos) {
+		pio->pos = pos;
+	}
+
+	static void FontMemoryClose(FontIO *pio) {
+		(void) pio;
+	}
+
+	static const FontIOFunctions FontMemoryFunctions =
+		{ FontMemoryRead, FontMemorySeek, FontMemoryClose };
+
+	#if GFX_USE_OS_CHIBIOS
+		static size_t FontBaseFileStreamRead(FontIO *pio, void *buf, size_t len) {
+			len = chSequentialStreamRead(((BaseFileStream *)pio->fd), (uint8_t *)buf, len);
+			pio->pos += len;
+			return len;
+		}
+
+		static void FontBaseFileStreamSeek(FontIO *pio, size_t pos) {
+			if (pio->pos != pos) {
+				chFileStreamSeek(((BaseFileStream *)pio->fd), pos);
+				pio->pos = pos;
+			}
+		}
+
+		static void FontBaseFileStreamClose(FontIO *pio) {
+			chFileStreamClose(((BaseFileStream *)pio->fd));
+		}
+
+		static const FontIOFunctions FontBaseFileStreamFunctions =
+			{ FontBaseFileStreamRead, FontBaseFileStreamSeek, FontBaseFileStreamClose };
+	#endif
+
+	#if defined(WIN32) || GFX_USE_OS_WIN32 || GFX_USE_OS_POSIX
+		#include <stdio.h>
+
+		static size_t FontFileRead(FontIO *pio, void *buf, size_t len) {
+			len = fread(buf, 1, len, (FILE *)pio->fd);
+			pio->pos += len;
+			return len;
+		}
+
+		static void FontFileSeek(FontIO *pio, size_t pos) {
+			if (pio->pos != pos) {
+				fseek((FILE *)pio->fd, pos, SEEK_SET);
+				pio->pos = pos;
+			}
+		}
+
+		static void FontFileClose(FontIO *pio) {
+			fclose((FILE *)pio->fd);
+		}
+
+		static const FontIOFunctions FontFileFunctions =
+			{ FontFileRead, FontFileSeek, FontFileClose };
+	#endif
+
+	/**
+	 * Free a loaded font that is no longer registered.
+	 */
+	static void FreeFont(font_t font) {
+		LoadedFont	*plf;
+
+		plf = (LoadedFont *)font;
+		plf->io.fns->close(&plf->io);
+		if (plf->cache)
+			gfxFree(plf->cache);
+		gfxFree(plf);
+	}
+
+	/**
+	 * Read the font tables and register the font. The io is closed if the font can't be loaded.
+	 * If mem is set the glyph runs are used directly from it, otherwise they are paged in from the io.
+	 */
+	static font_t LoadFont(FontIO *pio, const uint8_t *mem) {
+		LoadedFont *		plf;
+		uint8_t				hdr[FONTFILE_HEADER_SIZE];
+		uint8_t				kern[FONTFILE_KERN_SIZE];
+		uint32_t *			offsets;
+		struct fontrange *	pr;
+		struct fontkern *	pk;
+		uint8_t *			pw;
+		char *				name;
+		unsigned			glyphs, ranges, kerns, namelen, i;
+
+		/* Check the header */
+		if (pio->fns->read(pio, hdr, FONTFILE_HEADER_SIZE) != FONTFILE_HEADER_SIZE
+				|| hdr[0] != 'G' || hdr[1] != 'F' || hdr[2] != 'N' || hdr[3] != 'T'
+				|| hdr[4] != FONTFILE_VERSION || (hdr[5] != 2 && hdr[5] != 4))
+			goto baddata;
+		glyphs = LE16(hdr+12);
+		ranges = LE16(hdr+14);
+		kerns = LE16(hdr+16);
+		namelen = hdr[18];
+		if (!glyphs || !ranges || !namelen)
+			goto baddata;
+
+		/* Everything but the glyph runs is kept in RAM - most aligned tables first */
+		if (!(plf = (LoadedFont *)gfxAlloc(sizeof(LoadedFont) + (glyphs+1) * sizeof(uint32_t)
+						+ ranges * sizeof(struct fontrange) + kerns * sizeof(struct fontkern) + glyphs + namelen)))
+			goto baddata;
+		offsets = (uint32_t *)(plf+1);
+		pr = (struct fontrange *)(offsets + glyphs + 1);
+		pk = (struct fontkern *)(pr + ranges);
+		pw = (uint8_t *)(pk + kerns);
+		name = (char *)(pw + glyphs);
+
+		/* The name */
+		if (pio->fns->read(pio, name, namelen) != namelen)
+			goto badfont;
+		name[namelen-1] = 0;
+
+		/* The ranges - converted in place. Each range must fit within the glyphs. */
+		if (pio->fns->read(pio, pr, ranges * FONTFILE_RANGE_SIZE) != ranges * FONTFILE_RANGE_SIZE)
+			goto badfont;
+		for(i = 0; i < ranges; i++) {
+			pr[i].first = LE16((uint8_t *)(pr+i));
+			pr[i].last = LE16((uint8_t *)(pr+i)+2);
+			pr[i].index = LE16((uint8_t *)(pr+i)+4);
+			if (pr[i].last < pr[i].first || (unsigned)pr[i].index + (pr[i].last - pr[i].first) >= glyphs
+					|| (i && pr[i].first <= pr[i-1].last))
+				goto badfont;
+		}
+
+		/* The kerning pairs */
+		for(i = 0; i < kerns; i++) {
+			if (pio->fns->read(pio, kern, FONTFILE_KERN_SIZE) != FONTFILE_KERN_SIZE)
+				goto badfont;
+			pk[i].left = LE16(kern);
+			pk[i].right = LE16(kern+2);
+			pk[i].adjust = (int8_t)kern[4];
+		}
+
+		/* The widths */
+		if (pio->fns->read(pio, pw, glyphs) != glyphs)
+			goto badfont;
+
+		/* The offsets - converted in place. They must not go backwards. */
+		if (pio->fns->read(pio, offsets, (glyphs+1) * sizeof(uint32_t)) != (glyphs+1) * sizeof(uint32_t))
+			goto badfont;
+		plf->maxRuns = 0;
+		for(i = 0; i <= glyphs; i++) {
+			offsets[i] = LE32((uint8_t *)(offsets+i));
+			if (i && offsets[i] < offsets[i-1])
+				goto badfont;
+			if (i && offsets[i] - offsets[i-1] > plf->maxRuns)
+				plf->maxRuns = offsets[i] - offsets[i-1];
+		}
+		plf->runsPos = pio->pos;
+
+		/* Get the glyph cache ready if we need to page the glyphs in */
+		plf->cache = 0;
+		if (!mem) {
+			if (!(plf->cache = (uint8_t *)gfxAlloc(GDISP_FONT_CACHE_GLYPHS * plf->maxRuns)))
+				goto badfont;
+			for(i = 0; i < GDISP_FONT_CACHE_GLYPHS; i++)
+				plf->cacheGlyph[i] = -1;
+			plf->cacheNext = 0;
+		}
+		plf->io = *pio;
+
+		plf->aa.bitsPerPixel = hdr[5];
+		plf->aa.kernCount = kerns;
+		plf->aa.glyphOffsets = offsets;
+		plf->aa.glyphRuns = mem ? mem + plf->runsPos : 0;
+		plf->aa.kernTable = pk;
+
+		plf->f.name = name;
+		plf->f.height = hdr[6];
+		plf->f.charPadding = hdr[7];
+		plf->f.lineSpacing = hdr[8];
+		plf->f.descenderHeight = hdr[9];
+		plf->f.minWidth = hdr[10];
+		plf->f.maxWidth = hdr[11];
+		plf->f.minChar = plf->f.maxChar = 0;
+		plf->f.xscale = plf->f.yscale = 1;
+		plf->f.widthTable = pw;
+		plf->f.offsetTable = 0;
+		plf->f.dataTable = 0;
+		plf->f.aa = &plf->aa;
+		plf->f.rangeCount = ranges;
+		plf->f.rangeTable = pr;
+
+		/* Register it */
+		gfxMutexEnter(&FontRegMutex);
+		if (!AddFont(&plf->f, FONTREG_LOADED)) {
+			gfxMutexExit(&FontRegMutex);
+			FreeFont(&plf->f);
+			return 0;
+		}
+		gfxMutexExit(&FontRegMutex);
+		return &plf->f;
+
+	badfont:
+		gfxFree(plf);
+	baddata:
+		pio->fns->close(pio);
+		return 0;
+	}
+
+	/**
+	 * Get the runs of a glyph from a font that is paged in from a file or stream.
+	 */
+	const uint8_t *_gdispPageGlyph(font_t font, int glyph) {
+		LoadedFont	*plf;
+		uint8_t		*p;
+		size_t		len;
+		unsigned	i;
+
+		plf = (LoadedFont *)font;
+		for(i = 0; i < GDISP_FONT_CACHE_GLYPHS; i++) {
+			if (plf->cacheGlyph[i] == glyph)
+				return plf->cache + i * plf->maxRuns;
+		}
+
+		/* Replace the glyph that was read longest ago */
+		i = plf->cacheNext;
+		if (++plf->cacheNext >= GDISP_FONT_CACHE_GLYPHS)
+			plf->cacheNext = 0;
+		p = plf->cache + i * plf->maxRuns;
+		len = plf->aa.glyphOffsets[glyph+1] - plf->aa.glyphOffsets[glyph];
+		plf->io.fns->seek(&plf->io, plf->runsPos + plf->aa.glyphOffsets[glyph]);
+		if (plf->io.fns->read(&plf->io, p, len) == len) {
+			plf->cacheGlyph[i] = glyph;
+			return p;
+		}
+
+		/* A read error - draw it blank. Every run byte covers at least one pixel so these cover the glyph. */
+		memset(p, (0xFF << plf->aa.bitsPerPixel) & 0xFF, len);
+		plf->cacheGlyph[i] = -1;
+		return p;
+	}
+
+	font_t gdispLoadFontMemory(const void *memfont) {
+		FontIO	io;
+
+		io.fd = memfont;
+		io.pos = 0;
+		io.fns = &FontMemoryFunctions;
+		return LoadFont(&io, (const uint8_t *)memfont);
+	}
+
+	#if GFX_USE_OS_CHIBIOS
+		font_t gdispLoadFontBaseFileStream(void *BaseFileStreamPtr) {
+			FontIO	io;
+
+			io.fd = BaseFileStreamPtr;
+			io.pos = 0;
+			io.fns = &FontBaseFileStreamFunctions;
+			return LoadFont(&io, 0);
+		}
+	#endif
+
+	#if defined(WIN32) || GFX_USE_OS_WIN32 || GFX_USE_OS_POSIX
+		font_t gdispLoadFontFile(const char *filename) {
+			FontIO	io;
+
+			if (!(io.fd = (const void *)fopen(filename, "rb")))
+				return 0;
+			io.pos = 0;
+			io.fns = &FontFileFunctions;
+			return LoadFont(&io, 0);
+		}
+	#endif
+#endif
+
+/* Our module initialiser - register the built-in fonts */
+void _gdispFontInit(void) {
+	const struct font **p;
+
+	gfxMutexInit(&FontRegMutex);
+	for(p = BuiltinFontTable; p < BuiltinFontTable+sizeof(BuiltinFontTable)/sizeof(BuiltinFontTable[0]); p++)
+		AddFont(p[0], 0);
+}
+
+font_t gdispOpenFont(const char *name) {
+	struct FontRegEntry_t	*pe;
+	font_t					font;
+	uint32_t				hash;
+	unsigned				i;
+
+	font = 0;
+	pe = 0;
+	gfxMutexEnter(&FontRegMutex);
+
+	if (strchr(name, '*')) {
+		/* A wildcard has to be tried against every font */
+		for(i = 0; i < GDISP_FONT_REGISTRY_SIZE; i++) {
+			if (FontReg[i].font && matchfont(name, FontReg[i].font->name)) {
+				pe = FontReg+i;
+				break;
+			}
+		}
+	} else {
+		hash = hashfont(name);
+		for(i = FontHash[hash & (FONT_HASH_SIZE-1)]; i; i = FontReg[i-1].next) {
+			if (FontReg[i-1].hash == hash && !strcmp(name, FontReg[i-1].font->name)) {
+				pe = FontReg+i-1;
+				break;
+			}
+		}
+	}
+
+	if (pe) {
+		if ((pe->flags & FONTREG_LOADED))
+			pe->refs++;
+		font = pe->font;
+	}
+	gfxMutexExit(&FontRegMutex);
+	return font;
+}
+
 void gdispCloseFont(font_t font) {
-	(void) font;
+	struct FontRegEntry_t	*pe;
+	bool_t					unused;
+
+	unused = FALSE;
+	gfxMutexEnter(&FontRegMutex);
+	if ((pe = FindFont(font)) && (pe->flags & FONTREG_LOADED) && !--pe->refs) {
+		RemoveFont(pe);
+		unused = TRUE;
+	}
+	gfxMutexExit(&FontRegMutex);
+
+	#if GDISP_NEED_FONTLOAD
+		if (unused)
+			FreeFont(font);
+	#else
+		(void) unused;
+	#endif
+}
+
+bool_t gdispAddFont(font_t font) {
+	bool_t		added;
+
+	gfxMutexEnter(&FontRegMutex);
+	added = FindFont(font) || AddFont(font, 0);
+	gfxMutexExit(&FontRegMutex);
+	return added;
 }
 
 const char *gdispGetFontName(font_t font) {
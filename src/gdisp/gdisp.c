@@ -27,7 +27,16 @@
 /* Driver local variables.                                                   */
 /*===========================================================================*/
 
-#if GDISP_NEED_MULTITHREAD || GDISP_NEED_ASYNC
+#if GDISP_NEED_MULTIPLE_DISPLAYS
+	static const GDISPVMT	gdispVMT = GDISP_VMT_INIT;		/* The main display */
+	static GDisplay			gdispDisplays[GDISP_TOTAL_DISPLAYS];
+	static unsigned			gdispDisplayCount;
+
+	#if GDISP_NEED_MULTITHREAD
+		/* The main display uses the lock belonging to display 0 */
+		#define gdispMutex		(gdispDisplays[0].mutex)
+	#endif
+#elif GDISP_NEED_MULTITHREAD || GDISP_NEED_ASYNC
 	static gfxMutex			gdispMutex;
 #endif
 
@@ -42,10 +51,50 @@
 	static 					DECLARE_THREAD_STACK(waGDISPThread, GDISP_THREAD_STACK_SIZE);
 #endif
 
+#if GDISP_NEED_STATS
+	static GDispStats		gdispStats;
+	#if GDISP_NEED_MULTITHREAD || GDISP_NEED_ASYNC
+		static perftime_t	gdispLockStart;
+	#endif
+	#if GMISC_NEED_TRACE
+		static const char * const gdispStatNames[GDISP_STAT_COUNT] = {
+			"clear", "pixel", "line", "fill", "blit",
+			"circle", "fillcircle", "ellipse", "fillellipse",
+			"arc", "fillarc", "char", "fillchar",
+			"pixelread", "scroll", "control", "query", "clip"
+			};
+	#endif
+#endif
+
+/* Take and release the display lock */
+#if GDISP_NEED_STATS && (GDISP_NEED_MULTITHREAD || GDISP_NEED_ASYNC)
+	#define MUTEX_ENTER()		StatsMutexEnter()
+	#define MUTEX_EXIT()		StatsMutexExit()
+#else
+	#define MUTEX_ENTER()		gfxMutexEnter(&gdispMutex)
+	#define MUTEX_EXIT()		gfxMutexExit(&gdispMutex)
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if GDISP_NEED_STATS && (GDISP_NEED_MULTITHREAD || GDISP_NEED_ASYNC)
+	static void StatsMutexEnter(void) {
+		perftime_t	start;
+
+		start = gmiscPerfClock();
+		gfxMutexEnter(&gdispMutex);
+		gdispLockStart = gmiscPerfClock();
+		gdispStats.lockwait += gdispLockStart - start;
+	}
+
+	static void StatsMutexExit(void) {
+		gdispStats.locktime += gmiscPerfClock() - gdispLockStart;
+		gfxMutexExit(&gdispMutex);
+	}
+#endif
+
 #if GDISP_NEED_ASYNC
 	static DECLARE_THREAD_FUNCTION(GDISPThreadHandler, arg) {
 		(void)arg;
@@ -56,14 +105,14 @@
 			pmsg = (gdisp_lld_msg_t *)gfxQueueGet(&gdispQueue, TIME_INFINITE);
 
 			/* OK - we need to obtain the mutex in case a synchronous operation is occurring */
-			gfxMutexEnter(&gdispMutex);
+			MUTEX_ENTER();
 
 			gdisp_lld_msg_dispatch(pmsg);
 
 			/* Mark the message as free */
 			pmsg->action = GDISP_LLD_MSG_NOP;
 
-			gfxMutexExit(&gdispMutex);
+			MUTEX_EXIT();
 		}
 		return 0;
 	}
@@ -82,6 +131,23 @@
 				if (p->action == GDISP_LLD_MSG_NOP) {
 					/* Allocate it */
 					p->action = action;
+					#if GDISP_NEED_STATS
+						{
+							gdisp_lld_msg_t	*q;
+							uint16_t		depth;
+
+							/* How many messages are now waiting? */
+							for(depth = 0, q = gdispMsgs; q < &gdispMsgs[GDISP_QUEUE_SIZE]; q++) {
+								if (q->action != GDISP_LLD_MSG_NOP)
+									depth++;
+							}
+							if (depth > gdispStats.queuemax)
+								gdispStats.queuemax = depth;
+							#if GMISC_NEED_TRACE
+								gmiscTraceCounter("gdisp", "queue", depth);
+							#endif
+						}
+					#endif
 					gfxMutexExit(&gdispMsgsMutex);
 					return p;
 				}
@@ -101,13 +167,18 @@
 /* Our module initialiser */
 #if GDISP_NEED_MULTITHREAD
 	void _gdispInit(void) {
+		#if GDISP_NEED_MULTIPLE_DISPLAYS
+			gdispDisplays[0].vmt = &gdispVMT;
+			gdispDisplayCount = 1;
+		#endif
+
 		/* Initialise Mutex */
 		gfxMutexInit(&gdispMutex);
 
 		/* Initialise driver */
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_init();
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ASYNC
 	void _gdispInit(void) {
@@ -131,9 +202,15 @@
 		if (hth) gfxThreadClose(hth);
 
 		/* Initialise driver - synchronous */
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
+		gdisp_lld_init();
+		MUTEX_EXIT();
+	}
+#elif GDISP_NEED_MULTIPLE_DISPLAYS
+	void _gdispInit(void) {
+		gdispDisplays[0].vmt = &gdispVMT;
+		gdispDisplayCount = 1;
 		gdisp_lld_init();
-		gfxMutexExit(&gdispMutex);
 	}
 #endif
 
@@ -149,9 +226,9 @@
 
 #if GDISP_NEED_MULTITHREAD
 	void gdispClear(color_t color) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_clear(color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ASYNC
 	void gdispClear(color_t color) {
@@ -163,9 +240,9 @@
 
 #if GDISP_NEED_MULTITHREAD
 	void gdispDrawPixel(coord_t x, coord_t y, color_t color) {
-		gfxMutexEnter(&gdispMutex);
-		gdisp_lld_draw_pixel(x, y, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_ENTER();
+		gdisp_lld_region_draw_pixel(x, y, color);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ASYNC
 	void gdispDrawPixel(coord_t x, coord_t y, color_t color) {
@@ -179,9 +256,9 @@
 	
 #if GDISP_NEED_MULTITHREAD
 	void gdispDrawLine(coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_draw_line(x0, y0, x1, y1, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ASYNC
 	void gdispDrawLine(coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color) {
@@ -197,9 +274,9 @@
 
 #if GDISP_NEED_MULTITHREAD
 	void gdispFillArea(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
-		gfxMutexEnter(&gdispMutex);
-		gdisp_lld_fill_area(x, y, cx, cy, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_ENTER();
+		gdisp_lld_region_fill_area(x, y, cx, cy, color);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ASYNC
 	void gdispFillArea(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
@@ -215,9 +292,9 @@
 	
 #if GDISP_NEED_MULTITHREAD
 	void gdispBlitAreaEx(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
-		gfxMutexEnter(&gdispMutex);
-		gdisp_lld_blit_area_ex(x, y, cx, cy, srcx, srcy, srccx, buffer);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_ENTER();
+		gdisp_lld_region_blit_area_ex(x, y, cx, cy, srcx, srcy, srccx, buffer);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ASYNC
 	void gdispBlitAreaEx(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
@@ -236,9 +313,9 @@
 	
 #if (GDISP_NEED_CLIP && GDISP_NEED_MULTITHREAD)
 	void gdispSetClip(coord_t x, coord_t y, coord_t cx, coord_t cy) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_set_clip(x, y, cx, cy);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_CLIP && GDISP_NEED_ASYNC
 	void gdispSetClip(coord_t x, coord_t y, coord_t cx, coord_t cy) {
@@ -251,11 +328,29 @@
 	}
 #endif
 
+#if (GDISP_NEED_CLIPREGION && GDISP_NEED_MULTITHREAD)
+	void gdispSetClipRegion(const GClipRegion *pr) {
+		MUTEX_ENTER();
+		GDISP.region = pr;
+		MUTEX_EXIT();
+	}
+#elif GDISP_NEED_CLIPREGION && GDISP_NEED_ASYNC
+	void gdispSetClipRegion(const GClipRegion *pr) {
+		gdisp_lld_msg_t *p = gdispAllocMsg(GDISP_LLD_MSG_SETCLIPREGION);
+		p->setclipregion.region = pr;
+		gfxQueuePut(&gdispQueue, &p->qi, TIME_IMMEDIATE);
+	}
+#elif GDISP_NEED_CLIPREGION
+	void gdispSetClipRegion(const GClipRegion *pr) {
+		GDISP.region = pr;
+	}
+#endif
+
 #if (GDISP_NEED_CIRCLE && GDISP_NEED_MULTITHREAD)
 	void gdispDrawCircle(coord_t x, coord_t y, coord_t radius, color_t color) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_draw_circle(x, y, radius, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_CIRCLE && GDISP_NEED_ASYNC
 	void gdispDrawCircle(coord_t x, coord_t y, coord_t radius, color_t color) {
@@ -270,9 +365,9 @@
 	
 #if (GDISP_NEED_CIRCLE && GDISP_NEED_MULTITHREAD)
 	void gdispFillCircle(coord_t x, coord_t y, coord_t radius, color_t color) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_fill_circle(x, y, radius, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_CIRCLE && GDISP_NEED_ASYNC
 	void gdispFillCircle(coord_t x, coord_t y, coord_t radius, color_t color) {
@@ -287,9 +382,9 @@
 
 #if (GDISP_NEED_ELLIPSE && GDISP_NEED_MULTITHREAD)
 	void gdispDrawEllipse(coord_t x, coord_t y, coord_t a, coord_t b, color_t color) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_draw_ellipse(x, y, a, b, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ELLIPSE && GDISP_NEED_ASYNC
 	void gdispDrawEllipse(coord_t x, coord_t y, coord_t a, coord_t b, color_t color) {
@@ -305,9 +400,9 @@
 	
 #if (GDISP_NEED_ELLIPSE && GDISP_NEED_MULTITHREAD)
 	void gdispFillEllipse(coord_t x, coord_t y, coord_t a, coord_t b, color_t color) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_fill_ellipse(x, y, a, b, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ELLIPSE && GDISP_NEED_ASYNC
 	void gdispFillEllipse(coord_t x, coord_t y, coord_t a, coord_t b, color_t color) {
@@ -323,9 +418,9 @@
 
 #if (GDISP_NEED_ARC && GDISP_NEED_MULTITHREAD)
 	void gdispDrawArc(coord_t x, coord_t y, coord_t radius, coord_t start, coord_t end, color_t color) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_draw_arc(x, y, radius, start, end, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ARC && GDISP_NEED_ASYNC
 	void gdispDrawArc(coord_t x, coord_t y, coord_t radius, coord_t start, coord_t end, color_t color) {
@@ -342,9 +437,9 @@
 
 #if (GDISP_NEED_ARC && GDISP_NEED_MULTITHREAD)
 	void gdispFillArc(coord_t x, coord_t y, coord_t radius, coord_t start, coord_t end, color_t color) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_fill_arc(x, y, radius, start, end, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_ARC && GDISP_NEED_ASYNC
 	void gdispFillArc(coord_t x, coord_t y, coord_t radius, coord_t start, coord_t end, color_t color) {
@@ -396,13 +491,13 @@ void gdispFillRoundedBox(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t r
 #endif
 
 #if (GDISP_NEED_TEXT && GDISP_NEED_MULTITHREAD)
-	void gdispDrawChar(coord_t x, coord_t y, char c, font_t font, color_t color) {
-		gfxMutexEnter(&gdispMutex);
+	void gdispDrawChar(coord_t x, coord_t y, unicode_t c, font_t font, color_t color) {
+		MUTEX_ENTER();
 		gdisp_lld_draw_char(x, y, c, font, color);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_TEXT && GDISP_NEED_ASYNC
-	void gdispDrawChar(coord_t x, coord_t y, char c, font_t font, color_t color) {
+	void gdispDrawChar(coord_t x, coord_t y, unicode_t c, font_t font, color_t color) {
 		gdisp_lld_msg_t *p = gdispAllocMsg(GDISP_LLD_MSG_DRAWCHAR);
 		p->drawchar.x = x;
 		p->drawchar.y = y;
@@ -414,13 +509,13 @@ void gdispFillRoundedBox(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t r
 #endif
 
 #if (GDISP_NEED_TEXT && GDISP_NEED_MULTITHREAD)
-	void gdispFillChar(coord_t x, coord_t y, char c, font_t font, color_t color, color_t bgcolor) {
-		gfxMutexEnter(&gdispMutex);
+	void gdispFillChar(coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor) {
+		MUTEX_ENTER();
 		gdisp_lld_fill_char(x, y, c, font, color, bgcolor);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_TEXT && GDISP_NEED_ASYNC
-	void gdispFillChar(coord_t x, coord_t y, char c, font_t font, color_t color, color_t bgcolor) {
+	void gdispFillChar(coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor) {
 		gdisp_lld_msg_t *p = gdispAllocMsg(GDISP_LLD_MSG_FILLCHAR);
 		p->fillchar.x = x;
 		p->fillchar.y = y;
@@ -437,9 +532,9 @@ void gdispFillRoundedBox(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t r
 		color_t		c;
 
 		/* Always synchronous as it must return a value */
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		c = gdisp_lld_get_pixel_color(x, y);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 
 		return c;
 	}
@@ -447,9 +542,9 @@ void gdispFillRoundedBox(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t r
 
 #if (GDISP_NEED_SCROLL && GDISP_NEED_MULTITHREAD)
 	void gdispVerticalScroll(coord_t x, coord_t y, coord_t cx, coord_t cy, int lines, color_t bgcolor) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_vertical_scroll(x, y, cx, cy, lines, bgcolor);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_SCROLL && GDISP_NEED_ASYNC
 	void gdispVerticalScroll(coord_t x, coord_t y, coord_t cx, coord_t cy, int lines, color_t bgcolor) {
@@ -466,9 +561,9 @@ void gdispFillRoundedBox(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t r
 
 #if (GDISP_NEED_CONTROL && GDISP_NEED_MULTITHREAD)
 	void gdispControl(unsigned what, void *value) {
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		gdisp_lld_control(what, value);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 	}
 #elif GDISP_NEED_CONTROL && GDISP_NEED_ASYNC
 	void gdispControl(unsigned what, void *value) {
@@ -483,9 +578,9 @@ void gdispFillRoundedBox(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t r
 	void *gdispQuery(unsigned what) {
 		void *res;
 
-		gfxMutexEnter(&gdispMutex);
+		MUTEX_ENTER();
 		res = gdisp_lld_query(what);
-		gfxMutexExit(&gdispMutex);
+		MUTEX_EXIT();
 		return res;
 	}
 #endif
@@ -520,6 +615,401 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 	}
 }
 
+#if GDISP_NEED_CLIPREGION
+	/* Remove a rectangle from a region. Each rectangle it overlaps is split into up to 4 pieces. */
+	static bool_t regionSubtract(GClipRegion *pr, coord_t x0, coord_t y0, coord_t x1, coord_t y1) {
+		GClipRegion		res;
+		const GClipRect	*r;
+		GClipRect		*n;
+		coord_t			top, bottom;
+		unsigned		i;
+
+		res.count = 0;
+		n = res.rects;
+		for(i = 0, r = pr->rects; i < pr->count; i++, r++) {
+			/* Keep it unchanged if there is no overlap */
+			if (x0 >= r->x1 || x1 <= r->x0 || y0 >= r->y1 || y1 <= r->y0) {
+				if (res.count >= GDISP_CLIPREGION_RECTS) return FALSE;
+				*n++ = *r;
+				res.count++;
+				continue;
+			}
+
+			top = y0 > r->y0 ? y0 : r->y0;
+			bottom = y1 < r->y1 ? y1 : r->y1;
+
+			/* The full width strip above */
+			if (r->y0 < top) {
+				if (res.count >= GDISP_CLIPREGION_RECTS) return FALSE;
+				n->x0 = r->x0; n->y0 = r->y0; n->x1 = r->x1; n->y1 = top;
+				n++; res.count++;
+			}
+			/* The left and right pieces alongside */
+			if (r->x0 < x0) {
+				if (res.count >= GDISP_CLIPREGION_RECTS) return FALSE;
+				n->x0 = r->x0; n->y0 = top; n->x1 = x0; n->y1 = bottom;
+				n++; res.count++;
+			}
+			if (r->x1 > x1) {
+				if (res.count >= GDISP_CLIPREGION_RECTS) return FALSE;
+				n->x0 = x1; n->y0 = top; n->x1 = r->x1; n->y1 = bottom;
+				n++; res.count++;
+			}
+			/* The full width strip below */
+			if (r->y1 > bottom) {
+				if (res.count >= GDISP_CLIPREGION_RECTS) return FALSE;
+				n->x0 = r->x0; n->y0 = bottom; n->x1 = r->x1; n->y1 = r->y1;
+				n++; res.count++;
+			}
+		}
+		*pr = res;
+		return TRUE;
+	}
+
+	void gdispClipRegionInit(GClipRegion *pr, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+		pr->count = 0;
+		if (cx <= 0 || cy <= 0)
+			return;
+		pr->rects[0].x0 = x;
+		pr->rects[0].y0 = y;
+		pr->rects[0].x1 = x+cx;
+		pr->rects[0].y1 = y+cy;
+		pr->count = 1;
+	}
+
+	bool_t gdispClipRegionAdd(GClipRegion *pr, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+		GClipRegion		res;
+
+		if (cx <= 0 || cy <= 0)
+			return TRUE;
+
+		/* Remove any overlap first so the rectangles stay disjoint */
+		res = *pr;
+		if (!regionSubtract(&res, x, y, x+cx, y+cy) || res.count >= GDISP_CLIPREGION_RECTS)
+			return FALSE;
+		res.rects[res.count].x0 = x;
+		res.rects[res.count].y0 = y;
+		res.rects[res.count].x1 = x+cx;
+		res.rects[res.count].y1 = y+cy;
+		res.count++;
+		*pr = res;
+		return TRUE;
+	}
+
+	bool_t gdispClipRegionSubtract(GClipRegion *pr, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+		if (cx <= 0 || cy <= 0)
+			return TRUE;
+		return regionSubtract(pr, x, y, x+cx, y+cy);
+	}
+#endif
+
+#if GDISP_NEED_STYLEDLINE
+	/*
+	 * Send a run of pixels to the driver.
+	 * When asynchronous we must go through the queue to keep the drawing order.
+	 */
+	static void styledrun(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+		#if GDISP_NEED_ASYNC
+			if (cx == 1 && cy == 1)
+				gdispDrawPixel(x, y, color);
+			else
+				gdispFillArea(x, y, cx, cy, color);
+		#else
+			if (cx == 1 && cy == 1)
+				gdisp_lld_region_draw_pixel(x, y, color);
+			else
+				gdisp_lld_region_fill_area(x, y, cx, cy, color);
+		#endif
+	}
+
+	void gdispDrawStyledLine(coord_t x0, coord_t y0, coord_t x1, coord_t y1, coord_t thickness, coord_t dashon, coord_t dashoff, color_t color) {
+		coord_t	dy, dx;
+		coord_t addx, addy;
+		coord_t P, diff, i;
+		coord_t	run, period, len, sx, sy, t;
+
+		if (thickness < 1)
+			thickness = 1;
+		t = (thickness-1)/2;
+
+		/* A zero in the pattern means a solid line */
+		if (dashon <= 0 || dashoff <= 0) {
+			dashon = 1;
+			period = 1;
+		} else
+			period = dashon + dashoff;
+
+		if (x1 >= x0) {
+			dx = x1 - x0;
+			addx = 1;
+		} else {
+			dx = x0 - x1;
+			addx = -1;
+		}
+		if (y1 >= y0) {
+			dy = y1 - y0;
+			addy = 1;
+		} else {
+			dy = y0 - y1;
+			addy = -1;
+		}
+
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_ENTER();
+		#endif
+
+		/*
+		 * Bresenham's algorithm but rather than drawing each pixel we collect
+		 * runs along the major axis. A run ends when the minor axis steps or
+		 * when the dash pattern turns off.
+		 */
+		run = len = sx = sy = 0;
+		if (dx >= dy) {
+			dy *= 2;
+			P = dy - dx;
+			diff = P - dx;
+
+			for(i=0; i<=dx; ++i) {
+				if (run < dashon) {
+					if (len && y0 != sy) {
+						styledrun(addx > 0 ? sx : sx-len+1, sy-t, len, thickness, color);
+						len = 0;
+					}
+					if (!len) {
+						sx = x0;
+						sy = y0;
+					}
+					len++;
+				} else if (len) {
+					styledrun(addx > 0 ? sx : sx-len+1, sy-t, len, thickness, color);
+					len = 0;
+				}
+				if (++run >= period)
+					run = 0;
+				if (P < 0) {
+					P  += dy;
+					x0 += addx;
+				} else {
+					P  += diff;
+					x0 += addx;
+					y0 += addy;
+				}
+			}
+			if (len)
+				styledrun(addx > 0 ? sx : sx-len+1, sy-t, len, thickness, color);
+		} else {
+			dx *= 2;
+			P = dx - dy;
+			diff = P - dy;
+
+			for(i=0; i<=dy; ++i) {
+				if (run < dashon) {
+					if (len && x0 != sx) {
+						styledrun(sx-t, addy > 0 ? sy : sy-len+1, thickness, len, color);
+						len = 0;
+					}
+					if (!len) {
+						sx = x0;
+						sy = y0;
+					}
+					len++;
+				} else if (len) {
+					styledrun(sx-t, addy > 0 ? sy : sy-len+1, thickness, len, color);
+					len = 0;
+				}
+				if (++run >= period)
+					run = 0;
+				if (P < 0) {
+					P  += dx;
+					y0 += addy;
+				} else {
+					P  += diff;
+					x0 += addx;
+					y0 += addy;
+				}
+			}
+			if (len)
+				styledrun(sx-t, addy > 0 ? sy : sy-len+1, thickness, len, color);
+		}
+
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_EXIT();
+		#endif
+	}
+#endif
+
+#if GDISP_NEED_ALPHA || GDISP_NEED_ANTIALIAS
+	/*
+	 * The blend kernels. An alpha of 0 gives the background and 255 gives the foreground.
+	 */
+	#if GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB565
+		/* Spread the channels out in a 32 bit word so all three can be blended with one multiply */
+		#define BLEND565_MASK		0x07E0F81FUL
+		static inline color_t blendColor(color_t fg, color_t bg, unsigned alpha) {
+			uint32_t	f, b;
+
+			alpha = (alpha + 4) >> 3;		/* 0..32 */
+			f = (fg | ((uint32_t)fg << 16)) & BLEND565_MASK;
+			b = (bg | ((uint32_t)bg << 16)) & BLEND565_MASK;
+			b = (b + (((f - b) * alpha) >> 5)) & BLEND565_MASK;
+			return (color_t)(b | (b >> 16));
+		}
+	#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_RGB888
+		/* Red and blue are blended together in one multiply, green in another */
+		static inline color_t blendColor(color_t fg, color_t bg, unsigned alpha) {
+			uint32_t	rb, g;
+
+			alpha += alpha >> 7;			/* 0..256 */
+			rb = ((fg & 0xFF00FF) * alpha + (bg & 0xFF00FF) * (256 - alpha)) >> 8;
+			g = ((fg & 0x00FF00) * alpha + (bg & 0x00FF00) * (256 - alpha)) >> 8;
+			return (color_t)((rb & 0xFF00FF) | (g & 0x00FF00));
+		}
+	#elif GDISP_PIXELFORMAT == GDISP_PIXELFORMAT_MONO
+		static inline color_t blendColor(color_t fg, color_t bg, unsigned alpha) {
+			return alpha >= 128 ? fg : bg;
+		}
+	#else
+		static inline color_t blendColor(color_t fg, color_t bg, unsigned alpha) {
+			unsigned	ialpha;
+
+			alpha += alpha >> 7;			/* 0..256 */
+			ialpha = 256 - alpha;
+			return RGB2COLOR((RED_OF(fg) * alpha + RED_OF(bg) * ialpha) >> 8,
+							(GREEN_OF(fg) * alpha + GREEN_OF(bg) * ialpha) >> 8,
+							(BLUE_OF(fg) * alpha + BLUE_OF(bg) * ialpha) >> 8);
+		}
+	#endif
+
+	color_t gdispBlendColor(color_t fg, color_t bg, uint8_t alpha) {
+		return blendColor(fg, bg, alpha);
+	}
+#endif
+
+#if GDISP_NEED_ALPHA
+
+	/* Clip an area to the clip rectangle. Returns FALSE if nothing is left. Must be called with the mutex held. */
+	static bool_t alphaClip(coord_t *x, coord_t *y, coord_t *cx, coord_t *cy, coord_t *srcx, coord_t *srcy) {
+		#if GDISP_NEED_CLIP || GDISP_NEED_VALIDATION
+			if (*x < GDISP.clipx0) { *cx -= GDISP.clipx0 - *x; *srcx += GDISP.clipx0 - *x; *x = GDISP.clipx0; }
+			if (*y < GDISP.clipy0) { *cy -= GDISP.clipy0 - *y; *srcy += GDISP.clipy0 - *y; *y = GDISP.clipy0; }
+			if (*x + *cx > GDISP.clipx1) *cx = GDISP.clipx1 - *x;
+			if (*y + *cy > GDISP.clipy1) *cy = GDISP.clipy1 - *y;
+		#endif
+		return *cx > 0 && *cy > 0;
+	}
+
+	/* Read part of a row of the display */
+	static void alphaReadRow(pixel_t *buf, coord_t x, coord_t y, coord_t cx) {
+		while(cx--)
+			*buf++ = gdisp_lld_get_pixel_color(x++, y);
+	}
+
+	void gdispFillAreaAlpha(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color, uint8_t alpha) {
+		pixel_t		buf[GDISP_ALPHA_BUFFER_SIZE];
+		coord_t		i, j, k, n, sx, sy;
+
+		if (!alpha)
+			return;
+		if (alpha == 255) {
+			gdispFillArea(x, y, cx, cy, color);
+			return;
+		}
+
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_ENTER();
+		#endif
+		sx = sy = 0;
+		if (alphaClip(&x, &y, &cx, &cy, &sx, &sy)) {
+			for(j = 0; j < cy; j++) {
+				for(i = 0; i < cx; i += n) {
+					n = cx - i > GDISP_ALPHA_BUFFER_SIZE ? GDISP_ALPHA_BUFFER_SIZE : cx - i;
+					alphaReadRow(buf, x+i, y+j, n);
+					for(k = 0; k < n; k++)
+						buf[k] = blendColor(color, buf[k], alpha);
+					gdisp_lld_region_blit_area_ex(x+i, y+j, n, 1, 0, 0, n, buf);
+				}
+			}
+		}
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_EXIT();
+		#endif
+	}
+
+	void gdispBlitAreaAlphaEx(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer, uint8_t alpha) {
+		pixel_t			buf[GDISP_ALPHA_BUFFER_SIZE];
+		const pixel_t	*src;
+		coord_t			i, j, k, n;
+
+		if (!alpha)
+			return;
+		if (alpha == 255) {
+			gdispBlitAreaEx(x, y, cx, cy, srcx, srcy, srccx, buffer);
+			return;
+		}
+
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_ENTER();
+		#endif
+		if (alphaClip(&x, &y, &cx, &cy, &srcx, &srcy)) {
+			for(j = 0; j < cy; j++) {
+				src = buffer + (srcy+j)*srccx + srcx;
+				for(i = 0; i < cx; i += n, src += n) {
+					n = cx - i > GDISP_ALPHA_BUFFER_SIZE ? GDISP_ALPHA_BUFFER_SIZE : cx - i;
+					alphaReadRow(buf, x+i, y+j, n);
+					for(k = 0; k < n; k++)
+						buf[k] = blendColor(src[k], buf[k], alpha);
+					gdisp_lld_region_blit_area_ex(x+i, y+j, n, 1, 0, 0, n, buf);
+				}
+			}
+		}
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_EXIT();
+		#endif
+	}
+
+	void gdispBlitAreaARGBEx(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const uint32_t *buffer) {
+		pixel_t			buf[GDISP_ALPHA_BUFFER_SIZE];
+		const uint32_t	*src;
+		coord_t			i, j, k, n;
+		unsigned		a;
+		bool_t			opaque;
+
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_ENTER();
+		#endif
+		if (alphaClip(&x, &y, &cx, &cy, &srcx, &srcy)) {
+			for(j = 0; j < cy; j++) {
+				src = buffer + (srcy+j)*srccx + srcx;
+				for(i = 0; i < cx; i += n, src += n) {
+					n = cx - i > GDISP_ALPHA_BUFFER_SIZE ? GDISP_ALPHA_BUFFER_SIZE : cx - i;
+
+					/* Only read back the display if something in this piece is not opaque */
+					for(opaque = TRUE, k = 0; k < n; k++) {
+						if ((src[k] >> 24) != 0xFF) {
+							opaque = FALSE;
+							break;
+						}
+					}
+					if (opaque) {
+						for(k = 0; k < n; k++)
+							buf[k] = HTML2COLOR(src[k] & 0xFFFFFF);
+					} else {
+						alphaReadRow(buf, x+i, y+j, n);
+						for(k = 0; k < n; k++) {
+							if ((a = src[k] >> 24))
+								buf[k] = a == 0xFF ? HTML2COLOR(src[k] & 0xFFFFFF) : blendColor(HTML2COLOR(src[k] & 0xFFFFFF), buf[k], a);
+						}
+					}
+					gdisp_lld_region_blit_area_ex(x+i, y+j, n, 1, 0, 0, n, buf);
+				}
+			}
+		}
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_EXIT();
+		#endif
+	}
+#endif
+
 #if GDISP_NEED_CONVEX_POLYGON
 	void gdispDrawPoly(coord_t tx, coord_t ty, const point *pntarray, unsigned cnt, color_t color) {
 		const point	*epnt, *p;
@@ -615,11 +1105,71 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 	}
 #endif
 
+#if GDISP_NEED_TEXT && GDISP_NEED_UTF8
+	/* Decode the UTF-8 character at *pstr and move past it. A badly formed sequence gives U+FFFD. */
+	static unicode_t utf8Next(const char **pstr) {
+		const uint8_t	*s;
+		unicode_t		c;
+		unsigned		n;
+
+		s = (const uint8_t *)*pstr;
+		c = *s++;
+		if (c < 0x80)
+			n = 0;
+		else if (c >= 0xC2 && c < 0xE0) {
+			n = 1;
+			c &= 0x1F;
+		} else if (c >= 0xE0 && c < 0xF0) {
+			n = 2;
+			c &= 0x0F;
+		} else if (c >= 0xF0 && c < 0xF5) {
+			n = 3;
+			c &= 0x07;
+		} else {
+			/* A stray continuation byte or an invalid lead byte */
+			*pstr = (const char *)s;
+			return 0xFFFD;
+		}
+		for(; n; n--, s++) {
+			/* Don't swallow whatever cut the sequence short (including the terminator) */
+			if ((*s & 0xC0) != 0x80) {
+				c = 0xFFFD;
+				break;
+			}
+			c = (c << 6) | (*s & 0x3F);
+		}
+		*pstr = (const char *)s;
+		return c;
+	}
+
+	static unicode_t utf8At(const char *str) {
+		return utf8Next(&str);
+	}
+
+	/* Step back from str to the start of the previous UTF-8 character */
+	static const char *utf8Prev(const char *str, const char *start) {
+		unsigned	n;
+
+		str--;
+		for(n = 0; n < 3 && str > start && ((uint8_t)*str & 0xC0) == 0x80; n++)
+			str--;
+		return str;
+	}
+
+	#define getNextChar(str)		utf8Next(&(str))
+	#define getCharAt(str)			utf8At(str)
+	#define getPrevChar(str, start)	utf8Prev((str), (start))
+#elif GDISP_NEED_TEXT
+	#define getNextChar(str)		(*(str)++)
+	#define getCharAt(str)			(*(str))
+	#define getPrevChar(str, start)	((str)-1)
+#endif
+
 	#if GDISP_NEED_TEXT
 	void gdispDrawString(coord_t x, coord_t y, const char *str, font_t font, color_t color) {
 		/* No mutex required as we only call high level functions which have their own mutex */
 		coord_t		w, p;
-		char		c;
+		unicode_t	c, last = 0;
 		int			first;
 		
 		if (!str) return;
@@ -628,17 +1178,16 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 		p = font->charPadding * font->xscale;
 		while(*str) {
 			/* Get the next printable character */
-			c = *str++;
+			c = getNextChar(str);
 			w = _getCharWidth(font, c) * font->xscale;
 			if (!w) continue;
 			
-			/* Handle inter-character padding */
-			if (p) {
-				if (!first)
-					x += p;
-				else
-					first = 0;
-			}
+			/* Handle inter-character padding and kerning */
+			if (!first)
+				x += p + _getCharKerning(font, last, c);
+			else
+				first = 0;
+			last = c;
 			
 			/* Print the character */
 			gdispDrawChar(x, y, c, font, color);
@@ -650,8 +1199,8 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 #if GDISP_NEED_TEXT
 	void gdispFillString(coord_t x, coord_t y, const char *str, font_t font, color_t color, color_t bgcolor) {
 		/* No mutex required as we only call high level functions which have their own mutex */
-		coord_t		w, h, p;
-		char		c;
+		coord_t		w, h, p, k;
+		unicode_t	c, last = 0;
 		int			first;
 		
 		if (!str) return;
@@ -661,18 +1210,19 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 		p = font->charPadding * font->xscale;
 		while(*str) {
 			/* Get the next printable character */
-			c = *str++;
+			c = getNextChar(str);
 			w = _getCharWidth(font, c) * font->xscale;
 			if (!w) continue;
 			
-			/* Handle inter-character padding */
-			if (p) {
-				if (!first) {
-					gdispFillArea(x, y, p, h, bgcolor);
-					x += p;
-				} else
-					first = 0;
-			}
+			/* Handle inter-character padding and kerning */
+			if (!first) {
+				k = p + _getCharKerning(font, last, c);
+				if (k > 0)
+					gdispFillArea(x, y, k, h, bgcolor);
+				x += k;
+			} else
+				first = 0;
+			last = c;
 
 			/* Print the character */
 			gdispFillChar(x, y, c, font, color, bgcolor);
@@ -684,10 +1234,10 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 #if GDISP_NEED_TEXT
 	void gdispDrawStringBox(coord_t x, coord_t y, coord_t cx, coord_t cy, const char* str, font_t font, color_t color, justify_t justify) {
 		/* No mutex required as we only call high level functions which have their own mutex */
-		coord_t		w, h, p, ypos, xpos;
-		char		c;
+		coord_t		w, h, p, k, ypos, xpos;
+		unicode_t	c, last = 0;
 		int			first;
-		const char *rstr;
+		const char *rstr, *pstr;
 		
 		if (!str) str = "";
 
@@ -723,18 +1273,17 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 				first = 1;
 				while(*str) {
 					/* Get the next printable character */
-					c = *str++;
+					c = getNextChar(str);
 					w = _getCharWidth(font, c) * font->xscale;
 					if (!w) continue;
 					
-					/* Handle inter-character padding */
-					if (p) {
-						if (!first) {
-							xpos += p;
-							if (xpos > ypos) break;
-						} else
-							first = 0;
-					}
+					/* Handle inter-character padding and kerning */
+					if (!first) {
+						xpos += p + _getCharKerning(font, last, c);
+						if (xpos > ypos) break;
+					} else
+						first = 0;
+					last = c;
 
 					/* Print the character */
 					xpos += w;
@@ -748,26 +1297,27 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 			for(rstr = str; *str; str++);
 			xpos = x+cx - 2;
 			first = 1;
-			for(str--; str >= rstr; str--) {
-				/* Get the next printable character */
-				c = *str;
+			while(str > rstr) {
+				/* Get the previous printable character */
+				pstr = getPrevChar(str, rstr);
+				c = getCharAt(pstr);
 				w = _getCharWidth(font, c) * font->xscale;
-				if (!w) continue;
-				
-				/* Handle inter-character padding */
-				if (p) {
+				if (w) {
+					/* Handle inter-character padding and kerning */
 					if (!first) {
-						if (xpos - p < x) break;
-						xpos -= p;
+						k = p + _getCharKerning(font, c, last);
+						if (xpos - k < x) break;
+						xpos -= k;
 					} else
 						first = 0;
-				}
+					last = c;
 
-				/* Print the character */
-				if (xpos - w < x) break;
-				xpos -= w;
+					/* Print the character */
+					if (xpos - w < x) break;
+					xpos -= w;
+				}
+				str = pstr;
 			}
-			str++;
 			break;
 		case justifyLeft:
 			/* Fall through */
@@ -780,18 +1330,18 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 		first = 1;
 		while(*str) {
 			/* Get the next printable character */
-			c = *str++;
+			c = getNextChar(str);
 			w = _getCharWidth(font, c) * font->xscale;
 			if (!w) continue;
 			
-			/* Handle inter-character padding */
-			if (p) {
-				if (!first) {
-					if (xpos + p > x+cx) break;
-					xpos += p;
-				} else
-					first = 0;
-			}
+			/* Handle inter-character padding and kerning */
+			if (!first) {
+				k = p + _getCharKerning(font, last, c);
+				if (xpos + k > x+cx) break;
+				xpos += k;
+			} else
+				first = 0;
+			last = c;
 
 			/* Print the character */
 			if (xpos + w > x+cx) break;
@@ -804,10 +1354,10 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 #if GDISP_NEED_TEXT
 	void gdispFillStringBox(coord_t x, coord_t y, coord_t cx, coord_t cy, const char* str, font_t font, color_t color, color_t bgcolor, justify_t justify) {
 		/* No mutex required as we only call high level functions which have their own mutex */
-		coord_t		w, h, p, ypos, xpos;
-		char		c;
+		coord_t		w, h, p, k, ypos, xpos;
+		unicode_t	c, last = 0;
 		int			first;
-		const char *rstr;
+		const char *rstr, *pstr;
 		
 		if (!str) str = "";
 
@@ -846,18 +1396,17 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 				first = 1;
 				while(*str) {
 					/* Get the next printable character */
-					c = *str++;
+					c = getNextChar(str);
 					w = _getCharWidth(font, c) * font->xscale;
 					if (!w) continue;
 					
-					/* Handle inter-character padding */
-					if (p) {
-						if (!first) {
-							xpos += p;
-							if (xpos > ypos) break;
-						} else
-							first = 0;
-					}
+					/* Handle inter-character padding and kerning */
+					if (!first) {
+						xpos += p + _getCharKerning(font, last, c);
+						if (xpos > ypos) break;
+					} else
+						first = 0;
+					last = c;
 
 					/* Print the character */
 					xpos += w;
@@ -871,26 +1420,27 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 			for(rstr = str; *str; str++);
 			xpos = x+cx - 2;
 			first = 1;
-			for(str--; str >= rstr; str--) {
-				/* Get the next printable character */
-				c = *str;
+			while(str > rstr) {
+				/* Get the previous printable character */
+				pstr = getPrevChar(str, rstr);
+				c = getCharAt(pstr);
 				w = _getCharWidth(font, c) * font->xscale;
-				if (!w) continue;
-				
-				/* Handle inter-character padding */
-				if (p) {
+				if (w) {
+					/* Handle inter-character padding and kerning */
 					if (!first) {
-						if (xpos - p < x) break;
-						xpos -= p;
+						k = p + _getCharKerning(font, c, last);
+						if (xpos - k < x) break;
+						xpos -= k;
 					} else
 						first = 0;
-				}
+					last = c;
 
-				/* Print the character */
-				if (xpos - w < x) break;
-				xpos -= w;
+					/* Print the character */
+					if (xpos - w < x) break;
+					xpos -= w;
+				}
+				str = pstr;
 			}
-			str++;
 			break;
 		case justifyLeft:
 			/* Fall through */
@@ -907,19 +1457,20 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 		first = 1;
 		while(*str) {
 			/* Get the next printable character */
-			c = *str++;
+			c = getNextChar(str);
 			w = _getCharWidth(font, c) * font->xscale;
 			if (!w) continue;
 			
-			/* Handle inter-character padding */
-			if (p) {
-				if (!first) {
-					if (xpos + p > x+cx) break;
-					gdispFillArea(xpos, y, p, cy, bgcolor);
-					xpos += p;
-				} else
-					first = 0;
-			}
+			/* Handle inter-character padding and kerning */
+			if (!first) {
+				k = p + _getCharKerning(font, last, c);
+				if (xpos + k > x+cx) break;
+				if (k > 0)
+					gdispFillArea(xpos, y, k, cy, bgcolor);
+				xpos += k;
+			} else
+				first = 0;
+			last = c;
 
 			/* Print the character */
 			if (xpos + w > x+cx) break;
@@ -949,17 +1500,53 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 #endif
 	
 #if GDISP_NEED_TEXT
-	coord_t gdispGetCharWidth(char c, font_t font) {
+	coord_t gdispGetCharWidth(unicode_t c, font_t font) {
 		/* No mutex required as we only read static data */
 		return _getCharWidth(font, c) * font->xscale;
 	}
 #endif
+
+#if GDISP_NEED_TEXT
+	coord_t gdispGetCharKerning(unicode_t left, unicode_t right, font_t font) {
+		/* No mutex required as we only read static data */
+		#if GDISP_NEED_ANTIALIAS
+			const struct fontkern	*pk;
+			unsigned				lo, hi, mid;
+			int						d;
+
+			if (!font->aa)
+				return 0;
+
+			/* The pairs are sorted so binary search for this one */
+			lo = 0;
+			hi = font->aa->kernCount;
+			while(lo < hi) {
+				mid = (lo + hi) / 2;
+				pk = font->aa->kernTable + mid;
+				d = (int)pk->left - (int)_getCharCode(left);
+				if (!d)
+					d = (int)pk->right - (int)_getCharCode(right);
+				if (!d)
+					return pk->adjust;
+				if (d < 0)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+		#else
+			(void) left;
+			(void) right;
+			(void) font;
+		#endif
+		return 0;
+	}
+#endif
 	
 #if GDISP_NEED_TEXT
 	coord_t gdispGetStringWidth(const char* str, font_t font) {
 		/* No mutex required as we only read static data */
 		coord_t		w, p, x;
-		char		c;
+		unicode_t	c, last = 0;
 		int			first;
 		
 		first = 1;
@@ -967,17 +1554,16 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 		p = font->charPadding * font->xscale;
 		while(*str) {
 			/* Get the next printable character */
-			c = *str++;
+			c = getNextChar(str);
 			w = _getCharWidth(font, c)  * font->xscale;
 			if (!w) continue;
 			
-			/* Handle inter-character padding */
-			if (p) {
-				if (!first)
-					x += p;
-				else
-					first = 0;
-			}
+			/* Handle inter-character padding and kerning */
+			if (!first)
+				x += p + _getCharKerning(font, last, c);
+			else
+				first = 0;
+			last = c;
 			
 			/* Add the character width */
 			x += w;
@@ -986,6 +1572,214 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 	}
 #endif
 
+#if GDISP_NEED_TEXTLAYOUT
+	/* Justify a finished line and drop any characters that don't fit across the box */
+	static void layoutLine(gdispTextLayout *pl, gdispTextLine *pline, justify_t justify) {
+		gdispTextGlyph	*pg, *pd;
+		coord_t			w, xoff;
+		unsigned		i;
+
+		pg = pl->glyphs + pline->first;
+
+		/* Trailing spaces don't count */
+		while(pline->count && pg[pline->count-1].c == ' ')
+			pline->count--;
+		w = pline->count ? pg[pline->count-1].x + pg[pline->count-1].width : 0;
+		if (w > pl->width)
+			pl->width = w;
+
+		/* The same margins as gdispDrawStringBox() */
+		switch(justify) {
+		case justifyCenter:
+			xoff = (pl->cx - w)/2;
+			break;
+		case justifyRight:
+			xoff = pl->cx - 2 - w;
+			break;
+		case justifyLeft:
+			/* Fall through */
+		default:
+			xoff = 1;
+			break;
+		}
+
+		for(pd = pg, i = 0; i < pline->count; i++) {
+			pg[i].x += xoff;
+			if (pg[i].x >= 0 && pg[i].x + pg[i].width <= pl->cx)
+				*pd++ = pg[i];
+		}
+		pline->count = pd - pg;
+	}
+
+	bool_t gdispLayoutText(gdispTextLayout *pl, const char *str, font_t font, coord_t cx, coord_t cy, justify_t justify, bool_t wordwrap) {
+		gdispTextLine	*pline;
+		gdispTextGlyph	*pg;
+		const char		*pstr, *brkstr;
+		coord_t			w, h, p, k, x, pitch, ypos;
+		unicode_t		c, last = 0;
+		unsigned		len, n, brkn, i;
+		bool_t			newline;
+
+		if (!str) str = "";
+
+		/* There can't be more characters than bytes or more lines than characters plus one */
+		for(len = 0; str[len]; len++);
+		if (!(pl->lines = (gdispTextLine *)gfxAlloc((len+1) * sizeof(gdispTextLine) + len * sizeof(gdispTextGlyph))))
+			return FALSE;
+		pl->glyphs = (gdispTextGlyph *)(pl->lines + len + 1);
+		pl->font = font;
+		pl->cx = cx;
+		pl->cy = cy;
+		pl->width = 0;
+
+		/* Split the string into lines */
+		p = font->charPadding * font->xscale;
+		last = 0;
+		n = 0;
+		pline = pl->lines;
+		do {
+			pline->first = n;
+			brkstr = 0;
+			brkn = n;
+			newline = FALSE;
+			x = 0;
+			while(*str) {
+				/* Get the next printable character */
+				pstr = str;
+				c = getNextChar(str);
+				if (c == '\n') {
+					newline = TRUE;
+					break;
+				}
+				w = _getCharWidth(font, c) * font->xscale;
+				if (!w) continue;
+
+				/* Handle inter-character padding and kerning */
+				k = n > pline->first ? p + _getCharKerning(font, last, c) : 0;
+
+				/* Wrap at the last space or just before this character if there wasn't one */
+				if (wordwrap && n > pline->first && x + k + w > cx - 3) {
+					if (brkstr) {
+						n = brkn;
+						str = brkstr;
+					} else
+						str = pstr;
+					while(*str == ' ')
+						str++;
+					break;
+				}
+
+				/* A space is somewhere we could wrap */
+				if (c == ' ' && n > pline->first) {
+					brkn = n;
+					brkstr = str;
+				}
+
+				pg = pl->glyphs + n++;
+				pg->x = x + k;
+				pg->width = w;
+				pg->c = c;
+				x = pg->x + w;
+				last = c;
+			}
+			pline->count = n - pline->first;
+			layoutLine(pl, pline, justify);
+			n = pline->first + pline->count;
+			pline++;
+		} while(*str || newline);
+
+		/* Center the lines vertically and drop the ones that don't fit */
+		h = font->height * font->yscale;
+		pitch = font->lineSpacing * font->yscale;
+		if (pitch < h)
+			pitch = h;
+		pl->height = (pline - pl->lines - 1) * pitch + h;
+		ypos = (cy - pl->height + 1)/2;
+		if (ypos < 0)
+			ypos = 0;
+		for(i = 0; pl->lines+i < pline && ypos + h <= cy; i++, ypos += pitch)
+			pl->lines[i].y = ypos;
+		pl->lineCount = i;
+		return TRUE;
+	}
+
+	void gdispFreeTextLayout(gdispTextLayout *pl) {
+		if (pl->lines) {
+			gfxFree(pl->lines);
+			pl->lines = 0;
+			pl->glyphs = 0;
+			pl->lineCount = 0;
+		}
+	}
+
+	/*
+	 * With GDISP_NEED_ASYNC the layout is drawn through the queue (as gdispDrawString() is) so that it
+	 * stays in order with the drawing already queued. Otherwise the driver is called directly under one mutex.
+	 */
+	#if GDISP_NEED_ASYNC
+		#define layout_draw_char	gdispDrawChar
+		#define layout_fill_char	gdispFillChar
+		#define layout_fill_area	gdispFillArea
+	#else
+		#define layout_draw_char	gdisp_lld_draw_char
+		#define layout_fill_char	gdisp_lld_fill_char
+		#define layout_fill_area	gdisp_lld_region_fill_area
+	#endif
+
+	void gdispDrawTextLayout(coord_t x, coord_t y, const gdispTextLayout *pl, color_t color) {
+		const gdispTextLine		*pline;
+		const gdispTextGlyph	*pg, *pe;
+
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_ENTER();
+		#endif
+		for(pline = pl->lines; pline < pl->lines + pl->lineCount; pline++) {
+			for(pg = pl->glyphs + pline->first, pe = pg + pline->count; pg < pe; pg++)
+				layout_draw_char(x + pg->x, y + pline->y, pg->c, pl->font, color);
+		}
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_EXIT();
+		#endif
+	}
+
+	void gdispFillTextLayout(coord_t x, coord_t y, const gdispTextLayout *pl, color_t color, color_t bgcolor) {
+		const gdispTextLine		*pline;
+		const gdispTextGlyph	*pg, *pe;
+		coord_t					h, ly, xpos, ypos;
+
+		h = pl->font->height * pl->font->yscale;
+		ypos = y;
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_ENTER();
+		#endif
+		for(pline = pl->lines; pline < pl->lines + pl->lineCount; pline++) {
+			/* Fill above the line */
+			ly = y + pline->y;
+			if (ly > ypos)
+				layout_fill_area(x, ypos, pl->cx, ly - ypos, bgcolor);
+
+			/* Fill between the characters */
+			xpos = x;
+			for(pg = pl->glyphs + pline->first, pe = pg + pline->count; pg < pe; pg++) {
+				if (x + pg->x > xpos)
+					layout_fill_area(xpos, ly, x + pg->x - xpos, h, bgcolor);
+				layout_fill_char(x + pg->x, ly, pg->c, pl->font, color, bgcolor);
+				xpos = x + pg->x + pg->width;
+			}
+			if (xpos < x + pl->cx)
+				layout_fill_area(xpos, ly, x + pl->cx - xpos, h, bgcolor);
+			ypos = ly + h;
+		}
+
+		/* Fill below the last line */
+		if (ypos < y + pl->cy)
+			layout_fill_area(x, ypos, pl->cx, y + pl->cy - ypos, bgcolor);
+		#if GDISP_NEED_MULTITHREAD
+			MUTEX_EXIT();
+		#endif
+	}
+#endif
+
 #if (!defined(gdispPackPixels) && !defined(GDISP_PIXELFORMAT_CUSTOM))
 	void gdispPackPixels(pixel_t *buf, coord_t cx, coord_t x, coord_t y, color_t color) {
 		/* No mutex required as we only read static data */
@@ -1001,5 +1795,503 @@ void gdispDrawBox(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
 	}
 #endif
 
+#if GDISP_NEED_MULTIPLE_DISPLAYS
+	#if GDISP_NEED_MULTITHREAD
+		#define DISPLAY_LOCK(g)		gfxMutexEnter(&(g)->mutex)
+		#define DISPLAY_UNLOCK(g)	gfxMutexExit(&(g)->mutex)
+	#else
+		#define DISPLAY_LOCK(g)
+		#define DISPLAY_UNLOCK(g)
+	#endif
+
+	GDisplay *gdispAttachDisplay(const GDISPVMT *vmt) {
+		GDisplay	*g;
+
+		if (gdispDisplayCount >= GDISP_TOTAL_DISPLAYS)
+			return 0;
+
+		g = gdispDisplays + gdispDisplayCount;
+		g->vmt = vmt;
+		#if GDISP_NEED_MULTITHREAD
+			gfxMutexInit(&g->mutex);
+		#endif
+		if (!vmt->init())
+			return 0;
+		gdispDisplayCount++;
+		return g;
+	}
+
+	GDisplay *gdispGetDisplay(unsigned display) {
+		if (display >= gdispDisplayCount)
+			return 0;
+		return gdispDisplays + display;
+	}
+
+	bool_t gdispGIsBusy(GDisplay *g) {
+		(void) g;
+		return FALSE;
+	}
+
+	void gdispGClear(GDisplay *g, color_t color) {
+		DISPLAY_LOCK(g);
+		g->vmt->clear(color);
+		DISPLAY_UNLOCK(g);
+	}
+
+	void gdispGDrawPixel(GDisplay *g, coord_t x, coord_t y, color_t color) {
+		DISPLAY_LOCK(g);
+		g->vmt->draw_pixel(x, y, color);
+		DISPLAY_UNLOCK(g);
+	}
+
+	void gdispGDrawLine(GDisplay *g, coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color) {
+		DISPLAY_LOCK(g);
+		g->vmt->draw_line(x0, y0, x1, y1, color);
+		DISPLAY_UNLOCK(g);
+	}
+
+	void gdispGFillArea(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+		DISPLAY_LOCK(g);
+		g->vmt->fill_area(x, y, cx, cy, color);
+		DISPLAY_UNLOCK(g);
+	}
+
+	void gdispGBlitAreaEx(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
+		DISPLAY_LOCK(g);
+		g->vmt->blit_area_ex(x, y, cx, cy, srcx, srcy, srccx, buffer);
+		DISPLAY_UNLOCK(g);
+	}
+
+	void gdispGDrawBox(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+		coord_t	x1, y1;
+
+		x1 = x+cx-1;
+		y1 = y+cy-1;
+
+		/* Hold the lock so the box is drawn as a single operation */
+		DISPLAY_LOCK(g);
+		if (cx > 2) {
+			if (cy >= 1) {
+				g->vmt->draw_line(x, y, x1, y, color);
+				if (cy >= 2) {
+					g->vmt->draw_line(x, y1, x1, y1, color);
+					if (cy > 2) {
+						g->vmt->draw_line(x, y+1, x, y1-1, color);
+						g->vmt->draw_line(x1, y+1, x1, y1-1, color);
+					}
+				}
+			}
+		} else if (cx == 2) {
+			g->vmt->draw_line(x, y, x, y1, color);
+			g->vmt->draw_line(x1, y, x1, y1, color);
+		} else if (cx == 1) {
+			g->vmt->draw_line(x, y, x, y1, color);
+		}
+		DISPLAY_UNLOCK(g);
+	}
+
+	#if GDISP_NEED_CLIP
+		void gdispGSetClip(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy) {
+			DISPLAY_LOCK(g);
+			g->vmt->set_clip(x, y, cx, cy);
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_CLIPREGION
+		void gdispGSetClipRegion(GDisplay *g, const GClipRegion *pr) {
+			DISPLAY_LOCK(g);
+			g->vmt->state->region = pr;
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_CIRCLE
+		void gdispGDrawCircle(GDisplay *g, coord_t x, coord_t y, coord_t radius, color_t color) {
+			DISPLAY_LOCK(g);
+			g->vmt->draw_circle(x, y, radius, color);
+			DISPLAY_UNLOCK(g);
+		}
+
+		void gdispGFillCircle(GDisplay *g, coord_t x, coord_t y, coord_t radius, color_t color) {
+			DISPLAY_LOCK(g);
+			g->vmt->fill_circle(x, y, radius, color);
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_ELLIPSE
+		void gdispGDrawEllipse(GDisplay *g, coord_t x, coord_t y, coord_t a, coord_t b, color_t color) {
+			DISPLAY_LOCK(g);
+			g->vmt->draw_ellipse(x, y, a, b, color);
+			DISPLAY_UNLOCK(g);
+		}
+
+		void gdispGFillEllipse(GDisplay *g, coord_t x, coord_t y, coord_t a, coord_t b, color_t color) {
+			DISPLAY_LOCK(g);
+			g->vmt->fill_ellipse(x, y, a, b, color);
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_ARC
+		void gdispGDrawArc(GDisplay *g, coord_t x, coord_t y, coord_t radius, coord_t start, coord_t end, color_t color) {
+			DISPLAY_LOCK(g);
+			g->vmt->draw_arc(x, y, radius, start, end, color);
+			DISPLAY_UNLOCK(g);
+		}
+
+		void gdispGFillArc(GDisplay *g, coord_t x, coord_t y, coord_t radius, coord_t start, coord_t end, color_t color) {
+			DISPLAY_LOCK(g);
+			g->vmt->fill_arc(x, y, radius, start, end, color);
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_TEXT
+		void gdispGDrawChar(GDisplay *g, coord_t x, coord_t y, unicode_t c, font_t font, color_t color) {
+			DISPLAY_LOCK(g);
+			g->vmt->draw_char(x, y, c, font, color);
+			DISPLAY_UNLOCK(g);
+		}
+
+		void gdispGFillChar(GDisplay *g, coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor) {
+			DISPLAY_LOCK(g);
+			g->vmt->fill_char(x, y, c, font, color, bgcolor);
+			DISPLAY_UNLOCK(g);
+		}
+
+		void gdispGDrawString(GDisplay *g, coord_t x, coord_t y, const char *str, font_t font, color_t color) {
+			coord_t		w, p;
+			unicode_t	c, last = 0;
+			int			first;
+
+			if (!str) return;
+
+			first = 1;
+			p = font->charPadding * font->xscale;
+			DISPLAY_LOCK(g);
+			while(*str) {
+				/* Get the next printable character */
+				c = getNextChar(str);
+				w = _getCharWidth(font, c) * font->xscale;
+				if (!w) continue;
+
+				/* Handle inter-character padding and kerning */
+				if (!first)
+					x += p + _getCharKerning(font, last, c);
+				else
+					first = 0;
+				last = c;
+
+				/* Print the character */
+				g->vmt->draw_char(x, y, c, font, color);
+				x += w;
+			}
+			DISPLAY_UNLOCK(g);
+		}
+
+		void gdispGFillString(GDisplay *g, coord_t x, coord_t y, const char *str, font_t font, color_t color, color_t bgcolor) {
+			coord_t		w, h, p, k;
+			unicode_t	c, last = 0;
+			int			first;
+
+			if (!str) return;
+
+			first = 1;
+			h = font->height * font->yscale;
+			p = font->charPadding * font->xscale;
+			DISPLAY_LOCK(g);
+			while(*str) {
+				/* Get the next printable character */
+				c = getNextChar(str);
+				w = _getCharWidth(font, c) * font->xscale;
+				if (!w) continue;
+
+				/* Handle inter-character padding and kerning */
+				if (!first) {
+					k = p + _getCharKerning(font, last, c);
+					if (k > 0)
+						g->vmt->fill_area(x, y, k, h, bgcolor);
+					x += k;
+				} else
+					first = 0;
+				last = c;
+
+				/* Print the character */
+				g->vmt->fill_char(x, y, c, font, color, bgcolor);
+				x += w;
+			}
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_TEXTLAYOUT
+		void gdispGDrawTextLayout(GDisplay *g, coord_t x, coord_t y, const gdispTextLayout *pl, color_t color) {
+			const gdispTextLine		*pline;
+			const gdispTextGlyph	*pg, *pe;
+
+			DISPLAY_LOCK(g);
+			for(pline = pl->lines; pline < pl->lines + pl->lineCount; pline++) {
+				for(pg = pl->glyphs + pline->first, pe = pg + pline->count; pg < pe; pg++)
+					g->vmt->draw_char(x + pg->x, y + pline->y, pg->c, pl->font, color);
+			}
+			DISPLAY_UNLOCK(g);
+		}
+
+		void gdispGFillTextLayout(GDisplay *g, coord_t x, coord_t y, const gdispTextLayout *pl, color_t color, color_t bgcolor) {
+			const gdispTextLine		*pline;
+			const gdispTextGlyph	*pg, *pe;
+			coord_t					h, ly, xpos, ypos;
+
+			h = pl->font->height * pl->font->yscale;
+			ypos = y;
+			DISPLAY_LOCK(g);
+			for(pline = pl->lines; pline < pl->lines + pl->lineCount; pline++) {
+				/* Fill above the line */
+				ly = y + pline->y;
+				if (ly > ypos)
+					g->vmt->fill_area(x, ypos, pl->cx, ly - ypos, bgcolor);
+
+				/* Fill between the characters */
+				xpos = x;
+				for(pg = pl->glyphs + pline->first, pe = pg + pline->count; pg < pe; pg++) {
+					if (x + pg->x > xpos)
+						g->vmt->fill_area(xpos, ly, x + pg->x - xpos, h, bgcolor);
+					g->vmt->fill_char(x + pg->x, ly, pg->c, pl->font, color, bgcolor);
+					xpos = x + pg->x + pg->width;
+				}
+				if (xpos < x + pl->cx)
+					g->vmt->fill_area(xpos, ly, x + pl->cx - xpos, h, bgcolor);
+				ypos = ly + h;
+			}
+
+			/* Fill below the last line */
+			if (ypos < y + pl->cy)
+				g->vmt->fill_area(x, ypos, pl->cx, y + pl->cy - ypos, bgcolor);
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_PIXELREAD
+		color_t gdispGGetPixelColor(GDisplay *g, coord_t x, coord_t y) {
+			color_t		c;
+
+			DISPLAY_LOCK(g);
+			c = g->vmt->get_pixel_color(x, y);
+			DISPLAY_UNLOCK(g);
+			return c;
+		}
+	#endif
+
+	#if GDISP_NEED_SCROLL
+		void gdispGVerticalScroll(GDisplay *g, coord_t x, coord_t y, coord_t cx, coord_t cy, int lines, color_t bgcolor) {
+			DISPLAY_LOCK(g);
+			g->vmt->vertical_scroll(x, y, cx, cy, lines, bgcolor);
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_CONTROL
+		void gdispGControl(GDisplay *g, unsigned what, void *value) {
+			DISPLAY_LOCK(g);
+			g->vmt->control(what, value);
+			DISPLAY_UNLOCK(g);
+		}
+	#endif
+
+	#if GDISP_NEED_QUERY
+		void *gdispGQuery(GDisplay *g, unsigned what) {
+			void *res;
+
+			DISPLAY_LOCK(g);
+			res = g->vmt->query(what);
+			DISPLAY_UNLOCK(g);
+			return res;
+		}
+	#endif
+#endif
+
+#if GDISP_NEED_STATS
+	/*
+	 * The measured driver routines. The driver's own routines have been renamed
+	 * to gdisp_lld_xxx_hw() by include/gdisp/lld/gdisp_lld_stats.h
+	 */
+	static void StatsEnd(gdispStatOp op, uint32_t pixels, perftime_t start) {
+		gdispStats.calls[op]++;
+		gdispStats.pixels += pixels;
+		gdispStats.lldtime += gmiscPerfClock() - start;
+		#if GMISC_NEED_TRACE
+			gmiscTraceComplete("gdisp", gdispStatNames[op], start);
+		#endif
+	}
+
+	void gdisp_lld_clear(color_t color) {
+		perftime_t	start = gmiscPerfClock();
+		gdisp_lld_clear_hw(color);
+		StatsEnd(GDISP_STAT_CLEAR, (uint32_t)GDISP.Width * GDISP.Height, start);
+	}
+
+	void gdisp_lld_draw_pixel(coord_t x, coord_t y, color_t color) {
+		perftime_t	start = gmiscPerfClock();
+		gdisp_lld_draw_pixel_hw(x, y, color);
+		StatsEnd(GDISP_STAT_PIXEL, 1, start);
+	}
+
+	void gdisp_lld_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+		perftime_t	start = gmiscPerfClock();
+		gdisp_lld_fill_area_hw(x, y, cx, cy, color);
+		StatsEnd(GDISP_STAT_FILL, (uint32_t)cx * cy, start);
+	}
+
+	void gdisp_lld_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
+		perftime_t	start = gmiscPerfClock();
+		gdisp_lld_blit_area_ex_hw(x, y, cx, cy, srcx, srcy, srccx, buffer);
+		StatsEnd(GDISP_STAT_BLIT, (uint32_t)cx * cy, start);
+	}
+
+	void gdisp_lld_draw_line(coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color) {
+		perftime_t	start = gmiscPerfClock();
+		coord_t		dx, dy;
+
+		gdisp_lld_draw_line_hw(x0, y0, x1, y1, color);
+		dx = x1 > x0 ? x1 - x0 : x0 - x1;
+		dy = y1 > y0 ? y1 - y0 : y0 - y1;
+		StatsEnd(GDISP_STAT_LINE, (dx > dy ? dx : dy) + 1, start);
+	}
+
+	#if GDISP_NEED_CLIPREGION
+		void gdisp_lld_region_draw_pixel(coord_t x, coord_t y, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_region_draw_pixel_hw(x, y, color);
+			StatsEnd(GDISP_STAT_PIXEL, 1, start);
+		}
+
+		void gdisp_lld_region_fill_area(coord_t x, coord_t y, coord_t cx, coord_t cy, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_region_fill_area_hw(x, y, cx, cy, color);
+			StatsEnd(GDISP_STAT_FILL, (uint32_t)cx * cy, start);
+		}
+
+		void gdisp_lld_region_blit_area_ex(coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t *buffer) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_region_blit_area_ex_hw(x, y, cx, cy, srcx, srcy, srccx, buffer);
+			StatsEnd(GDISP_STAT_BLIT, (uint32_t)cx * cy, start);
+		}
+	#endif
+
+	#if GDISP_NEED_CIRCLE
+		void gdisp_lld_draw_circle(coord_t x, coord_t y, coord_t radius, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_draw_circle_hw(x, y, radius, color);
+			StatsEnd(GDISP_STAT_CIRCLE, 0, start);
+		}
+
+		void gdisp_lld_fill_circle(coord_t x, coord_t y, coord_t radius, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_fill_circle_hw(x, y, radius, color);
+			StatsEnd(GDISP_STAT_FILLCIRCLE, 0, start);
+		}
+	#endif
+
+	#if GDISP_NEED_ELLIPSE
+		void gdisp_lld_draw_ellipse(coord_t x, coord_t y, coord_t a, coord_t b, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_draw_ellipse_hw(x, y, a, b, color);
+			StatsEnd(GDISP_STAT_ELLIPSE, 0, start);
+		}
+
+		void gdisp_lld_fill_ellipse(coord_t x, coord_t y, coord_t a, coord_t b, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_fill_ellipse_hw(x, y, a, b, color);
+			StatsEnd(GDISP_STAT_FILLELLIPSE, 0, start);
+		}
+	#endif
+
+	#if GDISP_NEED_ARC
+		void gdisp_lld_draw_arc(coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_draw_arc_hw(x, y, radius, startangle, endangle, color);
+			StatsEnd(GDISP_STAT_ARC, 0, start);
+		}
+
+		void gdisp_lld_fill_arc(coord_t x, coord_t y, coord_t radius, coord_t startangle, coord_t endangle, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_fill_arc_hw(x, y, radius, startangle, endangle, color);
+			StatsEnd(GDISP_STAT_FILLARC, 0, start);
+		}
+	#endif
+
+	#if GDISP_NEED_TEXT
+		void gdisp_lld_draw_char(coord_t x, coord_t y, unicode_t c, font_t font, color_t color) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_draw_char_hw(x, y, c, font, color);
+			StatsEnd(GDISP_STAT_CHAR, 0, start);
+		}
+
+		void gdisp_lld_fill_char(coord_t x, coord_t y, unicode_t c, font_t font, color_t color, color_t bgcolor) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_fill_char_hw(x, y, c, font, color, bgcolor);
+			StatsEnd(GDISP_STAT_FILLCHAR, 0, start);
+		}
+	#endif
+
+	#if GDISP_NEED_PIXELREAD
+		color_t gdisp_lld_get_pixel_color(coord_t x, coord_t y) {
+			perftime_t	start = gmiscPerfClock();
+			color_t		c;
+
+			c = gdisp_lld_get_pixel_color_hw(x, y);
+			StatsEnd(GDISP_STAT_PIXELREAD, 1, start);
+			return c;
+		}
+	#endif
+
+	#if GDISP_NEED_SCROLL
+		void gdisp_lld_vertical_scroll(coord_t x, coord_t y, coord_t cx, coord_t cy, int lines, color_t bgcolor) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_vertical_scroll_hw(x, y, cx, cy, lines, bgcolor);
+			StatsEnd(GDISP_STAT_SCROLL, (uint32_t)cx * cy, start);
+		}
+	#endif
+
+	#if GDISP_NEED_CONTROL
+		void gdisp_lld_control(unsigned what, void *value) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_control_hw(what, value);
+			StatsEnd(GDISP_STAT_CONTROL, 0, start);
+		}
+	#endif
+
+	#if GDISP_NEED_QUERY
+		void *gdisp_lld_query(unsigned what) {
+			perftime_t	start = gmiscPerfClock();
+			void		*res;
+
+			res = gdisp_lld_query_hw(what);
+			StatsEnd(GDISP_STAT_QUERY, 0, start);
+			return res;
+		}
+	#endif
+
+	#if GDISP_NEED_CLIP
+		void gdisp_lld_set_clip(coord_t x, coord_t y, coord_t cx, coord_t cy) {
+			perftime_t	start = gmiscPerfClock();
+			gdisp_lld_set_clip_hw(x, y, cx, cy);
+			StatsEnd(GDISP_STAT_CLIP, 0, start);
+		}
+	#endif
+
+	void gdispGetStats(GDispStats *pstats) {
+		*pstats = gdispStats;
+	}
+
+	void gdispResetStats(void) {
+		static const GDispStats	zero;
+
+		gdispStats = zero;
+	}
+#endif
+
 #endif /* GFX_USE_GDISP */
 /** @} */
@@ -83,6 +83,136 @@ bool_t gdispImageSetMemoryReader(gdispImage *img, const void *memimage) {
 	return TRUE;
 }
 
+#if GDISP_NEED_IMAGE_COMPRESSED
+	/**
+	 * A memory image compressed by file2c -z. See tools/file2c for the format.
+	 * We keep the last window of decompressed bytes. Matches copy from it and short
+	 * seeks backwards (as the decoders do when they re-read a header) just replay it.
+	 */
+	typedef struct ImageCompressed {
+		const uint8_t *	start;		// The first token
+		const uint8_t *	src;		// The next compressed byte
+		size_t			outpos;		// How many bytes have been decompressed
+		size_t			length;		// The uncompressed length
+		uint16_t		run;		// The bytes left in the current token
+		uint16_t		offset;		// How far back the current match is (0 for literals)
+		uint16_t		mask;		// The window size - 1
+		uint8_t			window[1];	// The last decompressed bytes (really the window size)
+	} ImageCompressed;
+
+	/* Decompress the next len bytes. buf may be NULL to skip them. */
+	static void ImageCompressedInflate(ImageCompressed *pz, uint8_t *buf, size_t len) {
+		const uint8_t *	src;
+		size_t			n;
+		uint8_t			c;
+
+		src = pz->src;
+		while(len) {
+			if (!pz->run) {
+				c = *src++;
+				if ((c & 0x80)) {
+					pz->run = (c & 0x7F) + 4;
+					pz->offset = (src[0] | (src[1] << 8)) + 1;
+					src += 2;
+				} else {
+					pz->run = c + 1;
+					pz->offset = 0;
+				}
+			}
+			n = pz->run < len ? pz->run : len;
+			pz->run -= n;
+			len -= n;
+			if (pz->offset) {
+				while(n--) {
+					c = pz->window[(pz->outpos - pz->offset) & pz->mask];
+					pz->window[pz->outpos++ & pz->mask] = c;
+					if (buf) *buf++ = c;
+				}
+			} else {
+				while(n--) {
+					c = *src++;
+					pz->window[pz->outpos++ & pz->mask] = c;
+					if (buf) *buf++ = c;
+				}
+			}
+		}
+		pz->src = src;
+	}
+
+	static size_t ImageCompressedRead(struct gdispImageIO *pio, void *buf, size_t len) {
+		ImageCompressed	*pz;
+		uint8_t			*p;
+		size_t			n;
+
+		if (pio->fd == (void *)-1) return 0;
+		pz = (ImageCompressed *)pio->fd;
+		if (len > pz->length - pio->pos)
+			len = pz->length - pio->pos;
+
+		/* First anything we have seeked back over */
+		for(p = (uint8_t *)buf, n = len; n && pio->pos < pz->outpos; n--)
+			*p++ = pz->window[pio->pos++ & pz->mask];
+
+		if (n) {
+			ImageCompressedInflate(pz, p, n);
+			pio->pos += n;
+		}
+		return len;
+	}
+
+	static void ImageCompressedSeek(struct gdispImageIO *pio, size_t pos) {
+		ImageCompressed	*pz;
+
+		if (pio->fd == (void *)-1) return;
+		pz = (ImageCompressed *)pio->fd;
+		if (pos > pz->length)
+			pos = pz->length;
+
+		/* If it is no longer in the window we have to start again */
+		if (pz->outpos - pos > (size_t)pz->mask + 1 && pos < pz->outpos) {
+			pz->src = pz->start;
+			pz->outpos = 0;
+			pz->run = 0;
+		}
+		if (pos > pz->outpos)
+			ImageCompressedInflate(pz, 0, pos - pz->outpos);
+		pio->pos = pos;
+	}
+
+	static void ImageCompressedClose(struct gdispImageIO *pio) {
+		if (pio->fd == (void *)-1) return;
+		gfxFree((void *)pio->fd);
+		pio->fd = (void *)-1;
+		pio->pos = 0;
+	}
+
+	static const gdispImageIOFunctions ImageCompressedFunctions =
+		{ ImageCompressedRead, ImageCompressedSeek, ImageCompressedClose };
+
+	bool_t gdispImageSetCompressedMemoryReader(gdispImage *img, const void *memimage) {
+		const uint8_t	*p;
+		ImageCompressed	*pz;
+
+		img->io.fns = &ImageCompressedFunctions;
+		img->io.pos = 0;
+		img->io.fd = (void *)-1;
+
+		p = (const uint8_t *)memimage;
+		if (p[0] != 'G' || p[1] != 'Z' || p[2] < 4 || p[2] > 15)
+			return FALSE;
+		if (!(pz = (ImageCompressed *)gfxAlloc(sizeof(ImageCompressed) - 1 + (1 << p[2]))))
+			return FALSE;
+		pz->start = pz->src = p+8;
+		pz->outpos = 0;
+		pz->length = p[4] | (p[5] << 8) | ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);
+		pz->run = 0;
+		pz->offset = 0;
+		pz->mask = (1 << p[2]) - 1;
+		img->io.fd = pz;
+		return TRUE;
+	}
+#endif
+
 #if GFX_USE_OS_CHIBIOS
 	static size_t ImageBaseFileStreamRead(struct gdispImageIO *pio, void *buf, size_t len) {
 		if (pio->fd == (void *)-1) return 0;
@@ -206,11 +336,19 @@ delaytime_t gdispImageNext(gdispImage *img) {
 }
 
 // Helper Routines
+#if GDISP_IMAGE_USE_POOLS
+	#define ImageMemAlloc(sz)		gfxAllocPooled(sz)
+	#define ImageMemFree(ptr)		gfxFreePooled(ptr)
+#else
+	#define ImageMemAlloc(sz)		gfxAlloc(sz)
+	#define ImageMemFree(ptr)		gfxFree(ptr)
+#endif
+
 void *gdispImageAlloc(gdispImage *img, size_t sz) {
 	#if GDISP_NEED_IMAGE_ACCOUNTING
 		void *ptr;
 
-		ptr = gfxAlloc(sz);
+		ptr = ImageMemAlloc(sz);
 		if (ptr) {
 			img->memused += sz;
 			if (img->memused > img->maxmemused)
@@ -219,18 +357,18 @@ void *gdispImageAlloc(gdispImage *img, size_t sz) {
 		return ptr;
 	#else
 		(void) img;
-		return gfxAlloc(sz);
+		return ImageMemAlloc(sz);
 	#endif
 }
 
 void gdispImageFree(gdispImage *img, void *ptr, size_t sz) {
 	#if GDISP_NEED_IMAGE_ACCOUNTING
-		gfxFree(ptr);
+		ImageMemFree(ptr);
 		img->memused -= sz;
 	#else
 		(void) img;
 		(void) sz;
-		gfxFree(ptr);
+		ImageMemFree(ptr);
 	#endif
 }
 
@@ -8,20 +8,54 @@
 /**
  * @file    src/gdisp/image_native.c
  * @brief   GDISP native image code.
+ *
+ * @details	There are two versions of the native format. Both are written by tools/img2native.
+ *
+ * 			Version 1 is an 8 byte header of 'N', 'I', the width, the height and the pixel format
+ * 			(each 16 bit big endian) followed by the pixels exactly as they are in a pixel_t array.
+ *
+ * 			Version 2 is a 16 byte header of 'N', '2', the width, the height and the pixel format
+ * 			as above then...
+ * 				byte 8		- flags: NATIVE_FLG_RLE and/or NATIVE_FLG_PALETTE
+ * 				byte 9		- the bits per palette index (1, 2, 4 or 8)
+ * 				byte 10-11	- the number of palette entries (16 bit big endian)
+ * 				byte 12-15	- the length of the whole image in bytes (32 bit big endian)
+ * 			followed by the palette entries (3 bytes each - red, green and blue), then for
+ * 			an RLE image a table of 32 bit big endian file offsets for the start of each row,
+ * 			then the rows.
+ *
+ * 			Unpacked, each row is either pixels as for version 1 (which must be in GDISP_PIXELFORMAT)
+ * 			or palette indexes packed most significant bits first and padded to a byte. A palette
+ * 			image can be drawn whatever GDISP_PIXELFORMAT is.
+ * 			An RLE row is a series of units (pixels, or bytes of palette indexes)...
+ * 				0nnnnnnn						- (n+1) literal units follow
+ * 				1nnnnnnn unit					- the unit repeated (n+2) times
+ * 			Runs never cross the end of a row.
  */
 #include "gfx.h"
 
 #if GFX_USE_GDISP && GDISP_NEED_IMAGE && GDISP_NEED_IMAGE_NATIVE
 
+#include <string.h>
+
 /**
  * How big a pixel array to allocate for blitting
  * Bigger is faster but uses more RAM.
  */
-#define BLIT_BUFFER_SIZE	32
+#define BLIT_BUFFER_SIZE	64
+
+/**
+ * How many bytes to read from the image at a time
+ */
+#define READ_BUFFER_SIZE	64
 
 #define HEADER_SIZE			8
+#define HEADER2_SIZE		16
 #define FRAME0POS			(HEADER_SIZE)
 
+#define NATIVE_FLG_RLE		0x01
+#define NATIVE_FLG_PALETTE	0x02
+
 /**
  * Helper Routines Needed
  */
@@ -30,20 +64,218 @@ void gdispImageFree(gdispImage *img, void *ptr, size_t sz);
 
 typedef struct gdispImagePrivate {
 	pixel_t		*frame0cache;
+	color_t		*palette;
+	uint16_t	palsize;
+	uint8_t		flags;
+	uint8_t		bpp;					// Bits per palette index
+	uint8_t		unit;					// The size of an RLE unit
+	size_t		datapos;				// Where the rows (or the row offsets) start
+	size_t		dataend;				// Where the image ends - we never read past it
+	size_t		rowbytes;				// The bytes in an unpacked row
+
+	// Where we are in the current row
+	uint8_t		runcnt;					// The units left in the current RLE token
+	bool_t		runrep;					// Is the token a repeat
+	uint8_t		rununit[sizeof(pixel_t)];
+	uint8_t		curbyte;				// The palette indexes we have started on
+	uint8_t		bitsleft;
+
+	// Our read buffer
+	size_t		rbpos;					// The file position of rbuf[0]
+	size_t		rbcnt;
+	size_t		rbidx;
+	uint8_t		rbuf[READ_BUFFER_SIZE];
+
 	pixel_t		buf[BLIT_BUFFER_SIZE];
 	} gdispImagePrivate;
 
+static void SeekTo(gdispImagePrivate *priv, size_t pos) {
+	if (pos >= priv->rbpos && pos <= priv->rbpos + priv->rbcnt) {
+		priv->rbidx = pos - priv->rbpos;
+		return;
+	}
+	priv->rbpos = pos;
+	priv->rbcnt = priv->rbidx = 0;
+}
+
+/* Read n bytes through our buffer. dst may be NULL to skip them. */
+static bool_t ReadBytes(gdispImage *img, uint8_t *dst, size_t n) {
+	gdispImagePrivate	*priv;
+	size_t				m;
+
+	priv = img->priv;
+	if (!dst) {
+		SeekTo(priv, priv->rbpos + priv->rbidx + n);
+		return TRUE;
+	}
+	while(n) {
+		if (priv->rbidx >= priv->rbcnt) {
+			priv->rbpos += priv->rbcnt;
+			priv->rbidx = priv->rbcnt = 0;
+			if (priv->rbpos + n > priv->dataend)
+				return FALSE;
+			img->io.fns->seek(&img->io, priv->rbpos);
+
+			// Big reads go straight to the destination
+			if (n >= READ_BUFFER_SIZE) {
+				if (img->io.fns->read(&img->io, dst, n) != n)
+					return FALSE;
+				priv->rbpos += n;
+				return TRUE;
+			}
+
+			// Read ahead but not past the end of the image (a memory image has nothing after it)
+			m = priv->dataend - priv->rbpos;
+			if (m > READ_BUFFER_SIZE)
+				m = READ_BUFFER_SIZE;
+			if (!(priv->rbcnt = img->io.fns->read(&img->io, priv->rbuf, m)))
+				return FALSE;
+		}
+		m = priv->rbcnt - priv->rbidx;
+		if (m > n)
+			m = n;
+		memcpy(dst, priv->rbuf + priv->rbidx, m);
+		priv->rbidx += m;
+		dst += m;
+		n -= m;
+	}
+	return TRUE;
+}
+
+/* Read n units of the current row, expanding any RLE. dst may be NULL to skip them. */
+static bool_t ReadUnits(gdispImage *img, uint8_t *dst, size_t n) {
+	gdispImagePrivate	*priv;
+	size_t				m;
+	uint8_t				c;
+
+	priv = img->priv;
+	if (!(priv->flags & NATIVE_FLG_RLE))
+		return ReadBytes(img, dst, n * priv->unit);
+
+	while(n) {
+		if (!priv->runcnt) {
+			if (!ReadBytes(img, &c, 1))
+				return FALSE;
+			if ((c & 0x80)) {
+				priv->runcnt = (c & 0x7F) + 2;
+				priv->runrep = TRUE;
+				if (!ReadBytes(img, priv->rununit, priv->unit))
+					return FALSE;
+			} else {
+				priv->runcnt = c + 1;
+				priv->runrep = FALSE;
+			}
+		}
+		m = priv->runcnt < n ? priv->runcnt : n;
+		priv->runcnt -= m;
+		n -= m;
+		if (!priv->runrep) {
+			if (!ReadBytes(img, dst, m * priv->unit))
+				return FALSE;
+			if (dst)
+				dst += m * priv->unit;
+		} else if (dst) {
+			if (priv->unit == 1) {
+				memset(dst, priv->rununit[0], m);
+				dst += m;
+			} else {
+				for(; m; m--, dst += priv->unit)
+					memcpy(dst, priv->rununit, priv->unit);
+			}
+		}
+	}
+	return TRUE;
+}
+
+/* Get ready to read the pixels of a row from pixel sx */
+static bool_t StartRow(gdispImage *img, coord_t row, coord_t sx) {
+	gdispImagePrivate	*priv;
+	uint8_t				offs[4];
+	size_t				bit;
+
+	priv = img->priv;
+	priv->runcnt = 0;
+	priv->bitsleft = 0;
+	bit = (size_t)sx * (priv->flags & NATIVE_FLG_PALETTE ? priv->bpp : 8);
+
+	if ((priv->flags & NATIVE_FLG_RLE)) {
+		// Look up the row and then skip to sx
+		SeekTo(priv, priv->datapos + (size_t)row * 4);
+		if (!ReadBytes(img, offs, 4))
+			return FALSE;
+		SeekTo(priv, ((size_t)offs[0]<<24) | ((size_t)offs[1]<<16) | ((size_t)offs[2]<<8) | offs[3]);
+		if (!ReadUnits(img, 0, (priv->flags & NATIVE_FLG_PALETTE) ? bit/8 : (size_t)sx))
+			return FALSE;
+	} else if ((priv->flags & NATIVE_FLG_PALETTE))
+		SeekTo(priv, priv->datapos + (size_t)row * priv->rowbytes + bit/8);
+	else
+		SeekTo(priv, priv->datapos + ((size_t)row * img->width + sx) * sizeof(pixel_t));
+
+	// Part of a byte of palette indexes
+	if ((bit & 7)) {
+		if (!ReadUnits(img, &priv->curbyte, 1))
+			return FALSE;
+		priv->bitsleft = 8 - (bit & 7);
+	}
+	return TRUE;
+}
+
+/* Read the next cnt pixels of the row */
+static bool_t ReadPixels(gdispImage *img, pixel_t *dst, coord_t cnt) {
+	gdispImagePrivate	*priv;
+	uint8_t				mask;
+
+	priv = img->priv;
+	if (!(priv->flags & NATIVE_FLG_PALETTE))
+		return ReadUnits(img, (uint8_t *)dst, cnt);
+
+	mask = (1 << priv->bpp) - 1;
+	for(; cnt; cnt--) {
+		if (!priv->bitsleft) {
+			if (!ReadUnits(img, &priv->curbyte, 1))
+				return FALSE;
+			priv->bitsleft = 8;
+		}
+		priv->bitsleft -= priv->bpp;
+		*dst++ = priv->palette[(priv->curbyte >> priv->bitsleft) & mask];
+	}
+	return TRUE;
+}
+
+// Free the private data area and everything hanging off it
+static void FreePrivate(gdispImage *img) {
+	if (img->priv) {
+		if (img->priv->frame0cache)
+			gdispImageFree(img, (void *)img->priv->frame0cache, img->width * img->height * sizeof(pixel_t));
+		if (img->priv->palette)
+			gdispImageFree(img, (void *)img->priv->palette, img->priv->palsize * sizeof(color_t));
+		gdispImageFree(img, (void *)img->priv, sizeof(gdispImagePrivate));
+		img->priv = 0;
+	}
+}
+
 gdispImageError gdispImageOpen_NATIVE(gdispImage *img) {
-	uint8_t		hdr[HEADER_SIZE];
+	uint8_t				hdr[HEADER2_SIZE];
+	gdispImagePrivate	*priv;
+	uint16_t			fmt, i;
 
 	/* Read the 8 byte header */
 	if (img->io.fns->read(&img->io, hdr, 8) != 8)
 		return GDISP_IMAGE_ERR_BADFORMAT;		// It can't be us
 
-	if (hdr[0] != 'N' || hdr[1] != 'I')
+	if (hdr[0] != 'N' || (hdr[1] != 'I' && hdr[1] != '2'))
 		return GDISP_IMAGE_ERR_BADFORMAT;		// It can't be us
 
-	if (hdr[6] != GDISP_PIXELFORMAT/256 || hdr[7] != (GDISP_PIXELFORMAT & 0xFF))
+	/* Version 2 has the rest of the header */
+	if (hdr[1] == '2') {
+		if (img->io.fns->read(&img->io, hdr+HEADER_SIZE, HEADER2_SIZE-HEADER_SIZE) != HEADER2_SIZE-HEADER_SIZE)
+			return GDISP_IMAGE_ERR_BADDATA;
+	} else
+		hdr[8] = 0;
+
+	/* Raw pixels must be our pixel format */
+	fmt = (((uint16_t)hdr[6])<<8) | (hdr[7]);
+	if (!(hdr[8] & NATIVE_FLG_PALETTE) && fmt != GDISP_PIXELFORMAT)
 		return GDISP_IMAGE_ERR_UNSUPPORTED;		// Unsupported pixel format
 
 	/* We know we are a native format image */
@@ -52,25 +284,78 @@ gdispImageError gdispImageOpen_NATIVE(gdispImage *img) {
 	img->height = (((uint16_t)hdr[4])<<8) | (hdr[5]);
 	if (img->width < 1 || img->height < 1)
 		return GDISP_IMAGE_ERR_BADDATA;
-	if (!(img->priv = (gdispImagePrivate *)gdispImageAlloc(img, sizeof(gdispImagePrivate))))
+	if (!(img->priv = priv = (gdispImagePrivate *)gdispImageAlloc(img, sizeof(gdispImagePrivate))))
 		return GDISP_IMAGE_ERR_NOMEMORY;
-	img->priv->frame0cache = 0;
+	priv->frame0cache = 0;
+	priv->palette = 0;
+	priv->palsize = 0;
+	priv->flags = hdr[8];
+	priv->rbpos = priv->rbcnt = priv->rbidx = 0;
+
+	if (hdr[1] != '2') {
+		priv->unit = sizeof(pixel_t);
+		priv->rowbytes = img->width * sizeof(pixel_t);
+		priv->datapos = FRAME0POS;
+		priv->dataend = priv->datapos + img->height * priv->rowbytes;
+		return GDISP_IMAGE_ERR_OK;
+	}
 
+	if (!(priv->flags & NATIVE_FLG_PALETTE)) {
+		priv->unit = sizeof(pixel_t);
+		priv->rowbytes = img->width * sizeof(pixel_t);
+		priv->datapos = HEADER2_SIZE;
+		goto setdataend;
+	}
+
+	/* Read the palette - converting it to our pixel format as we go */
+	priv->bpp = hdr[9];
+	priv->palsize = (((uint16_t)hdr[10])<<8) | (hdr[11]);
+	if ((priv->bpp != 1 && priv->bpp != 2 && priv->bpp != 4 && priv->bpp != 8) || !priv->palsize || priv->palsize > (1 << priv->bpp))
+		goto baddatacleanup;
+	priv->unit = 1;
+	priv->rowbytes = ((size_t)img->width * priv->bpp + 7) / 8;
+	priv->datapos = HEADER2_SIZE + priv->palsize * 3;
+	priv->dataend = priv->datapos;				// Only the palette can be read for now
+	if (!(priv->palette = (color_t *)gdispImageAlloc(img, priv->palsize * sizeof(color_t))))
+		goto nomemcleanup;
+	SeekTo(priv, HEADER2_SIZE);
+	for(i = 0; i < priv->palsize; i++) {
+		if (!ReadBytes(img, hdr, 3))
+			goto baddatacleanup;
+		priv->palette[i] = RGB2COLOR(hdr[0], hdr[1], hdr[2]);
+	}
+
+setdataend:
+	/* An RLE image has to tell us where it ends */
+	if ((priv->flags & NATIVE_FLG_RLE)) {
+		priv->dataend = ((size_t)hdr[12]<<24) | ((size_t)hdr[13]<<16) | ((size_t)hdr[14]<<8) | hdr[15];
+		if (priv->dataend < priv->datapos + img->height * 4)
+			goto baddatacleanup;
+	} else
+		priv->dataend = priv->datapos + img->height * priv->rowbytes;
 	return GDISP_IMAGE_ERR_OK;
+
+	/*
+	 * On an unrecoverable error gdispImageClose() won't call us so free the private data area here.
+	 * The file is left open for gdispImageClose() to close.
+	 */
+baddatacleanup:
+	FreePrivate(img);
+	return GDISP_IMAGE_ERR_BADDATA;			// Oops - something wrong
+
+nomemcleanup:
+	FreePrivate(img);
+	return GDISP_IMAGE_ERR_NOMEMORY;		// Out of memory
 }
 
 void gdispImageClose_NATIVE(gdispImage *img) {
-	if (img->priv) {
-		if (img->priv->frame0cache)
-			gdispImageFree(img, (void *)img->priv->frame0cache, img->width * img->height * sizeof(pixel_t));
-		gdispImageFree(img, (void *)img->priv, sizeof(gdispImagePrivate));
-		img->priv = 0;
-	}
+	FreePrivate(img);
 	img->io.fns->close(&img->io);
 }
 
 gdispImageError gdispImageCache_NATIVE(gdispImage *img) {
 	size_t		len;
+	coord_t		row;
 
 	/* If we are already cached - just return OK */
 	if (img->priv->frame0cache)
@@ -83,16 +368,16 @@ gdispImageError gdispImageCache_NATIVE(gdispImage *img) {
 		return GDISP_IMAGE_ERR_NOMEMORY;
 
 	/* Read the entire bitmap into cache */
-	img->io.fns->seek(&img->io, FRAME0POS);
-	if (img->io.fns->read(&img->io, img->priv->frame0cache, len) != len)
-		return GDISP_IMAGE_ERR_BADDATA;
+	for(row = 0; row < img->height; row++) {
+		if (!StartRow(img, row, 0) || !ReadPixels(img, img->priv->frame0cache + row * img->width, img->width))
+			return GDISP_IMAGE_ERR_BADDATA;
+	}
 
 	return GDISP_IMAGE_ERR_OK;
 }
 
 gdispImageError gdispImageDraw_NATIVE(gdispImage *img, coord_t x, coord_t y, coord_t cx, coord_t cy, coord_t sx, coord_t sy) {
-	coord_t		mx, mcx;
-	size_t		pos, len;
+	coord_t		mx, len, rows, i;
 
 	/* Check some reasonableness */
 	if (sx >= img->width || sy >= img->height) return GDISP_IMAGE_ERR_OK;
@@ -105,30 +390,35 @@ gdispImageError gdispImageDraw_NATIVE(gdispImage *img, coord_t x, coord_t y, coo
 		return GDISP_IMAGE_ERR_OK;
 	}
 
-	/* For this image decoder we cheat and just seek straight to the region we want to display */
-	pos = FRAME0POS + (img->width * sy + cx) * sizeof(pixel_t);
+	/* Narrow enough - blit as many whole lines at a time as will fit */
+	if (cx <= BLIT_BUFFER_SIZE) {
+		for(rows = BLIT_BUFFER_SIZE / cx; cy; cy -= rows, sy += rows, y += rows) {
+			if (rows > cy)
+				rows = cy;
+			for(i = 0; i < rows; i++) {
+				if (!StartRow(img, sy+i, sx) || !ReadPixels(img, img->priv->buf + i*cx, cx))
+					return GDISP_IMAGE_ERR_BADDATA;
+			}
+			gdispBlitAreaEx(x, y, cx, rows, 0, 0, cx, img->priv->buf);
+		}
+		return GDISP_IMAGE_ERR_OK;
+	}
 
 	/* Cycle through the lines */
-	for(;cy;cy--, y++) {
+	for(;cy;cy--, y++, sy++) {
 		/* Move to the start of the line */
-		img->io.fns->seek(&img->io, pos);
+		if (!StartRow(img, sy, sx))
+			return GDISP_IMAGE_ERR_BADDATA;
 
 		/* Draw the line in chunks using BitBlt */
-		for(mx = x, mcx = cx; mcx > 0; mcx -= len, mx += len) {
-			// Read the data
-			len = img->io.fns->read(&img->io,
-						img->priv->buf,
-						mx > BLIT_BUFFER_SIZE ? (BLIT_BUFFER_SIZE*sizeof(pixel_t)) : (mx * sizeof(pixel_t)))
-					/ sizeof(pixel_t);
-			if (!len)
+		for(mx = 0; mx < cx; mx += len) {
+			len = cx - mx > BLIT_BUFFER_SIZE ? BLIT_BUFFER_SIZE : cx - mx;
+			if (!ReadPixels(img, img->priv->buf, len))
 				return GDISP_IMAGE_ERR_BADDATA;
 
 			/* Blit the chunk of data */
-			gdispBlitAreaEx(mx, y, len, 1, 0, 0, len, img->priv->buf);
+			gdispBlitAreaEx(x+mx, y, len, 1, 0, 0, len, img->priv->buf);
 		}
-
-		/* Get the position for the start of the next line */
-		pos += img->width*sizeof(pixel_t);
 	}
 
 	return GDISP_IMAGE_ERR_OK;
@@ -28,6 +28,10 @@ static gfxMutex	geventMutex;
 /* Our table of listener/source pairs */
 static GSourceListener		Assignments[GEVENT_MAX_SOURCE_LISTENERS];
 
+#if GEVENT_NEED_STATS
+	static GEventStats		geventStats;
+#endif
+
 /* Loop through the assignment table deleting this listener/source pair. */
 /*	Null is treated as a wildcard. */
 static void deleteAssignments(GListener *pl, GSourceHandle gsh) {
@@ -113,7 +117,27 @@ void geventDetachSource(GListener *pl, GSourceHandle gsh) {
 GEvent *geventEventWait(GListener *pl, delaytime_t timeout) {
 	if (pl->callback || gfxSemCounter(&pl->waitqueue) < 0)
 		return 0;
-	return gfxSemWait(&pl->waitqueue, timeout) ? &pl->event : 0;
+	#if GEVENT_NEED_STATS
+		{
+			perftime_t	latency;
+
+			if (!gfxSemWait(&pl->waitqueue, timeout))
+				return 0;
+			if (pl->event.type != GEVENT_EXIT) {
+				latency = gmiscPerfClock() - pl->sent;
+				geventStats.delivered++;
+				geventStats.latencytotal += latency;
+				if (latency > geventStats.latencymax)
+					geventStats.latencymax = latency;
+				#if GMISC_NEED_TRACE
+					gmiscTraceComplete("gevent", "dispatch", pl->sent);
+				#endif
+			}
+			return &pl->event;
+		}
+	#else
+		return gfxSemWait(&pl->waitqueue, timeout) ? &pl->event : 0;
+	#endif
 }
 
 void geventRegisterCallback(GListener *pl, GEventCallbackFn fn, void *param) {
@@ -158,7 +182,15 @@ GSourceListener *geventGetSourceListener(GSourceHandle gsh, GSourceListener *las
 
 GEvent *geventGetEventBuffer(GSourceListener *psl) {
 	// We already know we have the event lock
-	return &psl->pListener->callback || gfxSemCounter(&psl->pListener->waitqueue) < 0 ? &psl->pListener->event : 0;
+	if (psl->pListener->callback || gfxSemCounter(&psl->pListener->waitqueue) < 0)
+		return &psl->pListener->event;
+	#if GEVENT_NEED_STATS
+		geventStats.dropped++;
+		#if GMISC_NEED_TRACE
+			gmiscTraceInstant("gevent", "dropped");
+		#endif
+	#endif
+	return 0;
 }
 
 void geventSendEvent(GSourceListener *psl) {
@@ -166,12 +198,34 @@ void geventSendEvent(GSourceListener *psl) {
 	if (psl->pListener->callback) {				// This test needs to be taken inside the mutex
 		gfxMutexExit(&geventMutex);
 		// We already know we have the event lock
-		psl->pListener->callback(psl->pListener->param, &psl->pListener->event);
+		#if GEVENT_NEED_STATS
+			{
+				perftime_t	start, t;
+
+				start = gmiscPerfClock();
+				psl->pListener->callback(psl->pListener->param, &psl->pListener->event);
+				t = gmiscPerfClock() - start;
+				geventStats.callbacks++;
+				geventStats.callbacktotal += t;
+				if (t > geventStats.callbackmax)
+					geventStats.callbackmax = t;
+				#if GMISC_NEED_TRACE
+					gmiscTraceComplete("gevent", "callback", start);
+				#endif
+			}
+		#else
+			psl->pListener->callback(psl->pListener->param, &psl->pListener->event);
+		#endif
 
 	} else {
 		// Wake up the listener
-		if (gfxSemCounter(&psl->pListener->waitqueue) <= 0)
+		if (gfxSemCounter(&psl->pListener->waitqueue) <= 0) {
+			#if GEVENT_NEED_STATS
+				psl->pListener->sent = gmiscPerfClock();
+				geventStats.sent++;
+			#endif
 			gfxSemSignal(&psl->pListener->waitqueue);
+		}
 		gfxMutexExit(&geventMutex);
 	}
 }
@@ -182,5 +236,17 @@ void geventDetachSourceListeners(GSourceHandle gsh) {
 	gfxMutexExit(&geventMutex);
 }
 
+#if GEVENT_NEED_STATS
+	void geventGetStats(GEventStats *pstats) {
+		*pstats = geventStats;
+	}
+
+	void geventResetStats(void) {
+		static const GEventStats	zero;
+
+		geventStats = zero;
+	}
+#endif
+
 #endif /* GFX_USE_GEVENT */
 /** @} */
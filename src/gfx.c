@@ -32,9 +32,15 @@ void DEPRECATED("Use gfxInit() instead") gdispInit() { gfxInit(); }
 
 /* These init functions are defined by each module but not published */
 extern void _gosInit(void);
-#if GFX_USE_GDISP && (GDISP_NEED_MULTITHREAD || GDISP_NEED_ASYNC)
+#if GOS_NEED_POOLS
+	extern void _gosPoolInit(void);
+#endif
+#if GFX_USE_GDISP && (GDISP_NEED_MULTITHREAD || GDISP_NEED_ASYNC || GDISP_NEED_MULTIPLE_DISPLAYS)
 	extern void _gdispInit(void);
 #endif
+#if GFX_USE_GDISP && GDISP_NEED_TEXT
+	extern void _gdispFontInit(void);
+#endif
 #if GFX_USE_TDISP
 	extern void _tdispInit(void);
 #endif
@@ -73,6 +79,9 @@ void gfxInit(void) {
 
 	/* These must be initialised in the order of their dependancies */
 	_gosInit();
+	#if GOS_NEED_POOLS
+		_gosPoolInit();
+	#endif
 	#if GFX_USE_GMISC
 		_gmiscInit();
 	#endif
@@ -84,6 +93,9 @@ void gfxInit(void) {
 	#endif
 	#if GFX_USE_GDISP
 		_gdispInit();
+		#if GDISP_NEED_TEXT
+			_gdispFontInit();
+		#endif
 		gdispClear(Black);
 	#endif
 	#if GFX_USE_GWIN
@@ -18,6 +18,253 @@
 #include "gfx.h"
 
 #if (GFX_USE_GINPUT && GINPUT_NEED_KEYBOARD) || defined(__DOXYGEN__)
-	#error "GINPUT: GINPUT_NEED_KEYBOARD - Not Implemented Yet"
+
+#include "ginput/lld/keyboard.h"
+
+#define GKEYQ_DOWN			0x0001			// The key went down (otherwise up)
+#define GKEYQ_MISSED		0x0002			// Events were lost before this one
+
+#define GKEY_ISMETA(code)	((code) >= GKEY_SHIFT && (code) <= GKEY_FNKEY)
+#define GKEY_METABIT(code)	(GMETA_KEY_SHIFT << ((code) - GKEY_SHIFT))
+
+static GTIMER_DECL(KeyboardTimer);
+
+/* The key event queue - filled by the low level driver, emptied by KeyboardPoll() */
+static struct KeyQueueEntry_t {
+	uint16_t	instance;
+	uint16_t	code;
+	uint16_t	flags;
+} KeyQueue[GINPUT_KEYBOARD_QUEUE_SIZE];
+static volatile unsigned	KeyQueueRead;
+static volatile unsigned	KeyQueueCount;
+
+static struct KeyboardStatus_t {
+	uint16_t	code;			// The last key code
+	uint16_t	held;			// The key code currently held down (GKEY_NULL for none)
+	uint16_t	meta;			// The meta keys currently held down
+	uint16_t	last_buttons;	// The current_buttons sent with the last event
+	uint16_t	missed;			// Set (in I-class context) when the queue overflows
+} KeyboardStatus[GINPUT_KEYBOARD_NUM_PORTS];
+
+#if GINPUT_KEYBOARD_REPEAT_DELAY
+	static GTIMER_DECL(KeyRepeatTimer);
+	static uint16_t		RepeatInstance;
+#endif
+
+// Send a key event to the listeners that are interested.
+static void SendKeyEvent(uint16_t instance, uint16_t code, uint16_t buttons) {
+	struct KeyboardStatus_t	*pks;
+	GSourceListener			*psl;
+	GEventKeyboard			*pe;
+	unsigned				flags;
+	char					c;
+
+	pks = KeyboardStatus+instance;
+	c = code < 128 ? (char)code : 0;
+
+	psl = 0;
+	while ((psl = geventGetSourceListener((GSourceHandle)pks, psl))) {
+		flags = psl->listenflags;
+
+		// Does this listener want this event?
+		if ((flags & GLISTEN_KEYSINGLE)) {
+			if (code != (flags & ~GLISTEN_KEYSINGLE) || (buttons & GMETA_KEY_REPEAT))
+				continue;
+		} else if ((buttons & GMETA_KEY_DOWN)) {
+			if ((buttons & GMETA_KEY_REPEAT) && !(flags & GLISTEN_KEYREPEATS))
+				continue;
+			if (!c && !(flags & (GLISTEN_KEYCODES|GLISTEN_KEYALL)))
+				continue;
+		} else if (!(flags & GLISTEN_KEYALL))
+			continue;
+
+		if (!(pe = (GEventKeyboard *)geventGetEventBuffer(psl))) {
+			// This listener is busy - repeats can be coalesced, anything else is a lost event
+			if (!(buttons & GMETA_KEY_REPEAT))
+				psl->srcflags |= GMETA_KEY_MISSED_EVENT;
+			continue;
+		}
+		pe->type = GEVENT_KEYBOARD;
+		pe->instance = instance;
+		pe->c = c;
+		pe->code = code;
+		pe->current_buttons = buttons | psl->srcflags;
+		pe->last_buttons = pks->last_buttons;
+		psl->srcflags = 0;
+		geventSendEvent(psl);
+	}
+	pks->last_buttons = buttons & ~GMETA_KEY_MISSED_EVENT;
+}
+
+#if GINPUT_KEYBOARD_REPEAT_DELAY
+	// Generate a key repeat for the key being held down
+	static void KeyRepeat(void *param) {
+		struct KeyboardStatus_t	*pks;
+		(void) param;
+
+		pks = KeyboardStatus+RepeatInstance;
+		if (pks->held == GKEY_NULL)
+			return;
+		SendKeyEvent(RepeatInstance, pks->held, pks->meta|GMETA_KEY_DOWN|GMETA_KEY_REPEAT);
+		gtimerStart(&KeyRepeatTimer, KeyRepeat, 0, FALSE, GINPUT_KEYBOARD_REPEAT_PERIOD);
+	}
+#endif
+
+// Process a single event taken from the queue
+static void ProcessKey(uint16_t instance, uint16_t code, uint16_t flags) {
+	struct KeyboardStatus_t	*pks;
+	uint16_t				buttons;
+
+	pks = KeyboardStatus+instance;
+	buttons = 0;
+
+	// If we lost events we may also have lost a key up - stop any repeating
+	if ((flags & GKEYQ_MISSED)) {
+		buttons |= GMETA_KEY_MISSED_EVENT;
+		pks->held = GKEY_NULL;
+		#if GINPUT_KEYBOARD_REPEAT_DELAY
+			gtimerStop(&KeyRepeatTimer);
+		#endif
+	}
+
+	if ((flags & GKEYQ_DOWN)) {
+		if (GKEY_ISMETA(code))
+			pks->meta |= GKEY_METABIT(code);
+		buttons |= GMETA_KEY_DOWN;
+
+		if (code == pks->held) {
+			// The driver is generating its own repeats - let it
+			buttons |= GMETA_KEY_REPEAT;
+			#if GINPUT_KEYBOARD_REPEAT_DELAY
+				gtimerStop(&KeyRepeatTimer);
+			#endif
+		} else if (!GKEY_ISMETA(code)) {
+			pks->held = code;
+			#if GINPUT_KEYBOARD_REPEAT_DELAY
+				RepeatInstance = instance;
+				gtimerStart(&KeyRepeatTimer, KeyRepeat, 0, FALSE, GINPUT_KEYBOARD_REPEAT_DELAY);
+			#endif
+		}
+	} else {
+		if (GKEY_ISMETA(code))
+			pks->meta &= ~GKEY_METABIT(code);
+		if (code == pks->held) {
+			pks->held = GKEY_NULL;
+			#if GINPUT_KEYBOARD_REPEAT_DELAY
+				if (RepeatInstance == instance)
+					gtimerStop(&KeyRepeatTimer);
+			#endif
+		}
+	}
+
+	pks->code = code;
+	SendKeyEvent(instance, code, buttons | pks->meta);
+}
+
+// Our polling function - also called when the driver jabs us with new key events
+static void KeyboardPoll(void *param) {
+	struct KeyQueueEntry_t	ke;
+	(void) param;
+
+	#if GINPUT_KEYBOARD_POLL_PERIOD != TIME_INFINITE
+		ginput_lld_keyboard_poll();
+	#endif
+
+	// Empty the queue - only hold the lock while we copy each entry out
+	while(1) {
+		gfxSystemLock();
+		if (!KeyQueueCount) {
+			gfxSystemUnlock();
+			break;
+		}
+		ke = KeyQueue[KeyQueueRead];
+		if (++KeyQueueRead >= GINPUT_KEYBOARD_QUEUE_SIZE)
+			KeyQueueRead = 0;
+		KeyQueueCount--;
+		gfxSystemUnlock();
+
+		ProcessKey(ke.instance, ke.code, ke.flags);
+	}
+}
+
+// Add an event to the queue. Must be called with the system locked.
+static bool_t KeyQueuePutI(uint16_t instance, uint16_t code, bool_t down) {
+	struct KeyQueueEntry_t	*pke;
+
+	if (instance >= GINPUT_KEYBOARD_NUM_PORTS)
+		return FALSE;
+
+	// Coalesce a repeated key down with one that has not been processed yet
+	if (down && KeyQueueCount) {
+		pke = KeyQueue + (KeyQueueRead + KeyQueueCount - 1) % GINPUT_KEYBOARD_QUEUE_SIZE;
+		if (pke->instance == instance && pke->code == code && (pke->flags & GKEYQ_DOWN))
+			return FALSE;
+	}
+
+	// Is the queue full?
+	if (KeyQueueCount >= GINPUT_KEYBOARD_QUEUE_SIZE) {
+		KeyboardStatus[instance].missed = GKEYQ_MISSED;
+		return FALSE;
+	}
+
+	pke = KeyQueue + (KeyQueueRead + KeyQueueCount) % GINPUT_KEYBOARD_QUEUE_SIZE;
+	pke->instance = instance;
+	pke->code = code;
+	pke->flags = (down ? GKEYQ_DOWN : 0) | KeyboardStatus[instance].missed;
+	KeyboardStatus[instance].missed = 0;
+	KeyQueueCount++;
+	return TRUE;
+}
+
+GSourceHandle ginputGetKeyboard(uint16_t instance) {
+	if (instance >= GINPUT_KEYBOARD_NUM_PORTS)
+		return 0;
+
+	// Do we need to initialise the keyboard subsystem?
+	if (!gtimerIsActive(&KeyboardTimer)) {
+		ginput_lld_keyboard_init();
+		gtimerStart(&KeyboardTimer, KeyboardPoll, 0, TRUE, GINPUT_KEYBOARD_POLL_PERIOD);
+	}
+
+	// OK - return this input
+	return (GSourceHandle)(KeyboardStatus+instance);
+}
+
+bool_t ginputGetKeyboardStatus(uint16_t instance, GEventKeyboard *pk) {
+	struct KeyboardStatus_t	*pks;
+
+	// Win32 threads don't seem to recognise priority and/or pre-emption
+	// so we add a sleep here to prevent 100% polled applications from locking up.
+	gfxSleepMilliseconds(1);
+
+	if (instance >= GINPUT_KEYBOARD_NUM_PORTS)
+		return FALSE;
+	pks = KeyboardStatus+instance;
+	pk->type = GEVENT_KEYBOARD;
+	pk->instance = instance;
+	pk->code = pks->code;
+	pk->c = pks->code < 128 ? (char)pks->code : 0;
+	pk->current_buttons = pks->meta | (pks->held != GKEY_NULL ? GMETA_KEY_DOWN : 0);
+	pk->last_buttons = pks->last_buttons;
+	return TRUE;
+}
+
+/* Report a key event from a thread context */
+void ginputKeyboardPut(uint16_t instance, uint16_t code, bool_t down) {
+	bool_t	queued;
+
+	gfxSystemLock();
+	queued = KeyQueuePutI(instance, code, down);
+	gfxSystemUnlock();
+	if (queued)
+		gtimerJab(&KeyboardTimer);
+}
+
+/* Report a key event from an interrupt service routine */
+void ginputKeyboardPutI(uint16_t instance, uint16_t code, bool_t down) {
+	if (KeyQueuePutI(instance, code, down))
+		gtimerJabI(&KeyboardTimer);
+}
+
 #endif /* GFX_USE_GINPUT && GINPUT_NEED_KEYBOARD */
 /** @} */
@@ -36,13 +36,14 @@
 		#define GINPUT_MOUSE_CALIBRATION_POINTS		4
 	#endif
 
+	/* The calibration coefficients are fixed point so no floating point is needed per reading */
 	typedef struct Calibration_t {
-	    float ax;
-	    float bx;
-	    float cx;
-	    float ay;
-	    float by;
-	    float cy;
+	    fixed ax;
+	    fixed bx;
+	    fixed cx;
+	    fixed ay;
+	    fixed by;
+	    fixed cy;
 	} Calibration;
 #endif
 
@@ -50,6 +51,22 @@ typedef struct MousePoint_t {
 	coord_t		x, y;
 	} MousePoint;
 
+#if GINPUT_MOUSE_FILTER_MEDIAN || GINPUT_MOUSE_FILTER_IIR
+	typedef struct MouseFilter_t {
+		#if GINPUT_MOUSE_FILTER_MEDIAN
+			MousePoint	hist[2];			// The previous two raw readings
+		#endif
+		#if GINPUT_MOUSE_FILTER_IIR
+			int32_t		sx, sy;				// The smoothed position (4 fractional bits)
+		#endif
+		MousePoint		last;				// The last filtered position
+		uint8_t			state;
+			#define FILTER_EMPTY		0
+			#define FILTER_PEN_UP		1
+			#define FILTER_PEN_DOWN		2
+		} MouseFilter;
+#endif
+
 static GTIMER_DECL(MouseTimer);
 
 static struct MouseConfig_t {
@@ -70,6 +87,12 @@ static struct MouseConfig_t {
 		GMouseCalibrationLoadRoutine	fnloadcal;
 		Calibration						caldata;
 	#endif
+	#if GINPUT_MOUSE_FILTER_MEDIAN || GINPUT_MOUSE_FILTER_IIR
+		MouseFilter						filter;
+	#endif
+	#if GINPUT_MOUSE_PEN_IRQ
+		delaytime_t						period;
+	#endif
 	} MouseConfig;
 
 #if GINPUT_MOUSE_NEED_CALIBRATION
@@ -97,70 +120,204 @@ static struct MouseConfig_t {
 	}
 
 	static inline void _tsTransform(MouseReading *pt, const Calibration *c) {
-		pt->x = (coord_t) (c->ax * pt->x + c->bx * pt->y + c->cx);
-		pt->y = (coord_t) (c->ay * pt->x + c->by * pt->y + c->cy);
+		int64_t	x, y;
+
+		/* Both results must be calculated from the untransformed reading.
+		 * The products are done in 64 bits as raw readings times a fixed point can overflow 32 bits.
+		 * Adding 0.5 before the shift rounds to the nearest pixel.
+		 */
+		x = pt->x;
+		y = pt->y;
+		pt->x = (coord_t)((c->ax * x + c->bx * y + c->cx + FIXED0_5) >> 16);
+		pt->y = (coord_t)((c->ay * x + c->by * y + c->cy + FIXED0_5) >> 16);
+	}
+
+	/* Divide two integers returning a rounded fixed point result */
+	static fixed _tsFixedDiv(int64_t num, int64_t den) {
+		num <<= 16;
+		if ((num < 0) != (den < 0))
+			return (fixed)((num - den/2) / den);
+		return (fixed)((num + den/2) / den);
 	}
 
 	static inline void _tsDo3PointCalibration(const MousePoint *cross, const MousePoint *points, Calibration *c) {
-		float dx, dx0, dx1, dx2, dy0, dy1, dy2;
+		int64_t dx, dx0, dx1, dx2, dy0, dy1, dy2;
 
-		/* Compute all the required determinants */
-		dx = ((float)(points[0].x - points[2].x)) * ((float)(points[1].y - points[2].y))
-			- ((float)(points[1].x - points[2].x)) * ((float)(points[0].y - points[2].y));
+		/* Compute all the required determinants - all integer so no precision is lost */
+		dx = ((int64_t)(points[0].x - points[2].x)) * (points[1].y - points[2].y)
+			- ((int64_t)(points[1].x - points[2].x)) * (points[0].y - points[2].y);
 
-		dx0 = ((float)(cross[0].x - cross[2].x)) * ((float)(points[1].y - points[2].y))
-			- ((float)(cross[1].x - cross[2].x)) * ((float)(points[0].y - points[2].y));
+		/* Three identical readings - calibration can't be done */
+		if (!dx)
+			dx = 1;
 
-		dx1 = ((float)(cross[1].x - cross[2].x)) * ((float)(points[0].x - points[2].x))
-			- ((float)(cross[0].x - cross[2].x)) * ((float)(points[1].x - points[2].x));
+		dx0 = ((int64_t)(cross[0].x - cross[2].x)) * (points[1].y - points[2].y)
+			- ((int64_t)(cross[1].x - cross[2].x)) * (points[0].y - points[2].y);
 
-		dx2 = cross[0].x * ((float)points[1].x * (float)points[2].y - (float)points[2].x * (float)points[1].y) -
-			cross[1].x * ((float)points[0].x * (float)points[2].y - (float)points[2].x * (float)points[0].y) +
-			cross[2].x * ((float)points[0].x * (float)points[1].y - (float)points[1].x * (float)points[0].y);
+		dx1 = ((int64_t)(cross[1].x - cross[2].x)) * (points[0].x - points[2].x)
+			- ((int64_t)(cross[0].x - cross[2].x)) * (points[1].x - points[2].x);
 
-		dy0 = ((float)(cross[0].y - cross[2].y))  *  ((float)(points[1].y - points[2].y))
-			- ((float)(cross[1].y - cross[2].y))  *  ((float)(points[0].y - points[2].y));
+		dx2 = cross[0].x * ((int64_t)points[1].x * points[2].y - (int64_t)points[2].x * points[1].y) -
+			cross[1].x * ((int64_t)points[0].x * points[2].y - (int64_t)points[2].x * points[0].y) +
+			cross[2].x * ((int64_t)points[0].x * points[1].y - (int64_t)points[1].x * points[0].y);
 
-		dy1  = ((float)(cross[1].y - cross[2].y)) * ((float)(points[0].x - points[2].x))
-			- ((float)(cross[0].y - cross[2].y)) * ((float)(points[1].x - points[2].x));
+		dy0 = ((int64_t)(cross[0].y - cross[2].y)) * (points[1].y - points[2].y)
+			- ((int64_t)(cross[1].y - cross[2].y)) * (points[0].y - points[2].y);
 
-		dy2  = cross[0].y * ((float)points[1].x * (float)points[2].y - (float)points[2].x * (float)points[1].y) -
-			cross[1].y * ((float)points[0].x * (float)points[2].y - (float)points[2].x * (float)points[0].y) +
-			cross[2].y * ((float)points[0].x * (float)points[1].y - (float)points[1].x * (float)points[0].y);
+		dy1 = ((int64_t)(cross[1].y - cross[2].y)) * (points[0].x - points[2].x)
+			- ((int64_t)(cross[0].y - cross[2].y)) * (points[1].x - points[2].x);
+
+		dy2 = cross[0].y * ((int64_t)points[1].x * points[2].y - (int64_t)points[2].x * points[1].y) -
+			cross[1].y * ((int64_t)points[0].x * points[2].y - (int64_t)points[2].x * points[0].y) +
+			cross[2].y * ((int64_t)points[0].x * points[1].y - (int64_t)points[1].x * points[0].y);
 
 		/* Now, calculate all the required coefficients */
-		c->ax = dx0 / dx;
-		c->bx = dx1 / dx;
-		c->cx = dx2 / dx;
+		c->ax = _tsFixedDiv(dx0, dx);
+		c->bx = _tsFixedDiv(dx1, dx);
+		c->cx = _tsFixedDiv(dx2, dx);
 
-		c->ay = dy0 / dx;
-		c->by = dy1 / dx;
-		c->cy = dy2 / dx;
+		c->ay = _tsFixedDiv(dy0, dx);
+		c->by = _tsFixedDiv(dy1, dx);
+		c->cy = _tsFixedDiv(dy2, dx);
 	}
 #endif
 
 #if GINPUT_MOUSE_READ_CYCLES > 1
-	static void get_raw_reading(MouseReading *pt) {
-		int32_t x, y, z;
-		unsigned i;
+	/* Insert a value into a sorted list */
+	static void sorted_insert(coord_t *list, unsigned cnt, coord_t v) {
+		for(; cnt && list[cnt-1] > v; cnt--)
+			list[cnt] = list[cnt-1];
+		list[cnt] = v;
+	}
+
+	static coord_t sorted_median(const coord_t *list, unsigned cnt) {
+		return (cnt & 1) ? list[cnt/2] : (list[cnt/2-1] + list[cnt/2]) / 2;
+	}
+#endif
 
-		x = y = z = 0;
-		for(i = 0; i < GINPUT_MOUSE_READ_CYCLES; i++) {
+#if GINPUT_MOUSE_READ_CYCLES > 1 || GINPUT_MOUSE_READ_HYSTERESIS > 0
+	static void get_raw_reading(MouseReading *pt) {
+		#if GINPUT_MOUSE_READ_CYCLES > 1
+			MouseReading	r[GINPUT_MOUSE_READ_CYCLES];
+			coord_t			sx[GINPUT_MOUSE_READ_CYCLES], sy[GINPUT_MOUSE_READ_CYCLES], sz[GINPUT_MOUSE_READ_CYCLES];
+			unsigned		i, cnt;
+
+			for(i = 0; i < GINPUT_MOUSE_READ_CYCLES; i++)
+				ginput_lld_mouse_get_reading(r+i);
+
+			/* Take the median of the readings that agree with the final button state.
+			 *	This rejects the odd wild reading as well as readings taken as the pen
+			 *	was being pressed or released.
+			 */
+			*pt = r[GINPUT_MOUSE_READ_CYCLES-1];
+			for(i = cnt = 0; i < GINPUT_MOUSE_READ_CYCLES; i++) {
+				if (r[i].buttons != pt->buttons)
+					continue;
+				sorted_insert(sx, cnt, r[i].x);
+				sorted_insert(sy, cnt, r[i].y);
+				sorted_insert(sz, cnt, r[i].z);
+				cnt++;
+			}
+			pt->x = sorted_median(sx, cnt);
+			pt->y = sorted_median(sy, cnt);
+			pt->z = sorted_median(sz, cnt);
+		#else
 			ginput_lld_mouse_get_reading(pt);
-			x += pt->x;
-			y += pt->y;
-			z += pt->z;
-		}
+		#endif
 
-		/* Take the average of the readings */
-		pt->x = x / GINPUT_MOUSE_READ_CYCLES;
-		pt->y = y / GINPUT_MOUSE_READ_CYCLES;
-		pt->z = z / GINPUT_MOUSE_READ_CYCLES;
+		#if GINPUT_MOUSE_READ_HYSTERESIS > 0
+			{
+				static MousePoint	held;
+				static bool_t		holding;
+
+				/* Ignore small changes while the pen stays down. This stops a stationary pen
+				 *	generating a stream of one pixel moves.
+				 */
+				if (!(pt->buttons & GINPUT_MOUSE_BTN_LEFT))
+					holding = FALSE;
+				else if (holding
+						&& pt->x - held.x <= GINPUT_MOUSE_READ_HYSTERESIS && held.x - pt->x <= GINPUT_MOUSE_READ_HYSTERESIS
+						&& pt->y - held.y <= GINPUT_MOUSE_READ_HYSTERESIS && held.y - pt->y <= GINPUT_MOUSE_READ_HYSTERESIS) {
+					pt->x = held.x;
+					pt->y = held.y;
+				} else {
+					held.x = pt->x;
+					held.y = pt->y;
+					holding = TRUE;
+				}
+			}
+		#endif
 	}
 #else
 	#define get_raw_reading(pt)		ginput_lld_mouse_get_reading(pt)
 #endif
 
+#if GINPUT_MOUSE_FILTER_MEDIAN || GINPUT_MOUSE_FILTER_IIR
+	#if GINPUT_MOUSE_FILTER_MEDIAN
+		static inline coord_t median3(coord_t a, coord_t b, coord_t c) {
+			coord_t	t;
+
+			if (a > b) {
+				t = a;
+				a = b;
+				b = t;
+			}
+			return c <= a ? a : (c >= b ? b : c);
+		}
+	#endif
+
+	static void filter_reading(MouseReading *pt) {
+		MouseFilter	*pf;
+		coord_t		x, y;
+
+		pf = &MouseConfig.filter;
+
+		// While the pen is up just hold the last filtered position
+		if (!(pt->buttons & GINPUT_MOUSE_BTN_LEFT)) {
+			if (pf->state != FILTER_EMPTY) {
+				pt->x = pf->last.x;
+				pt->y = pf->last.y;
+				pf->state = FILTER_PEN_UP;
+			}
+			return;
+		}
+
+		x = pt->x;
+		y = pt->y;
+
+		// Pen down - start the filter from this reading
+		if (pf->state != FILTER_PEN_DOWN) {
+			#if GINPUT_MOUSE_FILTER_MEDIAN
+				pf->hist[0].x = pf->hist[1].x = x;
+				pf->hist[0].y = pf->hist[1].y = y;
+			#endif
+			#if GINPUT_MOUSE_FILTER_IIR
+				pf->sx = (int32_t)x << 4;
+				pf->sy = (int32_t)y << 4;
+			#endif
+			pf->state = FILTER_PEN_DOWN;
+		}
+
+		#if GINPUT_MOUSE_FILTER_MEDIAN
+			x = median3(pf->hist[0].x, pf->hist[1].x, pt->x);
+			y = median3(pf->hist[0].y, pf->hist[1].y, pt->y);
+			pf->hist[0] = pf->hist[1];
+			pf->hist[1].x = pt->x;
+			pf->hist[1].y = pt->y;
+		#endif
+
+		#if GINPUT_MOUSE_FILTER_IIR
+			pf->sx += (((int32_t)x << 4) - pf->sx) >> GINPUT_MOUSE_FILTER_IIR;
+			pf->sy += (((int32_t)y << 4) - pf->sy) >> GINPUT_MOUSE_FILTER_IIR;
+			x = (coord_t)((pf->sx + 8) >> 4);
+			y = (coord_t)((pf->sy + 8) >> 4);
+		#endif
+
+		pt->x = pf->last.x = x;
+		pt->y = pf->last.y = y;
+	}
+#endif
+
 static void get_calibrated_reading(MouseReading *pt) {
 	#if GINPUT_MOUSE_NEED_CALIBRATION || GDISP_NEED_CONTROL
 		coord_t		w, h;
@@ -168,6 +325,10 @@ static void get_calibrated_reading(MouseReading *pt) {
 
 	get_raw_reading(pt);
 
+	#if GINPUT_MOUSE_FILTER_MEDIAN || GINPUT_MOUSE_FILTER_IIR
+		filter_reading(pt);
+	#endif
+
 	#if GINPUT_MOUSE_NEED_CALIBRATION || GDISP_NEED_CONTROL
 		w = gdispGetWidth();
 		h = gdispGetHeight();
@@ -210,6 +371,33 @@ static void get_calibrated_reading(MouseReading *pt) {
 	#endif
 }
 
+static void MousePoll(void *param);
+
+#if GINPUT_MOUSE_PEN_IRQ
+	// Set the poll period - TIME_INFINITE means wait for the pen down interrupt
+	static void set_poll_period(delaytime_t period) {
+		if (period == MouseConfig.period && gtimerIsActive(&MouseTimer))
+			return;
+		if (period != TIME_INFINITE && MouseConfig.period == TIME_INFINITE)
+			ginput_lld_mouse_pen_irq(FALSE);
+		MouseConfig.period = period;
+		gtimerStart(&MouseTimer, MousePoll, 0, TRUE, period);
+
+		// Starting the timer clears any jab so only enable the interrupt (which may jab it straight away) once it is running
+		if (period == TIME_INFINITE)
+			ginput_lld_mouse_pen_irq(TRUE);
+	}
+#endif
+
+static void start_poll_timer(void) {
+	#if GINPUT_MOUSE_PEN_IRQ
+		MouseConfig.period = TIME_INFINITE;
+		set_poll_period((MouseConfig.t.buttons & GINPUT_MOUSE_BTN_LEFT) ? GINPUT_MOUSE_PEN_POLL_PERIOD : TIME_INFINITE);
+	#else
+		gtimerStart(&MouseTimer, MousePoll, 0, TRUE, GINPUT_MOUSE_POLL_PERIOD);
+	#endif
+}
+
 static void MousePoll(void *param) {
 	(void) param;
 	GSourceListener	*psl;
@@ -306,6 +494,17 @@ static void MousePoll(void *param) {
 			geventSendEvent(psl);
 		}
 	}
+
+	#if GINPUT_MOUSE_PEN_IRQ
+		// Idle until the next pen down. While the pen is down poll quickly if it is moving
+		//	and back off (up to the normal poll period) while it is held still.
+		if (!(MouseConfig.t.buttons & GINPUT_MOUSE_BTN_LEFT))
+			set_poll_period(TIME_INFINITE);
+		else if (meta || mdiff > GINPUT_MOUSE_MAX_MOVE_JITTER * GINPUT_MOUSE_MAX_MOVE_JITTER || MouseConfig.period == TIME_INFINITE)
+			set_poll_period(GINPUT_MOUSE_PEN_POLL_PERIOD);
+		else if (MouseConfig.period < GINPUT_MOUSE_POLL_PERIOD)
+			set_poll_period(MouseConfig.period * 2 < GINPUT_MOUSE_POLL_PERIOD ? MouseConfig.period * 2 : GINPUT_MOUSE_POLL_PERIOD);
+	#endif
 }
 
 GSourceHandle ginputGetMouse(uint16_t instance) {
@@ -338,11 +537,11 @@ GSourceHandle ginputGetMouse(uint16_t instance) {
 				if ((MouseConfig.flags & FLG_CAL_FREE))
 					gfxFree((void *)pc);
 			} else if (instance == 9999) {
-				MouseConfig.caldata.ax = 1;
+				MouseConfig.caldata.ax = FIXED(1);
 				MouseConfig.caldata.bx = 0;
 				MouseConfig.caldata.cx = 0;
 				MouseConfig.caldata.ay = 0;
-				MouseConfig.caldata.by = 1;
+				MouseConfig.caldata.by = FIXED(1);
 				MouseConfig.caldata.cy = 0;
 				MouseConfig.flags |= (FLG_CAL_OK|FLG_CAL_SAVED);
 			} else
@@ -355,7 +554,7 @@ GSourceHandle ginputGetMouse(uint16_t instance) {
 
 		// Mark init as done and start the Poll timer
 		MouseConfig.flags |= FLG_INIT_DONE;
-		gtimerStart(&MouseTimer, MousePoll, 0, TRUE, GINPUT_MOUSE_POLL_PERIOD);
+		start_poll_timer();
 	}
 
 	// Return our structure as the handle
@@ -502,7 +701,7 @@ bool_t ginputCalibrateMouse(uint16_t instance) {
 		get_calibrated_reading(&MouseConfig.t);
 		MouseConfig.flags &= ~FLG_IN_CAL;
 		if ((MouseConfig.flags & FLG_INIT_DONE))
-			gtimerStart(&MouseTimer, MousePoll, 0, TRUE, GINPUT_MOUSE_POLL_PERIOD);
+			start_poll_timer();
 		
 		// Save the calibration data (if possible)
 		if (MouseConfig.fnsavecal) {
@@ -16,209 +16,291 @@
 
 #if GFX_USE_GMISC && GMISC_NEED_ARRAYOPS
 
+#include <string.h>
+
+/*
+ * Every format is described by its bit width (the format with the signed bit removed)
+ * and its storage size. 4 and 8 bit formats are stored in a byte, the rest in a uint16_t.
+ */
+#define FMT_BITS(fmt)		((unsigned)(fmt) & ~1U)
+#define FMT_SIGNED(fmt)		((unsigned)(fmt) & 1U)
+#define FMT_IS8(fmt)		((fmt) <= ARRAY_DATA_8BITSIGNED)
+#define FMT_MASK(fmt)		((1UL << FMT_BITS(fmt)) - 1)
+#define FMT_SIGNBIT(fmt)	(1UL << (FMT_BITS(fmt) - 1))
+#define FMT_VALID(fmt)		((fmt) >= ARRAY_DATA_4BITUNSIGNED && (fmt) <= ARRAY_DATA_16BITSIGNED && FMT_BITS(fmt) != 6)
+
+/* Replicate a lane value across a 32 bit word */
+#define REP8(x)				((uint32_t)(x) * 0x01010101UL)
+#define REP16(x)			((uint32_t)(x) * 0x00010001UL)
+
+#define ISALIGNED(p)		(!((size_t)(p) & 3))
+
+/* Read an element as a signed value and write one back truncated to the format */
+#define RDVAL(v, msk, sgn)	((int32_t)(((v) & (msk)) ^ (sgn)) - (int32_t)(sgn))
+
+/*
+ * The ARMv7E-M DSP extension (Cortex-M4) can do saturating adds on 4 bytes or 2 halfwords at a time.
+ * Everywhere else we use portable word-at-a-time code and let the compiler vectorise what it can.
+ */
+#if defined(__GNUC__) && (defined(__ARM_ARCH_7EM__) || (defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32))
+	#define ARRAYOPS_SIMD32		TRUE
+	#define SIMD32_OP(op, a, b)	({ uint32_t r; __asm__ (op " %0, %1, %2" : "=r" (r) : "r" (a), "r" (b)); r; })
+#else
+	#define ARRAYOPS_SIMD32		FALSE
+#endif
+
 void gmiscArrayConvert(ArrayDataFormat srcfmt, void *src, ArrayDataFormat dstfmt, void *dst, size_t cnt) {
 	uint8_t		*src8, *dst8;
 	uint16_t	*src16, *dst16;
+	uint32_t	*srcw, *dstw, w, x, m;
+	int			shift;
+
+	if (!FMT_VALID(srcfmt) || !FMT_VALID(dstfmt))
+		return;
+
+	/*
+	 * Every conversion flips the source sign bit if the signedness changes and then
+	 * shifts the value to the new bit width.
+	 */
+	x = FMT_SIGNED(srcfmt) != FMT_SIGNED(dstfmt) ? FMT_SIGNBIT(srcfmt) : 0;
+	shift = (int)FMT_BITS(dstfmt) - (int)FMT_BITS(srcfmt);
 
 	dst8 = dst;
 	dst16 = dst;
 	src8 = src;
 	src16 = src;
 
-	/* We do this as a big switch in order to optimise efficiency for each transfer type */
-	switch(dstfmt) {
-	case ARRAY_DATA_4BITUNSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	if (dst != src) while(cnt--) { *dst8++ = *src8++; }		break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst8++ = (*src8++ ^ 8); }				break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst8++ = *src8++ >> 4; }				break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst8++ = (*src8++ ^ 128) >> 4; }		break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 6; }				break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 512) >> 6; }		break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 8; }				break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 2048) >> 8; }		break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 10; }				break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 8192) >> 10; }		break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 12; }				break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 32768) >> 12; }	break;
-		}
-		break;
-	case ARRAY_DATA_4BITSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst8++ = (*src8++ ^ 8); }				break;
-		case ARRAY_DATA_4BITSIGNED:		if (dst != src) while(cnt--) { *dst8++ = *src8++; }		break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst8++ = (*src8++ ^ 128) >> 4; }		break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst8++ = *src8++ >> 4; }				break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 512) >> 6; }		break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 6; }				break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 2048) >> 8; }		break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 8; }				break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 8192) >> 10; }		break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 10; }				break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 32768) >> 12; }	break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 12; }				break;
-		}
-		break;
-	case ARRAY_DATA_8BITUNSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst8++ = *src8++ << 4; }				break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst8++ = (*src8++ ^ 8) << 4; }			break;
-		case ARRAY_DATA_8BITUNSIGNED:	if (dst != src) while(cnt--) { *dst8++ = *src8++; }		break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst8++ = (*src8++ ^ 128); }				break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 512) >> 2; }		break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 4; }				break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 2048) >> 4; }		break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 6; }				break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 8192) >> 6; }		break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 8; }				break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 32768) >> 8; }		break;
+	if (FMT_IS8(srcfmt) == FMT_IS8(dstfmt)) {
+		/* The same storage size - nothing to do if the format is the same */
+		if (!x && !shift) {
+			if (dst != src)
+				memmove(dst, src, FMT_IS8(srcfmt) ? cnt : cnt * sizeof(uint16_t));
+			return;
 		}
-		break;
-	case ARRAY_DATA_8BITSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst8++ = (*src8++ ^ 8) << 4; }			break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst8++ = *src8++ << 4; }				break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst8++ = (*src8++ ^ 128); }				break;
-		case ARRAY_DATA_8BITSIGNED:		if (dst != src) while(cnt--) { *dst8++ = *src8++; }		break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 512) >> 2; }		break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 2048) >> 4; }		break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 4; }				break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 8192) >> 6; }		break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 6; }				break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst8++ = (*src16++ ^ 32768) >> 8; }		break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst8++ = *src16++ >> 8; }				break;
-		}
-		break;
-	case ARRAY_DATA_10BITUNSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst16++ = *src8++ << 6; }				break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst16++ = (*src8++ ^ 8) << 6; }			break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst16++ = *src8++ << 2; }				break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst16++ = (*src8++ ^ 128) << 2; }		break;
-		case ARRAY_DATA_10BITUNSIGNED:	if (dst != src) while(cnt--) { *dst16++ = *src16++; }	break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 512); }			break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 2048) >> 2; }		break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 4; }				break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 8192) >> 4; }		break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 6; }				break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 32768) >> 6; }	break;
-		}
-		break;
-	case ARRAY_DATA_10BITSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst16++ = (*src8++ ^ 8) << 6; }			break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst16++ = *src8++ << 6; }				break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst16++ = (*src8++ ^ 128) << 2; }		break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst16++ = *src8++ << 2; }				break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 512); }			break;
-		case ARRAY_DATA_10BITSIGNED:	if (dst != src) while(cnt--) { *dst16++ = *src16++; }	break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 2048) >> 2; }		break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 8192) >> 4; }		break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 4; }				break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 32768) >> 6; }	break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 6; }				break;
-		}
-		break;
-	case ARRAY_DATA_12BITUNSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst16++ = *src8++ << 8; }				break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst16++ = (*src8++ ^ 8) << 8; }			break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst16++ = *src8++ << 4; }				break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst16++ = (*src8++ ^ 128) << 4; }		break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ << 2; }				break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 512) << 2; }		break;
-		case ARRAY_DATA_12BITUNSIGNED:	if (dst != src) while(cnt--) { *dst16++ = *src16++; }	break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 2048); }			break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 8192) >> 2; }		break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 4; }				break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 32768) >> 4; }	break;
+
+		if (FMT_IS8(srcfmt)) {
+			/* Do single elements until we are word aligned and then do 4 at a time */
+			for(; cnt && !ISALIGNED(dst8); cnt--, src8++)
+				*dst8++ = shift > 0 ? (uint8_t)((*src8 ^ x) << shift) : (uint8_t)((*src8 ^ x) >> -shift);
+			if (ISALIGNED(src8)) {
+				srcw = (uint32_t *)src8;
+				dstw = (uint32_t *)dst8;
+				x = REP8(x);
+				if (shift > 0) {
+					m = REP8((0xFF << shift) & 0xFF);
+					for(; cnt >= 4; cnt -= 4)
+						*dstw++ = ((*srcw++ ^ x) << shift) & m;
+				} else {
+					m = REP8(0xFF >> -shift);
+					for(; cnt >= 4; cnt -= 4)
+						*dstw++ = ((*srcw++ ^ x) >> -shift) & m;
+				}
+				src8 = (uint8_t *)srcw;
+				dst8 = (uint8_t *)dstw;
+				x &= 0xFF;
+			}
+			for(; cnt; cnt--, src8++)
+				*dst8++ = shift > 0 ? (uint8_t)((*src8 ^ x) << shift) : (uint8_t)((*src8 ^ x) >> -shift);
+		} else {
+			/* Do single elements until we are word aligned and then do 2 at a time */
+			for(; cnt && !ISALIGNED(dst16); cnt--, src16++)
+				*dst16++ = shift > 0 ? (uint16_t)((*src16 ^ x) << shift) : (uint16_t)((*src16 ^ x) >> -shift);
+			if (ISALIGNED(src16)) {
+				srcw = (uint32_t *)src16;
+				dstw = (uint32_t *)dst16;
+				x = REP16(x);
+				if (shift > 0) {
+					m = REP16((0xFFFF << shift) & 0xFFFF);
+					for(; cnt >= 2; cnt -= 2)
+						*dstw++ = ((*srcw++ ^ x) << shift) & m;
+				} else {
+					m = REP16(0xFFFF >> -shift);
+					for(; cnt >= 2; cnt -= 2)
+						*dstw++ = ((*srcw++ ^ x) >> -shift) & m;
+				}
+				src16 = (uint16_t *)srcw;
+				dst16 = (uint16_t *)dstw;
+				x &= 0xFFFF;
+			}
+			for(; cnt; cnt--, src16++)
+				*dst16++ = shift > 0 ? (uint16_t)((*src16 ^ x) << shift) : (uint16_t)((*src16 ^ x) >> -shift);
 		}
-		break;
-	case ARRAY_DATA_12BITSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst16++ = (*src8++ ^ 8) << 8; }			break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst16++ = *src8++ << 8; }				break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst16++ = (*src8++ ^ 128) << 4; }		break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst16++ = *src8++ << 4; }				break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 512) << 2; }		break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst16++ = *src16++ << 2; }				break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 2048); }			break;
-		case ARRAY_DATA_12BITSIGNED:	if (dst != src) while(cnt--) { *dst16++ = *src16++; }	break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 8192) >> 2; }		break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 32768) >> 4; }	break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 4; }				break;
+		return;
+	}
+
+	/* Changing the storage size. Going down is always a right shift and going up is always a left shift. */
+	if (FMT_IS8(dstfmt)) {
+		for(; cnt >= 4; cnt -= 4, src16 += 4, dst8 += 4) {
+			w = ((uint32_t)src16[0] | ((uint32_t)src16[1] << 16)) ^ REP16(x);
+			dst8[0] = (uint8_t)((w & 0xFFFF) >> -shift);
+			dst8[1] = (uint8_t)(w >> (16 - shift));
+			w = ((uint32_t)src16[2] | ((uint32_t)src16[3] << 16)) ^ REP16(x);
+			dst8[2] = (uint8_t)((w & 0xFFFF) >> -shift);
+			dst8[3] = (uint8_t)(w >> (16 - shift));
 		}
-		break;
-	case ARRAY_DATA_14BITUNSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst16++ = *src8++ << 10; }				break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst16++ = (*src8++ ^ 8) << 10; }		break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst16++ = *src8++ << 6; }				break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst16++ = (*src8++ ^ 128) << 6; }		break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ << 4; }				break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 512) << 4; }		break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ << 2; }				break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 2048) >> 2; }		break;
-		case ARRAY_DATA_14BITUNSIGNED:	if (dst != src) while(cnt--) { *dst16++ = *src16++; }	break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 8192); }			break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 32768) >> 2; }	break;
+		while(cnt--)
+			*dst8++ = (uint8_t)((*src16++ ^ x) >> -shift);
+	} else {
+		for(; cnt >= 4; cnt -= 4, src8 += 4, dst16 += 4) {
+			dst16[0] = (uint16_t)((src8[0] ^ x) << shift);
+			dst16[1] = (uint16_t)((src8[1] ^ x) << shift);
+			dst16[2] = (uint16_t)((src8[2] ^ x) << shift);
+			dst16[3] = (uint16_t)((src8[3] ^ x) << shift);
 		}
-		break;
-	case ARRAY_DATA_14BITSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst16++ = (*src8++ ^ 8) << 10; }		break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst16++ = *src8++ << 10; }				break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst16++ = (*src8++ ^ 128) << 6; }		break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst16++ = *src8++ << 6; }				break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 512) << 4; }		break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst16++ = *src16++ << 4; }				break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 2048) << 2; }		break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst16++ = *src16++ << 2; }				break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 8192); }			break;
-		case ARRAY_DATA_14BITSIGNED:	if (dst != src) while(cnt--) { *dst16++ = *src16++; }	break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 32768) >> 2; }	break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 2; }				break;
+		while(cnt--)
+			*dst16++ = (uint16_t)((*src8++ ^ x) << shift);
+	}
+}
+
+/*
+ * Apply an operation to every element. The operation works on v (the element as a
+ * signed value) and the result is truncated to the format bit width.
+ */
+#define ARRAYLOOP(fmt, src, dst, cnt, op) {													\
+		uint32_t	msk = FMT_MASK(fmt), sgn = FMT_SIGNED(fmt) ? FMT_SIGNBIT(fmt) : 0;		\
+		int32_t		v;																		\
+		if (FMT_IS8(fmt)) {																	\
+			uint8_t	*s8 = (uint8_t *)(src), *d8 = (uint8_t *)(dst);							\
+			for(; cnt; cnt--) { v = RDVAL(*s8++, msk, sgn); op; *d8++ = (uint8_t)(v & msk); }	\
+		} else {																			\
+			uint16_t *s16 = (uint16_t *)(src), *d16 = (uint16_t *)(dst);					\
+			for(; cnt; cnt--) { v = RDVAL(*s16++, msk, sgn); op; *d16++ = (uint16_t)(v & msk); }	\
+		}																					\
+	}
+
+/*
+ * Add two arrays (or an array and a constant when src2 is NULL) one word at a time.
+ * Lanes are wrapped to the format bit width. Returns the number of elements done.
+ */
+static size_t wordadd(ArrayDataFormat fmt, uint8_t *src1, uint8_t *src2, uint8_t *dst, size_t cnt, uint32_t k) {
+	uint32_t	*s1, *s2, *d, m, h, a, b;
+	size_t		n, per;
+
+	per = FMT_IS8(fmt) ? 4 : 2;
+	if (!ISALIGNED(src1) || !ISALIGNED(dst) || (src2 && !ISALIGNED(src2)))
+		return 0;
+
+	m = FMT_IS8(fmt) ? REP8(FMT_MASK(fmt)) : REP16(FMT_MASK(fmt));
+	h = FMT_IS8(fmt) ? REP8(0x80) : REP16(0x8000);
+	k = FMT_IS8(fmt) ? REP8(k & FMT_MASK(fmt)) : REP16(k & FMT_MASK(fmt));
+	s1 = (uint32_t *)src1;
+	s2 = (uint32_t *)src2;
+	d = (uint32_t *)dst;
+
+	for(n = cnt / per; n; n--) {
+		a = *s1++ & m;
+		b = s2 ? *s2++ & m : k;
+		if (FMT_BITS(fmt) == 8 || FMT_BITS(fmt) == 16)
+			// Full lanes - stop the carry out of each lane spilling into the next
+			*d++ = ((a & ~h) + (b & ~h)) ^ ((a ^ b) & h);
+		else
+			// Narrow formats have spare bits at the top of each lane to absorb the carry
+			*d++ = (a + b) & m;
+	}
+	return cnt - cnt % per;
+}
+
+void gmiscArrayTranslate(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int trans) {
+	size_t	done;
+
+	if (!FMT_VALID(fmt))
+		return;
+
+	done = wordadd(fmt, src, 0, dst, cnt, (uint32_t)trans);
+	cnt -= done;
+	if (FMT_IS8(fmt)) {
+		src = (uint8_t *)src + done;
+		dst = (uint8_t *)dst + done;
+	} else {
+		src = (uint16_t *)src + done;
+		dst = (uint16_t *)dst + done;
+	}
+	ARRAYLOOP(fmt, src, dst, cnt, v += trans);
+}
+
+void gmiscArrayMultiply(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mult) {
+	if (!FMT_VALID(fmt))
+		return;
+	ARRAYLOOP(fmt, src, dst, cnt, v *= mult);
+}
+
+void gmiscArrayDivide(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mdiv) {
+	if (!FMT_VALID(fmt) || !mdiv)
+		return;
+	ARRAYLOOP(fmt, src, dst, cnt, v /= mdiv);
+}
+
+void gmiscArrayMultDiv(ArrayDataFormat fmt, void *src, void *dst, size_t cnt, int mult, int div) {
+	if (!FMT_VALID(fmt) || !div)
+		return;
+	ARRAYLOOP(fmt, src, dst, cnt, v = v * mult / div);
+}
+
+void gmiscArrayAdd(ArrayDataFormat fmt, void *src1, void *src2, void *dst, size_t cnt) {
+	uint32_t	msk;
+	size_t		done;
+
+	if (!FMT_VALID(fmt))
+		return;
+
+	done = wordadd(fmt, src1, src2, dst, cnt, 0);
+	cnt -= done;
+	msk = FMT_MASK(fmt);
+	if (FMT_IS8(fmt)) {
+		uint8_t	*s1 = (uint8_t *)src1 + done, *s2 = (uint8_t *)src2 + done, *d = (uint8_t *)dst + done;
+		while(cnt--)
+			*d++ = (uint8_t)((*s1++ + *s2++) & msk);
+	} else {
+		uint16_t *s1 = (uint16_t *)src1 + done, *s2 = (uint16_t *)src2 + done, *d = (uint16_t *)dst + done;
+		while(cnt--)
+			*d++ = (uint16_t)((*s1++ + *s2++) & msk);
+	}
+}
+
+void gmiscArrayAddNoOverflow(ArrayDataFormat fmt, void *src1, void *src2, void *dst, size_t cnt) {
+	uint32_t	msk, sgn;
+	int32_t		v, lo, hi;
+
+	if (!FMT_VALID(fmt))
+		return;
+
+	#if ARRAYOPS_SIMD32
+		/* Full width lanes map directly onto the DSP saturating adds */
+		if ((FMT_BITS(fmt) == 8 || FMT_BITS(fmt) == 16) && ISALIGNED(src1) && ISALIGNED(src2) && ISALIGNED(dst)) {
+			uint32_t	*s1 = src1, *s2 = src2, *d = dst;
+			size_t		n;
+
+			switch(fmt) {
+			case ARRAY_DATA_8BITUNSIGNED:	for(n = cnt/4; n; n--) *d++ = SIMD32_OP("uqadd8", *s1++, *s2++);	break;
+			case ARRAY_DATA_8BITSIGNED:		for(n = cnt/4; n; n--) *d++ = SIMD32_OP("qadd8", *s1++, *s2++);		break;
+			case ARRAY_DATA_16BITUNSIGNED:	for(n = cnt/2; n; n--) *d++ = SIMD32_OP("uqadd16", *s1++, *s2++);	break;
+			default:						for(n = cnt/2; n; n--) *d++ = SIMD32_OP("qadd16", *s1++, *s2++);	break;
+			}
+			n = FMT_IS8(fmt) ? cnt - cnt % 4 : cnt - cnt % 2;
+			cnt -= n;
+			src1 = FMT_IS8(fmt) ? (void *)((uint8_t *)src1 + n) : (void *)((uint16_t *)src1 + n);
+			src2 = FMT_IS8(fmt) ? (void *)((uint8_t *)src2 + n) : (void *)((uint16_t *)src2 + n);
+			dst = FMT_IS8(fmt) ? (void *)((uint8_t *)dst + n) : (void *)((uint16_t *)dst + n);
 		}
-		break;
-	case ARRAY_DATA_16BITUNSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst16++ = *src8++ << 12; }				break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst16++ = (*src8++ ^ 8) << 12; }		break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst16++ = *src8++ << 8; }				break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst16++ = (*src8++ ^ 128) << 8; }		break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ << 6; }				break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 512) << 6; }		break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ << 4; }				break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 2048) >> 4; }		break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 8192) >> 2; }		break;
-		case ARRAY_DATA_16BITUNSIGNED:	if (dst != src) while(cnt--) { *dst16++ = *src16++; }	break;
-		case ARRAY_DATA_16BITSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 32768); }			break;
+	#endif
+
+	/* Clamp to the range of the format */
+	msk = FMT_MASK(fmt);
+	sgn = FMT_SIGNED(fmt) ? FMT_SIGNBIT(fmt) : 0;
+	lo = -(int32_t)sgn;
+	hi = (int32_t)(msk - sgn);
+	if (FMT_IS8(fmt)) {
+		uint8_t	*s1 = src1, *s2 = src2, *d = dst;
+		while(cnt--) {
+			v = RDVAL(*s1++, msk, sgn) + RDVAL(*s2++, msk, sgn);
+			*d++ = (uint8_t)((v < lo ? lo : (v > hi ? hi : v)) & msk);
 		}
-		break;
-	case ARRAY_DATA_16BITSIGNED:
-		switch(srcfmt) {
-		case ARRAY_DATA_4BITUNSIGNED:	while(cnt--) { *dst16++ = (*src8++ ^ 8) << 12; }		break;
-		case ARRAY_DATA_4BITSIGNED:		while(cnt--) { *dst16++ = *src8++ << 12; }				break;
-		case ARRAY_DATA_8BITUNSIGNED:	while(cnt--) { *dst16++ = (*src8++ ^ 128) << 8; }		break;
-		case ARRAY_DATA_8BITSIGNED:		while(cnt--) { *dst16++ = *src8++ << 8; }				break;
-		case ARRAY_DATA_10BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 512) << 6; }		break;
-		case ARRAY_DATA_10BITSIGNED:	while(cnt--) { *dst16++ = *src16++ << 6; }				break;
-		case ARRAY_DATA_12BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 2048) << 4; }		break;
-		case ARRAY_DATA_12BITSIGNED:	while(cnt--) { *dst16++ = *src16++ << 4; }				break;
-		case ARRAY_DATA_14BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 8192) << 2; }		break;
-		case ARRAY_DATA_14BITSIGNED:	while(cnt--) { *dst16++ = *src16++ >> 2; }				break;
-		case ARRAY_DATA_16BITUNSIGNED:	while(cnt--) { *dst16++ = (*src16++ ^ 32768); }			break;
-		case ARRAY_DATA_16BITSIGNED:	if (dst != src) while(cnt--) { *dst16++ = *src16++; }	break;
+	} else {
+		uint16_t *s1 = src1, *s2 = src2, *d = dst;
+		while(cnt--) {
+			v = RDVAL(*s1++, msk, sgn) + RDVAL(*s2++, msk, sgn);
+			*d++ = (uint16_t)((v < lo ? lo : (v > hi ? hi : v)) & msk);
 		}
-		break;
 	}
 }
 
@@ -0,0 +1,321 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    src/gmisc/dsp.c
+ * @brief   GMISC fixed point signal processing.
+ *
+ * @addtogroup GMISC
+ * @{
+ */
+#include "gfx.h"
+
+#if (GFX_USE_GMISC && GMISC_NEED_DSP) || defined(__DOXYGEN__)
+
+/* The number of samples we convert at a time when we are handed a raw buffer */
+#define DSP_CHUNK		32
+
+/* sin() for a quarter of a circle of 1024 steps as Q15 */
+static const q15 sin1024[257] = {
+		0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210,
+		2411, 2611, 2811, 3012, 3212, 3412, 3612, 3812, 4011, 4211, 4410, 4609,
+		4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195, 6393, 6590, 6787, 6983,
+		7180, 7376, 7571, 7767, 7962, 8157, 8351, 8546, 8740, 8933, 9127, 9319,
+		9512, 9704, 9896, 10088, 10279, 10469, 10660, 10850, 11039, 11228, 11417, 11605,
+		11793, 11980, 12167, 12354, 12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828,
+		14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269, 15447, 15624, 15800, 15976,
+		16151, 16326, 16500, 16673, 16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+		18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358, 19520, 19681, 19841, 20001,
+		20160, 20318, 20475, 20632, 20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856,
+		22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028, 23170, 23312, 23453, 23593,
+		23732, 23870, 24008, 24144, 24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+		25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199, 26320, 26439, 26557, 26674,
+		26791, 26906, 27020, 27133, 27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002,
+		28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803, 28899, 28993, 29086, 29178,
+		29269, 29359, 29448, 29535, 29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+		30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784, 30853, 30920, 30986, 31050,
+		31114, 31177, 31238, 31298, 31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737,
+		31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099, 32138, 32177, 32214, 32251,
+		32286, 32319, 32352, 32383, 32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+		32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718, 32729, 32738, 32746, 32753,
+		32758, 32762, 32766, 32767, 32767,
+	};
+
+/* sin() and cos() for an angle where 1024 is a full circle */
+static q15 dspsin(unsigned a) {
+	a &= 1023;
+	if (a < 256)	return sin1024[a];
+	if (a < 512)	return sin1024[512-a];
+	if (a < 768)	return -sin1024[a-512];
+	return -sin1024[1024-a];
+}
+#define dspcos(a)	dspsin((a)+256)
+
+static uint32_t dspsqrt(uint32_t v) {
+	uint32_t	r, b;
+
+	r = 0;
+	for(b = 1UL << 30; b > v; b >>= 2);
+	for(; b; b >>= 2) {
+		if (v >= r + b) {
+			v -= r + b;
+			r = (r >> 1) + b;
+		} else
+			r >>= 1;
+	}
+	return r;
+}
+
+static q15 dspsat(int32_t v) {
+	return v > 32767 ? 32767 : (v < -32768 ? -32768 : (q15)v);
+}
+
+/*
+ * Get the next chunk of a raw sample buffer as Q15. Signed 16 bit buffers are used
+ * directly, anything else is converted into buf. Returns the number of samples.
+ */
+static size_t dspchunk(ArrayDataFormat fmt, uint8_t **psrc, size_t cnt, q15 *buf, q15 **pdata) {
+	if (fmt == ARRAY_DATA_16BITSIGNED) {
+		*pdata = (q15 *)*psrc;
+		*psrc += cnt * sizeof(q15);
+		return cnt;
+	}
+	if (cnt > DSP_CHUNK)
+		cnt = DSP_CHUNK;
+	gmiscArrayConvert(fmt, *psrc, ARRAY_DATA_16BITSIGNED, buf, cnt);
+	*psrc += fmt <= ARRAY_DATA_8BITSIGNED ? cnt : cnt * sizeof(uint16_t);
+	*pdata = buf;
+	return cnt;
+}
+
+void gmiscFFTLoad(ArrayDataFormat fmt, void *src, q15complex *data, unsigned log2n, FFTWindow window) {
+	q15			*tmp;
+	unsigned	i, n, step;
+	int32_t		w;
+
+	if (log2n > GMISC_DSP_FFT_MAX_LOG2)
+		return;
+	n = 1U << log2n;
+	step = 1024 >> log2n;
+
+	/* Convert into the top half of the buffer and then spread it out into complex values */
+	tmp = (q15 *)data + n;
+	gmiscArrayConvert(fmt, src, ARRAY_DATA_16BITSIGNED, tmp, n);
+	for(i = 0; i < n; i++) {
+		switch(window) {
+		case FFT_WINDOW_HANN:		w = 16384 - (dspcos(i*step) >> 1);									break;
+		case FFT_WINDOW_HAMMING:	w = 17695 - ((dspcos(i*step) * 15073) >> 15);						break;
+		case FFT_WINDOW_BLACKMAN:	w = 13763 - (dspcos(i*step) >> 1) + ((dspcos(2*i*step) * 2621) >> 15);	break;
+		default:					w = 32768;															break;
+		}
+		data[i].re = (q15)((tmp[i] * w) >> 15);
+		data[i].im = 0;
+	}
+}
+
+bool_t gmiscFFT(q15complex *data, unsigned log2n, bool_t inverse) {
+	q15complex	t;
+	unsigned	n, i, j, k, len, half, step;
+	int32_t		wr, wi, tr, ti;
+
+	if (!log2n || log2n > GMISC_DSP_FFT_MAX_LOG2)
+		return FALSE;
+	n = 1U << log2n;
+
+	/* Put the data into bit reversed order */
+	for(i = 1, j = 0; i < n; i++) {
+		for(k = n >> 1; j & k; k >>= 1)
+			j ^= k;
+		j ^= k;
+		if (i < j) {
+			t = data[i];
+			data[i] = data[j];
+			data[j] = t;
+		}
+	}
+
+	/* The butterflies - each pass is scaled by 1/2 so nothing can overflow */
+	for(len = 2; len <= n; len <<= 1) {
+		half = len >> 1;
+		step = 1024 / len;
+
+		/* The first butterfly of each group has a twiddle of 1 */
+		for(i = 0; i < n; i += len) {
+			j = i + half;
+			tr = data[j].re;
+			ti = data[j].im;
+			data[j].re = (q15)((data[i].re - tr) >> 1);
+			data[j].im = (q15)((data[i].im - ti) >> 1);
+			data[i].re = (q15)((data[i].re + tr) >> 1);
+			data[i].im = (q15)((data[i].im + ti) >> 1);
+		}
+
+		for(k = 1; k < half; k++) {
+			wr = dspcos(k*step);
+			wi = inverse ? dspsin(k*step) : -dspsin(k*step);
+			for(i = k; i < n; i += len) {
+				j = i + half;
+				tr = (wr * data[j].re - wi * data[j].im) >> 15;
+				ti = (wr * data[j].im + wi * data[j].re) >> 15;
+				data[j].re = (q15)((data[i].re - tr) >> 1);
+				data[j].im = (q15)((data[i].im - ti) >> 1);
+				data[i].re = (q15)((data[i].re + tr) >> 1);
+				data[i].im = (q15)((data[i].im + ti) >> 1);
+			}
+		}
+	}
+	return TRUE;
+}
+
+void gmiscFFTMagnitude(q15complex *data, q15 *mag, size_t cnt) {
+	uint32_t	v;
+
+	while(cnt--) {
+		v = dspsqrt((uint32_t)(data->re * data->re) + (uint32_t)(data->im * data->im));
+		*mag++ = v > 32767 ? 32767 : (q15)v;
+		data++;
+	}
+}
+
+bool_t gmiscCICInit(CICDecimator *pcic, unsigned stages, unsigned factor) {
+	uint32_t	gain;
+	unsigned	i;
+
+	if (!stages || stages > GMISC_DSP_CIC_MAX_STAGES || factor < 2)
+		return FALSE;
+
+	/* The filter gain is factor^stages and the result has to fit in 32 bits */
+	for(gain = 1, i = 0; i < stages; i++) {
+		gain *= factor;
+		if (gain > 65536)
+			return FALSE;
+	}
+
+	for(i = 0; i < GMISC_DSP_CIC_MAX_STAGES; i++)
+		pcic->integ[i] = pcic->comb[i] = 0;
+	pcic->stages = stages;
+	pcic->factor = factor;
+	pcic->phase = 0;
+	pcic->gain = gain;
+	for(pcic->shift = 0; (1UL << pcic->shift) < gain; pcic->shift++);
+	if ((1UL << pcic->shift) != gain)
+		pcic->shift = 0xFF;				// Not a power of 2 - we have to divide
+	return TRUE;
+}
+
+size_t gmiscCICDecimate(CICDecimator *pcic, ArrayDataFormat fmt, void *src, size_t cnt, q15 *dst) {
+	q15			buf[DSP_CHUNK], *data;
+	uint8_t		*p;
+	size_t		n, out;
+	unsigned	s;
+	uint32_t	v, t;
+
+	p = (uint8_t *)src;
+	out = 0;
+	while(cnt) {
+		n = dspchunk(fmt, &p, cnt, buf, &data);
+		cnt -= n;
+		for(; n; n--) {
+			// The integrators run at the input rate. Unsigned arithmetic lets them wrap harmlessly.
+			pcic->integ[0] += (uint32_t)(int32_t)*data++;
+			for(s = 1; s < pcic->stages; s++)
+				pcic->integ[s] += pcic->integ[s-1];
+
+			if (++pcic->phase < pcic->factor)
+				continue;
+			pcic->phase = 0;
+
+			// The combs run at the output rate
+			v = pcic->integ[pcic->stages-1];
+			for(s = 0; s < pcic->stages; s++) {
+				t = v;
+				v -= pcic->comb[s];
+				pcic->comb[s] = t;
+			}
+			*dst++ = pcic->shift == 0xFF ? dspsat((int32_t)v / (int32_t)pcic->gain) : dspsat((int32_t)v >> pcic->shift);
+			out++;
+		}
+	}
+	return out;
+}
+
+void gmiscFIRInit(FIRDecimator *pfir, const q15 *coeffs, q15 *history, unsigned ntaps, unsigned factor) {
+	unsigned	i;
+
+	pfir->coeffs = coeffs;
+	pfir->history = history;
+	pfir->ntaps = ntaps;
+	pfir->factor = factor ? factor : 1;
+	pfir->pos = 0;
+	pfir->phase = 0;
+	for(i = 0; i < ntaps; i++)
+		history[i] = 0;
+}
+
+size_t gmiscFIRDecimate(FIRDecimator *pfir, const q15 *src, size_t cnt, q15 *dst) {
+	const q15	*c;
+	int64_t		acc;
+	size_t		out;
+	unsigned	i, k;
+
+	out = 0;
+	while(cnt--) {
+		pfir->history[pfir->pos] = *src++;
+		if (++pfir->pos >= pfir->ntaps)
+			pfir->pos = 0;
+
+		// Only calculate the outputs we keep
+		if (++pfir->phase < pfir->factor)
+			continue;
+		pfir->phase = 0;
+
+		// The newest sample is just before pos - work backwards from there
+		acc = 1 << 14;
+		c = pfir->coeffs;
+		for(i = pfir->pos, k = pfir->ntaps; k; k--) {
+			if (!i)
+				i = pfir->ntaps;
+			acc += (int32_t)*c++ * pfir->history[--i];
+		}
+		*dst++ = dspsat((int32_t)(acc >> 15));
+		out++;
+	}
+	return out;
+}
+
+void gmiscLevels(ArrayDataFormat fmt, void *src, size_t cnt, q15 *prms, q15 *ppeak) {
+	q15			buf[DSP_CHUNK], *data;
+	uint8_t		*p;
+	uint64_t	sumsq;
+	size_t		n, total;
+	int32_t		v, peak;
+
+	p = (uint8_t *)src;
+	sumsq = 0;
+	peak = 0;
+	total = cnt;
+	while(cnt) {
+		n = dspchunk(fmt, &p, cnt, buf, &data);
+		cnt -= n;
+		for(; n; n--) {
+			v = *data++;
+			sumsq += (uint32_t)(v * v);
+			if (v < 0)
+				v = -v;
+			if (v > peak)
+				peak = v;
+		}
+	}
+
+	if (prms)
+		*prms = total ? (q15)dspsqrt((uint32_t)(sumsq / total)) : 0;
+	if (ppeak)
+		*ppeak = peak > 32767 ? 32767 : (q15)peak;
+}
+
+#endif /* GFX_USE_GMISC && GMISC_NEED_DSP */
+/** @} */
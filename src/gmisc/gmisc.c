@@ -0,0 +1,25 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    src/gmisc/gmisc.c
+ * @brief   GMISC sub-system code.
+ *
+ * @addtogroup GMISC
+ * @{
+ */
+#include "gfx.h"
+
+#if GFX_USE_GMISC
+
+/* The module initialiser */
+void _gmiscInit(void) {
+	/* Nothing to do here yet */
+}
+
+#endif /* GFX_USE_GMISC */
+/** @} */
@@ -1,2 +1,5 @@
-GFXSRC +=   $(GFXLIB)/src/gmisc/arrayops.c	\
-			$(GFXLIB)/src/gmisc/trig.c
+GFXSRC +=   $(GFXLIB)/src/gmisc/gmisc.c	\
+			$(GFXLIB)/src/gmisc/arrayops.c	\
+			$(GFXLIB)/src/gmisc/dsp.c	\
+			$(GFXLIB)/src/gmisc/trig.c	\
+			$(GFXLIB)/src/gmisc/trace.c
@@ -0,0 +1,145 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    src/gmisc/trace.c
+ * @brief   GMISC trace buffer.
+ *
+ * @details	A ring of fixed size records. Recording one only takes the system lock
+ * 			long enough to claim a slot so it can be left running in a real application.
+ * 			The text is only produced when the buffer is dumped.
+ *
+ * @addtogroup GMISC
+ * @{
+ */
+#include "gfx.h"
+
+#if (GFX_USE_GMISC && GMISC_NEED_TRACE) || defined(__DOXYGEN__)
+
+#define TRACE_COMPLETE		'X'
+#define TRACE_INSTANT		'i'
+#define TRACE_COUNTER		'C'
+
+typedef struct TraceRecord {
+	const char *	cat;
+	const char *	name;
+	perftime_t		ts;
+	uint32_t		arg;			// The duration (in perftime_t units) or the counter value
+	char			ph;				// The Chrome trace phase
+	} TraceRecord;
+
+static TraceRecord	Trace[GMISC_TRACE_SIZE];
+static unsigned		traceNext;		// The next record to write
+static unsigned		traceCount;		// How many records are in the buffer
+
+static void TraceAdd(const char *cat, const char *name, char ph, perftime_t ts, uint32_t arg) {
+	TraceRecord	*pr;
+
+	gfxSystemLock();
+	pr = Trace + traceNext;
+	if (++traceNext >= GMISC_TRACE_SIZE)
+		traceNext = 0;
+	if (traceCount < GMISC_TRACE_SIZE)
+		traceCount++;
+	pr->cat = cat;
+	pr->name = name;
+	pr->ph = ph;
+	pr->ts = ts;
+	pr->arg = arg;
+	gfxSystemUnlock();
+}
+
+void gmiscTraceComplete(const char *cat, const char *name, perftime_t start) {
+	TraceAdd(cat, name, TRACE_COMPLETE, start, (perftime_t)(gmiscPerfClock() - start));
+}
+
+void gmiscTraceInstant(const char *cat, const char *name) {
+	TraceAdd(cat, name, TRACE_INSTANT, gmiscPerfClock(), 0);
+}
+
+void gmiscTraceCounter(const char *cat, const char *name, uint32_t value) {
+	TraceAdd(cat, name, TRACE_COUNTER, gmiscPerfClock(), value);
+}
+
+/* Append a string and return the new end */
+static char *TraceStr(char *p, const char *s) {
+	while(*s)
+		*p++ = *s++;
+	return p;
+}
+
+/* Append an unsigned decimal number and return the new end */
+static char *TraceNum(char *p, uint32_t v) {
+	char	tmp[10];
+	int		i;
+
+	i = 0;
+	do {
+		tmp[i++] = '0' + v % 10;
+		v /= 10;
+	} while(v);
+	while(i)
+		*p++ = tmp[--i];
+	return p;
+}
+
+void gmiscTraceDump(TraceWriteFn fn, void *param) {
+	TraceRecord	r;
+	perftime_t	base;
+	bool_t		first;
+	char		line[80];
+	char		*p;
+
+	base = 0;
+	fn(param, "{\"traceEvents\":[\n");
+	for(first = TRUE; ; first = FALSE) {
+		// Take the oldest record
+		gfxSystemLock();
+		if (!traceCount) {
+			gfxSystemUnlock();
+			break;
+		}
+		r = Trace[(traceNext + GMISC_TRACE_SIZE - traceCount) % GMISC_TRACE_SIZE];
+		traceCount--;
+		gfxSystemUnlock();
+
+		// Times are relative to the first record so that a fast clock wrapping doesn't matter
+		if (first)
+			base = r.ts;
+
+		// The names are written straight from the record as they may be of any length
+		fn(param, first ? "{\"cat\":\"" : ",\n{\"cat\":\"");
+		fn(param, r.cat);
+		fn(param, "\",\"name\":\"");
+		fn(param, r.name);
+		p = TraceStr(line, "\",\"ph\":\"");
+		*p++ = r.ph;
+		p = TraceStr(p, "\",\"pid\":1,\"tid\":1,\"ts\":");
+		p = TraceNum(p, gmiscPerfToMicroseconds((perftime_t)(r.ts - base)));
+		switch(r.ph) {
+		case TRACE_COMPLETE:
+			p = TraceStr(p, ",\"dur\":");
+			p = TraceNum(p, gmiscPerfToMicroseconds(r.arg));
+			break;
+		case TRACE_INSTANT:
+			p = TraceStr(p, ",\"s\":\"g\"");
+			break;
+		case TRACE_COUNTER:
+			p = TraceStr(p, ",\"args\":{\"value\":");
+			p = TraceNum(p, r.arg);
+			*p++ = '}';
+			break;
+		}
+		*p++ = '}';
+		*p = 0;
+		fn(param, line);
+	}
+	fn(param, "\n]}\n");
+}
+
+#endif /* GFX_USE_GMISC && GMISC_NEED_TRACE */
+/** @} */
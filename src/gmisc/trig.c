@@ -155,5 +155,172 @@
 
 #endif
 
+#if GMISC_NEED_FIXEDMATH
+	/* sin() for the first quadrant in 256 steps as a fixed. sin(90) is 1.0 which is handled separately. */
+	static const uint16_t sinquadrant[256] = {
+		0, 402, 804, 1206, 1608, 2010, 2412, 2814,
+		3216, 3617, 4019, 4420, 4821, 5222, 5623, 6023,
+		6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+		9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391,
+		12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534,
+		15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+		19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699,
+		22078, 22457, 22834, 23210, 23586, 23961, 24335, 24708,
+		25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+		28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+		30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347,
+		33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+		36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716,
+		39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264,
+		41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+		44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056,
+		46341, 46624, 46906, 47186, 47464, 47741, 48015, 48288,
+		48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+		50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398,
+		52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+		54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+		56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607,
+		57798, 57986, 58172, 58356, 58538, 58718, 58896, 59071,
+		59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+		60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568,
+		61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596,
+		62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+		63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197,
+		64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766,
+		64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+		65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436,
+		65457, 65476, 65492, 65505, 65516, 65525, 65531, 65535
+		};
+
+	/* atan(2^-i) for the CORDIC in units of 1/2^32 of a turn */
+	static const uint32_t cordicangles[16] = {
+		536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838, 5340245,
+		2670163, 1335087, 667544, 333772, 166886, 83443, 41722, 20861
+		};
+
+	/* sin() for an angle in the first quadrant 0 .. 16384 */
+	static fixed quadsin(unsigned a) {
+		unsigned	i, f;
+		fixed		v0, v1;
+
+		if (a >= 16384)
+			return FIXED(1);
+		i = a >> 6;
+		f = a & 63;
+		v0 = sinquadrant[i];
+		v1 = i == 255 ? FIXED(1) : sinquadrant[i+1];
+		return v0 + (((v1 - v0) * (fixed)f + 32) >> 6);
+	}
+
+	fixed gmiscFixedSin(binangle angle) {
+		switch(angle >> 14) {
+		case 0:		return quadsin(angle & 0x3FFF);
+		case 1:		return quadsin(0x4000 - (angle & 0x3FFF));
+		case 2:		return -quadsin(angle & 0x3FFF);
+		default:	return -quadsin(0x4000 - (angle & 0x3FFF));
+		}
+	}
+
+	fixed gmiscFixedCos(binangle angle) {
+		return gmiscFixedSin((binangle)(angle + 0x4000));
+	}
+
+	binangle gmiscFixedAtan2(fixed y, fixed x) {
+		int32_t		tx, ty;
+		uint32_t	ax, ay, ang;
+		unsigned	i, sh;
+
+		if (!x && !y)
+			return 0;
+
+		// Work with the vector in the right half plane and remember if we turned it around
+		ax = x < 0 ? -(uint32_t)x : (uint32_t)x;
+		ay = y < 0 ? -(uint32_t)y : (uint32_t)y;
+
+		// Scale so that the CORDIC gain (1.647) can't overflow but we keep as many bits as possible
+		for(sh = 0; ((ax | ay) >> sh) >= 0x20000000; sh++);
+		ax >>= sh; ay >>= sh;
+		while(!((ax | ay) & 0x10000000)) {
+			ax <<= 1; ay <<= 1;
+		}
+		tx = (int32_t)ax;
+		ty = y < 0 ? -(int32_t)ay : (int32_t)ay;
+		if (x < 0) {
+			ang = 0x80000000;
+			ty = -ty;
+		} else
+			ang = 0;
+
+		// Rotate the vector onto the x axis adding up the angles we rotate through
+		for(i = 0; i < 16; i++) {
+			int32_t	ox = tx;
+			if (ty > 0) {
+				tx += ty >> i;
+				ty -= ox >> i;
+				ang += cordicangles[i];
+			} else {
+				tx -= ty >> i;
+				ty += ox >> i;
+				ang -= cordicangles[i];
+			}
+		}
+		return (binangle)((ang + 0x8000) >> 16);
+	}
+
+	uint16_t gmiscISqrt(uint32_t n) {
+		uint32_t	res, bit;
+
+		res = 0;
+		for(bit = 1UL << 30; bit > n; bit >>= 2);
+		for(; bit; bit >>= 2) {
+			if (n >= res + bit) {
+				n -= res + bit;
+				res = (res >> 1) + bit;
+			} else
+				res >>= 1;
+		}
+		return (uint16_t)res;
+	}
+
+	fixed gmiscFixedSqrt(fixed x) {
+		uint64_t	n, res, bit;
+
+		if (x <= 0)
+			return 0;
+
+		// sqrt(x * 65536) gives the square root with 16 bits of fraction
+		n = (uint64_t)x << 16;
+		res = 0;
+		for(bit = (uint64_t)1 << 46; bit > n; bit >>= 2);
+		for(; bit; bit >>= 2) {
+			if (n >= res + bit) {
+				n -= res + bit;
+				res = (res >> 1) + bit;
+			} else
+				res >>= 1;
+		}
+		// Round to nearest
+		if (n > res)
+			res++;
+		return (fixed)res;
+	}
+
+	fixed gmiscFixedDiv(fixed a, fixed b) {
+		int64_t		n, half;
+
+		if (!b)
+			return a < 0 ? (fixed)0x80000000 : (fixed)0x7FFFFFFF;
+		n = (int64_t)a << 16;
+		half = b < 0 ? -(int64_t)b/2 : (int64_t)b/2;
+		n = (n < 0 ? n - half : n + half) / b;
+		if (n > 0x7FFFFFFF)
+			return (fixed)0x7FFFFFFF;
+		if (n < -(int64_t)0x80000000)
+			return (fixed)0x80000000;
+		return (fixed)n;
+	}
+
+#endif
+
 #endif /* GFX_USE_GMISC */
 /** @} */
@@ -1,3 +1,4 @@
 GFXSRC +=   $(GFXLIB)/src/gos/chibios.c	\
 			$(GFXLIB)/src/gos/win32.c \
-			$(GFXLIB)/src/gos/posix.c
+			$(GFXLIB)/src/gos/posix.c \
+			$(GFXLIB)/src/gos/pool.c
@@ -0,0 +1,124 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    src/gos/pool.c
+ * @brief   GOS fixed size memory pools.
+ *
+ * @details	Each pool is a single allocation made when it is set up, carved into
+ * 			blocks of one size. Blocks are kept on a free list so allocating and
+ * 			freeing them never touches (or fragments) the heap.
+ */
+#include "gfx.h"
+
+#if GOS_NEED_POOLS
+
+/* Blocks are kept aligned for anything that might be put in them */
+#define POOL_ALIGN			8
+#define POOL_ROUNDUP(sz)	(((sz) + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1))
+
+static const size_t		ClassSizes[] = { GOS_POOL_SIZES };
+
+#define POOL_CLASSES		(sizeof(ClassSizes)/sizeof(ClassSizes[0]))
+
+/* Any missing counts are zero (an empty pool) */
+static const uint16_t	ClassCounts[POOL_CLASSES] = { GOS_POOL_COUNTS };
+static gfxPool			Classes[POOL_CLASSES];
+
+void gfxPoolInit(gfxPool *pool, void *mem, size_t blocksize, size_t count) {
+	uint8_t		*p;
+
+	blocksize = POOL_ROUNDUP(blocksize < sizeof(void *) ? sizeof(void *) : blocksize);
+	pool->blocksize = blocksize;
+	pool->count = mem ? (uint16_t)count : 0;
+	pool->used = pool->maxused = 0;
+	pool->failed = 0;
+	pool->mem = (uint8_t *)mem;
+	pool->memend = (uint8_t *)mem + pool->count * blocksize;
+
+	/* Link all the blocks together - the first block first */
+	pool->freelist = 0;
+	for(p = pool->memend; p > pool->mem; ) {
+		p -= blocksize;
+		*(void **)p = pool->freelist;
+		pool->freelist = p;
+	}
+}
+
+void *gfxPoolAlloc(gfxPool *pool) {
+	void	*p;
+
+	gfxSystemLock();
+	if ((p = pool->freelist)) {
+		pool->freelist = *(void **)p;
+		if (++pool->used > pool->maxused)
+			pool->maxused = pool->used;
+	} else
+		pool->failed++;
+	gfxSystemUnlock();
+	return p;
+}
+
+void gfxPoolFree(gfxPool *pool, void *ptr) {
+	gfxSystemLock();
+	*(void **)ptr = pool->freelist;
+	pool->freelist = ptr;
+	pool->used--;
+	gfxSystemUnlock();
+}
+
+/* Set up the size class pools. Called by gfxInit(). */
+void _gosPoolInit(void) {
+	uint8_t		*mem;
+	size_t		total;
+	unsigned	i;
+
+	/* One allocation for all of them - made before anything else can fragment the heap */
+	for(total = 0, i = 0; i < POOL_CLASSES; i++)
+		total += POOL_ROUNDUP(ClassSizes[i]) * ClassCounts[i];
+	mem = (uint8_t *)gfxAlloc(total);
+
+	for(i = 0; i < POOL_CLASSES; i++) {
+		gfxPoolInit(&Classes[i], mem, ClassSizes[i], ClassCounts[i]);
+		if (mem)
+			mem = Classes[i].memend;
+	}
+}
+
+void *gfxAllocPooled(size_t sz) {
+	gfxPool		*pool;
+	void		*p;
+
+	for(pool = Classes; pool < Classes+POOL_CLASSES; pool++) {
+		if (sz <= pool->blocksize && (p = gfxPoolAlloc(pool)))
+			return p;
+	}
+	return gfxAlloc(sz);
+}
+
+void gfxFreePooled(void *ptr) {
+	gfxPool		*pool;
+
+	if (!ptr)
+		return;
+
+	/* Which pool (if any) is it from? */
+	for(pool = Classes; pool < Classes+POOL_CLASSES; pool++) {
+		if ((uint8_t *)ptr >= pool->mem && (uint8_t *)ptr < pool->memend) {
+			gfxPoolFree(pool, ptr);
+			return;
+		}
+	}
+	gfxFree(ptr);
+}
+
+const gfxPool *gfxPoolGetClass(unsigned n) {
+	return n < POOL_CLASSES ? &Classes[n] : 0;
+}
+
+#endif /* GOS_NEED_POOLS */
+/** @} */
@@ -30,6 +30,9 @@ static gfxThreadHandle	hThread = 0;
 static GTimer			*pTimerHead = 0;
 static gfxSem			waitsem;
 static DECLARE_THREAD_STACK(waTimerThread, GTIMER_THREAD_WORKAREA_SIZE);
+#if GTIMER_NEED_STATS
+	static GTimerStats		gtimerStats;
+#endif
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
@@ -43,6 +46,10 @@ static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
 	systemticks_t	lastTime;
 	GTimerFunction	fn;
 	void			*param;
+	#if GTIMER_NEED_STATS
+		systemticks_t	late;
+		perftime_t		start, t;
+	#endif
 
 	nxtTimeout = TIME_INFINITE;
 	lastTime = 0;
@@ -66,6 +73,19 @@ static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
 				// Do we have something to do for this timer?
 				if ((pt->flags & GTIMER_FLG_JABBED) || (!(pt->flags & GTIMER_FLG_INFINITE) && TimeIsWithin(pt->when, lastTime, tm))) {
 				
+					#if GTIMER_NEED_STATS
+						// How late are we?
+						gtimerStats.fired++;
+						if ((pt->flags & GTIMER_FLG_JABBED))
+							gtimerStats.jabbed++;
+						else {
+							late = tm - pt->when;
+							gtimerStats.latetotal += late;
+							if (late > gtimerStats.latemax)
+								gtimerStats.latemax = late;
+						}
+					#endif
+
 					// Is this timer periodic?
 					if ((pt->flags & GTIMER_FLG_PERIODIC) && pt->period != TIME_IMMEDIATE) {
 						// Yes - Update ready for the next period
@@ -97,7 +117,19 @@ static DECLARE_THREAD_FUNCTION(GTimerThreadHandler, arg) {
 					fn = pt->fn;
 					param = pt->param;
 					gfxMutexExit(&mutex);
-					fn(param);
+					#if GTIMER_NEED_STATS
+						start = gmiscPerfClock();
+						fn(param);
+						t = gmiscPerfClock() - start;
+						gtimerStats.callbacktotal += t;
+						if (t > gtimerStats.callbackmax)
+							gtimerStats.callbackmax = t;
+						#if GMISC_NEED_TRACE
+							gmiscTraceComplete("gtimer", "callback", start);
+						#endif
+					#else
+						fn(param);
+					#endif
 					
 					// We no longer hold the mutex, the callback function may have taken a while
 					// and our list may have been altered so start again!
@@ -219,6 +251,18 @@ void gtimerJabI(GTimer *pt) {
 	gfxSemSignalI(&waitsem);
 }
 
+#if GTIMER_NEED_STATS
+	void gtimerGetStats(GTimerStats *pstats) {
+		*pstats = gtimerStats;
+	}
+
+	void gtimerResetStats(void) {
+		static const GTimerStats	zero;
+
+		gtimerStats = zero;
+	}
+#endif
+
 #endif /* GFX_USE_GTIMER */
 /** @} */
 
@@ -135,7 +135,7 @@ static void gwinButtonCallback(void *param, GEvent *pe) {
 }
 
 GHandle gwinCreateButton(GButtonObject *gb, coord_t x, coord_t y, coord_t width, coord_t height, font_t font, GButtonType type) {
-	if (!(gb = (GButtonObject *)_gwinInit((GWindowObject *)gb, x, y, width, height, sizeof(GButtonObject))))
+	if (!(gb = (GButtonObject *)_gwindowInit((GWindowObject *)gb, x, y, width, height, sizeof(GButtonObject))))
 		return 0;
 
 	gb->gwin.type = GW_BUTTON;
@@ -202,7 +202,7 @@ void gwinSetButtonText(GHandle gh, const char *txt, bool_t useAlloc) {
 	if ((gh->flags & GBTN_FLG_ALLOCTXT)) {
 		gh->flags &= ~GBTN_FLG_ALLOCTXT;
 		if (gbw->txt) {
-			gfxFree((void *)gbw->txt);
+			_gwinFree((void *)gbw->txt);
 			gbw->txt = "";
 		}
 	}
@@ -210,7 +210,7 @@ void gwinSetButtonText(GHandle gh, const char *txt, bool_t useAlloc) {
 	if (txt && useAlloc) {
 		char *str;
 		
-		if ((str = (char *)gfxAlloc(strlen(txt)+1))) {
+		if ((str = (char *)_gwinAlloc(strlen(txt)+1))) {
 			gh->flags |= GBTN_FLG_ALLOCTXT;
 			strcpy(str, txt);
 		}
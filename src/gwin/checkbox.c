@@ -19,6 +19,8 @@
 
 #if (GFX_USE_GWIN && GWIN_NEED_CHECKBOX) || defined(__DOXYGEN__)
 
+#include "gwin/internal.h"
+
 static const GCheckboxColor defaultColors = {
 	Grey,	// border
 	Grey,	// selected
@@ -103,7 +105,7 @@ static void gwinCheckboxCallback(void *param, GEvent *pe) {
 }
 
 GHandle gwinCheckboxCreate(GCheckboxObject *gb, coord_t x, coord_t y, coord_t width, coord_t height) {
-	if (!(gb = (GCheckboxObject *)_gwinInit((GWindowObject *)gb, x, y, width, height, sizeof(GCheckboxObject))))
+	if (!(gb = (GCheckboxObject *)_gwindowInit((GWindowObject *)gb, x, y, width, height, sizeof(GCheckboxObject))))
 		return 0;
 
 	gb->gwin.type = GW_CHECKBOX;			// create a window of the type checkbox
@@ -64,11 +64,6 @@ static void pointto(GGraphObject *gg, coord_t x, coord_t y, const GGraphPointSty
 }
 
 static void lineto(GGraphObject *gg, coord_t x0, coord_t y0, coord_t x1, coord_t y1, const GGraphLineStyle *style) {
-	coord_t	dy, dx;
-	coord_t addx, addy;
-	coord_t P, diff, i;
-	coord_t	run_on, run_off, run;
-
 	if (style->type == GGRAPH_LINE_NONE)
 		return;
 
@@ -86,84 +81,23 @@ static void lineto(GGraphObject *gg, coord_t x0, coord_t y0, coord_t x1, coord_t
 
 	switch (style->type) {
 	case GGRAPH_LINE_DOT:
-		run_on = 1;
-		run_off = -style->size;
+		gdispDrawStyledLine(x0, y0, x1, y1, 1, 1, style->size, style->color);
 		break;
 
 	case GGRAPH_LINE_DASH:
-		run_on = style->size;
-		run_off = -style->size;
+		gdispDrawStyledLine(x0, y0, x1, y1, 1, style->size, style->size, style->color);
 		break;
 
 	case GGRAPH_LINE_SOLID:
 	default:
 		// Use the driver to draw a solid line
 		gdispDrawLine(x0, y0, x1, y1, style->color);
-		return;
-	}
-
-	// Use Bresenham's algorithm modified to draw a stylized line
-	run = 0;
-	if (x1 >= x0) {
-		dx = x1 - x0;
-		addx = 1;
-	} else {
-		dx = x0 - x1;
-		addx = -1;
-	}
-	if (y1 >= y0) {
-		dy = y1 - y0;
-		addy = 1;
-	} else {
-		dy = y0 - y1;
-		addy = -1;
-	}
-
-	if (dx >= dy) {
-		dy *= 2;
-		P = dy - dx;
-		diff = P - dx;
-
-		for(i=0; i<=dx; ++i) {
-			if (run++ >= 0) {
-				if (run >= run_on)
-					run = run_off;
-				gdispDrawPixel(x0, y0, style->color);
-			}
-			if (P < 0) {
-				P  += dy;
-				x0 += addx;
-			} else {
-				P  += diff;
-				x0 += addx;
-				y0 += addy;
-			}
-		}
-	} else {
-		dx *= 2;
-		P = dx - dy;
-		diff = P - dy;
-
-		for(i=0; i<=dy; ++i) {
-			if (run++ >= 0) {
-				if (run >= run_on)
-					run = run_off;
-				gdispDrawPixel(x0, y0, style->color);
-			}
-			if (P < 0) {
-				P  += dx;
-				y0 += addy;
-			} else {
-				P  += diff;
-				x0 += addx;
-				y0 += addy;
-			}
-		}
+		break;
 	}
 }
 
 GHandle gwinCreateGraph(GGraphObject *gg, coord_t x, coord_t y, coord_t width, coord_t height) {
-	if (!(gg = (GGraphObject *)_gwinInit((GWindowObject *)gg, x, y, width, height, sizeof(GGraphObject))))
+	if (!(gg = (GGraphObject *)_gwindowInit((GWindowObject *)gg, x, y, width, height, sizeof(GGraphObject))))
 		return 0;
 	gg->gwin.type = GW_GRAPH;
 	gg->xorigin = gg->yorigin = 0;
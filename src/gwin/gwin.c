@@ -11,9 +11,13 @@
 
 #include "gwin/internal.h"
 
+void _gwinInit(void) {
+	/* Nothing to do here yet */
+}
+
 // Internal routine for use by GWIN components only
 // Initialise a window creating it dynamicly if required.
-GHandle _gwinInit(GWindowObject *gw, coord_t x, coord_t y, coord_t width, coord_t height, size_t size) {
+GHandle _gwindowInit(GWindowObject *gw, coord_t x, coord_t y, coord_t width, coord_t height, size_t size) {
 	coord_t	w, h;
 
 	// Check the window size against the screen size
@@ -27,7 +31,7 @@ GHandle _gwinInit(GWindowObject *gw, coord_t x, coord_t y, coord_t width, coord_
 	
 	// Allocate the structure if necessary
 	if (!gw) {
-		if (!(gw = (GWindowObject *)gfxAlloc(size)))
+		if (!(gw = (GWindowObject *)_gwinAlloc(size)))
 			return 0;
 		gw->flags = GWIN_FLG_DYNAMIC;
 	} else
@@ -47,7 +51,7 @@ GHandle _gwinInit(GWindowObject *gw, coord_t x, coord_t y, coord_t width, coord_
 }
 
 GHandle gwinCreateWindow(GWindowObject *gw, coord_t x, coord_t y, coord_t width, coord_t height) {
-	if (!(gw = (GWindowObject *)_gwinInit((GWindowObject *)gw, x, y, width, height, sizeof(GWindowObject))))
+	if (!(gw = (GWindowObject *)_gwindowInit((GWindowObject *)gw, x, y, width, height, sizeof(GWindowObject))))
 		return 0;
 	gw->type = GW_WINDOW;
 	return (GHandle)gw;
@@ -65,7 +69,7 @@ void gwinDestroyWindow(GHandle gh) {
 	case GW_BUTTON:
 		if ((gh->flags & GBTN_FLG_ALLOCTXT)) {
 			gh->flags &= ~GBTN_FLG_ALLOCTXT;		// To be sure, to be sure
-			gfxFree((void *)((GButtonObject *)gh)->txt);
+			_gwinFree((void *)((GButtonObject *)gh)->txt);
 		}
 		geventDetachSource(&((GButtonObject *)gh)->listener, 0);
 		geventDetachSourceListeners((GSourceHandle)gh);
@@ -84,7 +88,7 @@ void gwinDestroyWindow(GHandle gh) {
 	// Clean up the structure
 	if (gh->flags & GWIN_FLG_DYNAMIC) {
 		gh->flags = 0;							// To be sure, to be sure
-		gfxFree((void *)gh);
+		_gwinFree((void *)gh);
 	}
 }
 
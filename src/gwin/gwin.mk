@@ -4,4 +4,5 @@ GFXSRC +=   $(GFXLIB)/src/gwin/gwin.c \
 			$(GFXLIB)/src/gwin/slider.c \
 			$(GFXLIB)/src/gwin/graph.c \
 			$(GFXLIB)/src/gwin/checkbox.c \
+			$(GFXLIB)/src/gwin/spectrum.c \
 			
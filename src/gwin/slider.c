@@ -134,7 +134,7 @@ static void gwinSliderCallback(void *param, GEvent *pe) {
 }
 
 GHandle gwinCreateSlider(GSliderObject *gs, coord_t x, coord_t y, coord_t width, coord_t height) {
-	if (!(gs = (GSliderObject *)_gwinInit((GWindowObject *)gs, x, y, width, height, sizeof(GSliderObject))))
+	if (!(gs = (GSliderObject *)_gwindowInit((GWindowObject *)gs, x, y, width, height, sizeof(GSliderObject))))
 		return 0;
 	gs->gwin.type = GW_SLIDER;
 	gs->fn = gwinSliderDraw_Std;
@@ -0,0 +1,124 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * @file    src/gwin/spectrum.c
+ * @brief   GWIN sub-system spectrum code.
+ *
+ * @defgroup Spectrum Spectrum
+ * @ingroup GWIN
+ *
+ * @{
+ */
+
+#include "gfx.h"
+
+#if (GFX_USE_GWIN && GWIN_NEED_SPECTRUM) || defined(__DOXYGEN__)
+
+#include "gwin/internal.h"
+
+#define gs	((GSpectrumObject *)gh)
+
+/*
+ * Convert a magnitude to a bar height. The log scale uses log2() with 3 bits of
+ * fraction - each bit is 6.02dB which we approximate as 6dB.
+ */
+static coord_t barheight(GHandle gh, q15 m) {
+	unsigned	b;
+	int32_t		db8;
+
+	if (m <= 0)
+		return 0;
+	if (!gs->range)
+		return (coord_t)(((int32_t)m * gh->height) >> 15);
+
+	for(b = 14; !(m & (1 << b)); b--);
+	db8 = (int32_t)b * 8 + (b >= 3 ? ((m >> (b - 3)) & 7) : ((m << (3 - b)) & 7));		// 8 * log2(m)
+	db8 = (db8 - 15 * 8) * 6;															// 8 * dB below full scale
+	db8 += gs->range * 8;
+	if (db8 <= 0)
+		return 0;
+	return (coord_t)(db8 * gh->height / (gs->range * 8));
+}
+
+GHandle gwinCreateSpectrum(GSpectrumObject *gso, coord_t x, coord_t y, coord_t width, coord_t height) {
+	GHandle		gh;
+	unsigned	i;
+
+	if (!(gh = _gwindowInit((GWindowObject *)gso, x, y, width, height, sizeof(GSpectrumObject))))
+		return 0;
+	gh->type = GW_SPECTRUM;
+	gs->range = 60;
+	gs->decay = 2;
+	gs->peakcolor = White;
+	for(i = 0; i < GWIN_SPECTRUM_MAX_BARS; i++)
+		gs->peaks[i] = 0;
+	return gh;
+}
+
+void gwinSpectrumSetStyle(GHandle gh, uint8_t range, color_t peakcolor, uint8_t decay) {
+	if (gh->type != GW_SPECTRUM)
+		return;
+	gs->range = range;
+	gs->peakcolor = peakcolor;
+	gs->decay = decay;
+}
+
+void gwinSpectrumDraw(GHandle gh, const q15 *mag, size_t bins) {
+	unsigned	bars, bar, b0, b1;
+	coord_t		x0, x1, h, y;
+	q15			m;
+
+	if (gh->type != GW_SPECTRUM || !bins)
+		return;
+
+	#if GDISP_NEED_CLIP
+		gdispSetClip(gh->x, gh->y, gh->width, gh->height);
+	#endif
+
+	bars = bins < (size_t)gh->width ? (unsigned)bins : (unsigned)gh->width;
+	if (bars > GWIN_SPECTRUM_MAX_BARS)
+		bars = GWIN_SPECTRUM_MAX_BARS;
+
+	for(bar = 0; bar < bars; bar++) {
+		// The bins and the pixels for this bar
+		b0 = (unsigned)((size_t)bar * bins / bars);
+		b1 = (unsigned)((size_t)(bar+1) * bins / bars);
+		x0 = gh->x + (coord_t)(bar * gh->width / bars);
+		x1 = gh->x + (coord_t)((bar+1) * gh->width / bars);
+
+		for(m = 0; b0 < b1; b0++) {
+			if (mag[b0] > m)
+				m = mag[b0];
+		}
+		h = barheight(gh, m);
+		if (h > gh->height)
+			h = gh->height;
+
+		// Draw the bar and then the background above it
+		y = gh->y + gh->height - h;
+		if (h)
+			gdispFillArea(x0, y, x1 - x0, h, gh->color);
+		if (h < gh->height)
+			gdispFillArea(x0, gh->y, x1 - x0, gh->height - h, gh->bgcolor);
+
+		// The peak marker falls slowly
+		if (gs->decay) {
+			if (gs->peaks[bar] > gs->decay)
+				gs->peaks[bar] -= gs->decay;
+			else
+				gs->peaks[bar] = 0;
+			if (h >= gs->peaks[bar])
+				gs->peaks[bar] = h;
+			else
+				gdispFillArea(x0, gh->y + gh->height - gs->peaks[bar], x1 - x0, 1, gs->peakcolor);
+		}
+	}
+}
+
+#endif /* GFX_USE_GWIN && GWIN_NEED_SPECTRUM */
+/** @} */
@@ -18,6 +18,10 @@
 
 #include "tdisp/lld/tdisp_lld.h"
 
+#if TDISP_NEED_BUFFER
+	#include <string.h>
+#endif
+
 /* cursor controllers */
 #define TDISP_CURSOR		1
 #define TDISP_CURSOR_ON		0
@@ -38,6 +42,91 @@
 
 #endif
 
+#if TDISP_NEED_BUFFER
+	/* The RAM copy of the display.
+	 *	want[] is what the application has drawn, shown[] is what we know is on the display.
+	 *	The display cursor (hwcol, hwrow) is tracked so we only move it when we have to.
+	 */
+	static struct tdispBuffer_t {
+		char		want[TDISP_ROWS][TDISP_COLUMNS];
+		char		shown[TDISP_ROWS][TDISP_COLUMNS];
+		coord_t		col, row;
+		coord_t		hwcol, hwrow;				// hwrow < 0 means we don't know where the display cursor is
+		uint8_t		flags;
+			#define BUF_DIRTY			0x01	// Something has changed since the last flush
+			#define BUF_DECREASE		0x02	// The cursor moves left after drawing a character
+			#define BUF_CURSOR_SHOWN	0x04	// The cursor is visible so it needs to be in the right place
+	} tdispBuf;
+
+	#if TDISP_BUFFER_FLUSH_PERIOD
+		static GTIMER_DECL(tdispFlushTimer);
+	#endif
+
+	static void buf_draw_char(char c) {
+		if (tdispBuf.row >= 0 && tdispBuf.row < TDISP_ROWS && tdispBuf.col >= 0 && tdispBuf.col < TDISP_COLUMNS)
+			tdispBuf.want[tdispBuf.row][tdispBuf.col] = c;
+		if ((tdispBuf.flags & BUF_DECREASE))
+			tdispBuf.col--;
+		else
+			tdispBuf.col++;
+		tdispBuf.flags |= BUF_DIRTY;
+	}
+
+	/* Send the differences to the display. Must be called with the mutex held. */
+	static void buf_flush(void) {
+		coord_t	r, c;
+
+		if (!(tdispBuf.flags & BUF_DIRTY))
+			return;
+
+		for(r = 0; r < TDISP_ROWS; r++) {
+			for(c = 0; c < TDISP_COLUMNS; c++) {
+				if (tdispBuf.want[r][c] == tdispBuf.shown[r][c])
+					continue;
+
+				/* Runs of changed characters don't need the cursor moved between them */
+				if (tdispBuf.hwrow != r || tdispBuf.hwcol != c) {
+					tdisp_lld_set_cursor(c, r);
+					tdispBuf.hwrow = r;
+				}
+				tdisp_lld_draw_char(tdispBuf.want[r][c]);
+				tdispBuf.shown[r][c] = tdispBuf.want[r][c];
+				tdispBuf.hwcol = c+1;
+			}
+
+			/* Where the display address goes after the end of a row is controller specific */
+			if (tdispBuf.hwcol >= TDISP_COLUMNS)
+				tdispBuf.hwrow = -1;
+		}
+
+		/* Leave the display cursor where the application expects it */
+		if ((tdispBuf.flags & BUF_CURSOR_SHOWN) && (tdispBuf.hwrow != tdispBuf.row || tdispBuf.hwcol != tdispBuf.col)
+				&& tdispBuf.col >= 0 && tdispBuf.col < TDISP_COLUMNS) {
+			tdisp_lld_set_cursor(tdispBuf.col, tdispBuf.row);
+			tdispBuf.hwrow = tdispBuf.row;
+			tdispBuf.hwcol = tdispBuf.col;
+		}
+
+		tdispBuf.flags &= ~BUF_DIRTY;
+	}
+
+	#if TDISP_BUFFER_FLUSH_PERIOD
+		static void buf_flush_timer(void *param) {
+			(void) param;
+
+			MUTEX_ENTER();
+			buf_flush();
+			MUTEX_LEAVE();
+		}
+	#endif
+
+	void tdispFlush(void) {
+		MUTEX_ENTER();
+		buf_flush();
+		MUTEX_LEAVE();
+	}
+#endif
+
 bool_t tdispInit(void) {
 	bool_t		res;
 
@@ -45,20 +134,44 @@ bool_t tdispInit(void) {
 
 	MUTEX_ENTER();
 	res = tdisp_lld_init();
+	#if TDISP_NEED_BUFFER
+		/* Start from a known blank display */
+		tdisp_lld_clear();
+		memset(tdispBuf.want, ' ', sizeof(tdispBuf.want));
+		memset(tdispBuf.shown, ' ', sizeof(tdispBuf.shown));
+		tdispBuf.col = tdispBuf.row = 0;
+		tdispBuf.hwcol = tdispBuf.hwrow = 0;
+		tdispBuf.flags = 0;
+	#endif
 	MUTEX_LEAVE();
 
+	#if TDISP_NEED_BUFFER && TDISP_BUFFER_FLUSH_PERIOD
+		gtimerStart(&tdispFlushTimer, buf_flush_timer, 0, TRUE, TDISP_BUFFER_FLUSH_PERIOD);
+	#endif
+
 	return res;
 }
 
 void tdispClear(void) {
 	MUTEX_ENTER();
-	tdisp_lld_clear();
+	#if TDISP_NEED_BUFFER
+		memset(tdispBuf.want, ' ', sizeof(tdispBuf.want));
+		tdispBuf.col = tdispBuf.row = 0;
+		tdispBuf.flags |= BUF_DIRTY;
+	#else
+		tdisp_lld_clear();
+	#endif
 	MUTEX_LEAVE();
 }
 
 void tdispHome(void) {
 	MUTEX_ENTER();
-	tdisp_lld_set_cursor(0, 0);
+	#if TDISP_NEED_BUFFER
+		tdispBuf.col = tdispBuf.row = 0;
+		tdispBuf.flags |= BUF_DIRTY;
+	#else
+		tdisp_lld_set_cursor(0, 0);
+	#endif
 	MUTEX_LEAVE();
 }
 
@@ -67,7 +180,13 @@ void tdispSetCursor(coord_t col, coord_t row) {
 	if (row >= TDISP.rows)
 		row = TDISP.rows - 1;
 	MUTEX_ENTER();
-	tdisp_lld_set_cursor(col, row);
+	#if TDISP_NEED_BUFFER
+		tdispBuf.col = col;
+		tdispBuf.row = row;
+		tdispBuf.flags |= BUF_DIRTY;
+	#else
+		tdisp_lld_set_cursor(col, row);
+	#endif
 	MUTEX_LEAVE();
 }
 
@@ -76,25 +195,57 @@ void tdispCreateChar(uint8_t address, uint8_t *charmap) {
 	if (address < TDISP.maxCustomChars) {
 		MUTEX_ENTER();
 		tdisp_lld_create_char(address, charmap);
+		#if TDISP_NEED_BUFFER
+			/* The display cursor has been moved into the character generator memory */
+			tdispBuf.hwrow = -1;
+			tdispBuf.flags |= BUF_DIRTY;
+		#endif
 		MUTEX_LEAVE();
 	}
 }
 
 void tdispDrawChar(char c) {
 	MUTEX_ENTER();
-	tdisp_lld_draw_char(c);
+	#if TDISP_NEED_BUFFER
+		buf_draw_char(c);
+	#else
+		tdisp_lld_draw_char(c);
+	#endif
 	MUTEX_LEAVE();
 }
 
 void tdispDrawString(char *s) {
 	MUTEX_ENTER();
-	while(*s)
-		tdisp_lld_draw_char(*s++);
+	while(*s) {
+		#if TDISP_NEED_BUFFER
+			buf_draw_char(*s++);
+		#else
+			tdisp_lld_draw_char(*s++);
+		#endif
+	}
 	MUTEX_LEAVE();
 }
 
 void tdispControl(uint16_t what, uint16_t value) {
 	MUTEX_ENTER();
+	#if TDISP_NEED_BUFFER
+		switch(what) {
+		case TDISP_CTRL_MOVE:
+			/* We handle the move direction ourselves - the display always moves right */
+			if (value == cursorDecrease)
+				tdispBuf.flags |= BUF_DECREASE;
+			else
+				tdispBuf.flags &= ~BUF_DECREASE;
+			MUTEX_LEAVE();
+			return;
+		case TDISP_CTRL_CURSOR:
+			if (value == cursorOff)
+				tdispBuf.flags &= ~BUF_CURSOR_SHOWN;
+			else
+				tdispBuf.flags |= BUF_CURSOR_SHOWN|BUF_DIRTY;
+			break;
+		}
+	#endif
 	tdisp_lld_control(what, value);
 	MUTEX_LEAVE();
 }
@@ -6,6 +6,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <string.h>
 #ifdef WIN32
@@ -14,6 +15,147 @@
 
 static unsigned char buf[1024];
 
+/**
+ * The compressed format read by gdispImageSetCompressedMemoryReader().
+ * A header of 'G', 'Z', the window size as a power of 2, 0 and the 32 bit little endian
+ * uncompressed length. Then a series of tokens...
+ *		0nnnnnnn						- (n+1) literal bytes follow
+ *		1nnnnnnn offset-lo offset-hi	- copy (n+4) bytes from (offset+1) bytes back
+ * Matches never reach back further than the window so the decompressor only needs to
+ * remember that many bytes.
+ */
+#define Z_MINMATCH		4
+#define Z_MAXMATCH		(0x7F+Z_MINMATCH)
+#define Z_MAXLITERAL	0x80
+#define Z_HASHSIZE		4096
+#define Z_MAXCHAIN		256
+
+static unsigned char *	zdata;
+static size_t			zlen;
+static size_t			zpos;
+
+#define ZHASH(p)	((((unsigned)(p)[0] << 8) ^ ((unsigned)(p)[1] << 4) ^ (p)[2] ^ ((unsigned)(p)[3] << 2)) & (Z_HASHSIZE-1))
+
+static void zflush(const unsigned char *lit, size_t n) {
+	memcpy(zdata+zlen, lit, n);
+	zlen += n;
+}
+
+static int compress(const unsigned char *in, size_t len, unsigned wbits) {
+	long *		head;
+	long *		prev;
+	size_t		i, j, lit, best, bestoff, n, chain;
+	size_t		window;
+
+	window = (size_t)1 << wbits;
+	head = (long *)malloc(Z_HASHSIZE * sizeof(long));
+	prev = (long *)malloc((len+1) * sizeof(long));
+	zdata = (unsigned char *)malloc(len + len/Z_MAXLITERAL + 16);
+	if (!head || !prev || !zdata)
+		return 0;
+	for(i = 0; i < Z_HASHSIZE; i++)
+		head[i] = -1;
+
+	/* The header */
+	zdata[0] = 'G';
+	zdata[1] = 'Z';
+	zdata[2] = (unsigned char)wbits;
+	zdata[3] = 0;
+	zdata[4] = (unsigned char)len;
+	zdata[5] = (unsigned char)(len >> 8);
+	zdata[6] = (unsigned char)(len >> 16);
+	zdata[7] = (unsigned char)(len >> 24);
+	zlen = 8;
+
+	for(lit = i = 0; i < len; ) {
+		/* Find the longest match in the window */
+		best = bestoff = 0;
+		if (i + Z_MINMATCH <= len) {
+			prev[i] = head[ZHASH(in+i)];
+			head[ZHASH(in+i)] = (long)i;
+			for(chain = 0, j = (size_t)prev[i]; prev[i] >= 0 && i - j <= window && chain < Z_MAXCHAIN; chain++) {
+				for(n = 0; i+n < len && n < Z_MAXMATCH && in[j+n] == in[i+n]; n++);
+				if (n > best) {
+					best = n;
+					bestoff = i - j;
+					if (n == Z_MAXMATCH)
+						break;
+				}
+				if (prev[j] < 0)
+					break;
+				j = (size_t)prev[j];
+			}
+		}
+
+		if (best < Z_MINMATCH) {
+			/* Another literal */
+			if (++i - lit == Z_MAXLITERAL) {
+				zdata[zlen++] = (unsigned char)(Z_MAXLITERAL-1);
+				zflush(in+lit, Z_MAXLITERAL);
+				lit = i;
+			}
+			continue;
+		}
+
+		/* Flush the pending literals and then the match */
+		if (i > lit) {
+			zdata[zlen++] = (unsigned char)(i - lit - 1);
+			zflush(in+lit, i - lit);
+		}
+		zdata[zlen++] = (unsigned char)(0x80 | (best - Z_MINMATCH));
+		zdata[zlen++] = (unsigned char)(bestoff - 1);
+		zdata[zlen++] = (unsigned char)((bestoff - 1) >> 8);
+
+		/* Add the rest of the match to the hash chains */
+		for(n = 1; n < best; n++) {
+			if (i + n + Z_MINMATCH <= len) {
+				prev[i+n] = head[ZHASH(in+i+n)];
+				head[ZHASH(in+i+n)] = (long)(i+n);
+			}
+		}
+		i += best;
+		lit = i;
+	}
+	if (i > lit) {
+		zdata[zlen++] = (unsigned char)(i - lit - 1);
+		zflush(in+lit, i - lit);
+	}
+
+	free(head);
+	free(prev);
+	return 1;
+}
+
+/* Read the whole input file and compress it */
+static int readcompressed(FILE *f, unsigned wbits) {
+	unsigned char *	in;
+	unsigned char *	p;
+	size_t			len, sz;
+	int				ret;
+
+	for(in = 0, len = sz = 0; ; len += sz) {
+		if (!(p = (unsigned char *)realloc(in, len + sizeof(buf)))) {
+			free(in);
+			return 0;
+		}
+		in = p;
+		if (!(sz = fread(in+len, 1, sizeof(buf), f)))
+			break;
+	}
+	ret = compress(in, len, wbits);
+	free(in);
+	return ret;
+}
+
+/* Like fread() but from the compressed data */
+static size_t getcompressed(unsigned char *p, size_t len) {
+	if (len > zlen - zpos)
+		len = zlen - zpos;
+	memcpy(p, zdata+zpos, len);
+	zpos += len;
+	return len;
+}
+
 static char *filenameof(char *fname) {
 	char *p;
 
@@ -44,6 +186,8 @@ char *		opt_inputfile;
 char *		opt_outputfile;
 char *		opt_arrayname;
 int			opt_breakblocks;
+int			opt_compress;
+unsigned	opt_window;
 char *		opt_static;
 char *		opt_const;
 FILE *		f_input;
@@ -58,6 +202,8 @@ size_t		i;
 	opt_outputfile = 0;
 	opt_arrayname = 0;
 	opt_breakblocks = 0;
+	opt_compress = 0;
+	opt_window = 10;
 	opt_static = "";
 	opt_const = "";
 
@@ -70,7 +216,16 @@ size_t		i;
 				case 'b':		opt_breakblocks = 1;		break;
 				case 'c':		opt_const = "const ";		break;
 				case 's':		opt_static = "static ";		break;
+				case 'z':		opt_compress = 1;			break;
 				case 'n':		opt_arrayname = *++argv;	goto nextarg;
+				case 'w':
+					if (!argv[1] || (opt_window = (unsigned)atoi(argv[1])) < 4 || opt_window > 15) {
+						fprintf(stderr, "The window must be 4 to 15\n");
+						goto usage;
+					}
+					opt_compress = 1;
+					argv++;
+					goto nextarg;
 				default:
 					fprintf(stderr, "Unknown flag -%c\n", argv[0][0]);
 					goto usage;
@@ -83,12 +238,15 @@ size_t		i;
 		else {
 			usage:
 			fprintf(stderr, "Usage:\n\t%s -?\n"
-							"\t%s [-bs] [-n name] [inputfile] [outputfile]\n"
+							"\t%s [-bcsz] [-w bits] [-n name] [inputfile] [outputfile]\n"
 							"\t\t-?\tThis help\n"
 							"\t\t-h\tThis help\n"
 							"\t\t-b\tBreak the arrays for compilers that won't handle large arrays\n"
 							"\t\t-c\tDeclare the arrays as const (useful to ensure they end up in Flash)\n"
 							"\t\t-s\tDeclare the arrays as static\n"
+							"\t\t-z\tCompress the file. Read it with gdispImageSetCompressedMemoryReader()\n"
+							"\t\t-w bits\tCompress the file using a window of 2^bits bytes (4 to 15, default 10)\n"
+							"\t\t\tThe decompressor needs a buffer of this size\n"
 							"\t\t-n name\tUse \"name\" as the name of the array\n"
 					, opt_progname, opt_progname);
 			return 1;
@@ -129,12 +287,13 @@ size_t		i;
 	fprintf(f_output, "/**\n * This file was generated ");
 	if (opt_inputfile) fprintf(f_output, "from \"%s\" ", opt_inputfile);
 	fprintf(f_output, "using...\n *\n *\t%s", opt_progname);
-	if (opt_arrayname || opt_static[0] || opt_const[0] || opt_breakblocks) {
+	if (opt_arrayname || opt_static[0] || opt_const[0] || opt_breakblocks || opt_compress) {
 		fprintf(f_output, " -");
 		if (opt_breakblocks) fprintf(f_output, "b");
 		if (opt_const[0]) fprintf(f_output, "c");
 		if (opt_static[0]) fprintf(f_output, "s");
-		if (opt_arrayname) fprintf(f_output, "n %s", opt_arrayname);
+		if (opt_compress) fprintf(f_output, "w %u", opt_window);
+		if (opt_arrayname) fprintf(f_output, "%sn %s", opt_compress ? " -" : "", opt_arrayname);
 	}
 	if (opt_inputfile) fprintf(f_output, " %s", opt_inputfile);
 	if (opt_outputfile) fprintf(f_output, " %s", opt_outputfile);
@@ -153,9 +312,20 @@ size_t		i;
 	}
 	opt_arrayname = clean4c(opt_arrayname);
 
+	/* Compress the whole file first */
+	if (opt_compress) {
+		if (!readcompressed(f_input, opt_window)) {
+			fprintf(stderr, "Out of memory compressing the file\n");
+			return 1;
+		}
+		fprintf(f_output, "/* Compressed from %lu to %lu bytes. Read it with gdispImageSetCompressedMemoryReader() */\n",
+				(unsigned long)(zdata[4] | (zdata[5] << 8) | ((unsigned long)zdata[6] << 16) | ((unsigned long)zdata[7] << 24)),
+				(unsigned long)zlen);
+	}
+
 	/* Read the file processing 1K at a time */
 	blocknum = 0;
-	while((len = fread(buf, 1, sizeof(buf), f_input))) {
+	while((len = opt_compress ? getcompressed(buf, sizeof(buf)) : fread(buf, 1, sizeof(buf), f_input))) {
 		if (!blocknum++)
 			fprintf(f_output, "%s%sunsigned char %s[] = {", opt_static, opt_const, opt_arrayname);
 		else if (opt_breakblocks)
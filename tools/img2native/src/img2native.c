@@ -0,0 +1,471 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/**
+ * Convert a BMP file into a GDISP native image.
+ * See src/gdisp/image_native.c for a description of the format.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FLG_RLE			0x01
+#define FLG_PALETTE		0x02
+
+#define MODE_V1			0
+#define MODE_RAW		1
+#define MODE_RLE		2
+#define MODE_PAL		3
+#define MODE_PALRLE		4
+#define MODE_AUTO		5
+
+static const char *modenames[] = { "v1", "raw", "rle", "pal", "palrle", "auto" };
+
+/* The image as 0x00RRGGBB */
+static unsigned long *	image;
+static unsigned			width, height;
+
+/* The palette (if it fits) */
+static unsigned long	palette[256];
+static unsigned			palsize;
+
+/* The output being built */
+static unsigned char *	out;
+static size_t			outlen;
+
+static char *filenameof(char *fname) {
+	char *p;
+
+#ifdef WIN32
+	if (fname[1] == ':')
+		fname = fname+2;
+	p = strrchr(fname, '\\');
+	if (p) fname = p+1;
+#endif
+	p = strrchr(fname, '/');
+	if (p) fname = p+1;
+	return fname;
+}
+
+static unsigned long getLE(const unsigned char *p, unsigned bytes) {
+	unsigned long v;
+
+	for(v = 0, p += bytes; bytes--; )
+		v = (v << 8) | *--p;
+	return v;
+}
+
+static int readbmp(FILE *f) {
+	unsigned char	hdr[54];
+	unsigned char	pal[256*4];
+	unsigned char *	row;
+	unsigned long	offset, infosize, bpp, compression, ncolors;
+	long			h;
+	unsigned		x, y, stride, i;
+	int				topdown;
+
+	if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr) || hdr[0] != 'B' || hdr[1] != 'M') {
+		fprintf(stderr, "Not a BMP file\n");
+		return 0;
+	}
+	offset = getLE(hdr+10, 4);
+	infosize = getLE(hdr+14, 4);
+	width = (unsigned)getLE(hdr+18, 4);
+	h = (long)getLE(hdr+22, 4);
+	if (h & 0x80000000L)
+		h -= 0x100000000L;
+	topdown = h < 0;
+	height = (unsigned)(topdown ? -h : h);
+	bpp = getLE(hdr+28, 2);
+	compression = getLE(hdr+30, 4);
+	ncolors = getLE(hdr+46, 4);
+	if (infosize < 40 || (compression != 0 && !(compression == 3 && bpp == 32))
+			|| (bpp != 1 && bpp != 4 && bpp != 8 && bpp != 24 && bpp != 32)) {
+		fprintf(stderr, "Only uncompressed 1, 4, 8, 24 and 32 bit BMP files are supported\n");
+		return 0;
+	}
+	if (!width || !height || width > 32767 || height > 32767) {
+		fprintf(stderr, "Bad image size\n");
+		return 0;
+	}
+
+	/* The BMP palette */
+	if (bpp <= 8) {
+		if (!ncolors || ncolors > (1UL << bpp))
+			ncolors = 1UL << bpp;
+		fseek(f, 14 + infosize, SEEK_SET);
+		if (fread(pal, 4, ncolors, f) != ncolors) {
+			fprintf(stderr, "Bad BMP palette\n");
+			return 0;
+		}
+	}
+
+	stride = ((width * bpp + 31) / 32) * 4;
+	image = (unsigned long *)malloc(width * height * sizeof(unsigned long));
+	row = (unsigned char *)malloc(stride);
+	if (!image || !row) {
+		fprintf(stderr, "Out of memory\n");
+		return 0;
+	}
+	fseek(f, offset, SEEK_SET);
+	for(y = 0; y < height; y++) {
+		unsigned long *dst = image + (topdown ? y : height-1-y) * width;
+
+		if (fread(row, 1, stride, f) != stride) {
+			fprintf(stderr, "The BMP file is too short\n");
+			return 0;
+		}
+		for(x = 0; x < width; x++) {
+			switch(bpp) {
+			case 1:		i = (row[x/8] >> (7 - (x & 7))) & 0x01;			break;
+			case 4:		i = (row[x/2] >> ((x & 1) ? 0 : 4)) & 0x0F;		break;
+			case 8:		i = row[x];										break;
+			case 24:	dst[x] = getLE(row + x*3, 3);					continue;
+			default:	dst[x] = getLE(row + x*4, 4) & 0xFFFFFF;		continue;
+			}
+			dst[x] = i < ncolors ? getLE(pal + i*4, 3) : 0;
+		}
+	}
+	free(row);
+	return 1;
+}
+
+/* Rotate the image clockwise */
+static int rotate(unsigned degrees) {
+	unsigned long *	rot;
+	unsigned		x, y;
+
+	if (!degrees)
+		return 1;
+	if (!(rot = (unsigned long *)malloc(width * height * sizeof(unsigned long)))) {
+		fprintf(stderr, "Out of memory\n");
+		return 0;
+	}
+	for(y = 0; y < height; y++) {
+		for(x = 0; x < width; x++) {
+			switch(degrees) {
+			case 90:	rot[x * height + (height-1-y)] = image[y * width + x];					break;
+			case 180:	rot[(height-1-y) * width + (width-1-x)] = image[y * width + x];			break;
+			case 270:	rot[(width-1-x) * height + y] = image[y * width + x];					break;
+			}
+		}
+	}
+	free(image);
+	image = rot;
+	if (degrees != 180) {
+		x = width;
+		width = height;
+		height = x;
+	}
+	return 1;
+}
+
+/* Convert a color to a pixel in the GDISP pixel format. Returns the size of a pixel. */
+static unsigned topixel(unsigned long c, unsigned fmt, unsigned char *p) {
+	unsigned long	r, g, b, v;
+	unsigned		sz, i;
+
+	r = (c >> 16) & 0xFF;
+	g = (c >> 8) & 0xFF;
+	b = c & 0xFF;
+	switch(fmt) {
+	case 1:		v = (r|g|b) ? 1 : 0;										sz = 1;	break;
+	case 332:	v = (r & 0xE0) | ((g & 0xE0) >> 3) | (b >> 6);			sz = 1;	break;
+	case 444:	v = ((r & 0xF0) << 4) | (g & 0xF0) | (b >> 4);			sz = 2;	break;
+	case 666:	v = ((r & 0xFC) << 10) | ((g & 0xFC) << 4) | (b >> 2);	sz = 4;	break;
+	case 888:	v = c & 0xFFFFFF;										sz = 4;	break;
+	default:	v = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);	sz = 2;	break;
+	}
+
+	/* A pixel_t in little endian order */
+	for(i = 0; i < sz; i++, v >>= 8)
+		p[i] = (unsigned char)v;
+	return sz;
+}
+
+/* Build the palette. Returns 0 if there are too many colors. */
+static int makepalette(void) {
+	unsigned long	i;
+	unsigned		j;
+
+	for(palsize = 0, i = 0; i < (unsigned long)width * height; i++) {
+		for(j = 0; j < palsize && palette[j] != image[i]; j++);
+		if (j < palsize)
+			continue;
+		if (palsize >= 256)
+			return 0;
+		palette[palsize++] = image[i];
+	}
+	return 1;
+}
+
+static unsigned palindex(unsigned long c) {
+	unsigned j;
+
+	for(j = 0; palette[j] != c; j++);
+	return j;
+}
+
+static void put(const void *p, size_t len) {
+	memcpy(out+outlen, p, len);
+	outlen += len;
+}
+
+static void putbyte(unsigned v) {
+	out[outlen++] = (unsigned char)v;
+}
+
+static void putBE(unsigned long v, unsigned bytes) {
+	while(bytes--)
+		putbyte((unsigned)(v >> (bytes*8)));
+}
+
+/* Run length encode n units of usz bytes */
+static void putrle(const unsigned char *p, size_t n, unsigned usz) {
+	size_t		i, lit, run;
+	size_t		minrun;
+
+	/* A run of 2 single bytes saves nothing */
+	minrun = usz == 1 ? 3 : 2;
+	for(lit = i = 0; i < n; ) {
+		for(run = 1; i+run < n && run < 0x7F+2 && !memcmp(p+i*usz, p+(i+run)*usz, usz); run++);
+		if (run < minrun) {
+			if (++i - lit == 0x80) {
+				putbyte(0x7F);
+				put(p+lit*usz, 0x80*usz);
+				lit = i;
+			}
+			continue;
+		}
+		if (i > lit) {
+			putbyte((unsigned)(i - lit - 1));
+			put(p+lit*usz, (i-lit)*usz);
+		}
+		putbyte((unsigned)(0x80 | (run - 2)));
+		put(p+i*usz, usz);
+		i += run;
+		lit = i;
+	}
+	if (i > lit) {
+		putbyte((unsigned)(i - lit - 1));
+		put(p+lit*usz, (i-lit)*usz);
+	}
+}
+
+/* Build the image in memory */
+static int encode(unsigned mode, unsigned fmt) {
+	unsigned char *	row;
+	size_t			rowbytes, tablepos;
+	unsigned		x, y, bpp, usz, i;
+	unsigned char	pix[4];
+
+	if ((mode == MODE_PAL || mode == MODE_PALRLE) && !makepalette())
+		return 0;
+	for(bpp = 1; mode >= MODE_PAL && (1U << bpp) < palsize; bpp <<= 1);
+	usz = topixel(0, fmt, pix);
+	rowbytes = mode >= MODE_PAL ? (width * bpp + 7) / 8 : width * usz;
+
+	/* Worst case - every unit a literal */
+	free(out);
+	out = (unsigned char *)malloc(16 + 256*3 + height * (4 + rowbytes + rowbytes/0x80 + 2));
+	row = (unsigned char *)malloc(rowbytes);
+	if (!out || !row) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	outlen = 0;
+
+	/* The header */
+	putbyte('N');
+	putbyte(mode == MODE_V1 ? 'I' : '2');
+	putBE(width, 2);
+	putBE(height, 2);
+	putBE(mode >= MODE_PAL ? 888 : fmt, 2);
+	if (mode != MODE_V1) {
+		putbyte((mode == MODE_RLE || mode == MODE_PALRLE ? FLG_RLE : 0) | (mode >= MODE_PAL ? FLG_PALETTE : 0));
+		putbyte(mode >= MODE_PAL ? bpp : 0);
+		putBE(mode >= MODE_PAL ? palsize : 0, 2);
+		putBE(0, 4);						// The length of the image - filled in at the end
+	}
+	if (mode >= MODE_PAL) {
+		for(i = 0; i < palsize; i++)
+			putBE(palette[i], 3);
+	}
+
+	/* Leave room for the row offsets */
+	tablepos = outlen;
+	if (mode == MODE_RLE || mode == MODE_PALRLE)
+		outlen += height * 4;
+
+	for(y = 0; y < height; y++) {
+		const unsigned long *src = image + y * width;
+
+		/* Unpack the row */
+		if (mode >= MODE_PAL) {
+			memset(row, 0, rowbytes);
+			for(x = 0; x < width; x++)
+				row[x*bpp/8] |= (unsigned char)(palindex(src[x]) << (8 - bpp - (x*bpp & 7)));
+		} else {
+			for(x = 0; x < width; x++)
+				topixel(src[x], fmt, row + x*usz);
+		}
+
+		if (mode == MODE_RLE || mode == MODE_PALRLE) {
+			out[tablepos+y*4] = (unsigned char)(outlen >> 24);
+			out[tablepos+y*4+1] = (unsigned char)(outlen >> 16);
+			out[tablepos+y*4+2] = (unsigned char)(outlen >> 8);
+			out[tablepos+y*4+3] = (unsigned char)outlen;
+			putrle(row, mode == MODE_PALRLE ? rowbytes : width, mode == MODE_PALRLE ? 1 : usz);
+		} else
+			put(row, rowbytes);
+	}
+	free(row);
+
+	if (mode != MODE_V1) {
+		out[12] = (unsigned char)(outlen >> 24);
+		out[13] = (unsigned char)(outlen >> 16);
+		out[14] = (unsigned char)(outlen >> 8);
+		out[15] = (unsigned char)outlen;
+	}
+	return 1;
+}
+
+int main(int argc, char * argv[])
+{
+char *			opt_progname;
+char *			opt_inputfile;
+char *			opt_outputfile;
+unsigned		opt_format;
+unsigned		opt_mode;
+unsigned		opt_rotate;
+FILE *			f_input;
+FILE *			f_output;
+unsigned char *	best;
+size_t			bestlen;
+unsigned		bestmode, mode;
+(void)			argc;
+
+	/* Default values for our parameters */
+	opt_progname = filenameof(argv[0]);
+	opt_inputfile = 0;
+	opt_outputfile = 0;
+	opt_format = 565;
+	opt_mode = MODE_AUTO;
+	opt_rotate = 0;
+
+	/* Read the arguments */
+	while(*++argv) {
+		if (argv[0][0] == '-') {
+			switch(argv[0][1]) {
+			case 'f':
+				if (!argv[1]) goto usage;
+				opt_format = (unsigned)atoi(*++argv);
+				if (opt_format != 1 && opt_format != 332 && opt_format != 444 && opt_format != 565 && opt_format != 666 && opt_format != 888) {
+					fprintf(stderr, "Unknown pixel format %s\n", *argv);
+					goto usage;
+				}
+				break;
+			case 'e':
+				if (!argv[1]) goto usage;
+				for(opt_mode = 0; opt_mode <= MODE_AUTO && strcmp(argv[1], modenames[opt_mode]); opt_mode++);
+				if (opt_mode > MODE_AUTO) {
+					fprintf(stderr, "Unknown encoding %s\n", argv[1]);
+					goto usage;
+				}
+				argv++;
+				break;
+			case 'r':
+				if (!argv[1]) goto usage;
+				opt_rotate = (unsigned)atoi(*++argv);
+				if (opt_rotate != 0 && opt_rotate != 90 && opt_rotate != 180 && opt_rotate != 270) {
+					fprintf(stderr, "The rotation must be 0, 90, 180 or 270\n");
+					goto usage;
+				}
+				break;
+			default:
+				goto usage;
+			}
+		} else if (!opt_inputfile)
+			opt_inputfile = argv[0];
+		else if (!opt_outputfile)
+			opt_outputfile = argv[0];
+		else {
+			usage:
+			fprintf(stderr, "Usage:\n\t%s -?\n"
+							"\t%s [-f format] [-e encoding] [-r degrees] inputfile.bmp outputfile\n"
+							"\t\t-?\tThis help\n"
+							"\t\t-f format\tThe GDISP pixel format: 565 (default), 888, 444, 332, 666 or 1 (mono)\n"
+							"\t\t\t\tPalette images are drawn in any pixel format\n"
+							"\t\t-e encoding\tauto (default) - the smallest of the below\n"
+							"\t\t\t\traw - pixels\n"
+							"\t\t\t\trle - run length encoded pixels\n"
+							"\t\t\t\tpal - palette indexes (256 colors or less)\n"
+							"\t\t\t\tpalrle - run length encoded palette indexes\n"
+							"\t\t\t\tv1 - pixels in the original native format\n"
+							"\t\t-r degrees\tRotate the image clockwise by 90, 180 or 270 degrees\n"
+							"\t\t\t\tFor a display driven in its native orientation\n"
+							"\t\t\t\tbut mounted rotated.\n"
+							"\tUse file2c to compile the output into your project.\n"
+					, opt_progname, opt_progname);
+			return 1;
+		}
+	}
+	if (!opt_inputfile || !opt_outputfile)
+		goto usage;
+
+	/* Read the image */
+	if (!(f_input = fopen(opt_inputfile, "rb"))) {
+		fprintf(stderr, "Could not open input file '%s'\n", opt_inputfile);
+		return 1;
+	}
+	if (!readbmp(f_input))
+		return 1;
+	fclose(f_input);
+	if (!rotate(opt_rotate))
+		return 1;
+
+	/* Encode it */
+	if (opt_mode != MODE_AUTO) {
+		if (!encode(opt_mode, opt_format)) {
+			fprintf(stderr, "The image has more than 256 colors\n");
+			return 1;
+		}
+		bestmode = opt_mode;
+	} else {
+		best = 0;
+		bestlen = 0;
+		bestmode = MODE_RAW;
+		for(mode = MODE_RAW; mode < MODE_AUTO; mode++) {
+			if (!encode(mode, opt_format))
+				continue;
+			if (!best || outlen < bestlen) {
+				free(best);
+				best = out;
+				bestlen = outlen;
+				bestmode = mode;
+				out = 0;
+			}
+		}
+		out = best;
+		outlen = bestlen;
+	}
+
+	/* Write it */
+	if (!(f_output = fopen(opt_outputfile, "wb"))) {
+		fprintf(stderr, "Could not open output file '%s'\n", opt_outputfile);
+		return 1;
+	}
+	if (fwrite(out, 1, outlen, f_output) != outlen) {
+		fprintf(stderr, "Output file write error - disk full?\n");
+		return 1;
+	}
+	fclose(f_output);
+	printf("%s: %ux%u %s, %lu bytes\n", opt_outputfile, width, height, modenames[bestmode], (unsigned long)outlen);
+
+	return 0;
+}
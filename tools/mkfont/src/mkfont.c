@@ -0,0 +1,500 @@
+/*
+ * This file is subject to the terms of the GFX License, v1.0. If a copy of
+ * the license was not distributed with this file, you can obtain one at:
+ *
+ *              http://chibios-gfx.com/license.html
+ */
+
+/*
+ * Convert a TrueType (or any other FreeType supported) font into
+ * an anti-aliased GDISP font that can be compiled into your project
+ * or loaded at run-time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#define MAX_CHARS	65536
+#define MAX_KERNS	65535
+
+static unsigned char wanted[MAX_CHARS];		/* 1 = in the main range, 2 = only if the font has it */
+static unsigned		codes[MAX_CHARS];
+static unsigned		widths[MAX_CHARS];
+static unsigned		offsets[MAX_CHARS+1];
+static unsigned char *runs;
+static unsigned		runlen, runmax;
+static unsigned		kernleft[MAX_KERNS], kernright[MAX_KERNS];
+static int			kernadjust[MAX_KERNS];
+
+static char *filenameof(char *fname) {
+	char *p;
+
+#ifdef WIN32
+	if (fname[1] == ':')
+		fname = fname+2;
+	p = strrchr(fname, '\\');
+	if (p) fname = p+1;
+#endif
+	p = strrchr(fname, '/');
+	if (p) fname = p+1;
+	p = strchr(fname, '.');
+	if (p) *p = 0;
+	return fname;
+}
+
+static char *clean4c(char *fname) {
+	char *p;
+
+	while((p = strpbrk(fname, "-+ `~!@#$%^&*(){}[]|:;'\",<>?/|=.\\"))) *p = '_';
+	return fname;
+}
+
+/* Read a character number - decimal or 0x hex */
+static unsigned getcode(const char *str) {
+	return (unsigned)strtoul(str, 0, 0);
+}
+
+/* Add a range of characters of the form "first-last" or just "first" */
+static int addrange(const char *str) {
+	unsigned	first, last;
+	const char	*p;
+
+	first = last = getcode(str);
+	if ((p = strchr(str, '-')))
+		last = getcode(p+1);
+	if (first > last || last >= MAX_CHARS)
+		return 0;
+	while(first <= last)
+		if (!wanted[first++])
+			wanted[first-1] = 2;
+	return 1;
+}
+
+/* Add every character used in a UTF-8 text file */
+static int addtext(const char *fname) {
+	FILE *		f;
+	int			ch;
+	unsigned	c, n;
+
+	if (!(f = fopen(fname, "rb")))
+		return 0;
+	n = c = 0;
+	while((ch = getc(f)) != EOF) {
+		if ((ch & 0xC0) == 0x80) {
+			/* A continuation byte */
+			if (n) {
+				c = (c << 6) | (ch & 0x3F);
+				if (!--n && c < MAX_CHARS && c >= ' ' && !wanted[c])
+					wanted[c] = 2;
+			}
+			continue;
+		}
+		n = ch >= 0xF0 ? 3 : ch >= 0xE0 ? 2 : ch >= 0xC0 ? 1 : 0;
+		c = ch & (0x7F >> n);
+		if (!n && c >= ' ' && !wanted[c])
+			wanted[c] = 2;
+	}
+	fclose(f);
+	return 1;
+}
+
+static void put16(FILE *f, unsigned v) {
+	putc(v & 0xFF, f);
+	putc((v >> 8) & 0xFF, f);
+}
+
+static void put32(FILE *f, unsigned v) {
+	put16(f, v & 0xFFFF);
+	put16(f, v >> 16);
+}
+
+/* Write a font file for gdispLoadFontXxx(). See src/gdisp/fonts.c for the format. */
+static void writebinary(FILE *f, const char *fontname, unsigned bpp, unsigned height, unsigned linespacing, unsigned descent,
+						unsigned minwidth, unsigned maxwidth, unsigned nglyphs, unsigned nranges, unsigned kerncount) {
+	unsigned	i, j;
+
+	fwrite("GFNT", 1, 4, f);
+	putc(1, f);							/* The file version */
+	putc(bpp, f);
+	putc(height, f);
+	putc(0, f);							/* The character padding */
+	putc(linespacing, f);
+	putc(descent, f);
+	putc(minwidth, f);
+	putc(maxwidth, f);
+	put16(f, nglyphs);
+	put16(f, nranges);
+	put16(f, kerncount);
+	putc(strlen(fontname)+1, f);
+	putc(0, f);							/* Reserved */
+	fwrite(fontname, 1, strlen(fontname)+1, f);
+
+	for(i = 1, j = 0; i <= nglyphs; i++) {
+		if (i < nglyphs && codes[i] == codes[i-1]+1)
+			continue;
+		put16(f, codes[j]);
+		put16(f, codes[i-1]);
+		put16(f, j);
+		j = i;
+	}
+	for(i = 0; i < kerncount; i++) {
+		put16(f, kernleft[i]);
+		put16(f, kernright[i]);
+		putc(kernadjust[i] & 0xFF, f);
+	}
+	for(i = 0; i < nglyphs; i++)
+		putc(widths[i], f);
+	for(i = 0; i <= nglyphs; i++)
+		put32(f, offsets[i]);
+	fwrite(runs, 1, runlen, f);
+}
+
+static void addrun(unsigned value, unsigned count, unsigned bpp) {
+	unsigned	n;
+
+	/* A run byte holds the value in the bottom bits and (count-1) in the rest */
+	while(count) {
+		n = count > (256U >> bpp) ? (256U >> bpp) : count;
+		if (runlen >= runmax) {
+			runmax = runmax ? runmax * 2 : 4096;
+			if (!(runs = realloc(runs, runmax))) {
+				fprintf(stderr, "Out of memory\n");
+				exit(1);
+			}
+		}
+		runs[runlen++] = (unsigned char)(((n - 1) << bpp) | value);
+		count -= n;
+	}
+}
+
+/* Render a character into a cell of coverage runs. Returns the cell width. */
+static unsigned addglyph(FT_Face face, unsigned c, int ascent, unsigned height, unsigned bpp) {
+	FT_GlyphSlot	g;
+	unsigned		width, x, y, v, last, count, maxv;
+	int				bx, by;
+
+	if (FT_Load_Char(face, c, FT_LOAD_RENDER|FT_LOAD_TARGET_NORMAL))
+		return 0;
+	g = face->glyph;
+	width = (g->advance.x + 32) >> 6;
+	if (!width)
+		return 0;
+
+	maxv = (1 << bpp) - 1;
+	last = count = 0;
+	for(y = 0; y < height; y++) {
+		for(x = 0; x < width; x++) {
+			/* Anything outside the cell is clipped */
+			bx = (int)x - g->bitmap_left;
+			by = (int)y - (ascent - g->bitmap_top);
+			v = 0;
+			if (bx >= 0 && by >= 0 && bx < (int)g->bitmap.width && by < (int)g->bitmap.rows)
+				v = (g->bitmap.buffer[by * g->bitmap.pitch + bx] * maxv + 127) / 255;
+			if (count && v != last) {
+				addrun(last, count, bpp);
+				count = 0;
+			}
+			last = v;
+			count++;
+		}
+	}
+	if (count)
+		addrun(last, count, bpp);
+	return width;
+}
+
+int main(int argc, char * argv[])
+{
+char **		opt_args;
+char *		opt_progname;
+char *		opt_inputfile;
+char *		opt_outputfile;
+char *		opt_fontname;
+unsigned	opt_size;
+unsigned	opt_bpp;
+unsigned	opt_first;
+unsigned	opt_last;
+int			opt_kerning;
+int			opt_binary;
+char		fontname[256];
+char		cname[256+4];
+FT_Library	library;
+FT_Face		face;
+FT_Vector	delta;
+FILE *		f_output;
+int			ascent, descent;
+unsigned	height, linespacing, minwidth, maxwidth, kerncount;
+unsigned	nglyphs, nranges, maxcode;
+unsigned	c, i, j;
+
+	/* Keep a copy of the arguments for the comment header */
+	if (!(opt_args = malloc(argc * sizeof(char *))))
+		return 1;
+	memcpy(opt_args, argv, argc * sizeof(char *));
+
+	/* Default values for our parameters */
+	opt_progname = filenameof(argv[0]);
+	opt_inputfile = 0;
+	opt_outputfile = 0;
+	opt_fontname = 0;
+	opt_size = 16;
+	opt_bpp = 4;
+	opt_first = ' ';
+	opt_last = '~';
+	opt_kerning = 1;
+	opt_binary = 0;
+
+	/* Read the arguments */
+	while(*++argv) {
+		if (argv[0][0] == '-') {
+			while (*++(argv[0])) {
+				switch(argv[0][0]) {
+				case '?': case 'h':							goto usage;
+				case 'k':		opt_kerning = 0;			break;
+				case 'x':		opt_binary = 1;				break;
+				case 'b':		if (!argv[1]) goto usage; opt_bpp = atoi(*++argv);		goto nextarg;
+				case 's':		if (!argv[1]) goto usage; opt_size = atoi(*++argv);		goto nextarg;
+				case 'f':		if (!argv[1]) goto usage; opt_first = atoi(*++argv);	goto nextarg;
+				case 'l':		if (!argv[1]) goto usage; opt_last = atoi(*++argv);		goto nextarg;
+				case 'n':		if (!argv[1]) goto usage; opt_fontname = *++argv;		goto nextarg;
+				case 'r':
+					if (!argv[1] || !addrange(argv[1])) {
+						fprintf(stderr, "Bad character range\n");
+						goto usage;
+					}
+					argv++;
+					goto nextarg;
+				case 't':
+					if (!argv[1] || !addtext(argv[1])) {
+						fprintf(stderr, "Could not read text file\n");
+						goto usage;
+					}
+					argv++;
+					goto nextarg;
+				default:
+					fprintf(stderr, "Unknown flag -%c\n", argv[0][0]);
+					goto usage;
+				}
+			}
+		} else if (!opt_inputfile)
+			opt_inputfile = argv[0];
+		else if (!opt_outputfile)
+			opt_outputfile = argv[0];
+		else {
+			usage:
+			fprintf(stderr, "Usage:\n\t%s -?\n"
+							"\t%s [-k] [-x] [-b bits] [-s size] [-f first] [-l last] [-r range] [-t textfile] [-n name] fontfile [outputfile]\n"
+							"\t\t-?\tThis help\n"
+							"\t\t-h\tThis help\n"
+							"\t\t-k\tDon't include the kerning table\n"
+							"\t\t-x\tWrite a font file to load at run-time rather than C source\n"
+							"\t\t-b bits\tBits of coverage per pixel - 2 or 4 (default 4)\n"
+							"\t\t-s size\tThe font size (em height) in pixels (default 16)\n"
+							"\t\t-f first\tThe first character code (default 32)\n"
+							"\t\t-l last\tThe last character code (default 126)\n"
+							"\t\t-r range\tAlso include the characters first-last the font has (eg 0x400-0x4FF)\n"
+							"\t\t-t textfile\tAlso include every character used in a UTF-8 text file\n"
+							"\t\t-n name\tUse \"name\" as the font name\n"
+					, opt_progname, opt_progname);
+			return 1;
+		}
+	nextarg:	;
+	}
+
+	if (!opt_inputfile)
+		goto usage;
+	if (opt_bpp != 2 && opt_bpp != 4) {
+		fprintf(stderr, "Only 2 or 4 bits per pixel are supported\n");
+		goto usage;
+	}
+	if (opt_first < 1 || opt_first > opt_last || opt_last >= MAX_CHARS) {
+		fprintf(stderr, "The character range must be within 1 to %u\n", MAX_CHARS-1);
+		goto usage;
+	}
+	for(c = opt_first; c <= opt_last; c++)
+		wanted[c] = 1;
+
+	/* Open the font */
+	if (FT_Init_FreeType(&library) || FT_New_Face(library, opt_inputfile, 0, &face)) {
+		fprintf(stderr, "Could not open font file '%s'\n", opt_inputfile);
+		return 1;
+	}
+	if (FT_Set_Pixel_Sizes(face, 0, opt_size)) {
+		fprintf(stderr, "Could not set the font size to %u\n", opt_size);
+		return 1;
+	}
+
+	/* Open the output file */
+	if (opt_outputfile) {
+		f_output = fopen(opt_outputfile, opt_binary ? "wb" : "w");
+		if (!f_output) {
+			fprintf(stderr, "Could not open output file '%s'\n", opt_outputfile);
+			goto usage;
+		}
+	} else
+		f_output = stdout;
+
+	/* Work out the cell */
+	ascent = (face->size->metrics.ascender + 63) >> 6;
+	descent = (-face->size->metrics.descender + 63) >> 6;
+	height = ascent + descent;
+	linespacing = (face->size->metrics.height + 32) >> 6;
+	if (height > 255 || linespacing > 255) {
+		fprintf(stderr, "The font is too large\n");
+		return 1;
+	}
+
+	/* List the characters and the ranges they make. Extra characters the font doesn't have are dropped. */
+	nglyphs = nranges = 0;
+	for(c = 0; c < MAX_CHARS; c++) {
+		if (!wanted[c] || (wanted[c] == 2 && !FT_Get_Char_Index(face, c)))
+			continue;
+		if (!nglyphs || c != codes[nglyphs-1]+1)
+			nranges++;
+		codes[nglyphs++] = c;
+	}
+	maxcode = codes[nglyphs-1];
+
+	/* Render every character */
+	minwidth = 255;
+	maxwidth = 0;
+	for(i = 0; i < nglyphs; i++) {
+		offsets[i] = runlen;
+		widths[i] = addglyph(face, codes[i], ascent, height, opt_bpp);
+		if (widths[i] > 255) {
+			fprintf(stderr, "Character %u is too wide\n", codes[i]);
+			return 1;
+		}
+		if (widths[i] && widths[i] < minwidth)	minwidth = widths[i];
+		if (widths[i] > maxwidth)				maxwidth = widths[i];
+	}
+	offsets[nglyphs] = runlen;
+	if (!maxwidth) {
+		fprintf(stderr, "The font has no characters in the range %u to %u\n", opt_first, opt_last);
+		return 1;
+	}
+	if (opt_binary && nglyphs > 65535) {
+		fprintf(stderr, "A font file can hold no more than 65535 characters\n");
+		return 1;
+	}
+
+	/* Set the names */
+	if (opt_fontname)
+		snprintf(fontname, sizeof(fontname), "%s", opt_fontname);
+	else
+		snprintf(fontname, sizeof(fontname), "%s %u", face->family_name ? face->family_name : "Font", opt_size);
+	if (opt_binary)
+		fontname[254] = 0;		/* A font file name length is a byte including the nul */
+	snprintf(cname, sizeof(cname), "font%s", fontname);
+	clean4c(cname);
+
+	/* The kerning pairs - in left then right order so they can be binary searched */
+	kerncount = 0;
+	if (opt_kerning && FT_HAS_KERNING(face)) {
+		for(i = 0; i < nglyphs; i++) {
+			if (!widths[i]) continue;
+			for(j = 0; j < nglyphs && kerncount < MAX_KERNS; j++) {
+				if (!widths[j]) continue;
+				if (FT_Get_Kerning(face, FT_Get_Char_Index(face, codes[i]), FT_Get_Char_Index(face, codes[j]), FT_KERNING_DEFAULT, &delta))
+					continue;
+				delta.x = (delta.x + (delta.x < 0 ? -32 : 32)) / 64;
+				if (!delta.x || delta.x < -128 || delta.x > 127)
+					continue;
+				kernleft[kerncount] = codes[i];
+				kernright[kerncount] = codes[j];
+				kernadjust[kerncount++] = (int)delta.x;
+			}
+		}
+	}
+
+	/* A font file is all binary */
+	if (opt_binary) {
+		writebinary(f_output, fontname, opt_bpp, height, linespacing, descent, minwidth, maxwidth, nglyphs, nranges, kerncount);
+		goto done;
+	}
+
+	/* Print the comment header */
+	fprintf(f_output, "/**\n * This file was generated from \"%s\" using...\n *\n *\t%s", opt_inputfile, opt_progname);
+	for(i = 1; i < (unsigned)argc; i++)
+		fprintf(f_output, strchr(opt_args[i], ' ') ? " \"%s\"" : " %s", opt_args[i]);
+	fprintf(f_output, "\n *\n * To use it add this file to your project and then...\n"
+			" *\textern const struct font %s;\n"
+			" *\tgdispFillString(x, y, \"Hello\", &%s, White, Black);\n */\n\n", cname, cname);
+
+	fprintf(f_output, "#include \"gfx.h\"\n\n#if GFX_USE_GDISP && GDISP_NEED_TEXT\n\n#include \"gdisp/fonts.h\"\n\n"
+			"#if !GDISP_NEED_ANTIALIAS\n\t#error \"GDISP: GDISP_NEED_ANTIALIAS must be TRUE to use %s\"\n#endif\n", fontname);
+	if (maxcode > 255)
+		fprintf(f_output, "#if !GDISP_NEED_UTF8\n\t#error \"GDISP: GDISP_NEED_UTF8 must be TRUE to use %s\"\n#endif\n", fontname);
+	fprintf(f_output, "\n");
+
+	/* The character ranges - only needed for a sparse font */
+	if (nranges > 1 || maxcode > 127) {
+		fprintf(f_output, "static const struct fontrange %s_Ranges[] = {", cname);
+		for(i = 1, j = c = 0; i <= nglyphs; i++) {
+			if (i < nglyphs && codes[i] == codes[i-1]+1)
+				continue;
+			fprintf(f_output, (c++ & 0x03) ? " {%u, %u, %u}," : "\n\t{%u, %u, %u},", codes[j], codes[i-1], j);
+			j = i;
+		}
+		fprintf(f_output, "\n};\n");
+	} else
+		nranges = 0;
+
+	/* The glyph widths */
+	fprintf(f_output, "static const uint8_t %s_Widths[] = {", cname);
+	for(i = 0; i < nglyphs; i++)
+		fprintf(f_output, (i & 0x0F) ? " %u," : "\n\t%u,", widths[i]);
+	fprintf(f_output, "\n};\n");
+
+	/* The glyph offsets */
+	fprintf(f_output, "static const uint32_t %s_Offsets[] = {", cname);
+	for(i = 0; i < nglyphs; i++)
+		fprintf(f_output, (i & 0x07) ? " %u," : "\n\t%u,", offsets[i]);
+	fprintf(f_output, "\n};\n");
+
+	/* The glyph runs */
+	fprintf(f_output, "static const uint8_t %s_Runs[] = {", cname);
+	for(i = 0; i < runlen; i++)
+		fprintf(f_output, (i & 0x0F) ? " 0x%02X," : "\n\t0x%02X,", runs[i]);
+	fprintf(f_output, "\n};\n");
+
+	/* The kerning pairs */
+	if (kerncount) {
+		fprintf(f_output, "static const struct fontkern %s_Kerning[] = {", cname);
+		for(i = 0; i < kerncount; i++)
+			fprintf(f_output, (i & 0x03) ? " {%u, %u, %d}," : "\n\t{%u, %u, %d},", kernleft[i], kernright[i], kernadjust[i]);
+		fprintf(f_output, "\n};\n");
+	}
+
+	/* The font structures */
+	fprintf(f_output, "\nstatic const struct fontaa %s_AA = {\n\t%u, %u,\n\t%s_Offsets,\n\t%s_Runs,\n\t",
+			cname, opt_bpp, kerncount, cname, cname);
+	if (kerncount)
+		fprintf(f_output, "%s_Kerning\n};\n", cname);
+	else
+		fprintf(f_output, "0\n};\n");
+
+	fprintf(f_output, "const struct font %s = {\n\t\"%s\",\n\t%u, 0, %u, %u, %u, %u, %u, %u, 1, 1,\n"
+			"\t%s_Widths,\n\t0,\n\t0,\n\t&%s_AA,\n",
+			cname, fontname, height, linespacing, descent, minwidth, maxwidth,
+			nranges ? 0 : codes[0], nranges ? 0 : maxcode, cname, cname);
+	if (nranges)
+		fprintf(f_output, "\t%u, %s_Ranges\n};\n", nranges, cname);
+	else
+		fprintf(f_output, "\t0, 0\n};\n");
+	fprintf(f_output, "\n#endif /* GFX_USE_GDISP && GDISP_NEED_TEXT */\n");
+
+done:
+	/* Clean up */
+	if (ferror(f_output))
+		fprintf(stderr, "Output file write error - disk full?\n");
+	if (f_output != stdout)
+		fclose(f_output);
+	FT_Done_Face(face);
+	FT_Done_FreeType(library);
+
+	return 0;
+}